@@ -8,6 +8,10 @@ target_include_directories(${LIBRARY_NAME} PUBLIC
         $<BUILD_INTERFACE:${PROJECT_INCLUDE_FOLDER}>
         $<INSTALL_INTERFACE:${PROJECT_INSTALL_INCLUDE_FOLDER}>)
 
+# Set the fixed width of the ONV representation (in 64-bit words), which should be the same for the library and everything that uses its headers
+math(EXPR ONV_WORDS "${ONV_WIDTH} / 64")
+target_compile_definitions(${LIBRARY_NAME} PUBLIC GQCP_ONV_WORDS=${ONV_WORDS})
+
 # Include boost
 target_include_directories(${LIBRARY_NAME} PUBLIC ${Boost_INCLUDE_DIRS})
 target_link_libraries(${LIBRARY_NAME} PUBLIC ${Boost_LIBRARIES})
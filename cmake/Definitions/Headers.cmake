@@ -10,6 +10,7 @@ set(PROJECT_INCLUDE_FILES
         ${PROJECT_INCLUDE_FOLDER}/CISolver/CISolver.hpp
 
         ${PROJECT_INCLUDE_FOLDER}/FockSpace/BaseFockSpace.hpp
+        ${PROJECT_INCLUDE_FOLDER}/FockSpace/BitString.hpp
         ${PROJECT_INCLUDE_FOLDER}/FockSpace/Configuration.hpp
         ${PROJECT_INCLUDE_FOLDER}/FockSpace/FockPermutator.hpp
         ${PROJECT_INCLUDE_FOLDER}/FockSpace/FockSpace.hpp
@@ -18,6 +19,7 @@ set(PROJECT_INCLUDE_FILES
         ${PROJECT_INCLUDE_FOLDER}/FockSpace/FockSpaceType.hpp
         ${PROJECT_INCLUDE_FOLDER}/FockSpace/ONV.hpp
         ${PROJECT_INCLUDE_FOLDER}/FockSpace/SelectedFockSpace.hpp
+        ${PROJECT_INCLUDE_FOLDER}/FockSpace/SingleExcitationList.hpp
         ${PROJECT_INCLUDE_FOLDER}/FockSpace/ProductFockSpace.hpp
 
         ${PROJECT_INCLUDE_FOLDER}/geminals/AP1roG.hpp
@@ -38,10 +40,13 @@ set(PROJECT_INCLUDE_FILES
         ${PROJECT_INCLUDE_FOLDER}/HamiltonianBuilder/FrozenCoreFCI.hpp
         ${PROJECT_INCLUDE_FOLDER}/HamiltonianBuilder/HamiltonianBuilder.hpp
         ${PROJECT_INCLUDE_FOLDER}/HamiltonianBuilder/Hubbard.hpp
+        ${PROJECT_INCLUDE_FOLDER}/HamiltonianBuilder/PreparedFCI.hpp
         ${PROJECT_INCLUDE_FOLDER}/HamiltonianBuilder/SelectedCI.hpp
 
         ${PROJECT_INCLUDE_FOLDER}/HamiltonianParameters/BaseHamiltonianParameters.hpp
+        ${PROJECT_INCLUDE_FOLDER}/HamiltonianParameters/FCIDUMP.hpp
         ${PROJECT_INCLUDE_FOLDER}/HamiltonianParameters/HamiltonianParameters.hpp
+        ${PROJECT_INCLUDE_FOLDER}/HamiltonianParameters/PairIntegrals.hpp
 
         ${PROJECT_INCLUDE_FOLDER}/Localization/BaseERLocalizer.hpp
         ${PROJECT_INCLUDE_FOLDER}/Localization/ERJacobiLocalizer.hpp
@@ -65,8 +70,10 @@ set(PROJECT_INCLUDE_FILES
         ${PROJECT_INCLUDE_FOLDER}/math/ScalarFunction.hpp
         ${PROJECT_INCLUDE_FOLDER}/math/SquareMatrix.hpp
         ${PROJECT_INCLUDE_FOLDER}/math/SquareRankFourTensor.hpp
+        ${PROJECT_INCLUDE_FOLDER}/math/SymmetricSparseMatrix.hpp
         ${PROJECT_INCLUDE_FOLDER}/math/Tensor.hpp
 
+        ${PROJECT_INCLUDE_FOLDER}/Operator/FactorizedTwoElectronOperator.hpp
         ${PROJECT_INCLUDE_FOLDER}/Operator/OneElectronOperator.hpp
         ${PROJECT_INCLUDE_FOLDER}/Operator/TwoElectronOperator.hpp
 
@@ -84,17 +91,22 @@ set(PROJECT_INCLUDE_FILES
         ${PROJECT_INCLUDE_FOLDER}/RDM/RDMCalculator.hpp
         ${PROJECT_INCLUDE_FOLDER}/RDM/RDMs.hpp
         ${PROJECT_INCLUDE_FOLDER}/RDM/SelectedRDMBuilder.hpp
+        ${PROJECT_INCLUDE_FOLDER}/RDM/SeniorityZeroTwoRDM.hpp
         ${PROJECT_INCLUDE_FOLDER}/RDM/SpinUnresolvedFCIRDMBuilder.hpp
         ${PROJECT_INCLUDE_FOLDER}/RDM/SpinUnresolvedRDMCalculator.hpp
         ${PROJECT_INCLUDE_FOLDER}/RDM/TwoRDM.hpp
 
         ${PROJECT_INCLUDE_FOLDER}/RHF/DIISRHFSCFSolver.hpp
+        ${PROJECT_INCLUDE_FOLDER}/RHF/DirectRHFSCFSolver.hpp
+        ${PROJECT_INCLUDE_FOLDER}/RHF/FactorizedRHFSCFSolver.hpp
         ${PROJECT_INCLUDE_FOLDER}/RHF/PlainRHFSCFSolver.hpp
         ${PROJECT_INCLUDE_FOLDER}/RHF/RHF.hpp
         ${PROJECT_INCLUDE_FOLDER}/RHF/RHFSCFSolver.hpp
 
         ${PROJECT_INCLUDE_FOLDER}/utilities/linalg.hpp
+        ${PROJECT_INCLUDE_FOLDER}/utilities/MappedFile.hpp
         ${PROJECT_INCLUDE_FOLDER}/utilities/miscellaneous.hpp
+        ${PROJECT_INCLUDE_FOLDER}/utilities/parallel.hpp
 
         ${PROJECT_INCLUDE_FOLDER}/WaveFunction/SpinUnresolvedWaveFunction.hpp
         ${PROJECT_INCLUDE_FOLDER}/WaveFunction/WaveFunction.hpp
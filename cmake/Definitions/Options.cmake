@@ -6,3 +6,9 @@ option(BUILD_BENCHMARKS "Build benchmarks executables" OFF)
 option(BUILD_DRIVERS "Build standard drivers" OFF)
 
 option(USE_MKL "Find and use MKL for BLAS" OFF)
+
+set(ONV_WIDTH 128 CACHE STRING "The number of bits in the representation of an ONV, i.e. the maximum number of spatial orbitals: 64, 128 or 256")
+set_property(CACHE ONV_WIDTH PROPERTY STRINGS 64 128 256)
+if (NOT ONV_WIDTH MATCHES "^(64|128|256)$")
+    message(FATAL_ERROR "ONV_WIDTH should be 64, 128 or 256")
+endif()
@@ -16,6 +16,7 @@ set(PROJECT_SOURCE_FILES
         ${PROJECT_SOURCE_FOLDER}/FockSpace/ONV.cpp
         ${PROJECT_SOURCE_FOLDER}/FockSpace/ProductFockSpace.cpp
         ${PROJECT_SOURCE_FOLDER}/FockSpace/SelectedFockSpace.cpp
+        ${PROJECT_SOURCE_FOLDER}/FockSpace/SingleExcitationList.cpp
 
         ${PROJECT_SOURCE_FOLDER}/geminals/AP1roG.cpp
         ${PROJECT_SOURCE_FOLDER}/geminals/AP1roGBivariationalSolver.cpp
@@ -35,9 +36,11 @@ set(PROJECT_SOURCE_FILES
         ${PROJECT_SOURCE_FOLDER}/HamiltonianBuilder/FrozenCoreFCI.cpp
         ${PROJECT_SOURCE_FOLDER}/HamiltonianBuilder/HamiltonianBuilder.cpp
         ${PROJECT_SOURCE_FOLDER}/HamiltonianBuilder/Hubbard.cpp
+        ${PROJECT_SOURCE_FOLDER}/HamiltonianBuilder/PreparedFCI.cpp
         ${PROJECT_SOURCE_FOLDER}/HamiltonianBuilder/SelectedCI.cpp
 
         ${PROJECT_SOURCE_FOLDER}/HamiltonianParameters/BaseHamiltonianParameters.cpp
+        ${PROJECT_SOURCE_FOLDER}/HamiltonianParameters/FCIDUMP.cpp
 
         ${PROJECT_SOURCE_FOLDER}/Localization/BaseERLocalizer.cpp
         ${PROJECT_SOURCE_FOLDER}/Localization/ERJacobiLocalizer.cpp
@@ -71,12 +74,16 @@ set(PROJECT_SOURCE_FILES
         ${PROJECT_SOURCE_FOLDER}/RDM/SpinUnresolvedRDMCalculator.cpp
 
         ${PROJECT_SOURCE_FOLDER}/RHF/DIISRHFSCFSolver.cpp
+        ${PROJECT_SOURCE_FOLDER}/RHF/DirectRHFSCFSolver.cpp
+        ${PROJECT_SOURCE_FOLDER}/RHF/FactorizedRHFSCFSolver.cpp
         ${PROJECT_SOURCE_FOLDER}/RHF/PlainRHFSCFSolver.cpp
         ${PROJECT_SOURCE_FOLDER}/RHF/RHF.cpp
         ${PROJECT_SOURCE_FOLDER}/RHF/RHFSCFSolver.cpp
 
         ${PROJECT_SOURCE_FOLDER}/utilities/linalg.cpp
+        ${PROJECT_SOURCE_FOLDER}/utilities/MappedFile.cpp
         ${PROJECT_SOURCE_FOLDER}/utilities/miscellaneous.cpp
+        ${PROJECT_SOURCE_FOLDER}/utilities/parallel.cpp
 
         ${PROJECT_SOURCE_FOLDER}/WaveFunction/SpinUnresolvedWaveFunction.cpp
         ${PROJECT_SOURCE_FOLDER}/WaveFunction/WaveFunction.cpp
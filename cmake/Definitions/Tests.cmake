@@ -13,13 +13,16 @@ set(PROJECT_TEST_SOURCE_FILES
         ${PROJECT_TESTS_FOLDER}/CISolver/CISolver_FCI_Dense_test.cpp
         ${PROJECT_TESTS_FOLDER}/CISolver/CISolver_Hubbard_Davidson_test.cpp
         ${PROJECT_TESTS_FOLDER}/CISolver/CISolver_Hubbard_Dense_test.cpp
+        ${PROJECT_TESTS_FOLDER}/CISolver/CISolver_Hubbard_Sparse_test.cpp
         ${PROJECT_TESTS_FOLDER}/CISolver/CISolver_test.cpp
 
+        ${PROJECT_TESTS_FOLDER}/FockSpace/BitString_test.cpp
         ${PROJECT_TESTS_FOLDER}/FockSpace/FockSpace_test.cpp
         ${PROJECT_TESTS_FOLDER}/FockSpace/FrozenFockSpace_test.cpp
         ${PROJECT_TESTS_FOLDER}/FockSpace/FrozenProductFockSpace_test.cpp
         ${PROJECT_TESTS_FOLDER}/FockSpace/ONV_test.cpp
         ${PROJECT_TESTS_FOLDER}/FockSpace/SelectedFockSpace_test.cpp
+        ${PROJECT_TESTS_FOLDER}/FockSpace/SingleExcitationList_test.cpp
         ${PROJECT_TESTS_FOLDER}/FockSpace/ProductFockSpace_test.cpp
 
         ${PROJECT_TESTS_FOLDER}/geminals/AP1roGBivariationalSolver_test.cpp
@@ -33,9 +36,11 @@ set(PROJECT_TEST_SOURCE_FILES
         ${PROJECT_TESTS_FOLDER}/HamiltonianBuilder/FCI_test.cpp
         ${PROJECT_TESTS_FOLDER}/HamiltonianBuilder/FrozenCoreDOCI_test.cpp
         ${PROJECT_TESTS_FOLDER}/HamiltonianBuilder/FrozenCoreFCI_test.cpp
+        ${PROJECT_TESTS_FOLDER}/HamiltonianBuilder/HamiltonianBuilder_test.cpp
         ${PROJECT_TESTS_FOLDER}/HamiltonianBuilder/Hubbard_test.cpp
         ${PROJECT_TESTS_FOLDER}/HamiltonianBuilder/SelectedCI_test.cpp
 
+        ${PROJECT_TESTS_FOLDER}/HamiltonianParameters/FCIDUMP_test.cpp
         ${PROJECT_TESTS_FOLDER}/HamiltonianParameters/HamiltonianParameters_test.cpp
 
         ${PROJECT_TESTS_FOLDER}/Localization/ERJacobiLocalizer_test.cpp
@@ -52,8 +57,10 @@ set(PROJECT_TEST_SOURCE_FILES
         ${PROJECT_TESTS_FOLDER}/math/ScalarFunction_test.cpp
         ${PROJECT_TESTS_FOLDER}/math/SquareMatrix_test.cpp
         ${PROJECT_TESTS_FOLDER}/math/SquareRankFourTensor_test.cpp
+        ${PROJECT_TESTS_FOLDER}/math/SymmetricSparseMatrix_test.cpp
         ${PROJECT_TESTS_FOLDER}/math/Tensor_test.cpp
 
+        ${PROJECT_TESTS_FOLDER}/Operator/FactorizedTwoElectronOperator_test.cpp
         ${PROJECT_TESTS_FOLDER}/Operator/OneElectronOperator_test.cpp
         ${PROJECT_TESTS_FOLDER}/Operator/TwoElectronOperator_test.cpp
 
@@ -67,16 +74,20 @@ set(PROJECT_TEST_SOURCE_FILES
         ${PROJECT_TESTS_FOLDER}/RDM/OneRDM_test.cpp
         ${PROJECT_TESTS_FOLDER}/RDM/RDMCalculator_test.cpp
         ${PROJECT_TESTS_FOLDER}/RDM/SelectedRDMBuilder_test.cpp
+        ${PROJECT_TESTS_FOLDER}/RDM/SeniorityZeroTwoRDM_test.cpp
         ${PROJECT_TESTS_FOLDER}/RDM/SpinUnresolvedFCIRDMBuilder_test.cpp
         ${PROJECT_TESTS_FOLDER}/RDM/TwoRDM_test.cpp
 
         ${PROJECT_TESTS_FOLDER}/RHF/constrained_RHF_test.cpp
         ${PROJECT_TESTS_FOLDER}/RHF/DIISRHFSCFSolver_test.cpp
+        ${PROJECT_TESTS_FOLDER}/RHF/DirectRHFSCFSolver_test.cpp
+        ${PROJECT_TESTS_FOLDER}/RHF/FactorizedRHFSCFSolver_test.cpp
         ${PROJECT_TESTS_FOLDER}/RHF/PlainRHFSCFSolver_test.cpp
         ${PROJECT_TESTS_FOLDER}/RHF/RHF_test.cpp
 
         ${PROJECT_TESTS_FOLDER}/utilities/linalg_test.cpp
         ${PROJECT_TESTS_FOLDER}/utilities/miscellaneous_test.cpp
+        ${PROJECT_TESTS_FOLDER}/utilities/parallel_test.cpp
 
         ${PROJECT_TESTS_FOLDER}/WaveFunction/WaveFunction_test.cpp
 
@@ -21,6 +21,7 @@
 
 #include "HamiltonianBuilder/HamiltonianBuilder.hpp"
 #include "HamiltonianParameters/HamiltonianParameters.hpp"
+#include "math/SymmetricSparseMatrix.hpp"
 #include "WaveFunction/WaveFunction.hpp"
 
 #include "math/optimization/Eigenpair.hpp"
@@ -40,6 +41,15 @@ private:
 
     std::vector<Eigenpair> eigenpairs;  // eigenvalues and -vectors
 
+    mutable std::shared_ptr<const SymmetricSparseMatrix<double>> symmetric_sparse_hamiltonian;  // the upper half of the sparse Hamiltonian, assembled on first use and reused in subsequent solves
+
+
+    // PRIVATE METHODS
+    /**
+     *  @return the Hamiltonian as a sparse matrix that stores its upper half, which is only assembled on the first call
+     */
+    const SymmetricSparseMatrix<double>& get_symmetric_sparse_hamiltonian() const;
+
 public:
     // CONSTRUCTORS
     /**
@@ -0,0 +1,412 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef GQCP_BITSTRING_HPP
+#define GQCP_BITSTRING_HPP
+
+
+#include <array>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+
+namespace GQCP {
+
+
+/**
+ *  A bitstring of a fixed width of a number of 64-bit words, which represents the occupations of an ONV
+ *
+ *  As for the unsigned representation of an ONV, bits are read from right to left: the least significant bit (of the first word) relates to the first orbital
+ *  All operations are implemented word by word with popcount and ctz, in loops over the fixed number of words that the compiler can unroll: for a single word, they reduce to the plain unsigned operations
+ *
+ *  @tparam Words       the number of words, e.g. 1 for 64 orbitals, 2 for 128 orbitals and 4 for 256 orbitals
+ */
+template <size_t Words>
+class BitString {
+public:
+    static constexpr size_t bits_per_word = std::numeric_limits<size_t>::digits;
+    static constexpr size_t number_of_bits = Words * bits_per_word;
+
+
+private:
+    std::array<size_t, Words> words;  // words[0] holds the least significant bits
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  Construct a bitstring without any set bits
+     */
+    BitString() :
+        words {}
+    {}
+
+
+    /**
+     *  @param representation       the representation of the least significant word, e.g. the unsigned representation of an ONV in at most 64 orbitals
+     *
+     *  Note that, like for std::bitset, this constructor is not explicit, so that unsigned representations can be used wherever a bitstring is expected
+     */
+    BitString(size_t representation) :
+        words {}
+    {
+        this->words[0] = representation;
+    }
+
+
+    /*
+     *  NAMED CONSTRUCTORS
+     */
+
+    /**
+     *  @param n        the number of set bits
+     *
+     *  @return the bitstring in which the n least significant bits are set
+     */
+    static BitString<Words> LowestBits(size_t n) {
+
+        BitString<Words> mask;
+        for (size_t w = 0; w < Words; w++) {
+            if (n >= (w + 1) * bits_per_word) {
+                mask.words[w] = ~0UL;
+            } else if (n > w * bits_per_word) {
+                mask.words[w] = (1UL << (n - w * bits_per_word)) - 1;
+            }
+        }
+
+        return mask;
+    }
+
+
+    /*
+     *  OPERATORS
+     */
+
+    /**
+     *  @param other        the other bitstring
+     *
+     *  @return if this bitstring is equal to the other
+     */
+    bool operator==(const BitString<Words>& other) const { return this->words == other.words; }
+
+    /**
+     *  @param other        the other bitstring
+     *
+     *  @return if this bitstring is different from the other
+     */
+    bool operator!=(const BitString<Words>& other) const { return !this->operator==(other); }
+
+    /**
+     *  @param other        the other bitstring
+     *
+     *  @return if this bitstring is smaller than the other, when both are read as unsigned integers
+     */
+    bool operator<(const BitString<Words>& other) const {
+        for (size_t w = Words; w-- > 0; ) {
+            if (this->words[w] != other.words[w]) {
+                return this->words[w] < other.words[w];
+            }
+        }
+        return false;
+    }
+
+    /**
+     *  @return the bitwise complement of this bitstring
+     */
+    BitString<Words> operator~() const {
+        BitString<Words> result;
+        for (size_t w = 0; w < Words; w++) {
+            result.words[w] = ~this->words[w];
+        }
+        return result;
+    }
+
+    /**
+     *  @param other        the other bitstring
+     *
+     *  @return the bitwise XOR of this bitstring and the other
+     */
+    BitString<Words> operator^(const BitString<Words>& other) const {
+        BitString<Words> result;
+        for (size_t w = 0; w < Words; w++) {
+            result.words[w] = this->words[w] ^ other.words[w];
+        }
+        return result;
+    }
+
+    /**
+     *  @param other        the other bitstring
+     *
+     *  @return the bitwise AND of this bitstring and the other
+     */
+    BitString<Words> operator&(const BitString<Words>& other) const {
+        BitString<Words> result;
+        for (size_t w = 0; w < Words; w++) {
+            result.words[w] = this->words[w] & other.words[w];
+        }
+        return result;
+    }
+
+    /**
+     *  @param other        the other bitstring
+     *
+     *  @return the bitwise OR of this bitstring and the other
+     */
+    BitString<Words> operator|(const BitString<Words>& other) const {
+        BitString<Words> result;
+        for (size_t w = 0; w < Words; w++) {
+            result.words[w] = this->words[w] | other.words[w];
+        }
+        return result;
+    }
+
+    /**
+     *  @param shift        the number of positions the bits should be moved to the left, i.e. to more significant bits
+     *
+     *  @return this bitstring shifted to the left, where the bits that are shifted out are lost
+     */
+    BitString<Words> operator<<(size_t shift) const {
+
+        BitString<Words> result;
+        size_t word_shift = shift / bits_per_word;
+        size_t bit_shift = shift % bits_per_word;
+
+        for (size_t w = Words; w-- > word_shift; ) {
+            result.words[w] = this->words[w - word_shift] << bit_shift;
+            if ((bit_shift != 0) && (w > word_shift)) {  // carry the bits of the less significant word
+                result.words[w] |= this->words[w - word_shift - 1] >> (bits_per_word - bit_shift);
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     *  @param shift        the number of positions the bits should be moved to the right, i.e. to less significant bits
+     *
+     *  @return this bitstring shifted to the right, where the bits that are shifted out are lost
+     */
+    BitString<Words> operator>>(size_t shift) const {
+
+        BitString<Words> result;
+        size_t word_shift = shift / bits_per_word;
+        size_t bit_shift = shift % bits_per_word;
+
+        for (size_t w = 0; w + word_shift < Words; w++) {
+            result.words[w] = this->words[w + word_shift] >> bit_shift;
+            if ((bit_shift != 0) && (w + word_shift + 1 < Words)) {  // carry the bits of the more significant word
+                result.words[w] |= this->words[w + word_shift + 1] << (bits_per_word - bit_shift);
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     *  @param os           the output stream which the bitstring should be concatenated to
+     *  @param bitstring    the bitstring that should be concatenated to the output stream
+     *
+     *  @return the updated output stream, to which the bits are written from the most significant set bit to the least significant bit
+     */
+    friend std::ostream& operator<<(std::ostream& os, const BitString<Words>& bitstring) {
+
+        std::string buffer;
+        for (size_t p = number_of_bits; p-- > 0; ) {
+            if (!buffer.empty() || bitstring.isSet(p)) {
+                buffer.push_back(bitstring.isSet(p) ? '1' : '0');
+            }
+        }
+
+        return os << (buffer.empty() ? std::string("0") : buffer);
+    }
+
+
+    /*
+     *  GETTERS
+     */
+
+    const std::array<size_t, Words>& get_words() const { return this->words; }
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  @param p        the index of the bit, starting from 0 at the least significant bit
+     *
+     *  @return if the p-th bit is set
+     */
+    bool isSet(size_t p) const {
+        return (this->words[p / bits_per_word] >> (p % bits_per_word)) & 1UL;
+    }
+
+    /**
+     *  Set the p-th bit
+     *
+     *  @param p        the index of the bit, starting from 0 at the least significant bit
+     */
+    void set(size_t p) {
+        this->words[p / bits_per_word] |= 1UL << (p % bits_per_word);
+    }
+
+    /**
+     *  Clear the p-th bit
+     *
+     *  @param p        the index of the bit, starting from 0 at the least significant bit
+     */
+    void reset(size_t p) {
+        this->words[p / bits_per_word] &= ~(1UL << (p % bits_per_word));
+    }
+
+    /**
+     *  @return if no bits are set
+     */
+    bool none() const {
+        size_t any = 0;
+        for (size_t w = 0; w < Words; w++) {
+            any |= this->words[w];
+        }
+        return any == 0;
+    }
+
+    /**
+     *  @return the number of set bits
+     */
+    size_t count() const {
+        size_t count = 0;
+        for (size_t w = 0; w < Words; w++) {
+            count += __builtin_popcountl(this->words[w]);
+        }
+        return count;
+    }
+
+    /**
+     *  @param p        the index of a bit
+     *
+     *  @return the number of set bits before the p-th bit (not included), which determines the phase factor of an operator acting on orbital p
+     */
+    size_t countBefore(size_t p) const {
+        return (*this & BitString<Words>::LowestBits(p)).count();
+    }
+
+    /**
+     *  @return the index of the least significant set bit
+     */
+    size_t countTrailingZeros() const {
+        for (size_t w = 0; w < Words; w++) {
+            if (this->words[w] != 0) {
+                return w * bits_per_word + __builtin_ctzl(this->words[w]);
+            }
+        }
+
+        throw std::logic_error("BitString::countTrailingZeros(): The bitstring has no set bits.");
+    }
+
+    /**
+     *  Clear the least significant set bit
+     */
+    void resetLeastSignificantBit() {
+        for (size_t w = 0; w < Words; w++) {
+            if (this->words[w] != 0) {
+                this->words[w] &= this->words[w] - 1;
+                return;
+            }
+        }
+    }
+
+    /**
+     *  @return the next bitstring with the same number of set bits, i.e. the next permutation in reverse lexical ordering
+     *
+     *      Examples:
+     *          011 -> 101
+     *          101 -> 110
+     *
+     *  The lowest run of set bits [p, q) is moved up: bit q is set, and the remaining q - p - 1 bits of the run move to the least significant positions
+     */
+    BitString<Words> nextPermutation() const {
+
+        const size_t p = this->countTrailingZeros();  // the start of the lowest run of set bits
+        const BitString<Words> unset_after_run = ~(*this | BitString<Words>::LowestBits(p));
+        if (unset_after_run.none()) {
+            throw std::overflow_error("BitString::nextPermutation(): The next permutation doesn't fit in the bitstring.");
+        }
+        const size_t q = unset_after_run.countTrailingZeros();  // the first unset bit after that run
+
+        BitString<Words> next = (*this & ~BitString<Words>::LowestBits(q)) | BitString<Words>::LowestBits(q - p - 1);
+        next.set(q);
+        return next;
+    }
+
+    /**
+     *  @return this bitstring as an unsigned integer, which is only possible if no bits outside of the least significant word are set
+     */
+    size_t asUnsigned() const {
+        for (size_t w = 1; w < Words; w++) {
+            if (this->words[w] != 0) {
+                throw std::overflow_error("BitString::asUnsigned(): The bitstring doesn't fit in a single unsigned integer.");
+            }
+        }
+        return this->words[0];
+    }
+
+    /**
+     *  @return a hash value of this bitstring, combining the hashes of its words
+     */
+    size_t hash() const {
+        size_t seed = std::hash<size_t>()(this->words[0]);
+        for (size_t w = 1; w < Words; w++) {
+            seed ^= std::hash<size_t>()(this->words[w]) + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+};
+
+
+template <size_t Words>
+constexpr size_t BitString<Words>::bits_per_word;
+
+template <size_t Words>
+constexpr size_t BitString<Words>::number_of_bits;
+
+
+}  // namespace GQCP
+
+
+namespace std {
+
+
+/**
+ *  Make bitstrings usable as keys of unordered containers
+ */
+template <size_t Words>
+struct hash<GQCP::BitString<Words>> {
+    size_t operator()(const GQCP::BitString<Words>& bitstring) const { return bitstring.hash(); }
+};
+
+
+}  // namespace std
+
+
+#endif  // GQCP_BITSTRING_HPP
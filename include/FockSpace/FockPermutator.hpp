@@ -36,8 +36,8 @@ namespace GQCP {
  *  e.g. "Derived : public Base<Derived>"
  *
  *  Example of why this is required is found in this class:
- *       ulongNextPermutation(size_t representation) is pure virtual
- *       setNextONV(ONV &onv) is implemented in the base and calls "ulongNextPermutation(size_t representation)"
+ *       nextPermutation(const ONVRepresentation& representation) is pure virtual
+ *       setNextONV(ONV &onv) is implemented in the base and calls "nextPermutation(const ONVRepresentation& representation)"
  *       and contains "auto& fock_space = static_cast<const DerivedPermutator&>(*this)" a self-cast to the derived instance
  *       allowing compile-time identification of the called method and thus inlining
  */
@@ -65,23 +65,23 @@ public:
      *
      *  @return the next bitstring permutation in the Fock space
      */
-    virtual size_t ulongNextPermutation(size_t representation) const = 0;
+    virtual ONVRepresentation nextPermutation(const ONVRepresentation& representation) const = 0;
 
     /**
      *  @param representation      a representation of an ONV
      *
      *  @return the address (i.e. the ordering number) of the given ONV
      */
-    virtual size_t getAddress(size_t representation) const = 0;
+    virtual size_t getAddress(const ONVRepresentation& representation) const = 0;
 
     /**
-      *  Calculate unsigned representation for a given address
+      *  Calculate the representation for a given address
       *
       *  @param address                 the address of the representation is calculated
       *
-      *  @return unsigned representation of the address
+      *  @return the representation of the address
       */
-    virtual size_t calculateRepresentation(size_t address) const = 0;
+    virtual ONVRepresentation calculateRepresentation(size_t address) const = 0;
 
     /**
      *  @param onv       the ONV
@@ -134,14 +134,14 @@ public:
     }
 
     /**
-     *  Set the current ONV to the next ONV: performs ulongNextPermutation() and updates the corresponding occupation indices of the ONV occupation array
+     *  Set the current ONV to the next ONV: performs nextPermutation() and updates the corresponding occupation indices of the ONV occupation array
      *
      *  @param onv      the current ONV
      */
     void setNextONV(ONV &onv) const {
 
         const auto& fock_space = this->derived();
-        onv.set_representation(fock_space.ulongNextPermutation(onv.get_unsigned_representation()));
+        onv.set_representation(fock_space.nextPermutation(onv.get_representation()));
     }
 
     /**
@@ -152,7 +152,7 @@ public:
     size_t getAddress(const ONV &onv) const {
 
         const auto& fock_space = this->derived();
-        return fock_space.getAddress(onv.get_unsigned_representation());
+        return fock_space.getAddress(onv.get_representation());
     };
 
     /**
@@ -27,6 +27,9 @@
 namespace GQCP {
 
 
+class SingleExcitationList;
+
+
 /**
  *  The full Fock space for a number of orbitals and number of electrons
  *
@@ -35,7 +38,8 @@ namespace GQCP {
  */
 class FockSpace: public BaseFockSpace, public FockPermutator<FockSpace> {
 private:
-    Matrixu vertex_weights;  // vertex_weights of the addressing scheme
+    Vectoru vertex_weights;  // vertex_weights of the addressing scheme, stored contiguously: the weight of vertex (p,m) is at p*(N+1)+m
+    mutable std::shared_ptr<const SingleExcitationList> single_excitations;  // the single excitation list, which is only generated when it is first asked for
 
 public:
     // CONSTRUCTORS
@@ -51,10 +55,18 @@ public:
 
 
     // GETTERS
-    size_t get_vertex_weights(size_t p, size_t m) const { return this->vertex_weights[p][m]; }
-    const Matrixu& get_vertex_weights() const { return this->vertex_weights; }
+    size_t get_vertex_weights(size_t p, size_t m) const { return this->vertex_weights[p * (this->N + 1) + m]; }
+    Matrixu get_vertex_weights() const;
     FockSpaceType get_type() const override { return FockSpaceType::FockSpace; }
 
+    /**
+     *  @return the list of all single excitations E_pq |I> of this Fock space, which is generated on the first call and shared by all copies of this Fock space that are made afterwards
+     *
+     *  Note that the list needs SingleExcitationList::calculateMemoryRequirement(K, N) bytes: if it shouldn't be kept alive together with this Fock space, construct a SingleExcitationList directly instead
+     *  This method may be called from several threads at once
+     */
+    std::shared_ptr<const SingleExcitationList> get_single_excitations() const;
+
 
     // STATIC PUBLIC METHODS
     /**
@@ -76,23 +88,30 @@ public:
      *          011 -> 101
      *          101 -> 110
      */
-    size_t ulongNextPermutation(size_t representation) const override;
+    ONVRepresentation nextPermutation(const ONVRepresentation& representation) const override;
 
     /**
      *  @param representation      a representation of an ONV
      *
      *  @return the address (i.e. the ordering number) of the given ONV
      */
-    size_t getAddress(size_t representation) const override;
+    size_t getAddress(const ONVRepresentation& representation) const override;
+
+    /**
+     *  @param representations      representations of ONVs
+     *
+     *  @return the addresses (i.e. the ordering numbers) of the given ONVs
+     */
+    Vectoru getAddresses(const std::vector<ONVRepresentation>& representations) const;
 
     /**
-      *  Calculate unsigned representation for a given address
+      *  Calculate the representation for a given address
       *
       *  @param address                 the address of the representation is calculated
       *
-      *  @return unsigned representation of the address
+      *  @return the representation of the address
       */
-    size_t calculateRepresentation(size_t address) const override;
+    ONVRepresentation calculateRepresentation(size_t address) const override;
 
     /**
      *  @param onv       the ONV
@@ -70,23 +70,23 @@ public:
      *          0101 -> 1001
      *         01101 -> 10011
      */
-    size_t ulongNextPermutation(size_t representation) const override;
+    ONVRepresentation nextPermutation(const ONVRepresentation& representation) const override;
 
     /**
      *  @param representation      a representation of an ONV
      *
      *  @return the address (i.e. the ordering number) of the given ONV
      */
-    size_t getAddress(size_t representation) const override;
+    size_t getAddress(const ONVRepresentation& representation) const override;
 
     /**
-      *  Calculate unsigned representation for a given address
+      *  Calculate the representation for a given address
       *
       *  @param address                 the address of the representation is calculated
       *
-      *  @return unsigned representation of the address
+      *  @return the representation of the address
       */
-    size_t calculateRepresentation(size_t address) const override;
+    ONVRepresentation calculateRepresentation(size_t address) const override;
 
     /**
      *  @param onv       the ONV
@@ -19,13 +19,40 @@
 #define GQCP_ONV_HPP
 
 
+#include "FockSpace/BitString.hpp"
 #include "math/Matrix.hpp"
 
+#include <array>
+
 
 
 namespace GQCP {
 
 
+#ifndef GQCP_ONV_WORDS
+#define GQCP_ONV_WORDS 2  // the number of 64-bit words in the representation of an ONV, which is set through the ONV_WIDTH CMake option
+#endif
+
+/**
+ *  The fixed-width representation of an ONV, which can hold up to ONVRepresentation::number_of_bits spatial orbitals
+ */
+using ONVRepresentation = BitString<GQCP_ONV_WORDS>;
+
+
+/**
+ *  The result of the excitation analysis of two ONVs, i.e. the input for the Slater-Condon rules
+ */
+struct ONVExcitation {
+    size_t degree;  // the number of electrons that are excited between both ONVs
+
+    // Only the first min(degree, 2) holes and particles are set, in increasing order
+    std::array<size_t, 2> holes;  // the orbitals that are occupied in the first ONV, but not in the second
+    std::array<size_t, 2> particles;  // the orbitals that are occupied in the second ONV, but not in the first
+
+    int sign;  // the product of the operator phase factors of the holes in the first ONV and of the particles in the second ONV (only set if degree <= 2)
+};
+
+
 /**
  *  A class that represents an ONV (occupation number vector)
 
@@ -36,12 +63,14 @@ namespace GQCP {
  *  In this code bitstrings are read from right to left. This means that the least significant bit relates to the first orbital.
  *  Using this notation is how normally bits are read, leading to more efficient code.
  *  As is also usual, the least significant bit has index 0. The previous example is then represented by the bit string "0111" (7).
+ *
+ *  The bit string is stored as a fixed-width ONVRepresentation, so that the number of spatial orbitals is limited by its width (see the ONV_WIDTH CMake option) instead of by a single unsigned integer
  */
 class ONV {
 private:
     size_t K;  // number of spatial orbitals
     size_t N;  // number of electrons
-    size_t unsigned_representation;
+    ONVRepresentation representation;
     VectorXs occupation_indices;  // the occupied orbital electron indices
                                   // it is a vector of N elements in which occupation_indices[j]
                                   // gives the occupied orbital index for electron j
@@ -53,9 +82,9 @@ public:
     /**
      *  @param K                        the number of orbitals
      *  @param N                        the number of electrons
-     *  @param unsigned_representation  the representation for the ONV as an unsigned integer
+     *  @param representation           the representation for the ONV, e.g. as an unsigned integer
      */
-    ONV(size_t K, size_t N, size_t unsigned_representation);
+    ONV(size_t K, size_t N, const ONVRepresentation& representation);
 
     /**
      *  Constructs a default ONV without a representation
@@ -92,15 +121,18 @@ public:
 
     // SETTERS
     /**
-     *  @param unsigned_representation      the new representation as an unsigned integer
+     *  @param representation       the new representation, e.g. as an unsigned integer
      *
      *  Set the representation of an ONV to a new representation and call update the occupation indices accordingly
      */
-    void set_representation(size_t unsigned_representation);
+    void set_representation(const ONVRepresentation& representation);
 
 
     // GETTERS
-    size_t get_unsigned_representation() const { return unsigned_representation; }
+    size_t get_K() const { return this->K; }
+    size_t get_N() const { return this->N; }
+    const ONVRepresentation& get_representation() const { return this->representation; }
+    size_t get_unsigned_representation() const { return this->representation.asUnsigned(); }  // only possible if the ONV fits in a single unsigned integer
     const VectorXs& get_occupation_indices() const { return occupation_indices; }
 
     /**
@@ -113,7 +145,7 @@ public:
 
     // PUBLIC METHODS
     /**
-     *  Extracts the positions of the set bits from the this->unsigned_representation and places them in the this->occupation_indices
+     *  Extracts the positions of the set bits from the this->representation and places them in the this->occupation_indices
      */
     void updateOccupationIndices();
 
@@ -149,7 +181,7 @@ public:
      *  @param index_start      the starting index (included), read from right to left
      *  @param index_end        the ending index (not included), read from right to left
      *
-     *  @return the representation of a slice (i.e. a subset) of the spin string (read from right to left) between index_start (included) and index_end (not included)
+     *  @return the representation of a slice (i.e. a subset) of the spin string (read from right to left) between index_start (included) and index_end (not included), which should fit in an unsigned integer
      *
      *      Example:
      *          "010011".slice(1, 4) => "01[001]1" -> "001"
@@ -261,6 +293,50 @@ public:
      */
     std::vector<size_t> findMatchingOccupations(const ONV& other) const;
 
+    /**
+     *  @param other        the other ONV
+     *
+     *  @return the excitation analysis from this ONV to the other, without any allocations
+     */
+    ONVExcitation analyzeExcitation(const ONV& other) const { return ONV::AnalyzeExcitation(this->representation, other.representation); }
+
+    /**
+     *  @param representation           the representation of the first ONV
+     *  @param other_representation     the representation of the second ONV
+     *
+     *  @return the excitation analysis from the first ONV to the second, using only XOR, popcount and ctz on the representations
+     *
+     *  Note that the holes, particles and sign are only determined for up to double excitations, which is all the Slater-Condon rules need. This method is defined in the header, so that it can be inlined in the loops over pairs of ONVs
+     */
+    static ONVExcitation AnalyzeExcitation(const ONVRepresentation& representation, const ONVRepresentation& other_representation) {
+
+        ONVExcitation excitation {};
+
+        ONVRepresentation differences = representation ^ other_representation;
+        excitation.degree = differences.count() / 2;
+        if (excitation.degree > 2) {
+            return excitation;
+        }
+
+        ONVRepresentation holes = differences & representation;
+        ONVRepresentation particles = differences & other_representation;
+        size_t parity = 0;  // the number of electrons in front of the holes (in the first ONV) and the particles (in the second ONV)
+        for (size_t i = 0; i < excitation.degree; i++) {
+            size_t hole = holes.countTrailingZeros();
+            size_t particle = particles.countTrailingZeros();
+            excitation.holes[i] = hole;
+            excitation.particles[i] = particle;
+
+            parity += representation.countBefore(hole) + other_representation.countBefore(particle);
+
+            holes.resetLeastSignificantBit();
+            particles.resetLeastSignificantBit();
+        }
+        excitation.sign = (parity % 2 == 0) ? 1 : -1;
+
+        return excitation;
+    }
+
     /**
      *  @return a string representation of the ONV
      */
@@ -24,6 +24,9 @@
 #include "FockSpace/FrozenProductFockSpace.hpp"
 #include "Configuration.hpp"
 
+#include <unordered_map>
+#include <utility>
+
 
 namespace GQCP {
 
@@ -32,6 +35,8 @@ namespace GQCP {
  *  A class that represents a Fock space that is flexible in the number of states that span it
  *
  *  Configurations are represented as a Configuration: a combination of an alpha and a beta ONV
+ *
+ *  Every configuration is present only once: a hash index on the (alpha, beta) representations gives the address of a configuration in constant time
  */
 class SelectedFockSpace : public BaseFockSpace {
 private:
@@ -40,17 +45,38 @@ private:
 
     std::vector<Configuration> configurations;
 
+    /**
+     *  A hash function for the pair of the representations of an alpha and a beta ONV
+     */
+    struct RepresentationPairHash {
+        size_t operator()(const std::pair<ONVRepresentation, ONVRepresentation>& representations) const {
+            // Mix the beta representation before combining, so that (a, b) and (b, a) map to different buckets
+            size_t beta_hash = representations.second.hash() * 0x9E3779B97F4A7C15ULL;
+            return representations.first.hash() ^ (beta_hash + (beta_hash >> 29));
+        }
+    };
+
+    std::unordered_map<std::pair<ONVRepresentation, ONVRepresentation>, size_t, RepresentationPairHash> addresses;  // maps the (alpha, beta) representations of a configuration to its address
+
+
+    // PRIVATE METHODS
+    /**
+     *  Rebuild the hash index from the current configurations
+     */
+    void updateAddresses();
+
     /**
      *  @param onv1     the alpha ONV as a string representation read from right to left
      *  @param onv2     the beta ONV as a string representation read from right to left
      *
      *  @return the configuration that holds both ONVs
-     *
-     *  IMPORTANT: only works for up to 64 bits!
      */
     Configuration makeConfiguration(const std::string& onv1, const std::string& onv2) const;
 
 public:
+    static constexpr size_t not_found = static_cast<size_t>(-1);  // the address of a configuration that isn't in the Fock space
+
+
     // CONSTRUCTORS
     SelectedFockSpace() = default;  // need a default constructor
 
@@ -96,25 +122,92 @@ public:
     size_t get_N_alpha() const { return this->N_alpha; }
     size_t get_N_beta() const { return this->N_beta; }
     const Configuration& get_configuration(size_t index) const { return this->configurations[index]; }
+    const std::vector<Configuration>& get_configurations() const { return this->configurations; }
     FockSpaceType get_type() const override { return FockSpaceType::SelectedFockSpace; }
 
 
     // PUBLIC METHODS
     /**
-     *  Make a configuration (see makeConfiguration()) and add it to this Fock space
+     *  @param alpha_representation     the representation of the alpha ONV
+     *  @param beta_representation      the representation of the beta ONV
+     *
+     *  @return the address of the configuration with the given representations, or SelectedFockSpace::not_found if it isn't in this Fock space
+     */
+    size_t findAddress(const ONVRepresentation& alpha_representation, const ONVRepresentation& beta_representation) const;
+
+    /**
+     *  @param configuration        the configuration
+     *
+     *  @return the address of the given configuration, or SelectedFockSpace::not_found if it isn't in this Fock space
+     */
+    size_t findAddress(const Configuration& configuration) const;
+
+    /**
+     *  @param configuration        the configuration
+     *
+     *  @return if the given configuration is in this Fock space
+     */
+    bool contains(const Configuration& configuration) const { return this->findAddress(configuration) != not_found; }
+
+    /**
+     *  Reserve memory for a number of configurations
+     *
+     *  @param number_of_configurations     the total number of configurations that is expected
+     */
+    void reserve(size_t number_of_configurations);
+
+    /**
+     *  Add a configuration to this Fock space, if it isn't present yet
+     *
+     *  @param configuration        the configuration
+     *
+     *  @return the address of the given configuration
+     */
+    size_t addConfiguration(const Configuration& configuration);
+
+    /**
+     *  Add configurations to this Fock space, skipping the ones that are already present
+     *
+     *  @param configurations       the configurations
+     */
+    void addConfiguration(const std::vector<Configuration>& configurations);
+
+    /**
+     *  Make a configuration (see makeConfiguration()) and add it to this Fock space, if it isn't present yet
      *
      *  @param onv1     the alpha ONV as a string representation read from right to left
      *  @param onv2     the beta ONV as a string representation read from right to left
+     *
+     *  @return the address of the configuration
      */
-    void addConfiguration(const std::string& onv1, const std::string& onv2);
+    size_t addConfiguration(const std::string& onv1, const std::string& onv2);
 
     /**
-     *  Make configurations (see makeConfiguration()) and add them to the Fock space
+     *  Make configurations (see makeConfiguration()) and add them to the Fock space, skipping the ones that are already present
      *
      *  @param onv1s     the alpha ONVs as string representations read from right to left
      *  @param onv2s     the beta ONVs as string representations read from right to left
      */
     void addConfiguration(const std::vector<std::string>& onv1s, const std::vector<std::string>& onv2s);
+
+    /**
+     *  Sort the configurations by their alpha and then their beta representation, so that configurations sharing an alpha ONV are contiguous
+     *
+     *  Note that this changes the addresses of the configurations
+     */
+    void sort();
+
+    /**
+     *  Find, for every configuration, the configurations that are at most doubly excited with respect to it
+     *
+     *  Instead of comparing every pair of configurations, the configurations are grouped by their unique alpha and unique beta ONVs:
+     *      - excitations in only one spin component are found among the configurations that share the other spin component
+     *      - mixed alpha-beta double excitations are found by going over the singly excited alpha ONVs and checking the beta ONVs of the configurations that contain them
+     *  The cost then scales with the number of connected pairs rather than with the square of the dimension
+     *
+     *  @return for every address I, the sorted addresses J > I of the configurations that differ from configuration I by a single or double excitation
+     */
+    std::vector<std::vector<size_t>> calculateConnections() const;
 };
 
 
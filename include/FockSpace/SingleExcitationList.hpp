@@ -0,0 +1,175 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef GQCP_SINGLEEXCITATIONLIST_HPP
+#define GQCP_SINGLEEXCITATIONLIST_HPP
+
+
+#include "typedefs.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace GQCP {
+
+
+class FockSpace;
+
+
+/**
+ *  A single excitation E_pq |I> = sign |J>, i.e. the annihilation of an electron in orbital q followed by the creation of an electron in orbital p
+ *
+ *  The excitation is packed in 8 bytes, so that the lists of single excitations take up as little memory (bandwidth) as possible: p and q share one 32-bit word, and the sign is kept in the most significant bit of the 32-bit address J
+ */
+class SingleExcitation {
+public:
+    static constexpr size_t max_address = (1UL << 31) - 1;  // the largest address J that can be stored, while the orbital indices always fit in 16 bits since an ONV holds at most 256 orbitals
+
+
+private:
+    std::uint32_t pq;  // the index p of the created orbital in the 16 most significant bits, and the index q of the annihilated orbital in the 16 least significant bits
+    std::uint32_t signed_address;  // the address J of the resulting ONV, whose most significant bit is set if the phase factor is -1
+
+
+public:
+    // CONSTRUCTORS
+    /**
+     *  Construct an uninitialized excitation, so that lists of excitations can be allocated before they are filled in
+     */
+    SingleExcitation() = default;
+
+    /**
+     *  @param p        the index of the orbital in which an electron is created
+     *  @param q        the index of the orbital from which an electron is annihilated
+     *  @param J        the address of the resulting ONV, at most max_address
+     *  @param sign     the phase factor of the excitation
+     */
+    SingleExcitation(size_t p, size_t q, size_t J, int sign) :
+        pq (static_cast<std::uint32_t>((p << 16) | q)),
+        signed_address (static_cast<std::uint32_t>(J) | ((sign < 0) ? (1U << 31) : 0U))
+    {}
+
+
+    // GETTERS
+    size_t get_p() const { return this->pq >> 16; }
+    size_t get_q() const { return this->pq & 0xFFFFU; }
+    size_t get_J() const { return this->signed_address & ~(1U << 31); }
+    int get_sign() const { return (this->signed_address >> 31) ? -1 : 1; }
+};
+
+
+/**
+ *  All single excitations E_pq |I> of the ONVs |I> in a Fock space, stored in a compressed sparse row (CSR) format: the excitations of the ONV with address I are those in [begin(I), end(I))
+ *
+ *  For every ONV, the excitations are ordered by the annihilated orbital q and then by the created orbital p. The excitations with p = q (i.e. J = I, sign = 1) are included as well, so that sums over all E_pq can be written as a single loop
+ *
+ *  The list can be written to a binary file and read back in, which avoids generating it again for a next calculation in the same Fock space. Such a file consists of
+ *      - the 8 characters 'GQCPSEXL'
+ *      - the version, K, N and the dimension of the Fock space, as 64-bit unsigned integers
+ *      - the packed single excitations (8 bytes each), ONV by ONV
+ */
+class SingleExcitationList {
+private:
+    size_t K;  // the number of orbitals
+    size_t N;  // the number of electrons
+
+    Vectoru offsets;  // the excitations of the ONV with address I start at offsets[I]; offsets[dim] is the total number of excitations
+    std::vector<SingleExcitation> excitations;
+
+
+    // PRIVATE CONSTRUCTORS
+    /**
+     *  Allocate the list of single excitations for a Fock space with K orbitals, N electrons and the given dimension, without filling it in
+     *
+     *  @param K        the number of orbitals
+     *  @param N        the number of electrons
+     *  @param dim      the dimension of the Fock space
+     */
+    SingleExcitationList(size_t K, size_t N, size_t dim);
+
+
+public:
+    // CONSTRUCTORS
+    /**
+     *  Generate all single excitations of the given Fock space
+     *
+     *  @param fock_space       the Fock space
+     */
+    explicit SingleExcitationList(const FockSpace& fock_space);
+
+
+    // NAMED CONSTRUCTORS
+    /**
+     *  @param filename     the name of a binary single excitation file (see the class documentation for the format)
+     *
+     *  @return the single excitations in the given file, which is mapped into memory to read them
+     */
+    static SingleExcitationList ReadBinary(const std::string& filename);
+
+
+    // STATIC PUBLIC METHODS
+    /**
+     *  @param K        the number of orbitals
+     *  @param N        the number of electrons
+     *
+     *  @return the number of bytes that are needed to store the single excitation list of the Fock space with K orbitals and N electrons
+     */
+    static size_t calculateMemoryRequirement(size_t K, size_t N);
+
+
+    // GETTERS
+    size_t get_K() const { return this->K; }
+    size_t get_N() const { return this->N; }
+    const Vectoru& get_offsets() const { return this->offsets; }
+    const std::vector<SingleExcitation>& get_excitations() const { return this->excitations; }
+
+
+    // PUBLIC METHODS
+    /**
+     *  @return the number of ONVs for which the excitations are stored
+     */
+    size_t get_dimension() const { return this->offsets.size() - 1; }
+
+    /**
+     *  @param I        the address of an ONV
+     *
+     *  @return a pointer to the first single excitation of the ONV with address I
+     */
+    const SingleExcitation* begin(size_t I) const { return this->excitations.data() + this->offsets[I]; }
+
+    /**
+     *  @param I        the address of an ONV
+     *
+     *  @return a pointer past the last single excitation of the ONV with address I
+     */
+    const SingleExcitation* end(size_t I) const { return this->excitations.data() + this->offsets[I + 1]; }
+
+    /**
+     *  Write the single excitations to a binary file (see the class documentation for the format)
+     *
+     *  @param filename     the name of the binary single excitation file
+     */
+    void writeBinary(const std::string& filename) const;
+};
+
+
+}  // namespace GQCP
+
+
+#endif  // GQCP_SINGLEEXCITATIONLIST_HPP
@@ -37,6 +37,15 @@ private:
     FockSpace fock_space;  // both the alpha and beta Fock space
 
 
+    // PRIVATE METHODS
+    /**
+     *  Evaluate the off-diagonal elements of the DOCI Hamiltonian, i.e. the pair hopping couplings between different ONVs
+     *
+     *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+     *  @param method                       the method that is called for every coupling H(I,J), in both the upper and the lower half
+     */
+    void evaluateHamiltonianElements(const HamiltonianParameters<double>& hamiltonian_parameters, const PassToMethod& method) const;
+
 public:
     // CONSTRUCTORS
     /**
@@ -70,6 +79,29 @@ public:
      */
     VectorX<double> matrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const VectorX<double>& x, const VectorX<double>& diagonal) const override;
 
+    /**
+     *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+     *  @param X                            the vectors upon which the DOCI Hamiltonian acts, as the columns of a (dim x m)-matrix
+     *  @param diagonal                     the diagonal of the DOCI Hamiltonian matrix
+     *
+     *  @return the action of the DOCI Hamiltonian on every column of X
+     */
+    MatrixX<double> blockMatrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const MatrixX<double>& X, const VectorX<double>& diagonal) const override;
+
+    /**
+     *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the compressed sparse representation of the DOCI Hamiltonian matrix, assembled from the evaluated elements
+     */
+    Eigen::SparseMatrix<double> constructSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const override;
+
+    /**
+     *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the DOCI Hamiltonian matrix, assembled from the evaluated elements in its upper half
+     */
+    SymmetricSparseMatrix<double> constructSymmetricSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const override;
+
     /**
      *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
      *
@@ -20,10 +20,14 @@
 
 
 #include "HamiltonianBuilder/HamiltonianBuilder.hpp"
+#include "HamiltonianBuilder/PreparedFCI.hpp"
 #include "FockSpace/ProductFockSpace.hpp"
+#include "FockSpace/SingleExcitationList.hpp"
 
 #include <Eigen/Sparse>
 
+#include <memory>
+
 
 namespace GQCP {
 
@@ -33,7 +37,9 @@ namespace GQCP {
 class FCI : public HamiltonianBuilder {
 private:
     ProductFockSpace fock_space;  // fock space containing the alpha and beta Fock space
-    std::vector<Eigen::SparseMatrix<double>> alpha_couplings;
+    std::shared_ptr<const std::vector<Eigen::SparseMatrix<double>>> alpha_couplings;  // sigma(pq) + sigma(qp) in the alpha Fock space
+
+    mutable std::shared_ptr<const PreparedFCI> prepared_fci;  // the most recently prepared FCI operator, which is re-used as long as the Hamiltonian parameters are not modified
 
     // PRIVATE METHODS
     /**
@@ -52,21 +58,31 @@ private:
      *
      *  @param r                        First index of the two-electron integral
      *  @param s                        Second index of the two-electron integral
-     *  @param fock_space               Fock space for the spin specific Hamiltonian
      *  @param hamiltonian_parameters   The Hamiltonian parameters in an orthonormal orbital basis
+     *  @param single_excitations       the single excitations of the (spin) Fock space
      *
      *  @return The sparse matrix containing the calculated two-electron integrals mapped to one-electron couplings
      */
-    Eigen::SparseMatrix<double> calculateTwoElectronIntermediate(size_t r, size_t s, const HamiltonianParameters<double>& hamiltonian_parameters, const FockSpace& fock_space) const;
+    Eigen::SparseMatrix<double> calculateTwoElectronIntermediate(size_t r, size_t s, const HamiltonianParameters<double>& hamiltonian_parameters, const SingleExcitationList& single_excitations) const;
 
     /**
      *  Calculates sigma(pq) + sigma(qp)'s: all one-electron couplings for each annihilation-creation pair in the (spin) Fock space
      *  and stores them in sparse matrices for each pair combination
      *
+     *  @param single_excitations       the single excitations of the (spin) Fock space
+     *
      *  @return vector of sparse matrices containing the one-electron couplings for the (spin) Fock space
      *      Ordered as: sigma(00), sigma(01) + sigma(10), sigma(02)+ sigma(20), ...
      */
-    std::vector<Eigen::SparseMatrix<double>> calculateOneElectronCouplingsIntermediates(const FockSpace& fock_space) const;
+    std::vector<Eigen::SparseMatrix<double>> calculateOneElectronCouplingsIntermediates(const SingleExcitationList& single_excitations) const;
+
+    /**
+     *  Evaluate the elements of the FCI Hamiltonian from its prepared alpha, beta and mixed intermediates, apart from the contributions in calculateDiagonal()
+     *
+     *  @param prepared_fci     the FCI Hamiltonian bound to the Hamiltonian parameters
+     *  @param method           the method that is called for every contribution to H(I,J), in both the upper and the lower half
+     */
+    void evaluateHamiltonianElements(const PreparedFCI& prepared_fci, const PassToMethod& method) const;
 public:
 
     // CONSTRUCTORS
@@ -84,6 +100,17 @@ public:
     const BaseFockSpace* get_fock_space() const override { return &fock_space; }
 
 
+    // PUBLIC METHODS
+    /**
+     *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the FCI Hamiltonian bound to the given Hamiltonian parameters, in which all intermediates of the matrix-vector product are calculated once
+     *
+     *  Note that the most recently prepared operator is kept, so that preparing again for unmodified Hamiltonian parameters (i.e. with the same revision) doesn't recalculate the intermediates
+     */
+    std::shared_ptr<const PreparedFCI> prepare(const HamiltonianParameters<double>& hamiltonian_parameters) const;
+
+
     // OVERRIDDEN PUBLIC METHODS
     /**
      *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
@@ -98,9 +125,34 @@ public:
      *  @param diagonal                     the diagonal of the FCI Hamiltonian matrix
      *
      *  @return the action of the FCI Hamiltonian on the coefficient vector
+     *
+     *  Note that the intermediates that only depend on the Hamiltonian parameters are calculated in the first call and re-used in subsequent calls with unmodified Hamiltonian parameters
      */
     VectorX<double> matrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const VectorX<double>& x, const VectorX<double>& diagonal) const override;
 
+    /**
+     *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+     *  @param X                            the vectors upon which the FCI Hamiltonian acts, as the columns of a (dim x m)-matrix
+     *  @param diagonal                     the diagonal of the FCI Hamiltonian matrix
+     *
+     *  @return the action of the FCI Hamiltonian on every column of X
+     */
+    MatrixX<double> blockMatrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const MatrixX<double>& X, const VectorX<double>& diagonal) const override;
+
+    /**
+     *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the compressed sparse representation of the FCI Hamiltonian matrix, assembled from the evaluated elements
+     */
+    Eigen::SparseMatrix<double> constructSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const override;
+
+    /**
+     *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the FCI Hamiltonian matrix, assembled from the evaluated elements in its upper half
+     */
+    SymmetricSparseMatrix<double> constructSymmetricSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const override;
+
     /**
      *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
      *
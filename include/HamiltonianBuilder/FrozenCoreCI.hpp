@@ -34,6 +34,9 @@ protected:
     size_t X;  // number of frozen orbitals/electrons
     std::shared_ptr<HamiltonianBuilder> active_hamiltonian_builder;  // non-frozen core Hamiltonian builder performing the HamiltonianBuilder interface in the active space with the frozen Hamiltonian parameters
 
+    mutable std::shared_ptr<const HamiltonianParameters<double>> frozen_ham_par;  // the most recently frozen Hamiltonian parameters, which are re-used as long as the Hamiltonian parameters are not modified
+    mutable size_t frozen_ham_par_revision = 0;  // the revision of the Hamiltonian parameters from which frozen_ham_par was derived
+
 public:
     // CONSTRUCTORS
     /**
@@ -60,6 +63,15 @@ public:
      */
     VectorX<double> matrixVectorProduct(const HamiltonianParameters<double>& ham_par, const VectorX<double>& x, const VectorX<double>& diagonal) const override;
 
+    /**
+     *  @param ham_par      the Hamiltonian parameters in an orthonormal orbital basis
+     *  @param V            the vectors upon which the frozen core Hamiltonian acts, as the columns of a (dim x m)-matrix
+     *  @param diagonal     the diagonal of the frozen core Hamiltonian matrix
+     *
+     *  @return the action of the frozen core Hamiltonian on every column of V
+     */
+    MatrixX<double> blockMatrixVectorProduct(const HamiltonianParameters<double>& ham_par, const MatrixX<double>& V, const VectorX<double>& diagonal) const override;
+
     /**
      *  @param ham_par      the Hamiltonian parameters in an orthonormal orbital basis
      *
@@ -67,6 +79,13 @@ public:
      */
     VectorX<double> calculateDiagonal(const HamiltonianParameters<double>& ham_par) const override;
 
+    /**
+     *  @param ham_par      the Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the compressed sparse representation of the frozen core Hamiltonian matrix
+     */
+    Eigen::SparseMatrix<double> constructSparseHamiltonian(const HamiltonianParameters<double>& ham_par) const override;
+
 
     // PUBLIC METHODS
     /**
@@ -78,6 +97,24 @@ public:
      */
     HamiltonianParameters<double> freezeHamiltonianParameters(const HamiltonianParameters<double>& ham_par, size_t X) const;
 
+    /**
+     *  @param ham_par      the Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the 'frozen' Hamiltonian parameters (see freezeHamiltonianParameters()) for this builder's number of frozen orbitals
+     *
+     *  Note that the most recently frozen Hamiltonian parameters are kept, so that preparing again for unmodified Hamiltonian parameters (i.e. with the same revision) doesn't copy the integrals again.
+     *  Since the frozen Hamiltonian parameters then also keep their revision, the active Hamiltonian builder can re-use its own prepared quantities
+     */
+    std::shared_ptr<const HamiltonianParameters<double>> prepareFrozenHamiltonianParameters(const HamiltonianParameters<double>& ham_par) const;
+
+    /**
+     *  @param ham_par      the Hamiltonian parameters in an orthonormal orbital basis
+     *  @param X            the number of frozen orbitals
+     *
+     *  @return the energy of the doubly occupied frozen orbitals, which is the same for every ONV
+     */
+    double calculateFrozenCoreEnergy(const HamiltonianParameters<double>& ham_par, size_t X) const;
+
     /**
      *  @param ham_par      the Hamiltonian parameters in an orthonormal orbital basis
      *  @param X            the number of frozen orbitals
@@ -21,6 +21,9 @@
 
 #include "HamiltonianParameters/HamiltonianParameters.hpp"
 #include "FockSpace/BaseFockSpace.hpp"
+#include "math/SymmetricSparseMatrix.hpp"
+
+#include <Eigen/Sparse>
 
 #include <memory>
 #include <utility>
@@ -45,6 +48,9 @@ using PassToMethod = std::function<void (size_t I, size_t J, double value)>;
  *      - constructHamiltonian() which constructs the full Hamiltonian matrix in the given Fock space
  *      - matrixVectorProduct() which gives the result of the action of the Hamiltonian on a given coefficient vector
  *      - calculateDiagonal() which gives the diagonal of the Hamiltonian matrix
+ *
+ *  Derived classes can override blockMatrixVectorProduct() if they can let the Hamiltonian act on several vectors at once more efficiently than one by one,
+ *  and constructSparseHamiltonian() and constructSymmetricSparseHamiltonian() if they can emit the non-zero elements of the Hamiltonian matrix directly
  */
 class HamiltonianBuilder {
 public:
@@ -82,6 +88,37 @@ public:
      *  @return the diagonal of the matrix representation of the Hamiltonian
      */
     virtual VectorX<double> calculateDiagonal(const HamiltonianParameters<double>& hamiltonian_parameters) const = 0;
+
+
+    // PUBLIC METHODS
+    /**
+     *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+     *  @param X                            the vectors upon which the Hamiltonian acts, as the columns of a (dim x m)-matrix
+     *  @param diagonal                     the diagonal of the Hamiltonian matrix
+     *
+     *  @return the action of the Hamiltonian on every column of X, i.e. the (dim x m)-matrix H X
+     *
+     *  Note that this default implementation calls matrixVectorProduct() for every column
+     */
+    virtual MatrixX<double> blockMatrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const MatrixX<double>& X, const VectorX<double>& diagonal) const;
+
+    /**
+     *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the compressed sparse representation of the Hamiltonian matrix
+     *
+     *  Note that this default implementation throws instead of converting the dense Hamiltonian matrix: derived classes that can emit the non-zero elements directly should override it
+     */
+    virtual Eigen::SparseMatrix<double> constructSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const;
+
+    /**
+     *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the Hamiltonian matrix in a compressed sparse row format, whose (parallel) matrix-vector products can be re-used in every iteration of an eigensolver
+     *
+     *  Note that this default implementation converts the sparse Hamiltonian matrix from constructSparseHamiltonian()
+     */
+    virtual SymmetricSparseMatrix<double> constructSymmetricSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const;
 };
 
 
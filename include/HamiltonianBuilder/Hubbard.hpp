@@ -40,13 +40,27 @@ private:
     
     // PRIVATE METHODS
     /**
-     *  Evaluate the one-electron operators for alpha or beta and store the result in a matrix-vector product or a matrix, depending on the method passed
+     *  Evaluate the one-electron operators for alpha or beta and store the result in a matrix-vector product or a matrix, depending on the visitor passed
+     *
+     *  @tparam Visitor                 a callable with signature void(size_t I, size_t J, double value), whose calls are inlined in the coupling loop
      *
      *  @param fock_space_target        the Fock space that is used as a target, i.e. that is evaluated
      *  @param fock_space_fixed         the Fock space that is not evaluated
      *  @param target_is_major          whether or not the evaluated component is the major index
      *  @param hamiltonian_parameters   the Hubbard Hamiltonian parameters
-     *  @param method                   the used method: constructHamiltonian() or matrixVectorProduct()
+     *  @param visit                    the visitor that is called for every coupling H(I,J)
+     */
+    template <typename Visitor>
+    void oneOperatorModule(const FockSpace& fock_space_target, const FockSpace& fock_space_fixed, bool target_is_major, const HamiltonianParameters<double>& hamiltonian_parameters, const Visitor& visit) const;
+
+    /**
+     *  Evaluate the one-electron operators for alpha or beta through a type-erased method
+     *
+     *  @param fock_space_target        the Fock space that is used as a target, i.e. that is evaluated
+     *  @param fock_space_fixed         the Fock space that is not evaluated
+     *  @param target_is_major          whether or not the evaluated component is the major index
+     *  @param hamiltonian_parameters   the Hubbard Hamiltonian parameters
+     *  @param method                   the method that is called for every coupling H(I,J)
      */
     void oneOperatorModule(const FockSpace& fock_space_target, const FockSpace& fock_space_fixed, bool target_is_major, const HamiltonianParameters<double>& hamiltonian_parameters, const PassToMethod& method) const;
 
@@ -85,6 +99,29 @@ public:
      */
     VectorX<double> matrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const VectorX<double>& x, const VectorX<double>& diagonal) const override;
 
+    /**
+     *  @param hamiltonian_parameters       the Hubbard Hamiltonian parameters in an orthonormal orbital basis
+     *  @param X                            the vectors upon which the Hubbard Hamiltonian acts, as the columns of a (dim x m)-matrix
+     *  @param diagonal                     the diagonal of the Hubbard Hamiltonian matrix
+     *
+     *  @return the action of the Hubbard Hamiltonian on every column of X
+     */
+    MatrixX<double> blockMatrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const MatrixX<double>& X, const VectorX<double>& diagonal) const override;
+
+    /**
+     *  @param hamiltonian_parameters       the Hubbard Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the compressed sparse representation of the Hubbard Hamiltonian matrix, assembled from the evaluated elements
+     */
+    Eigen::SparseMatrix<double> constructSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const override;
+
+    /**
+     *  @param hamiltonian_parameters       the Hubbard Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the Hubbard Hamiltonian matrix, assembled from the evaluated elements in its upper half
+     */
+    SymmetricSparseMatrix<double> constructSymmetricSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const override;
+
     /**
      *  @param hamiltonian_parameters       the Hubbard Hamiltonian parameters in an orthonormal orbital basis
      *
@@ -0,0 +1,98 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef GQCP_PREPAREDFCI_HPP
+#define GQCP_PREPAREDFCI_HPP
+
+
+#include "math/Matrix.hpp"
+
+#include <Eigen/Sparse>
+
+#include <memory>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  The FCI Hamiltonian bound to one set of Hamiltonian parameters: all intermediates of the matrix-vector product that only depend on the Hamiltonian parameters (and not on the vector the Hamiltonian acts on) are stored, so that they can be re-used in every subsequent matrix-vector product
+ */
+class PreparedFCI {
+private:
+    size_t K;  // the number of spatial orbitals
+    size_t dim_alpha;  // the dimension of the alpha Fock space
+    size_t dim_beta;  // the dimension of the beta Fock space
+    size_t revision;  // the revision of the Hamiltonian parameters these intermediates were calculated for
+
+    std::shared_ptr<const std::vector<Eigen::SparseMatrix<double>>> alpha_couplings;  // sigma(pq) + sigma(qp) in the alpha Fock space, ordered as in FCI
+    std::vector<Eigen::SparseMatrix<double>> beta_two_electron_intermediates;  // theta(pq) in the beta Fock space, for p <= q and ordered as the alpha couplings
+    Eigen::SparseMatrix<double> alpha_hamiltonian;  // the Hamiltonian in the alpha Fock space
+    Eigen::SparseMatrix<double> beta_hamiltonian;  // the Hamiltonian in the beta Fock space
+
+
+public:
+    // CONSTRUCTORS
+    /**
+     *  @param K                                    the number of spatial orbitals
+     *  @param revision                             the revision of the Hamiltonian parameters the intermediates were calculated for
+     *  @param alpha_couplings                      sigma(pq) + sigma(qp) in the alpha Fock space, ordered as: sigma(00), sigma(01) + sigma(10), sigma(02)+ sigma(20), ...
+     *  @param beta_two_electron_intermediates      theta(pq) in the beta Fock space, ordered as the alpha couplings
+     *  @param alpha_hamiltonian                    the Hamiltonian in the alpha Fock space
+     *  @param beta_hamiltonian                     the Hamiltonian in the beta Fock space
+     */
+    PreparedFCI(size_t K, size_t revision, std::shared_ptr<const std::vector<Eigen::SparseMatrix<double>>> alpha_couplings, std::vector<Eigen::SparseMatrix<double>> beta_two_electron_intermediates, Eigen::SparseMatrix<double> alpha_hamiltonian, Eigen::SparseMatrix<double> beta_hamiltonian);
+
+
+    // GETTERS
+    size_t get_K() const { return this->K; }
+    size_t get_revision() const { return this->revision; }
+    size_t get_dimension() const { return this->dim_alpha * this->dim_beta; }
+    const std::vector<Eigen::SparseMatrix<double>>& get_alpha_couplings() const { return *this->alpha_couplings; }
+    const std::vector<Eigen::SparseMatrix<double>>& get_beta_two_electron_intermediates() const { return this->beta_two_electron_intermediates; }
+    const Eigen::SparseMatrix<double>& get_alpha_hamiltonian() const { return this->alpha_hamiltonian; }
+    const Eigen::SparseMatrix<double>& get_beta_hamiltonian() const { return this->beta_hamiltonian; }
+
+
+    // PUBLIC METHODS
+    /**
+     *  @param x            the vector upon which the FCI Hamiltonian acts
+     *  @param diagonal     the diagonal of the FCI Hamiltonian matrix
+     *
+     *  @return the action of the FCI Hamiltonian on the coefficient vector
+     *
+     *  Note that the calculation is divided over getNumberOfThreads() threads
+     */
+    VectorX<double> matrixVectorProduct(const VectorX<double>& x, const VectorX<double>& diagonal) const;
+
+    /**
+     *  @param X            the vectors upon which the FCI Hamiltonian acts, as the columns of a (dim x m)-matrix
+     *  @param diagonal     the diagonal of the FCI Hamiltonian matrix
+     *
+     *  @return the action of the FCI Hamiltonian on every column of X
+     *
+     *  Note that the calculation is divided over getNumberOfThreads() threads
+     */
+    MatrixX<double> blockMatrixVectorProduct(const MatrixX<double>& X, const VectorX<double>& diagonal) const;
+};
+
+
+}  // namespace GQCP
+
+
+#endif  // GQCP_PREPAREDFCI_HPP
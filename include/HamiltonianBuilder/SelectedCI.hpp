@@ -32,14 +32,27 @@ namespace GQCP {
 class SelectedCI : public HamiltonianBuilder {
 private:
     SelectedFockSpace fock_space;  // contains both the alpha and beta Fock space
+    std::vector<std::vector<size_t>> connections;  // for every address I, the addresses J > I of the configurations that are singly or doubly excited with respect to configuration I
     
     // PRIVATE METHODS
     /**
-     *  Evaluate all Hamiltonian elements, putting the results in the Hamiltonian matrix or matvec through the `method` function
+     *  Evaluate all Hamiltonian elements, putting the results in the Hamiltonian matrix or matvec through the `visit` function
      *  This function is used both in `constructHamiltonian()` and `matrixVectorProduct()` to avoid duplicate code.
+     *  Only the pairs of configurations in `connections` are evaluated, instead of all pairs.
+     *
+     *  @tparam Visitor                 a callable with signature void(size_t I, size_t J, double value), whose calls are inlined in the evaluation loop
+     *
+     *  @param hamiltonian_parameters   the Hamiltonian parameters in an orthonormal basis
+     *  @param visit                    the visitor that is called once for both H(I,J) and H(J,I) of every connected pair
+     */
+    template <typename Visitor>
+    void evaluateHamiltonianElements(const HamiltonianParameters<double>& hamiltonian_parameters, const Visitor& visit) const;
+
+    /**
+     *  Evaluate all Hamiltonian elements through a type-erased method
      *
      *  @param hamiltonian_parameters   the Hamiltonian parameters in an orthonormal basis
-     *  @param method                   the method depending to how you wish to construct the Hamiltonian
+     *  @param method                   the method that is called once for both H(I,J) and H(J,I) of every connected pair
      */
     void evaluateHamiltonianElements(const HamiltonianParameters<double>& hamiltonian_parameters, const PassToMethod& method) const;
 public:
@@ -76,6 +89,29 @@ public:
      */
     VectorX<double> matrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const VectorX<double>& x, const VectorX<double>& diagonal) const override;
 
+    /**
+     *  @param hamiltonian_parameters       the SelectedCI Hamiltonian parameters in an orthonormal orbital basis
+     *  @param X                            the vectors upon which the SelectedCI Hamiltonian acts, as the columns of a (dim x m)-matrix
+     *  @param diagonal                     the diagonal of the SelectedCI Hamiltonian matrix
+     *
+     *  @return the action of the SelectedCI Hamiltonian on every column of X
+     */
+    MatrixX<double> blockMatrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const MatrixX<double>& X, const VectorX<double>& diagonal) const override;
+
+    /**
+     *  @param hamiltonian_parameters       the SelectedCI Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the compressed sparse representation of the SelectedCI Hamiltonian matrix, assembled from the evaluated elements
+     */
+    Eigen::SparseMatrix<double> constructSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const override;
+
+    /**
+     *  @param hamiltonian_parameters       the SelectedCI Hamiltonian parameters in an orthonormal orbital basis
+     *
+     *  @return the SelectedCI Hamiltonian matrix, assembled from the evaluated elements in its upper half
+     */
+    SymmetricSparseMatrix<double> constructSymmetricSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const override;
+
     /**
      *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
      *
@@ -31,10 +31,26 @@ namespace GQCP {
  *  A base class for representing Hamiltonian parameters, i.e. the one- and two-electron integrals in the second-quantized expression of the Hamiltonian
  */
 class BaseHamiltonianParameters {
+private:
+    // PRIVATE STATIC METHODS
+    /**
+     *  @return a revision that hasn't been handed out before
+     */
+    static size_t nextRevision();
+
 protected:
     double scalar;  // a scalar interaction term
     std::shared_ptr<AOBasis> ao_basis;  // the initial atomic orbitals
 
+    size_t revision;  // an identifier for the current values of the parameters: it is renewed every time the parameters are modified, so that cached quantities derived from them can be recognized as outdated
+
+
+    // PROTECTED METHODS
+    /**
+     *  Assign a new, unique revision to these Hamiltonian parameters: this should be called every time the parameters are modified
+     */
+    void updateRevision();
+
 public:
     // CONSTRUCTORS
     /**
@@ -53,6 +69,7 @@ public:
     // GETTERS
     const std::shared_ptr<AOBasis>& get_ao_basis() const { return this->ao_basis; }
     double get_scalar() const { return this->scalar; }
+    size_t get_revision() const { return this->revision; }
 };
 
 
@@ -0,0 +1,177 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef GQCP_FCIDUMP_HPP
+#define GQCP_FCIDUMP_HPP
+
+
+#include "Operator/OneElectronOperator.hpp"
+#include "Operator/TwoElectronOperator.hpp"
+
+#include <string>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  The contents of an integral file: the header of an FCIDUMP file (the number of orbitals and electrons, the spin projection and the orbital symmetries), the core energy and the symmetry-unique integrals
+ *
+ *  Only the two-electron integrals (pq|rs) with p >= q, r >= s and pq >= rs are stored, which is the same information that is present in an FCIDUMP file. Besides the text FCIDUMP format, the integrals can be written to and read from a compact binary format:
+ *      - the 8 characters "GQCPFCID", followed by a 64-bit format version
+ *      - the 64-bit unsigned integers K and N, the 64-bit signed integer MS2 and the core energy as a double
+ *      - K 64-bit unsigned orbital symmetries
+ *      - the K(K+1)/2 one-electron integrals h(p,q) with p >= q, followed by the unique two-electron integrals, both as doubles in the order of FCIDUMP::pairIndex() and FCIDUMP::uniqueIndex()
+ *  All values are stored in the native byte order, so that the binary file can be mapped into memory directly
+ */
+class FCIDUMP {
+private:
+    size_t K;  // the number of spatial orbitals
+    size_t N;  // the number of electrons
+    int MS2;  // twice the spin projection
+    std::vector<size_t> orbital_symmetries;  // the irreducible representation of every orbital
+    double core_energy;  // the scalar energy term (usually the internuclear repulsion energy)
+
+    OneElectronOperator<double> h;  // the one-electron integrals
+    std::vector<double> unique_two_electron_integrals;  // the two-electron integrals (pq|rs) with p >= q, r >= s and pq >= rs, in chemist's notation
+
+
+    // PRIVATE STATIC METHODS
+    /**
+     *  Skip the whitespace in the given buffer
+     *
+     *  @param position     the current position in the buffer, which is advanced
+     *  @param end          the end of the buffer
+     */
+    static void skipWhitespace(const char*& position, const char* end);
+
+    /**
+     *  Parse a floating point number (possibly with a Fortran 'D' exponent) from the given buffer
+     *
+     *  @param position     the current position in the buffer, which is advanced past the number
+     *  @param end          the end of the buffer
+     *
+     *  @return the parsed number
+     */
+    static double parseDouble(const char*& position, const char* end);
+
+    /**
+     *  Parse an orbital index from the given buffer
+     *
+     *  @param position     the current position in the buffer, which is advanced past the index
+     *  @param end          the end of the buffer
+     *
+     *  @return the parsed index
+     */
+    static size_t parseIndex(const char*& position, const char* end);
+
+    /**
+     *  @param header       the namelist header of an FCIDUMP file
+     *  @param key          the name of the variable
+     *  @param values       the number of values that should be read
+     *
+     *  @return the integer values that are assigned to the given variable, or an empty vector if the variable is not present
+     */
+    static std::vector<long> parseHeaderValues(const std::string& header, const std::string& key, size_t values);
+
+
+public:
+    // CONSTRUCTORS
+    /**
+     *  @param N                                    the number of electrons
+     *  @param MS2                                  twice the spin projection
+     *  @param orbital_symmetries                   the irreducible representation of every orbital
+     *  @param core_energy                          the scalar energy term
+     *  @param h                                    the one-electron integrals
+     *  @param unique_two_electron_integrals        the two-electron integrals (pq|rs) with p >= q, r >= s and pq >= rs, in the order of FCIDUMP::uniqueIndex()
+     */
+    FCIDUMP(size_t N, int MS2, const std::vector<size_t>& orbital_symmetries, double core_energy, const OneElectronOperator<double>& h, const std::vector<double>& unique_two_electron_integrals);
+
+    /**
+     *  @param N                        the number of electrons
+     *  @param MS2                      twice the spin projection
+     *  @param orbital_symmetries       the irreducible representation of every orbital
+     *  @param core_energy              the scalar energy term
+     *  @param h                        the one-electron integrals
+     *  @param g                        the two-electron integrals in chemist's notation, which should have the permutational symmetries of real integrals
+     */
+    FCIDUMP(size_t N, int MS2, const std::vector<size_t>& orbital_symmetries, double core_energy, const OneElectronOperator<double>& h, const TwoElectronOperator<double>& g);
+
+
+    // NAMED CONSTRUCTORS
+    /**
+     *  @param filename     the name of a text FCIDUMP file
+     *
+     *  @return the contents of the given FCIDUMP file
+     *
+     *  The file is mapped into memory and parsed in place
+     */
+    static FCIDUMP ReadText(const std::string& filename);
+
+    /**
+     *  @param filename     the name of a binary integral file (see the class documentation for the format)
+     *
+     *  @return the contents of the given binary integral file
+     */
+    static FCIDUMP ReadBinary(const std::string& filename);
+
+
+    // GETTERS
+    size_t get_K() const { return this->K; }
+    size_t get_N() const { return this->N; }
+    int get_MS2() const { return this->MS2; }
+    const std::vector<size_t>& get_orbital_symmetries() const { return this->orbital_symmetries; }
+    double get_core_energy() const { return this->core_energy; }
+    const OneElectronOperator<double>& get_h() const { return this->h; }
+    const std::vector<double>& get_unique_two_electron_integrals() const { return this->unique_two_electron_integrals; }
+
+
+    // STATIC PUBLIC METHODS
+    /**
+     *  @param p        the first index
+     *  @param q        the second index
+     *
+     *  @return the compound index of the pair (p,q), which doesn't depend on the order of p and q
+     */
+    static size_t pairIndex(size_t p, size_t q) { return (p >= q) ? p * (p + 1) / 2 + q : q * (q + 1) / 2 + p; }
+
+    /**
+     *  @return the position of the two-electron integral (pq|rs) in the symmetry-unique two-electron integrals
+     */
+    static size_t uniqueIndex(size_t p, size_t q, size_t r, size_t s) { return pairIndex(pairIndex(p, q), pairIndex(r, s)); }
+
+
+    // PUBLIC METHODS
+    /**
+     *  @return the full two-electron integrals in chemist's notation, unfolded from the symmetry-unique ones
+     */
+    TwoElectronOperator<double> calculateTwoElectronIntegrals() const;
+
+    /**
+     *  Write the integrals to a binary integral file (see the class documentation for the format)
+     *
+     *  @param filename     the name of the binary integral file
+     */
+    void writeBinary(const std::string& filename) const;
+};
+
+
+}  // namespace GQCP
+
+
+#endif  // GQCP_FCIDUMP_HPP
@@ -19,6 +19,8 @@
 #define GQCP_HAMILTONIANPARAMETERS_HPP
 
 #include "HamiltonianParameters/BaseHamiltonianParameters.hpp"
+#include "HamiltonianParameters/FCIDUMP.hpp"
+#include "HamiltonianParameters/PairIntegrals.hpp"
 #include "HoppingMatrix.hpp"
 #include "JacobiRotationParameters.hpp"
 #include "LibintCommunicator.hpp"
@@ -27,6 +29,7 @@
 #include "Operator/TwoElectronOperator.hpp"
 #include "RDM/TwoRDM.hpp"
 #include "RDM/OneRDM.hpp"
+#include "RDM/SeniorityZeroTwoRDM.hpp"
 #include "typedefs.hpp"
 
 
@@ -52,6 +55,8 @@ private:
 
     SquareMatrix<Scalar> T_total;  // total transformation matrix between the current (restricted) molecular orbitals and the atomic orbitals
 
+    mutable std::shared_ptr<const PairIntegrals<Scalar>> pair_integrals;  // the most recently calculated pair integrals, which are re-used as long as the parameters are not modified
+
 
 public:
 
@@ -244,7 +249,7 @@ public:
             throw std::runtime_error("HamiltonianParameters::ReadFCIDUMP(std::string): You did not provide a .FCIDUMP file name");
         }
 
-        // If the xyz_filename isn't properly converted into an input file stream, we assume the user supplied a wrong file
+        // If the file can't be opened, we assume the user supplied a wrong file
         std::ifstream input_file_stream (fcidump_file);
 
         if (!input_file_stream.good()) {
@@ -252,97 +257,42 @@ public:
         }
 
 
-        // Do the actual parsing
-
-        //  Get the number of orbitals to check if it's a valid FCIDUMP file
-        std::string start_line;  // first line contains orbitals and electron count
-        std::getline(input_file_stream, start_line);
-        std::stringstream linestream (start_line);
-
-        size_t K = 0;
-        char iter;
-
-        while (linestream >> iter) {
-            if (iter == '=') {
-                linestream >> K;  // right here we have the number of orbitals
-                break;  // we can finish reading the linestream after we found K
-            }
-        }
-
-        if (K == 0) {
-            throw std::invalid_argument("HamiltonianParameters::ReadFCIDUMP(std::string): The .FCIDUMP-file is invalid: could not read a number of orbitals.");
-        }
-
-
-        double scalar = 0.0;
-        OneElectronOperator<double> h_core = OneElectronOperator<double>::Zero(K, K);
-        TwoElectronOperator<double> g (K);
-        g.setZero();
-
-        //  Skip 3 lines
-        for (size_t counter = 0; counter < 3; counter++) {
-            std::getline(input_file_stream, start_line);
-        }
-
-
-        //  Start reading in the one- and two-electron integrals
-        double x;
-        size_t i, j, a, b;
-
-        std::string line;
-        while (std::getline(input_file_stream, line)) {
-            std::istringstream iss (line);
-
-            // Based on what the values of the indices are, we can read one-electron integrals, two-electron integrals and the internuclear repulsion energy
-            //  See also (http://hande.readthedocs.io/en/latest/manual/integrals.html)
-            //  I think the documentation is a bit unclear for the two-electron integrals, but we can rest assured that FCIDUMP files give the two-electron integrals in CHEMIST's notation.
-            iss >> x >> i >> a >> j >> b;
-
-            //  Internuclear repulsion energy
-            if ((i == 0) && (j == 0) && (a == 0) && (b == 0)) {
-                scalar = x;
-            }
+        // Do the actual parsing on the file mapped into memory
+        return HamiltonianParameters<double>::FromFCIDUMP(FCIDUMP::ReadText(fcidump_file));
+    }
 
-            //  Single-particle eigenvalues (skipped)
-            else if ((a == 0) && (j == 0) && (b == 0)) {}
 
-            //  One-electron integrals (h_core)
-            else if ((j == 0) && (b == 0)) {
-                size_t p = i - 1;
-                size_t q = a - 1;
-                h_core(p,q) = x;
+    /**
+     *  @param filename     the name of a binary integral file, as written by FCIDUMP::writeBinary()
+     *
+     *  @return Hamiltonian parameters corresponding to the contents of the binary integral file
+     *
+     *  Note that this named constructor is only available for real matrix representations
+     */
+    template<typename Z = Scalar>
+    static enable_if_t<std::is_same<Z, double>::value, HamiltonianParameters<double>> ReadBinaryFCIDUMP(const std::string& filename) {
+        return HamiltonianParameters<double>::FromFCIDUMP(FCIDUMP::ReadBinary(filename));
+    }
 
-                // Apply the permutational symmetry for real orbitals
-                h_core(q,p) = x;
-            }
 
-            //  Two-electron integrals are given in CHEMIST'S NOTATION, so just copy them over
-            else if ((i > 0) && (a > 0) && (j > 0) && (b > 0)) {
-                size_t p = i - 1;
-                size_t q = a - 1;
-                size_t r = j - 1;
-                size_t s = b - 1;
-                g(p,q,r,s) = x;
-
-                // Apply the permutational symmetries for real orbitals
-                g(p,q,s,r) = x;
-                g(q,p,r,s) = x;
-                g(q,p,s,r) = x;
-
-                g(r,s,p,q) = x;
-                g(s,r,p,q) = x;
-                g(r,s,q,p) = x;
-                g(s,r,q,p) = x;
-            }
-        }  // while loop
+    /**
+     *  @param fcidump      the contents of an integral file
+     *
+     *  @return Hamiltonian parameters corresponding to the given integrals, which are assumed to be expressed in an orthonormal basis
+     *
+     *  Note that this named constructor is only available for real matrix representations
+     */
+    template<typename Z = Scalar>
+    static enable_if_t<std::is_same<Z, double>::value, HamiltonianParameters<double>> FromFCIDUMP(const FCIDUMP& fcidump) {
 
+        size_t K = fcidump.get_K();
 
         // Make the ingredients to construct HamiltonianParameters
         std::shared_ptr<AOBasis> ao_basis;  // nullptr
-        OneElectronOperator<Scalar> S = OneElectronOperator<double>::Identity(K, K);
+        OneElectronOperator<double> S = OneElectronOperator<double>::Identity(K, K);
         SquareMatrix<double> C = SquareMatrix<double>::Identity(K, K);
 
-        return HamiltonianParameters(ao_basis, S, h_core, g, C, scalar);
+        return HamiltonianParameters(ao_basis, S, fcidump.get_h(), fcidump.calculateTwoElectronIntegrals(), C, fcidump.get_core_energy());
     }
 
 
@@ -402,6 +352,23 @@ public:
     const SquareMatrix<Scalar>& get_T_total() const { return this->T_total; }
     size_t get_K() const { return this->K; }
 
+    /**
+     *  @return the Coulomb, exchange and pair-hopping integrals (see PairIntegrals) of these Hamiltonian parameters
+     *
+     *  Note that these are only calculated once for the current values of the parameters: copies of these Hamiltonian parameters share them, and they are recalculated after the parameters are modified (i.e. when the revision has changed)
+     */
+    std::shared_ptr<const PairIntegrals<Scalar>> get_pair_integrals() const {
+
+        auto pair_integrals = std::atomic_load(&this->pair_integrals);  // other threads may be updating the cache
+        if (pair_integrals && (pair_integrals->get_revision() == this->revision)) {
+            return pair_integrals;
+        }
+
+        pair_integrals = std::make_shared<const PairIntegrals<Scalar>>(this->g, this->revision);
+        std::atomic_store(&this->pair_integrals, pair_integrals);
+        return pair_integrals;
+    }
+
 
     /*
      *  PUBLIC METHODS
@@ -435,6 +402,9 @@ public:
         this->g.transform(T);
 
         this->T_total = this->T_total * T;  // use the correct transformation formula for subsequent transformations
+
+        this->updateRevision();
+        std::atomic_store(&this->pair_integrals, std::shared_ptr<const PairIntegrals<Scalar>>());  // other threads may be reading the cache
     }
 
 
@@ -463,6 +433,8 @@ public:
         auto J = SquareMatrix<double>::FromJacobi(jacobi_rotation_parameters, K);
         this->T_total = this->T_total * J;
 
+        this->updateRevision();
+        std::atomic_store(&this->pair_integrals, std::shared_ptr<const PairIntegrals<Scalar>>());  // other threads may be reading the cache
     }
 
 
@@ -562,6 +534,51 @@ public:
         return F;
     }
 
+    /**
+     *  @param D      the 1-RDM
+     *  @param d      the 2-RDM of a seniority-zero wave function, in its compact representation
+     *
+     *  @return the generalized Fock matrix
+     *
+     *  Since only O(K) elements d(p,r,s,t) are non-zero for a given p, this scales as O(K^3) instead of O(K^5)
+     */
+    OneElectronOperator<Scalar> calculateGeneralizedFockMatrix(const OneRDM<double>& D, const SeniorityZeroTwoRDM<double>& d) const {
+
+        // Check if dimensions are compatible
+        if (D.get_dim() != this->K) {
+            throw std::invalid_argument("HamiltonianParameters::calculateGeneralizedFockMatrix(OneRDM<double>, SeniorityZeroTwoRDM<double>): The 1-RDM is not compatible with the HamiltonianParameters.");
+        }
+
+        if (d.get_K() != this->K) {
+            throw std::invalid_argument("HamiltonianParameters::calculateGeneralizedFockMatrix(OneRDM<double>, SeniorityZeroTwoRDM<double>): The 2-RDM is not compatible with the HamiltonianParameters.");
+        }
+
+
+        OneElectronOperator<Scalar> F = OneElectronOperator<Scalar>::Zero(this->K, this->K);
+        for (size_t p = 0; p < this->K; p++) {
+            for (size_t q = 0; q < this->K; q++) {
+
+                // One-electron part
+                for (size_t r = 0; r < this->K; r++) {
+                    F(p,q) += h(q,r) * D(p,r);
+                }
+
+                // Two-electron part: the non-zero elements are d(p,p,b,b), d(p,b,b,p) and d(p,b,p,b)
+                for (size_t b = 0; b < this->K; b++) {
+                    F(p,q) += g(q,p,b,b) * d(p,p,b,b);
+
+                    if (b != p) {
+                        F(p,q) += g(q,b,b,p) * d(p,b,b,p) + g(q,b,p,b) * d(p,b,p,b);
+                    }
+                }  // two-electron part
+
+            }
+        }  // F elements loop
+
+
+        return F;
+    }
+
     /**
      *  @param ao_list     indices of the AOs used for the Mulliken populations
      *
@@ -672,6 +689,85 @@ public:
         return W;
     }
 
+    /**
+     *  @param D      the 1-RDM
+     *  @param d      the 2-RDM of a seniority-zero wave function, in its compact representation
+     *
+     *  @return the super-generalized Fock matrix
+     *
+     *  Since only O(K) of the (t,u)-pairs contribute to every two-electron contraction, this scales as O(K^5) instead of O(K^6)
+     */
+    TwoElectronOperator<Scalar> calculateSuperGeneralizedFockMatrix(const OneRDM<double>& D, const SeniorityZeroTwoRDM<double>& d) const {
+
+        // Check if dimensions are compatible
+        if (D.get_dim() != this->K) {
+            throw std::invalid_argument("HamiltonianParameters::calculateSuperGeneralizedFockMatrix(OneRDM<double>, SeniorityZeroTwoRDM<double>): The 1-RDM is not compatible with the HamiltonianParameters.");
+        }
+
+        if (d.get_K() != this->K) {
+            throw std::invalid_argument("HamiltonianParameters::calculateSuperGeneralizedFockMatrix(OneRDM<double>, SeniorityZeroTwoRDM<double>): The 2-RDM is not compatible with the HamiltonianParameters.");
+        }
+
+
+        // We have to calculate the generalized Fock matrix F first
+        OneElectronOperator<Scalar> F = this->calculateGeneralizedFockMatrix(D, d);
+
+        TwoElectronOperator<Scalar> W (this->K);
+        W.setZero();
+        for (size_t p = 0; p < this->K; p++) {
+            for (size_t q = 0; q < this->K; q++) {
+                for (size_t r = 0; r < this->K; r++) {
+                    for (size_t s = 0; s < this->K; s++) {
+
+                        // Generalized Fock matrix part
+                        if (r == q) {
+                            W(p,q,r,s) += F(p,s);
+                        }
+
+                        // One-electron part
+                        W(p,q,r,s) -= this->h(s,p) * D(r,q);
+
+                        // Two-electron part: g(s,t,q,u) d(r,t,p,u)
+                        W(p,q,r,s) += this->g(s,r,q,p) * d(r,r,p,p);
+                        if (r != p) {
+                            W(p,q,r,s) += this->g(s,p,q,r) * d(r,p,p,r);
+                        } else {
+                            for (size_t b = 0; b < this->K; b++) {
+                                if (b != r) {
+                                    W(p,q,r,s) += this->g(s,b,q,b) * d(r,b,r,b);
+                                }
+                            }
+                        }
+
+                        // Two-electron part: - g(s,t,u,p) d(r,t,u,q)
+                        W(p,q,r,s) -= this->g(s,r,q,p) * d(r,r,q,q);
+                        if (r != q) {
+                            W(p,q,r,s) -= this->g(s,q,r,p) * d(r,q,r,q);
+                        } else {
+                            for (size_t b = 0; b < this->K; b++) {
+                                if (b != r) {
+                                    W(p,q,r,s) -= this->g(s,b,b,p) * d(r,b,b,r);
+                                }
+                            }
+                        }
+
+                        // Two-electron part: - g(s,p,t,u) d(r,q,t,u)
+                        if (r != q) {
+                            W(p,q,r,s) -= this->g(s,p,q,r) * d(r,q,q,r) + this->g(s,p,r,q) * d(r,q,r,q);
+                        } else {
+                            for (size_t b = 0; b < this->K; b++) {
+                                W(p,q,r,s) -= this->g(s,p,b,b) * d(r,r,b,b);
+                            }
+                        }
+                    }
+                }
+            }
+        }  // W elements loop
+
+
+        return W;
+    }
+
 
     // PUBLIC METHODS - CONSTRAINTS
     /**
@@ -0,0 +1,88 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef GQCP_PAIRINTEGRALS_HPP
+#define GQCP_PAIRINTEGRALS_HPP
+
+
+#include "math/SquareMatrix.hpp"
+#include "Operator/TwoElectronOperator.hpp"
+
+
+namespace GQCP {
+
+
+/**
+ *  The two-electron integrals in which the orbital indices occur in pairs, collected in contiguous K x K matrices
+ *
+ *  In chemist's notation, these are
+ *      - the Coulomb integrals             J(p,q) = g(p,p,q,q)
+ *      - the exchange integrals            K(p,q) = g(p,q,q,p)
+ *      - the pair-hopping integrals        P(p,q) = g(p,q,p,q)
+ *
+ *  Seniority-zero methods (DOCI, AP1roG) and diagonals of CI Hamiltonians only need these, so working with them avoids strided access into the full K^4 two-electron integrals
+ *
+ *  @tparam Scalar      the scalar type
+ */
+template <typename Scalar>
+class PairIntegrals {
+private:
+    size_t revision;  // the revision of the Hamiltonian parameters these integrals were extracted from
+
+    SquareMatrix<Scalar> coulomb;  // J(p,q) = g(p,p,q,q)
+    SquareMatrix<Scalar> exchange;  // K(p,q) = g(p,q,q,p)
+    SquareMatrix<Scalar> pair_hopping;  // P(p,q) = g(p,q,p,q)
+
+
+public:
+    // CONSTRUCTORS
+    /**
+     *  @param g            the two-electron integrals
+     *  @param revision     the revision of the Hamiltonian parameters the two-electron integrals belong to
+     */
+    PairIntegrals(const TwoElectronOperator<Scalar>& g, size_t revision) :
+        revision (revision)
+    {
+        auto K = g.get_dim();
+
+        this->coulomb = SquareMatrix<Scalar>::Zero(K, K);
+        this->exchange = SquareMatrix<Scalar>::Zero(K, K);
+        this->pair_hopping = SquareMatrix<Scalar>::Zero(K, K);
+
+        for (size_t q = 0; q < K; q++) {  // fill column by column, since the matrices are column-major
+            for (size_t p = 0; p < K; p++) {
+                this->coulomb(p,q) = g(p,p,q,q);
+                this->exchange(p,q) = g(p,q,q,p);
+                this->pair_hopping(p,q) = g(p,q,p,q);
+            }
+        }
+    }
+
+
+    // GETTERS
+    size_t get_revision() const { return this->revision; }
+    size_t get_K() const { return static_cast<size_t>(this->coulomb.cols()); }
+    const SquareMatrix<Scalar>& get_coulomb() const { return this->coulomb; }
+    const SquareMatrix<Scalar>& get_exchange() const { return this->exchange; }
+    const SquareMatrix<Scalar>& get_pair_hopping() const { return this->pair_hopping; }
+};
+
+
+}  // namespace GQCP
+
+
+#endif  // GQCP_PAIRINTEGRALS_HPP
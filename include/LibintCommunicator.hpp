@@ -21,12 +21,18 @@
 
 #include "AOBasis.hpp"
 #include "Molecule.hpp"
+#include "Operator/FactorizedTwoElectronOperator.hpp"
 #include "Operator/OneElectronOperator.hpp"
 #include "Operator/TwoElectronOperator.hpp"
+#include "RDM/OneRDM.hpp"
+#include "utilities/parallel.hpp"
 
 #include <boost/preprocessor.hpp>  // include preprocessor before libint to fix libint-boost bug
 #include <libint2.hpp>
 
+#include <functional>
+#include <utility>
+
 
 namespace GQCP {
 
@@ -34,6 +40,8 @@ namespace GQCP {
 /**
  *  A singleton class that takes care of interfacing with the Libint2 (version >2.2.0) C++ API
  *
+ *  The integrals are calculated in parallel, where every thread uses its own libint2::Engine. The number of threads is controlled by setNumberOfThreads() (see utilities/parallel.hpp)
+ *
  *  Singleton class template from (https://stackoverflow.com/a/1008289)
  */
 class LibintCommunicator {
@@ -54,6 +62,10 @@ private:
     typedef struct {} empty;  // empty_pod is a private typedef for libint2::Engine, so we copy it over
 
 
+    // PRIVATE ALIASES
+    using DiagonalShellQuartetMethod = std::function<void(size_t sh1, size_t sh2, const Eigen::Map<const Eigen::MatrixXd>& ab_ab)>;  // receives the diagonal shell quartet (ab|ab) of the shell pair (sh1, sh2)
+
+
     // PRIVATE METHODS
     /**
      *  @tparam N               the number of operator components
@@ -75,57 +87,88 @@ private:
         }
 
 
-        // Construct the libint2 engine
+        // Construct the libint2 engine, and give every thread its own copy
         libint2::Engine engine (operator_type, basisset.max_nprim(), static_cast<int>(basisset.max_l()));
         engine.set_params(parameters);
+        assert(engine.results().size() == N);  // its size is N, so it holds N pointers to the first computed integral of an integral set
 
-        const auto shell2bf = basisset.shell2bf();  // create a map between (shell index) -> (basis function index)
+        const auto number_of_threads = getNumberOfThreads();
+        std::vector<libint2::Engine> engines (number_of_threads, engine);
 
-        const auto& calculated_integrals = engine.results();  // vector that holds pointers to computed shell sets
-        assert(calculated_integrals.size() == N);             // its size is N, so it holds N pointers to the first computed integral of an integral set
+        const auto shell2bf = basisset.shell2bf();  // create a map between (shell index) -> (basis function index)
 
 
         // One-electron integrals are between two basis functions, so we'll need two loops
         // Libint calculates integrals between libint2::Shells, so we will loop over the shells in the basisset
+        // The shell pairs are handed out dynamically to the threads, which each write to their own elements of the matrix representations
         const auto nsh = static_cast<size_t>(basisset.size());  // number of shells
-        for (auto sh1 = 0; sh1 != nsh; ++sh1) {  // shell 1
-            for (auto sh2 = 0; sh2 != nsh; ++sh2) {  // shell 2
-                // Calculate integrals between the two shells
-                engine.compute(basisset[sh1], basisset[sh2]);  // this updates the pointers in calculated_integrals
+        parallelForDynamic(0, nsh * nsh, [&] (size_t shell_pair, size_t thread_index) {
+            const auto sh1 = shell_pair / nsh;  // shell 1
+            const auto sh2 = shell_pair % nsh;  // shell 2
 
+            // Calculate integrals between the two shells
+            auto& thread_engine = engines[thread_index];
+            const auto& calculated_integrals = thread_engine.results();  // vector that holds pointers to computed shell sets
+            thread_engine.compute(basisset[sh1], basisset[sh2]);  // this updates the pointers in calculated_integrals
 
-                // Place the calculated integrals into the matrix representation(s): the integrals are stored in row-major form
-                auto bf1 = shell2bf[sh1];  // (index of) first bf in sh1
-                auto bf2 = shell2bf[sh2];  // (index of) first bf in sh2
 
-                auto nbf_sh1 = basisset[sh1].size();  // number of basis functions in first shell
-                auto nbf_sh2 = basisset[sh2].size();  // number of basis functions in second shell
+            // Place the calculated integrals into the matrix representation(s): the integrals are stored in row-major form
+            auto bf1 = shell2bf[sh1];  // (index of) first bf in sh1
+            auto bf2 = shell2bf[sh2];  // (index of) first bf in sh2
 
-                for (auto f1 = 0; f1 != nbf_sh1; ++f1) {  // f1: index of basis function within shell 1
-                    for (auto f2 = 0; f2 != nbf_sh2; ++f2) { // f2: index of basis function within shell 2
+            auto nbf_sh1 = basisset[sh1].size();  // number of basis functions in first shell
+            auto nbf_sh2 = basisset[sh2].size();  // number of basis functions in second shell
 
-                        for (size_t i = 0; i < N; i++) {
-                            double computed_integral = calculated_integrals[i][f2 + f1 * nbf_sh2];  // integrals are packed in row-major form
-                            operator_components[i](bf1 + f1, bf2 + f2) = computed_integral;
-                        }
+            for (auto f1 = 0; f1 != nbf_sh1; ++f1) {  // f1: index of basis function within shell 1
+                for (auto f2 = 0; f2 != nbf_sh2; ++f2) { // f2: index of basis function within shell 2
 
+                    for (size_t i = 0; i < N; i++) {
+                        double computed_integral = calculated_integrals[i][f2 + f1 * nbf_sh2];  // integrals are packed in row-major form
+                        operator_components[i](bf1 + f1, bf2 + f2) = computed_integral;
                     }
-                }  // data access loops
 
-            }
-        }  // shell loops
+                }
+            }  // data access loops
+        }, number_of_threads);  // shell pair loop
 
         return operator_components;
     }
 
 
     /**
+     *  @param shell_pair       the compound index sh1 (sh1 + 1) / 2 + sh2 of a shell pair with sh1 >= sh2
+     *
+     *  @return the shell indices (sh1, sh2) that correspond to the given compound shell pair index
+     */
+    static std::pair<size_t, size_t> unpackShellPair(size_t shell_pair);
+
+    /**
+     *  Calculate the diagonal shell quartets (ab|ab) for all shell pairs sh1 >= sh2, without screening them
+     *
      *  @param operator_type    the name of the operator as specified by the enumeration
-     *  @param ao_basis         the AO basis in which the two-electron operator should be expressed
+     *  @param basisset         the libint2 basis set representing the AO basis
+     *  @param method           the function that is called (in parallel) for every shell pair whose integrals are not exhausted, with the integrals (ab|ab) as a square (nbf_sh1 * nbf_sh2)-matrix in which ab = f2 + nbf_sh2 * f1
+     */
+    void calculateDiagonalShellQuartets(libint2::Operator operator_type, const libint2::BasisSet& basisset, const DiagonalShellQuartetMethod& method) const;
+
+    /**
+     *  @param operator_type    the name of the operator as specified by the enumeration
+     *  @param basisset         the libint2 basis set representing the AO basis
+     *
+     *  @return the Cauchy-Schwarz bounds for all shell pairs, i.e. the matrix with elements sqrt(max |(ab|ab)|) for the basis functions a, b in the shells
+     */
+    MatrixX<double> calculateSchwarzBounds(libint2::Operator operator_type, const libint2::BasisSet& basisset) const;
+
+    /**
+     *  @param operator_type        the name of the operator as specified by the enumeration
+     *  @param ao_basis             the AO basis in which the two-electron operator should be expressed
+     *  @param schwarz_threshold    the shell quartets whose Cauchy-Schwarz bound is smaller than this threshold are not calculated
      *
      *  @return the matrix representation of a two-electron operator in the given AO basis
+     *
+     *  Only the symmetry-unique shell quartets are calculated: their integrals are unfolded using the 8-fold permutational symmetry of real two-electron integrals
      */
-    TwoElectronOperator<double> calculateTwoElectronIntegrals(libint2::Operator operator_type, const AOBasis& ao_basis) const;
+    TwoElectronOperator<double> calculateTwoElectronIntegrals(libint2::Operator operator_type, const AOBasis& ao_basis, double schwarz_threshold) const;
 
 
 public:
@@ -180,11 +223,78 @@ public:
     std::array<OneElectronOperator<double>, 3> calculateDipoleIntegrals(const AOBasis& ao_basis, const Vector<double, 3>& origin=Vector<double, 3>::Zero()) const;
 
     /**
-     *  @param ao_basis     the AO basis used for the calculation of the Coulomb repulsion integrals
+     *  @param ao_basis             the AO basis used for the calculation of the Coulomb repulsion integrals
+     *  @param schwarz_threshold    the shell quartets whose Cauchy-Schwarz bound is smaller than this threshold are not calculated, i.e. set to zero
      *
      *  @return the Coulomb repulsion integrals expressed in the given AO basis
      */
-    TwoElectronOperator<double> calculateCoulombRepulsionIntegrals(const AOBasis& ao_basis) const;
+    TwoElectronOperator<double> calculateCoulombRepulsionIntegrals(const AOBasis& ao_basis, double schwarz_threshold = 1.0e-12) const;
+
+    /**
+     *  @param ao_basis     the AO basis used for the calculation of the Coulomb repulsion integrals
+     *
+     *  @return the Cauchy-Schwarz bounds of the Coulomb repulsion integrals for all shell pairs, i.e. the matrix with elements sqrt(max |(ab|ab)|) for the basis functions a, b in the shells
+     */
+    MatrixX<double> calculateCoulombRepulsionSchwarzBounds(const AOBasis& ao_basis) const;
+
+    /**
+     *  Calculate the two-electron part G = J - 1/2 K of the RHF Fock matrix directly from the Coulomb repulsion shell quartets, without storing the integrals
+     *
+     *  @param ao_basis                 the AO basis in which the density matrix is expressed
+     *  @param D_AO                     the (symmetric) density matrix in AO basis, or a difference of two of them
+     *  @param schwarz_bounds           the Cauchy-Schwarz bounds of the shell pairs, see calculateCoulombRepulsionSchwarzBounds()
+     *  @param screening_threshold      the shell quartets whose Cauchy-Schwarz bound, weighted with the largest density matrix element they are contracted with, is smaller than this threshold are not calculated
+     *
+     *  @return the two-electron part of the RHF Fock matrix expressed in the AO basis
+     */
+    SquareMatrix<double> calculateRHFTwoElectronFockMatrix(const AOBasis& ao_basis, const OneRDM<double>& D_AO, const MatrixX<double>& schwarz_bounds, double screening_threshold = 1.0e-12) const;
+
+    /**
+     *  @param auxiliary_basis      the auxiliary basis used for the calculation of the two-center Coulomb repulsion integrals
+     *
+     *  @return the Coulomb metric (P|Q) of the auxiliary basis
+     */
+    SquareMatrix<double> calculateCoulombMetric(const AOBasis& auxiliary_basis) const;
+
+    /**
+     *  @param ao_basis             the AO basis used for the calculation of the three-center Coulomb repulsion integrals
+     *  @param auxiliary_basis      the auxiliary basis used for the calculation of the three-center Coulomb repulsion integrals
+     *
+     *  @return the three-center Coulomb repulsion integrals (mu nu|P) as a (K^2 x N_aux)-matrix, in which the element (mu + K nu, P) is (mu nu|P)
+     */
+    MatrixX<double> calculateThreeCenterCoulombRepulsionIntegrals(const AOBasis& ao_basis, const AOBasis& auxiliary_basis) const;
+
+    /**
+     *  @param ao_basis             the AO basis used for the calculation of the Coulomb repulsion integrals
+     *  @param auxiliary_basis      the auxiliary basis used for the density fitting
+     *
+     *  @return the density-fitted Coulomb repulsion integrals expressed in the given AO basis
+     */
+    FactorizedTwoElectronOperator<double> calculateDensityFittedCoulombRepulsionIntegrals(const AOBasis& ao_basis, const AOBasis& auxiliary_basis) const;
+
+    /**
+     *  @param ao_basis             the AO basis used for the calculation of the Coulomb repulsion integrals
+     *
+     *  @return the diagonal (mu nu|mu nu) of the Coulomb repulsion integrals, in which the element mu + K nu is (mu nu|mu nu)
+     */
+    VectorX<double> calculateCoulombRepulsionIntegralsDiagonal(const AOBasis& ao_basis) const;
+
+    /**
+     *  @param ao_basis             the AO basis used for the calculation of the Coulomb repulsion integrals
+     *  @param sh3                  the index of the first shell of the ket shell pair
+     *  @param sh4                  the index of the second shell of the ket shell pair
+     *
+     *  @return the Coulomb repulsion integrals (mu nu|rho lambda) for all rho in sh3 and lambda in sh4 as a (K^2 x nbf_sh3 nbf_sh4)-matrix, in which the element (mu + K nu, f3 + nbf_sh3 f4) is (mu nu|rho lambda) with rho the f3-th basis function in sh3 and lambda the f4-th basis function in sh4
+     */
+    MatrixX<double> calculateCoulombRepulsionIntegralsColumns(const AOBasis& ao_basis, size_t sh3, size_t sh4) const;
+
+    /**
+     *  @param ao_basis             the AO basis used for the calculation of the Coulomb repulsion integrals
+     *  @param threshold            the decomposition stops when the largest remaining diagonal element is smaller than this threshold
+     *
+     *  @return the pivoted incomplete Cholesky decomposition of the Coulomb repulsion integrals expressed in the given AO basis, which is calculated from the diagonal and the pivot columns only
+     */
+    FactorizedTwoElectronOperator<double> calculateCholeskyDecomposedCoulombRepulsionIntegrals(const AOBasis& ao_basis, double threshold = 1.0e-06) const;
 
 
 };
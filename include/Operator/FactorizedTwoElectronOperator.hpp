@@ -0,0 +1,299 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef GQCP_FACTORIZEDTWOELECTRONOPERATOR_HPP
+#define GQCP_FACTORIZEDTWOELECTRONOPERATOR_HPP
+
+
+#include "JacobiRotationParameters.hpp"
+#include "math/SquareMatrix.hpp"
+#include "Operator/Operator.hpp"
+#include "Operator/TwoElectronOperator.hpp"
+#include "utilities/parallel.hpp"
+
+#include <Eigen/Cholesky>
+
+
+namespace GQCP {
+
+
+/**
+ *  A class that represents a two-electron operator in an orbital basis through a factorization of its matrix representation
+ *      g(p q r s) = sum_m L_m(p q) L_m(r s)
+ *  in which the number of vectors L_m is called the rank of the factorization
+ *
+ *  Density fitting and Cholesky decompositions of the two-electron integrals lead to such a factorization: only K^2 M instead of K^4 elements are stored, and a basis transformation costs O(K^3 M) instead of O(K^5)
+ *
+ *  @tparam _Scalar     the scalar type
+ */
+template <typename _Scalar>
+class FactorizedTwoElectronOperator : public Operator<FactorizedTwoElectronOperator<_Scalar>> {
+public:
+
+    using Scalar = _Scalar;
+
+
+private:
+
+    size_t K;  // the dimension of the orbital basis
+    MatrixX<Scalar> L;  // the (K^2 x M)-matrix whose columns are the column-major vectorized (K x K)-matrices L_m
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param K        the dimension of the orbital basis
+     *  @param L        the (K^2 x M)-matrix whose columns are the column-major vectorized (K x K)-matrices L_m
+     */
+    FactorizedTwoElectronOperator(size_t K, const MatrixX<Scalar>& L) :
+        K (K),
+        L (L)
+    {
+        if (static_cast<size_t>(L.rows()) != K * K) {
+            throw std::invalid_argument("FactorizedTwoElectronOperator::FactorizedTwoElectronOperator(size_t, MatrixX<Scalar>): The number of rows of the vectors should be K^2.");
+        }
+    }
+
+
+    /**
+     *  Default constructor: a factorization of rank 0
+     *
+     *  @param K        the dimension of the orbital basis
+     */
+    explicit FactorizedTwoElectronOperator(size_t K = 0) :
+        FactorizedTwoElectronOperator(K, MatrixX<Scalar>::Zero(K * K, 0))
+    {}
+
+
+
+    /*
+     *  NAMED CONSTRUCTORS
+     */
+
+    /**
+     *  Construct the density-fitted (resolution-of-the-identity) approximation
+     *      (mu nu|rho lambda) = sum_PQ (mu nu|P) (P|Q)^(-1) (Q|rho lambda)
+     *  by factorizing the Coulomb metric (P|Q) = C C^T through a Cholesky decomposition, which leads to the vectors L = (mu nu|P) C^(-T)
+     *
+     *  @param three_index_integrals        the three-index integrals (mu nu|P) as a (K^2 x N_aux)-matrix, whose columns are the column-major vectorized (K x K)-matrices
+     *  @param metric                       the two-index integrals (P|Q) of the auxiliary basis
+     *
+     *  @return the density-fitted two-electron operator
+     */
+    static FactorizedTwoElectronOperator<Scalar> DensityFitted(const MatrixX<Scalar>& three_index_integrals, const SquareMatrix<Scalar>& metric) {
+
+        if (three_index_integrals.cols() != metric.cols()) {
+            throw std::invalid_argument("FactorizedTwoElectronOperator::DensityFitted(MatrixX<Scalar>, SquareMatrix<Scalar>): The dimensions of the three-index integrals and the metric are incompatible.");
+        }
+
+        const auto K = static_cast<size_t>(std::round(std::sqrt(three_index_integrals.rows())));
+        if (K * K != static_cast<size_t>(three_index_integrals.rows())) {
+            throw std::invalid_argument("FactorizedTwoElectronOperator::DensityFitted(MatrixX<Scalar>, SquareMatrix<Scalar>): The number of rows of the three-index integrals should be a square.");
+        }
+
+        Eigen::LLT<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> llt (metric);
+        if (llt.info() != Eigen::Success) {
+            throw std::runtime_error("FactorizedTwoElectronOperator::DensityFitted(MatrixX<Scalar>, SquareMatrix<Scalar>): The Coulomb metric of the auxiliary basis is not positive definite.");
+        }
+
+        // L^T = C^(-1) (P|mu nu) is found by forward substitution, instead of explicitly inverting the metric
+        MatrixX<Scalar> L_transpose = llt.matrixL().solve(three_index_integrals.transpose());
+        return FactorizedTwoElectronOperator<Scalar>(K, L_transpose.transpose());
+    }
+
+
+    /**
+     *  Construct the pivoted incomplete Cholesky decomposition of the two-electron operator, seen as the positive semi-definite (K^2 x K^2)-matrix V(pq, rs) = g(p q r s)
+     *
+     *  Every step chooses the largest remaining diagonal element as pivot, so that only the diagonal and the pivot columns of V are ever needed. Since every element of the residual V - L L^T is bounded by its largest diagonal element, all elements of the decomposition are accurate to within the threshold
+     *
+     *  @tparam ColumnFunction      the type of a callable that returns the column V(:, pq) as a VectorX<Scalar>, given the compound index pq = p + K q
+     *
+     *  @param diagonal             the diagonal V(pq, pq) = g(p q p q)
+     *  @param column               the callable that calculates a column of V
+     *  @param threshold            the decomposition stops when the largest remaining diagonal element is smaller than this threshold
+     *
+     *  @return the Cholesky-decomposed two-electron operator
+     */
+    template <typename ColumnFunction>
+    static FactorizedTwoElectronOperator<Scalar> Cholesky(const VectorX<Scalar>& diagonal, const ColumnFunction& column, double threshold = 1.0e-06) {
+
+        const auto K = static_cast<size_t>(std::round(std::sqrt(diagonal.size())));
+        if (K * K != static_cast<size_t>(diagonal.size())) {
+            throw std::invalid_argument("FactorizedTwoElectronOperator::Cholesky(VectorX<Scalar>, ColumnFunction, double): The dimension of the diagonal should be a square.");
+        }
+        const size_t dim = K * K;
+
+
+        // The vectors are stored in a matrix whose capacity is doubled whenever it runs out, starting from the typical rank of a few times K
+        MatrixX<Scalar> L = MatrixX<Scalar>::Zero(dim, std::min(dim, 4 * K));
+        VectorX<Scalar> d = diagonal;  // the diagonal of the residual V - L L^T
+
+        size_t M = 0;  // the current rank
+        while (M < dim) {
+            Eigen::Index pivot;
+            const Scalar d_max = d.maxCoeff(&pivot);
+            if (d_max < threshold) {
+                break;
+            }
+
+            if (M == static_cast<size_t>(L.cols())) {
+                L.conservativeResize(Eigen::NoChange, std::min(dim, 2 * M));
+            }
+
+            // The next vector is the pivot column of the residual, normalized by the square root of its pivot element
+            VectorX<Scalar> L_M = column(static_cast<size_t>(pivot));
+            L_M.noalias() -= L.leftCols(M) * L.row(pivot).head(M).transpose();
+            L_M /= std::sqrt(d_max);
+
+            d -= L_M.cwiseAbs2();
+            d(pivot) = 0.0;  // remove the round-off, so that the pivot is never chosen again
+
+            L.col(M) = L_M;
+            M++;
+        }
+
+        return FactorizedTwoElectronOperator<Scalar>(K, L.leftCols(M));
+    }
+
+
+    /**
+     *  Construct the pivoted incomplete Cholesky decomposition of a dense two-electron operator
+     *
+     *  @param g                    the two-electron operator that should be decomposed
+     *  @param threshold            the decomposition stops when the largest remaining diagonal element is smaller than this threshold
+     *
+     *  @return the Cholesky-decomposed two-electron operator
+     */
+    static FactorizedTwoElectronOperator<Scalar> Cholesky(const TwoElectronOperator<Scalar>& g, double threshold = 1.0e-06) {
+
+        // g(p q r s) is stored at (p + K q) + K^2 (r + K s), which is the (pq, rs)-element of the column-major (K^2 x K^2)-matrix V
+        const auto dim = static_cast<long>(g.get_dim() * g.get_dim());
+        Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> V (g.data(), dim, dim);
+
+        const VectorX<Scalar> diagonal = V.diagonal();
+        return FactorizedTwoElectronOperator<Scalar>::Cholesky(diagonal, [&V] (size_t pq) { return VectorX<Scalar>(V.col(pq)); }, threshold);
+    }
+
+
+
+    /*
+     *  GETTERS
+     */
+
+    size_t get_dim() const { return this->K; }
+    size_t get_rank() const { return static_cast<size_t>(this->L.cols()); }
+    const MatrixX<Scalar>& get_vectors() const { return this->L; }
+
+
+
+    /*
+     *  OPERATORS
+     */
+
+    /**
+     *  @return the element g(p q r s) of the matrix representation
+     *
+     *  Note that the vectors are stored contiguously (as columns), which the transformations and the Fock matrix contractions rely on: every element is therefore a strided dot product of length M, and toTwoElectronOperator() should be preferred when many elements are needed
+     */
+    Scalar operator()(size_t p, size_t q, size_t r, size_t s) const {
+        return this->L.row(p + this->K * q).dot(this->L.row(r + this->K * s));
+    }
+
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  @param m        the index of the vector
+     *
+     *  @return the m-th vector L_m as a (K x K)-matrix
+     */
+    SquareMatrix<Scalar> vector(size_t m) const {
+        return SquareMatrix<Scalar>(Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>(this->L.col(m).data(), this->K, this->K));
+    }
+
+    /**
+     *  @return the full (dense) representation of the two-electron operator
+     */
+    TwoElectronOperator<Scalar> toTwoElectronOperator() const {
+
+        TwoElectronOperator<Scalar> g (this->K);
+
+        // g(p q r s) is stored at (p + K q) + K^2 (r + K s), which is the (pq, rs)-element of the column-major (K^2 x K^2)-matrix L L^T
+        Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> g_matrix (g.data(), this->K * this->K, this->K * this->K);
+        g_matrix.noalias() = this->L * this->L.transpose();
+
+        return g;
+    }
+
+    /**
+     *  In-place transform the matrix representation of the two-electron operator, i.e. transform every vector L_m' = T^dagger L_m T
+     *
+     *  @param T                    the transformation matrix between the old and the new orbital basis, it is used as
+     *      b' = b T ,
+     *   in which the basis functions are collected as elements of a row vector b
+     *  @param number_of_threads    the number of threads that should be used
+     */
+    void transform(const SquareMatrix<Scalar>& T, size_t number_of_threads = getNumberOfThreads()) {
+
+        if (T.get_dim() != this->K) {
+            throw std::invalid_argument("FactorizedTwoElectronOperator::transform(SquareMatrix<Scalar>, size_t): The dimension of the transformation matrix is incompatible.");
+        }
+
+        const size_t K = this->K;
+        const SquareMatrix<Scalar> T_adjoint = T.adjoint();
+
+        // Every thread transforms its own range of vectors, with two matrix-matrix products for every vector
+        parallelFor(0, this->get_rank(), [this, K, &T, &T_adjoint] (size_t begin, size_t end) {
+            SquareMatrix<Scalar> L_m (K);
+            for (size_t m = begin; m < end; m++) {
+                Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> L_m_map (this->L.col(m).data(), K, K);
+                L_m.noalias() = T_adjoint * L_m_map;
+                L_m_map.noalias() = L_m * T;
+            }
+        }, number_of_threads);
+    }
+
+
+    using Operator<FactorizedTwoElectronOperator<Scalar>>::rotate;  // bring over rotate() from the base class
+
+
+    /**
+     *  In-place rotate the matrix representation of the two-electron operator using a unitary Jacobi rotation matrix constructed from the Jacobi rotation parameters. Note that this function is only available for real (double) matrix representations
+     *
+     *  @param jacobi_rotation_parameters       the Jacobi rotation parameters (p, q, angle) that are used to specify a Jacobi rotation: we use the (cos, sin, -sin, cos) definition for the Jacobi rotation matrix. See transform() for how the transformation matrix between the two bases should be represented
+     */
+    template<typename Z = Scalar>
+    enable_if_t<std::is_same<Z, double>::value> rotate(const JacobiRotationParameters& jacobi_rotation_parameters) {
+
+        auto J = SquareMatrix<double>::FromJacobi(jacobi_rotation_parameters, this->K);  // this is sure to return a unitary matrix
+        this->rotate(J);
+    }
+};
+
+
+}  // namespace GQCP
+
+
+#endif  // GQCP_FACTORIZEDTWOELECTRONOPERATOR_HPP
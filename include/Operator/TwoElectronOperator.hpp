@@ -23,6 +23,7 @@
 #include "math/SquareRankFourTensor.hpp"
 #include "Operator/Operator.hpp"
 #include "utilities/miscellaneous.hpp"
+#include "utilities/parallel.hpp"
 
 
 namespace GQCP {
@@ -58,7 +59,7 @@ public:
      */
 
     /**
-     *  In-place transform the matrix representation of the two-electron operator
+     *  In-place transform the matrix representation of the two-electron operator, for transformation matrices whose scalar type differs from the scalar type of the two-electron operator
      *
      *  @tparam TransformationScalar        the type of scalar used for the transformation matrix
 
@@ -106,6 +107,80 @@ public:
     }
 
 
+    /**
+     *  In-place transform the matrix representation of the two-electron operator
+     *
+     *  @param T                    the transformation matrix between the old and the new orbital basis, it is used as
+     *      b' = b T ,
+     *   in which the basis functions are collected as elements of a row vector b
+     *  @param number_of_threads    the number of threads that should be used
+     *
+     *  The elements g(p q r s) are stored at (p + K q) + K^2 (r + K s), i.e. as the column-major (K^2 x K^2)-matrix V(pq, rs). The four quarter-transformations are done in place as two half-transformations, each consisting of two matrix-matrix products:
+     *      - the ket indices are transformed for blocks of rows of V, which are copied into a bounded workspace for every thread
+     *      - the bra indices are transformed for every column of V, which is a contiguous (K x K)-matrix A_rs that becomes T^dagger A_rs T
+     *  Apart from a workspace for every thread, no copies of the two-electron operator are made
+     */
+    void transform(const SquareMatrix<Scalar>& T, size_t number_of_threads = getNumberOfThreads()) {
+
+        const auto K = static_cast<size_t>(this->dimension(0));  // .dimension() returns a long
+        if (T.get_dim() != K) {
+            throw std::invalid_argument("TwoElectronOperator::transform(SquareMatrix<Scalar>, size_t): The dimension of the transformation matrix is incompatible.");
+        }
+
+        const size_t dim = K * K;
+        if (dim == 0) {
+            return;
+        }
+
+        Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> V (this->data(), dim, dim);
+
+        const SquareMatrix<Scalar> T_adjoint = T.adjoint();
+        const SquareMatrix<Scalar> T_conjugate = T.conjugate();
+
+
+        // Transform the ket indices: g(p q r' s') = sum_rs g(p q r s) T^*(r r') T(s s')
+        // The rows are handed out in blocks of at most 2^20 elements, and every row block W(x, r + K s) is viewed as the (nb K x K)-matrix with elements (x + nb r, s)
+        const size_t block_size = std::max<size_t>(1, std::min<size_t>(dim, (1 << 20) / dim));  // the number of rows in a block
+        const size_t number_of_blocks = (dim + block_size - 1) / block_size;
+
+        parallelFor(0, number_of_blocks, [&] (size_t blocks_begin, size_t blocks_end) {
+            // The workspaces are used contiguously for every block, so that a partial last block has leading dimension nb instead of block_size
+            VectorX<Scalar> W_workspace (block_size * dim);  // the current block of rows
+            VectorX<Scalar> X (block_size * dim);  // the block after transforming the index s
+
+            for (size_t block = blocks_begin; block < blocks_end; block++) {
+                const size_t row_begin = block * block_size;
+                const size_t nb = std::min(block_size, dim - row_begin);  // the number of rows in this block
+
+                Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> W (W_workspace.data(), nb, dim);
+                W = V.middleRows(row_begin, nb);
+
+                Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> W_map (W_workspace.data(), nb * K, K);
+                Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> X_map (X.data(), nb * K, K);
+                X_map.noalias() = W_map * T;
+
+                // For every s', the (nb x K)-matrix with elements (x, r) is contiguous in X
+                for (size_t s = 0; s < K; s++) {
+                    Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> X_s (X.data() + s * nb * K, nb, K);
+                    V.block(row_begin, s * K, nb, K).noalias() = X_s * T_conjugate;
+                }
+            }
+        }, number_of_threads);
+
+
+        // Transform the bra indices: g(p' q' r s) = sum_pq T^*(p p') g(p q r s) T(q q')
+        parallelFor(0, dim, [&] (size_t rs_begin, size_t rs_end) {
+            Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> TA (K, K);
+
+            for (size_t rs = rs_begin; rs < rs_end; rs++) {
+                Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> A (this->data() + rs * dim, K, K);
+                TA.noalias() = T_adjoint * A;
+                A.noalias() = TA * T;
+            }
+        }, number_of_threads);
+    }
+
+
     using Operator<TwoElectronOperator<Scalar>>::rotate;  // bring over rotate() from the base class
 
 
@@ -22,6 +22,7 @@
 #include "FockSpace/FockSpace.hpp"
 #include "RDM/BaseRDMBuilder.hpp"
 #include "RDM/RDMs.hpp"
+#include "RDM/SeniorityZeroTwoRDM.hpp"
 
 
 namespace GQCP {
@@ -72,6 +73,17 @@ public:
      *      calculateElement({0, 1}, {2, 1}) would calculate d^{(2)} (0, 1, 1, 2): the operator string would be a^\dagger_0 a^\dagger_1 a_2 a_1
      */
     double calculateElement(const std::vector<size_t>& bra_indices, const std::vector<size_t>& ket_indices, const VectorX<double>& x) const override;
+
+
+    // PUBLIC METHODS
+    /**
+     *  @param x        the coefficient vector representing the DOCI wave function
+     *
+     *  @return the 2-RDM in the compact seniority-zero representation, i.e. only its number-number and pair blocks
+     *
+     *  Note that the calculation is divided over multiple threads (see getNumberOfThreads())
+     */
+    SeniorityZeroTwoRDM<double> calculateSeniorityZero2RDM(const VectorX<double>& x) const;
 };
 
 
@@ -0,0 +1,233 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef GQCP_SENIORITYZEROTWORDM_HPP
+#define GQCP_SENIORITYZEROTWORDM_HPP
+
+
+#include "math/SquareMatrix.hpp"
+#include "RDM/OneRDM.hpp"
+#include "RDM/TwoRDM.hpp"
+
+
+namespace GQCP {
+
+
+/**
+ *  A class that represents the 2-RDM of a seniority-zero wave function (e.g. DOCI), by storing only the two K x K blocks that are non-zero
+ *
+ *  In terms of the pair occupation numbers n_p (which are 0 or 1 for a seniority-zero ONV) and the pair annihilation operators P_q = b_q a_q, these blocks are
+ *      - the number-number block       N(p,q) = < n_p n_q >
+ *      - the pair block                Pi(p,q) = < P^\dagger_p P_q >
+ *  of which the diagonals coincide. The non-zero elements of the spin-summed 2-RDM d are then
+ *      d(p,p,q,q) = 4 N(p,q)   (p != q)
+ *      d(p,q,q,p) = -2 N(p,q)  (p != q)
+ *      d(p,q,p,q) = 2 Pi(p,q)  (p != q)
+ *      d(p,p,p,p) = 2 N(p,p)
+ *
+ *  @tparam _Scalar     the scalar type
+ */
+template <typename _Scalar>
+class SeniorityZeroTwoRDM {
+public:
+
+    using Scalar = _Scalar;
+
+
+private:
+    SquareMatrix<Scalar> number_block;  // N(p,q)
+    SquareMatrix<Scalar> pair_block;  // Pi(p,q)
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  @param number_block     the number-number block N(p,q)
+     *  @param pair_block       the pair block Pi(p,q)
+     */
+    SeniorityZeroTwoRDM(const SquareMatrix<Scalar>& number_block, const SquareMatrix<Scalar>& pair_block) :
+        number_block (number_block),
+        pair_block (pair_block)
+    {
+        if (number_block.get_dim() != pair_block.get_dim()) {
+            throw std::invalid_argument("SeniorityZeroTwoRDM::SeniorityZeroTwoRDM(SquareMatrix<Scalar>, SquareMatrix<Scalar>): The number-number block and the pair block have incompatible dimensions.");
+        }
+    }
+
+
+    /*
+     *  NAMED CONSTRUCTORS
+     */
+
+    /**
+     *  @param K        the number of spatial orbitals
+     *
+     *  @return a seniority-zero 2-RDM with random, symmetric blocks whose diagonals coincide, which is not necessarily N-representable
+     */
+    static SeniorityZeroTwoRDM<Scalar> Random(size_t K) {
+
+        SquareMatrix<Scalar> N = SquareMatrix<Scalar>::Random(K, K);
+        SquareMatrix<Scalar> Pi = SquareMatrix<Scalar>::Random(K, K);
+        N = (N + N.transpose()) / 2;
+        Pi = (Pi + Pi.transpose()) / 2;
+        Pi.diagonal() = N.diagonal();
+
+        return SeniorityZeroTwoRDM<Scalar>(N, Pi);
+    }
+
+
+    /*
+     *  GETTERS
+     */
+
+    size_t get_K() const { return this->number_block.get_dim(); }
+    const SquareMatrix<Scalar>& get_number_block() const { return this->number_block; }
+    const SquareMatrix<Scalar>& get_pair_block() const { return this->pair_block; }
+
+
+    /*
+     *  OPERATORS
+     */
+
+    /**
+     *  @return the element d(p,q,r,s) of the spin-summed 2-RDM
+     */
+    Scalar operator()(size_t p, size_t q, size_t r, size_t s) const {
+
+        if ((p == q) && (r == s)) {
+            return (p == r) ? 2 * this->number_block(p,p) : 4 * this->number_block(p,r);
+        }
+
+        else if ((p == s) && (q == r)) {  // p != q
+            return -2 * this->number_block(p,q);
+        }
+
+        else if ((p == r) && (q == s)) {  // p != q
+            return 2 * this->pair_block(p,q);
+        }
+
+        return 0.0;
+    }
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  @return the trace of the spin-summed 2-RDM, i.e. d(p,p,q,q)
+     */
+    Scalar trace() const {
+        return 4 * this->number_block.sum() - 2 * this->number_block.trace();
+    }
+
+
+    /**
+     *  @return a partial contraction of the spin-summed 2-RDM, where D(p,q) = d(p,q,r,r)
+     */
+    OneRDM<Scalar> reduce() const {
+
+        auto K = this->get_K();
+
+        OneRDM<Scalar> D = OneRDM<Scalar>::Zero(K, K);
+        for (size_t p = 0; p < K; p++) {
+            D(p,p) = 4 * this->number_block.row(p).sum() - 2 * this->number_block(p,p);
+        }
+
+        return D;
+    }
+
+
+    /**
+     *  @return the full spin-summed 2-RDM
+     */
+    TwoRDM<Scalar> expand() const {
+
+        auto K = this->get_K();
+
+        TwoRDM<Scalar> d (K);
+        d.setZero();
+        for (size_t p = 0; p < K; p++) {
+            d(p,p,p,p) = 2 * this->number_block(p,p);
+
+            for (size_t q = 0; q < K; q++) {
+                if (p != q) {
+                    d(p,p,q,q) = 4 * this->number_block(p,q);
+                    d(p,q,q,p) = -2 * this->number_block(p,q);
+                    d(p,q,p,q) = 2 * this->pair_block(p,q);
+                }
+            }
+        }
+
+        return d;
+    }
+
+
+    /**
+     *  @return the full alpha-alpha-alpha-alpha 2-RDM, which is equal to the beta-beta-beta-beta 2-RDM
+     */
+    TwoRDM<Scalar> expandSameSpin() const {
+
+        auto K = this->get_K();
+
+        TwoRDM<Scalar> d_aaaa (K);
+        d_aaaa.setZero();
+        for (size_t p = 0; p < K; p++) {
+            for (size_t q = 0; q < K; q++) {
+                if (p != q) {
+                    d_aaaa(p,p,q,q) = this->number_block(p,q);
+                    d_aaaa(p,q,q,p) = -this->number_block(p,q);
+                }
+            }
+        }
+
+        return d_aaaa;
+    }
+
+
+    /**
+     *  @return the full alpha-alpha-beta-beta 2-RDM, which is equal to the beta-beta-alpha-alpha 2-RDM
+     */
+    TwoRDM<Scalar> expandOppositeSpin() const {
+
+        auto K = this->get_K();
+
+        TwoRDM<Scalar> d_aabb (K);
+        d_aabb.setZero();
+        for (size_t p = 0; p < K; p++) {
+            for (size_t q = 0; q < K; q++) {
+                d_aabb(p,p,q,q) = this->number_block(p,q);
+
+                if (p != q) {
+                    d_aabb(p,q,p,q) = this->pair_block(p,q);
+                }
+            }
+        }
+
+        return d_aabb;
+    }
+};
+
+
+}  // namespace GQCP
+
+
+#endif  // GQCP_SENIORITYZEROTWORDM_HPP
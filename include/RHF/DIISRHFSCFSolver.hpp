@@ -32,6 +32,8 @@ namespace GQCP {
 
 class DIISRHFSCFSolver : public RHFSCFSolver {
 private:
+    HamiltonianParameters<double> ham_par;  // Hamiltonian parameters expressed in an AO basis
+
     size_t minimum_subspace_dimension;  // the minimum number of Fock matrices that have to be in the subspace before enabling DIIS
     size_t maximum_subspace_dimension;  // the maximum DIIS subspace dimension before the oldest Fock matrices get discarded (one at a time)
 
@@ -0,0 +1,85 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef DirectRHFSCFSolver_hpp
+#define DirectRHFSCFSolver_hpp
+
+
+#include "RHFSCFSolver.hpp"
+
+#include <memory>
+
+
+namespace GQCP {
+
+
+/**
+ *  A class that implements an integral-direct plain RHF SCF algorithm: instead of storing the two-electron integrals, the screened shell quartets are recalculated in every iteration and contracted directly with the density matrix
+ *
+ *  The two-electron part of the Fock matrix is updated incrementally from the change in the density matrix, whose decreasing elements allow the density-weighted Cauchy-Schwarz screening to skip more and more shell quartets as the SCF procedure converges
+ */
+class DirectRHFSCFSolver : public RHFSCFSolver {
+private:
+    std::shared_ptr<AOBasis> ao_basis;
+    MatrixX<double> schwarz_bounds;  // the Cauchy-Schwarz bounds of the Coulomb repulsion integrals for all shell pairs
+
+    double screening_threshold;  // the shell quartets whose density-weighted Cauchy-Schwarz bound is smaller than this threshold are skipped
+    size_t full_rebuild_interval;  // the number of Fock builds after which the two-electron part is rebuilt from the full density matrix, to prevent the accumulation of screening errors
+
+    size_t number_of_fock_builds = 0;
+    OneRDM<double> D_AO_previous;  // the density matrix of the previous Fock build
+    SquareMatrix<double> G;  // the two-electron part of the previous Fock matrix
+
+
+    // PRIVATE METHODS
+    /**
+     *  Update the Fock matrix, i.e. calculate the Fock matrix to be used in the next iteration of the SCF procedure: the 'new' Fock matrix is just F = H_core + G, in which G is updated with the contribution of the change in the density matrix
+     *
+     *  @param D_AO     the RHF density matrix in AO basis
+     *
+     *  @return the new Fock matrix (expressed in AO basis)
+     */
+    OneElectronOperator<double> calculateNewFockMatrix(const OneRDM<double>& D_AO) override;
+
+public:
+    // CONSTRUCTORS
+    /**
+     *  @param ao_basis                         the AO basis in which the SCF equations are solved
+     *  @param molecule                         the molecule used for the SCF calculation
+     *  @param screening_threshold              the shell quartets whose density-weighted Cauchy-Schwarz bound is smaller than this threshold are skipped
+     *  @param full_rebuild_interval            the number of Fock builds after which the two-electron part is rebuilt from the full density matrix
+     *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+     *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+     */
+    DirectRHFSCFSolver(std::shared_ptr<AOBasis> ao_basis, const Molecule& molecule, double screening_threshold=1.0e-12, size_t full_rebuild_interval=8, double threshold=1.0e-08, size_t maximum_number_of_iterations=128);
+
+    /**
+     *  @param molecule                         the molecule used for the SCF calculation
+     *  @param basisset                         the name of the basisset corresponding to the AO basis
+     *  @param screening_threshold              the shell quartets whose density-weighted Cauchy-Schwarz bound is smaller than this threshold are skipped
+     *  @param full_rebuild_interval            the number of Fock builds after which the two-electron part is rebuilt from the full density matrix
+     *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+     *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+     */
+    DirectRHFSCFSolver(const Molecule& molecule, const std::string& basisset, double screening_threshold=1.0e-12, size_t full_rebuild_interval=8, double threshold=1.0e-08, size_t maximum_number_of_iterations=128);
+};
+
+
+}  // namespace GQCP
+
+
+#endif /* DirectRHFSCFSolver_hpp */
@@ -0,0 +1,92 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef FactorizedRHFSCFSolver_hpp
+#define FactorizedRHFSCFSolver_hpp
+
+
+#include "RHFSCFSolver.hpp"
+#include "Operator/FactorizedTwoElectronOperator.hpp"
+
+
+namespace GQCP {
+
+
+/**
+ *  A class that implements a plain RHF SCF algorithm with factorized (density-fitted or Cholesky-decomposed) two-electron integrals: the two-electron part of the Fock matrix is built with the RI-J/K contractions of the vectors L_m, without ever forming the K^4 integrals
+ */
+class FactorizedRHFSCFSolver : public RHFSCFSolver {
+private:
+    FactorizedTwoElectronOperator<double> g_AO;  // the factorized two-electron integrals in AO basis
+
+
+    // PRIVATE METHODS
+    /**
+     *  Update the Fock matrix, i.e. calculate the Fock matrix to be used in the next iteration of the SCF procedure: the 'new' Fock matrix is just F = H_core + G, in which G is built from the factorized two-electron integrals
+     *
+     *  @param D_AO     the RHF density matrix in AO basis
+     *
+     *  @return the new Fock matrix (expressed in AO basis)
+     */
+    OneElectronOperator<double> calculateNewFockMatrix(const OneRDM<double>& D_AO) override;
+
+public:
+    // CONSTRUCTORS
+    /**
+     *  @param S                                the overlap matrix in AO basis
+     *  @param H_core                           the core Hamiltonian in AO basis
+     *  @param g_AO                             the factorized two-electron integrals in AO basis
+     *  @param molecule                         the molecule used for the SCF calculation
+     *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+     *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+     */
+    FactorizedRHFSCFSolver(const OneElectronOperator<double>& S, const OneElectronOperator<double>& H_core, const FactorizedTwoElectronOperator<double>& g_AO, const Molecule& molecule, double threshold=1.0e-08, size_t maximum_number_of_iterations=128);
+
+
+    // NAMED CONSTRUCTORS
+    /**
+     *  @param molecule                         the molecule used for the SCF calculation
+     *  @param basisset                         the name of the basisset corresponding to the AO basis
+     *  @param auxiliary_basisset               the name of the basisset corresponding to the auxiliary basis used for density fitting
+     *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+     *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+     *
+     *  @return an RHF SCF solver that uses the density-fitted two-electron integrals
+     */
+    static FactorizedRHFSCFSolver DensityFitted(const Molecule& molecule, const std::string& basisset, const std::string& auxiliary_basisset, double threshold=1.0e-08, size_t maximum_number_of_iterations=128);
+
+    /**
+     *  @param molecule                         the molecule used for the SCF calculation
+     *  @param basisset                         the name of the basisset corresponding to the AO basis
+     *  @param cholesky_threshold               the threshold for the pivoted incomplete Cholesky decomposition of the two-electron integrals
+     *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+     *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+     *
+     *  @return an RHF SCF solver that uses the Cholesky-decomposed two-electron integrals
+     */
+    static FactorizedRHFSCFSolver Cholesky(const Molecule& molecule, const std::string& basisset, double cholesky_threshold=1.0e-06, double threshold=1.0e-08, size_t maximum_number_of_iterations=128);
+
+
+    // GETTERS
+    const FactorizedTwoElectronOperator<double>& get_g_AO() const { return this->g_AO; }
+};
+
+
+}  // namespace GQCP
+
+
+#endif /* FactorizedRHFSCFSolver_hpp */
@@ -30,6 +30,9 @@ namespace GQCP {
  */
 class PlainRHFSCFSolver : public RHFSCFSolver {
 private:
+    HamiltonianParameters<double> ham_par;  // Hamiltonian parameters expressed in an AO basis
+
+
     /**
      *  Update the Fock matrix, i.e. calculate the Fock matrix to be used in the next iteration of the SCF procedure: the 'new' Fock matrix is just F = H_core + G
      *
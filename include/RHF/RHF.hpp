@@ -20,7 +20,9 @@
 
 
 #include "HamiltonianParameters/HamiltonianParameters.hpp"
+#include "Operator/FactorizedTwoElectronOperator.hpp"
 #include "RDM/OneRDM.hpp"
+#include "utilities/parallel.hpp"
 
 
 namespace GQCP {
@@ -80,6 +82,32 @@ OneRDM<double> calculateRHF1RDM(size_t K, size_t N);
  */
 OneRDM<double> calculateRHFAO1RDM(const SquareMatrix<double>& C, size_t N);
 
+/**
+ *  Calculate the two-electron part G = J - 1/2 K of the RHF Fock matrix, in which
+ *      J(mu nu) = (mu nu|rho lambda) D(lambda rho)
+ *      K(mu lambda) = (mu nu|rho lambda) D(nu rho)
+ *
+ *  @param D_AO                 the RHF density matrix in AO basis
+ *  @param g_AO                 the two-electron integrals in AO basis
+ *  @param number_of_threads    the number of threads that should be used
+ *
+ *  @return the two-electron part of the RHF Fock matrix expressed in the AO basis
+ */
+SquareMatrix<double> calculateRHFAOTwoElectronFockMatrix(const OneRDM<double>& D_AO, const TwoElectronOperator<double>& g_AO, size_t number_of_threads = getNumberOfThreads());
+
+/**
+ *  Calculate the two-electron part G = J - 1/2 K of the RHF Fock matrix from a factorization of the two-electron integrals (mu nu|rho lambda) = sum_m L_m(mu nu) L_m(rho lambda), i.e.
+ *      J = sum_m L_m tr(L_m D)
+ *      K = sum_m L_m D L_m
+ *
+ *  @param D_AO                 the RHF density matrix in AO basis
+ *  @param g_AO                 the factorized (e.g. density-fitted) two-electron integrals in AO basis
+ *  @param number_of_threads    the number of threads that should be used
+ *
+ *  @return the two-electron part of the RHF Fock matrix expressed in the AO basis
+ */
+SquareMatrix<double> calculateRHFAOTwoElectronFockMatrix(const OneRDM<double>& D_AO, const FactorizedTwoElectronOperator<double>& g_AO, size_t number_of_threads = getNumberOfThreads());
+
 /**
  *  Calculate the RHF Fock matrix F = H_core + G, in which G is a contraction of the density matrix and the two-electron integrals
  *
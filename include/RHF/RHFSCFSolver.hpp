@@ -38,7 +38,8 @@ protected:
     double threshold;
     bool is_converged = false;
 
-    HamiltonianParameters<double> ham_par;  // Hamiltonian parameters expressed in an AO basis
+    OneElectronOperator<double> S;  // the overlap matrix in AO basis
+    OneElectronOperator<double> H_core;  // the core Hamiltonian in AO basis
     Molecule molecule;
 
     RHF solution;
@@ -64,6 +65,16 @@ public:
      */
     RHFSCFSolver(const HamiltonianParameters<double>& ham_par, const Molecule& molecule, double threshold=1.0e-08, size_t maximum_number_of_iterations=128);
 
+    /**
+     *  @param S                                the overlap matrix in AO basis
+     *  @param H_core                           the core Hamiltonian in AO basis
+     *  @param molecule                         the molecule used for the SCF calculation
+     *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+     *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+     */
+    RHFSCFSolver(const OneElectronOperator<double>& S, const OneElectronOperator<double>& H_core, const Molecule& molecule, double threshold=1.0e-08, size_t maximum_number_of_iterations=128);
+
+
     // GETTERS
     const RHF& get_solution() const { return this->solution; }
 
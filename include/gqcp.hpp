@@ -22,12 +22,14 @@
 #include "CISolver/CISolver.hpp"
 
 #include "FockSpace/BaseFockSpace.hpp"
+#include "FockSpace/BitString.hpp"
 #include "FockSpace/Configuration.hpp"
 #include "FockSpace/FockSpace.hpp"
 #include "FockSpace/FockSpaceType.hpp"
 #include "FockSpace/ONV.hpp"
 #include "FockSpace/ProductFockSpace.hpp"
 #include "FockSpace/SelectedFockSpace.hpp"
+#include "FockSpace/SingleExcitationList.hpp"
 
 #include "geminals/AP1roG.hpp"
 #include "geminals/AP1roGBivariationalSolver.hpp"
@@ -45,15 +47,19 @@
 #include "HamiltonianBuilder/FCI.hpp"
 #include "HamiltonianBuilder/HamiltonianBuilder.hpp"
 #include "HamiltonianBuilder/Hubbard.hpp"
+#include "HamiltonianBuilder/PreparedFCI.hpp"
 
 #include "HamiltonianParameters/BaseHamiltonianParameters.hpp"
+#include "HamiltonianParameters/FCIDUMP.hpp"
 #include "HamiltonianParameters/HamiltonianParameters.hpp"
+#include "HamiltonianParameters/PairIntegrals.hpp"
 
 #include "Localization/BaseERLocalizer.hpp"
 #include "Localization/ERJacobiLocalizer.hpp"
 #include "Localization/ERNewtonLocalizer.hpp"
 
 #include "Operator/BaseOperator.hpp"
+#include "Operator/FactorizedTwoElectronOperator.hpp"
 #include "Operator/OneElectronOperator.hpp"
 #include "Operator/TwoElectronOperator.hpp"
 
@@ -74,6 +80,7 @@
 #include "math/ScalarFunction.hpp"
 #include "math/SquareMatrix.hpp"
 #include "math/SquareRankFourTensor.hpp"
+#include "math/SymmetricSparseMatrix.hpp"
 #include "math/Tensor.hpp"
 
 #include "properties/expectation_values.hpp"
@@ -88,16 +95,21 @@
 #include "RDM/RDMCalculator.hpp"
 #include "RDM/RDMs.hpp"
 #include "RDM/SelectedRDMBuilder.hpp"
+#include "RDM/SeniorityZeroTwoRDM.hpp"
 #include "RDM/SpinUnresolvedFCIRDMBuilder.hpp"
 #include "RDM/SpinUnresolvedRDMCalculator.hpp"
 
 #include "RHF/DIISRHFSCFSolver.hpp"
+#include "RHF/DirectRHFSCFSolver.hpp"
+#include "RHF/FactorizedRHFSCFSolver.hpp"
 #include "RHF/PlainRHFSCFSolver.hpp"
 #include "RHF/RHF.hpp"
 #include "RHF/RHFSCFSolver.hpp"
 
 #include "utilities/linalg.hpp"
+#include "utilities/MappedFile.hpp"
 #include "utilities/miscellaneous.hpp"
+#include "utilities/parallel.hpp"
 
 #include "WaveFunction/SpinUnresolvedWaveFunction.hpp"
 #include "WaveFunction/WaveFunction.hpp"
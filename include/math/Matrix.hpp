@@ -240,6 +240,7 @@ using VectorXs = VectorX<size_t>;
 
 using VectorFunction = std::function<VectorX<double> (const VectorX<double>&)>;
 using MatrixFunction = std::function<MatrixX<double> (const VectorX<double>&)>;
+using BlockVectorFunction = std::function<MatrixX<double> (const MatrixX<double>&)>;  // acts on every column of the given matrix at once
 
 
 }  // namespace GQCP
@@ -0,0 +1,351 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef GQCP_SYMMETRICSPARSEMATRIX_HPP
+#define GQCP_SYMMETRICSPARSEMATRIX_HPP
+
+
+#include "math/Matrix.hpp"
+#include "utilities/parallel.hpp"
+
+#include <Eigen/Sparse>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  A symmetric sparse matrix of which only the upper triangle (including the diagonal) is stored, in a compressed sparse row (CSR) format
+ *
+ *  In a matrix-vector product, every stored element (i,j) contributes to both y(i) and y(j). The rows are divided over threads that each scatter the contributions of the mirrored elements into their own accumulator, which are summed afterwards, so no two threads write to the same element
+ *
+ *  @tparam _Scalar      the scalar type
+ */
+template <typename _Scalar>
+class SymmetricSparseMatrix {
+public:
+
+    using Scalar = _Scalar;
+
+
+private:
+
+    size_t dim;  // the dimension of the matrix
+
+    Vectoru row_offsets;  // the stored elements of row i are in [row_offsets[i], row_offsets[i+1])
+    Vectoru column_indices;  // the column indices of the stored elements, which are ascending in every row
+    std::vector<Scalar> values;  // the values of the stored elements
+
+
+    /*
+     *  PRIVATE METHODS
+     */
+
+    /**
+     *  @param number_of_chunks     the number of chunks in which the rows should be divided
+     *
+     *  @return the boundaries of contiguous chunks of rows, each of which contains (almost) the same number of stored elements
+     */
+    Vectoru balancedRowChunks(size_t number_of_chunks) const {
+
+        Vectoru boundaries (number_of_chunks + 1, this->dim);
+        boundaries[0] = 0;
+
+        size_t nnz = this->values.size();
+        for (size_t t = 1; t < number_of_chunks; t++) {
+            size_t target = (nnz * t) / number_of_chunks;
+            boundaries[t] = std::lower_bound(this->row_offsets.begin(), this->row_offsets.end(), target) - this->row_offsets.begin();
+            boundaries[t] = std::max(boundaries[t - 1], std::min(boundaries[t], this->dim));
+        }
+
+        return boundaries;
+    }
+
+
+    /**
+     *  @param number_of_threads        the number of threads that should be used
+     *  @param accumulate_chunk         the function void(size_t row_begin, size_t row_end, size_t t) that adds the contributions of the given rows to the accumulator of thread t
+     *
+     *  Call the given function for every (balanced) chunk of rows, each in a separate thread
+     */
+    template <typename Function>
+    void forEachRowChunk(size_t number_of_threads, const Function& accumulate_chunk) const {
+
+        Vectoru chunks = this->balancedRowChunks(number_of_threads);
+        parallelFor(0, number_of_threads, [&chunks, &accumulate_chunk] (size_t t_begin, size_t t_end) {
+            for (size_t t = t_begin; t < t_end; t++) {
+                accumulate_chunk(chunks[t], chunks[t + 1], t);
+            }
+        }, number_of_threads);
+    }
+
+
+public:
+
+    /*
+     *  CONSTRUCTORS
+     */
+
+    /**
+     *  Construct a zero matrix
+     *
+     *  @param dim      the dimension of the matrix
+     */
+    explicit SymmetricSparseMatrix(size_t dim = 0) :
+        dim (dim),
+        row_offsets (dim + 1, 0)
+    {}
+
+
+    /**
+     *  @param dim          the dimension of the matrix
+     *  @param triplets     the elements of the matrix, where the values of duplicate entries are summed
+     *
+     *  Note that the triplets in the strict lower triangle are ignored, since they are determined by the ones in the upper triangle
+     */
+    SymmetricSparseMatrix(size_t dim, const std::vector<Eigen::Triplet<Scalar>>& triplets) :
+        dim (dim),
+        row_offsets (dim + 1, 0)
+    {
+        // Count the number of elements in every row, and place them row by row
+        for (const auto& triplet : triplets) {
+            if ((triplet.row() < 0) || (triplet.col() < 0) || (static_cast<size_t>(triplet.row()) >= dim) || (static_cast<size_t>(triplet.col()) >= dim)) {
+                throw std::invalid_argument("SymmetricSparseMatrix::SymmetricSparseMatrix(size_t, std::vector<Eigen::Triplet<Scalar>>): A triplet is out of the bounds of the matrix.");
+            }
+            if (triplet.row() <= triplet.col()) {
+                this->row_offsets[triplet.row() + 1]++;
+            }
+        }
+        for (size_t i = 0; i < dim; i++) {
+            this->row_offsets[i + 1] += this->row_offsets[i];
+        }
+
+        std::vector<std::pair<size_t, Scalar>> elements (this->row_offsets[dim]);
+        Vectoru positions (this->row_offsets.begin(), this->row_offsets.end() - 1);
+        for (const auto& triplet : triplets) {
+            if (triplet.row() <= triplet.col()) {
+                elements[positions[triplet.row()]++] = std::make_pair(static_cast<size_t>(triplet.col()), triplet.value());
+            }
+        }
+
+
+        // Sort every row on the column indices and sum the duplicate entries
+        this->column_indices.reserve(elements.size());
+        this->values.reserve(elements.size());
+        size_t start = 0;
+        for (size_t i = 0; i < dim; i++) {
+            auto row_begin = elements.begin() + this->row_offsets[i];
+            auto row_end = elements.begin() + this->row_offsets[i + 1];
+            std::sort(row_begin, row_end, [] (const std::pair<size_t, Scalar>& lhs, const std::pair<size_t, Scalar>& rhs) { return lhs.first < rhs.first; });
+
+            for (auto it = row_begin; it != row_end; it++) {
+                if ((this->column_indices.size() > start) && (this->column_indices.back() == it->first)) {
+                    this->values.back() += it->second;
+                } else {
+                    this->column_indices.push_back(it->first);
+                    this->values.push_back(it->second);
+                }
+            }
+
+            this->row_offsets[i] = start;
+            start = this->column_indices.size();
+        }
+        this->row_offsets[dim] = start;
+    }
+
+
+    /**
+     *  @param matrix       a symmetric sparse matrix, of which only the upper triangle is used
+     */
+    explicit SymmetricSparseMatrix(const Eigen::SparseMatrix<Scalar>& matrix) :
+        dim (static_cast<size_t>(matrix.rows())),
+        row_offsets (static_cast<size_t>(matrix.rows()) + 1, 0)
+    {
+        if (matrix.rows() != matrix.cols()) {
+            throw std::invalid_argument("SymmetricSparseMatrix::SymmetricSparseMatrix(Eigen::SparseMatrix<Scalar>): The given matrix is not square.");
+        }
+
+        // The upper triangle of a row-major matrix is read row by row, with ascending column indices
+        Eigen::SparseMatrix<Scalar, Eigen::RowMajor> upper = matrix.template triangularView<Eigen::Upper>();
+        upper.makeCompressed();
+
+        this->column_indices.reserve(upper.nonZeros());
+        this->values.reserve(upper.nonZeros());
+        for (size_t i = 0; i < this->dim; i++) {
+            for (typename Eigen::SparseMatrix<Scalar, Eigen::RowMajor>::InnerIterator it (upper, i); it; ++it) {
+                this->column_indices.push_back(static_cast<size_t>(it.col()));
+                this->values.push_back(it.value());
+            }
+            this->row_offsets[i + 1] = this->column_indices.size();
+        }
+    }
+
+
+    /*
+     *  GETTERS
+     */
+
+    size_t get_dimension() const { return this->dim; }
+    const Vectoru& get_row_offsets() const { return this->row_offsets; }
+    const Vectoru& get_column_indices() const { return this->column_indices; }
+    const std::vector<Scalar>& get_values() const { return this->values; }
+
+
+    /*
+     *  PUBLIC METHODS
+     */
+
+    /**
+     *  @return the number of stored elements, i.e. the number of non-zero elements in the upper triangle (including the diagonal)
+     */
+    size_t countStoredElements() const { return this->values.size(); }
+
+    /**
+     *  @param i        a row index
+     *  @param j        a column index
+     *
+     *  @return the element (i,j) of the matrix
+     */
+    Scalar operator()(size_t i, size_t j) const {
+
+        if (i > j) {  // an element of the strict lower triangle is found by symmetry
+            std::swap(i, j);
+        }
+
+        auto row_begin = this->column_indices.begin() + this->row_offsets[i];
+        auto row_end = this->column_indices.begin() + this->row_offsets[i + 1];
+        auto it = std::lower_bound(row_begin, row_end, j);
+        if ((it != row_end) && (*it == j)) {
+            return this->values[it - this->column_indices.begin()];
+        }
+        return Scalar {};
+    }
+
+    /**
+     *  @return the diagonal of the matrix
+     */
+    VectorX<Scalar> diagonal() const {
+
+        VectorX<Scalar> diagonal = VectorX<Scalar>::Zero(this->dim);
+        for (size_t i = 0; i < this->dim; i++) {
+            diagonal(i) = this->operator()(i, i);
+        }
+        return diagonal;
+    }
+
+    /**
+     *  @param x                        the vector upon which the matrix acts
+     *  @param number_of_threads        the number of threads that should be used
+     *
+     *  @return the matrix-vector product A x
+     *
+     *  Every thread handles a (balanced) chunk of rows and accumulates into its own vector, which requires number_of_threads vectors of the dimension of the matrix
+     */
+    VectorX<Scalar> matrixVectorProduct(const VectorX<Scalar>& x, size_t number_of_threads = getNumberOfThreads()) const {
+
+        if (static_cast<size_t>(x.size()) != this->dim) {
+            throw std::invalid_argument("SymmetricSparseMatrix::matrixVectorProduct(VectorX<Scalar>, size_t): The dimension of the vector doesn't match the matrix.");
+        }
+
+        number_of_threads = std::max<size_t>(std::min(number_of_threads, this->dim), 1);
+        std::vector<VectorX<Scalar>> accumulators (number_of_threads, VectorX<Scalar>::Zero(this->dim));
+
+        this->forEachRowChunk(number_of_threads, [this, &x, &accumulators] (size_t row_begin, size_t row_end, size_t t) {
+            VectorX<Scalar>& y = accumulators[t];
+
+            for (size_t i = row_begin; i < row_end; i++) {
+                Scalar y_i {};
+                for (size_t k = this->row_offsets[i]; k < this->row_offsets[i + 1]; k++) {
+                    size_t j = this->column_indices[k];
+
+                    y_i += this->values[k] * x(j);
+                    if (j != i) {  // the mirrored element (j,i)
+                        y(j) += this->values[k] * x(i);
+                    }
+                }
+                y(i) += y_i;
+            }
+        });
+
+
+        // Sum the accumulators, dividing the elements over the threads
+        parallelFor(0, this->dim, [&accumulators] (size_t begin, size_t end) {
+            for (size_t t = 1; t < accumulators.size(); t++) {
+                accumulators[0].segment(begin, end - begin) += accumulators[t].segment(begin, end - begin);
+            }
+        }, number_of_threads);
+
+        return std::move(accumulators[0]);
+    }
+
+    /**
+     *  @param X                        the vectors upon which the matrix acts, as the columns of a (dim x m)-matrix
+     *  @param number_of_threads        the number of threads that should be used
+     *
+     *  @return the matrix-matrix product A X, for which the stored elements are only traversed once
+     *
+     *  Every thread handles a (balanced) chunk of rows and accumulates into its own (m x dim)-matrix
+     */
+    MatrixX<Scalar> blockMatrixVectorProduct(const MatrixX<Scalar>& X, size_t number_of_threads = getNumberOfThreads()) const {
+
+        if (static_cast<size_t>(X.rows()) != this->dim) {
+            throw std::invalid_argument("SymmetricSparseMatrix::blockMatrixVectorProduct(MatrixX<Scalar>, size_t): The dimension of the vectors doesn't match the matrix.");
+        }
+
+        // Work with the transposed vectors, so that the coefficients of one row for all vectors are contiguous
+        MatrixX<Scalar> X_transposed = X.transpose();
+
+        number_of_threads = std::max<size_t>(std::min(number_of_threads, this->dim), 1);
+        std::vector<MatrixX<Scalar>> accumulators (number_of_threads, MatrixX<Scalar>::Zero(X.cols(), this->dim));
+
+        this->forEachRowChunk(number_of_threads, [this, &X_transposed, &accumulators] (size_t row_begin, size_t row_end, size_t t) {
+            MatrixX<Scalar>& Y_transposed = accumulators[t];
+
+            for (size_t i = row_begin; i < row_end; i++) {
+                for (size_t k = this->row_offsets[i]; k < this->row_offsets[i + 1]; k++) {
+                    size_t j = this->column_indices[k];
+
+                    Y_transposed.col(i) += this->values[k] * X_transposed.col(j);
+                    if (j != i) {  // the mirrored element (j,i)
+                        Y_transposed.col(j) += this->values[k] * X_transposed.col(i);
+                    }
+                }
+            }
+        });
+
+
+        // Sum the accumulators, dividing the rows of the product over the threads
+        parallelFor(0, this->dim, [&accumulators] (size_t begin, size_t end) {
+            for (size_t t = 1; t < accumulators.size(); t++) {
+                accumulators[0].middleCols(begin, end - begin) += accumulators[t].middleCols(begin, end - begin);
+            }
+        }, number_of_threads);
+
+        return accumulators[0].transpose();
+    }
+};
+
+
+}  // namespace GQCP
+
+
+#endif  // GQCP_SYMMETRICSPARSEMATRIX_HPP
@@ -33,6 +33,8 @@ namespace GQCP {
 /**
  *  A class that implements the Davidson algorithm for finding the lowest eigenpair of a (possibly large) diagonally-
  *  dominant symmetric matrix
+ *
+ *  If the block size is larger than 1, the (block) Davidson algorithm expands the subspace with the correction vectors of several roots at once: they are orthonormalized using block Gram-Schmidt and the matrix is applied to them with one block matrix-vector product
  */
 class DavidsonSolver : public BaseEigenproblemSolver {
 private:
@@ -42,14 +44,37 @@ private:
     size_t collapsed_subspace_dimension;
     size_t maximum_number_of_iterations;
     size_t number_of_iterations = 0;
+    size_t block_size;  // the maximum number of correction vectors that are added per iteration
+    bool lock_converged_eigenpairs;  // if true, converged eigenpairs no longer contribute correction vectors
 
-    VectorFunction matrixVectorProduct;
+    BlockVectorFunction blockMatrixVectorProduct;
     VectorX<double> diagonal;  // the diagonal of the matrix in question
     MatrixX<double> V_0;  // the set of initial guesses (every column is an initial guess)
 
+    // PRIVATE METHODS
+    /**
+     *  Solve the eigenvalue problem using the block Davidson algorithm, in which the correction vectors of (at most this->block_size) roots are added to the subspace at once
+     */
+    void solveBlock();
+
 
 public:
     // CONSTRUCTORS
+    /**
+     *  @param blockMatrixVectorProduct             a function that returns the matrix-vector products of all the columns of a given matrix at once
+     *  @param diagonal                             the diagonal of the matrix
+     *  @param V_0                                  the (set of) initial guess(es) specified as a vector (matrix of column vectors)
+     *  @param number_of_requested_eigenpairs       the number of eigenpairs the solver should find
+     *  @param convergence_threshold                the tolerance on the norm of the residual vector
+     *  @param correction_threshold                 the threshold used in solving the (approximated) residue correction equation
+     *  @param maximum_subspace_dimension           the maximum dimension of the Davidson subspace before collapsing
+     *  @param collapsed_subspace_dimension         the dimension of the subspace after collapse
+     *  @param maximum_number_of_iterations         the maximum number of Davidson iterations
+     *  @param block_size                           the maximum number of correction vectors that are added per iteration
+     *  @param lock_converged_eigenpairs            if true, converged eigenpairs no longer contribute correction vectors
+     */
+    DavidsonSolver(const BlockVectorFunction& blockMatrixVectorProduct, const VectorX<double>& diagonal, const MatrixX<double>& V_0, size_t number_of_requested_eigenpairs = 1, double convergence_threshold = 1.0e-08, double correction_threshold = 1.0e-12, size_t maximum_subspace_dimension = 15, size_t collapsed_subspace_dimension = 2, size_t maximum_number_of_iterations = 128, size_t block_size = 1, bool lock_converged_eigenpairs = false);
+
     /**
      *  @param matrixVectorProduct                  a vector function that returns the matrix-vector product (i.e. the matrix-vector product representation of the matrix)
      *  @param diagonal                             the diagonal of the matrix
@@ -60,8 +85,10 @@ public:
      *  @param maximum_subspace_dimension           the maximum dimension of the Davidson subspace before collapsing
      *  @param collapsed_subspace_dimension         the dimension of the subspace after collapse
      *  @param maximum_number_of_iterations         the maximum number of Davidson iterations
+     *  @param block_size                           the maximum number of correction vectors that are added per iteration
+     *  @param lock_converged_eigenpairs            if true, converged eigenpairs no longer contribute correction vectors
      */
-    DavidsonSolver(const VectorFunction& matrixVectorProduct, const VectorX<double>& diagonal, const MatrixX<double>& V_0, size_t number_of_requested_eigenpairs = 1, double convergence_threshold = 1.0e-08, double correction_threshold = 1.0e-12, size_t maximum_subspace_dimension = 15, size_t collapsed_subspace_dimension = 2, size_t maximum_number_of_iterations = 128);
+    DavidsonSolver(const VectorFunction& matrixVectorProduct, const VectorX<double>& diagonal, const MatrixX<double>& V_0, size_t number_of_requested_eigenpairs = 1, double convergence_threshold = 1.0e-08, double correction_threshold = 1.0e-12, size_t maximum_subspace_dimension = 15, size_t collapsed_subspace_dimension = 2, size_t maximum_number_of_iterations = 128, size_t block_size = 1, bool lock_converged_eigenpairs = false);
 
     /**
      *  @param A                                    the matrix to be diagonalized
@@ -72,8 +99,10 @@ public:
      *  @param maximum_subspace_dimension           the maximum dimension of the Davidson subspace before collapsing
      *  @param collapsed_subspace_dimension         the dimension of the subspace after collapse
      *  @param maximum_number_of_iterations         the maximum number of Davidson iterations
+     *  @param block_size                           the maximum number of correction vectors that are added per iteration
+     *  @param lock_converged_eigenpairs            if true, converged eigenpairs no longer contribute correction vectors
      */
-    DavidsonSolver(const SquareMatrix<double>& A, const MatrixX<double>& V_0, size_t number_of_requested_eigenpairs = 1, double convergence_threshold = 1.0e-08, double correction_threshold = 1.0e-12, size_t maximum_subspace_dimension = 15, size_t collapsed_subspace_dimension = 2, size_t maximum_number_of_iterations = 128);
+    DavidsonSolver(const SquareMatrix<double>& A, const MatrixX<double>& V_0, size_t number_of_requested_eigenpairs = 1, double convergence_threshold = 1.0e-08, double correction_threshold = 1.0e-12, size_t maximum_subspace_dimension = 15, size_t collapsed_subspace_dimension = 2, size_t maximum_number_of_iterations = 128, size_t block_size = 1, bool lock_converged_eigenpairs = false);
 
     /**
      *  @param matrixVectorProduct          a vector function that returns the matrix-vector product (i.e. the matrix-vector product representation of the matrix)
@@ -82,6 +111,13 @@ public:
      */
     DavidsonSolver(const VectorFunction& matrixVectorProduct, const VectorX<double>& diagonal, const DavidsonSolverOptions& davidson_solver_options);
 
+    /**
+     *  @param blockMatrixVectorProduct     a function that returns the matrix-vector products of all the columns of a given matrix at once
+     *  @param diagonal                     the diagonal of the matrix
+     *  @param davidson_solver_options      the options specified for solving the Davidson eigenvalue problem
+     */
+    DavidsonSolver(const BlockVectorFunction& blockMatrixVectorProduct, const VectorX<double>& diagonal, const DavidsonSolverOptions& davidson_solver_options);
+
     /**
      *  @param A                            the matrix to be diagonalized
      *  @param davidson_solver_options      the options specified for solving the Davidson eigenvalue problem
@@ -107,6 +143,7 @@ public:
      *      - the number of requested eigenpairs
      */
     void solve() override;
+
 };
 
 
@@ -70,6 +70,10 @@ public:
  */
 struct SparseSolverOptions : public BaseSolverOptions {
 public:
+    // MEMBERS
+    bool matrix_free = false;  // if true, the Lanczos algorithm only uses matrix-vector products of the HamiltonianBuilder and no (sparse) matrix is stored
+
+
     // OVERRIDDEN METHODS
     SolverType get_solver_type () const override { return SolverType::SPARSE; };
 };
@@ -89,6 +93,10 @@ public:
     size_t collapsed_subspace_dimension = 2;
     size_t maximum_number_of_iterations = 128;
 
+    size_t block_size = 1;  // the maximum number of correction vectors that are added per iteration: if larger than 1, the corrections are orthonormalized and multiplied with the matrix as one block
+    bool lock_converged_eigenpairs = false;  // if true, converged eigenpairs no longer contribute correction vectors to the subspace
+    bool preassemble = false;  // if true, the CISolver assembles the sparse Hamiltonian once and uses its (parallel) sparse matrix-vector products in every iteration
+
     MatrixX<double> X_0;  // MatrixX<double> of initial guesses, or VectorX<double> of initial guess
 
 
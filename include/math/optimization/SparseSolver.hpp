@@ -24,6 +24,9 @@
 
 #include "math/optimization/BaseMatrixSolver.hpp"
 #include "math/optimization/EigenproblemSolverOptions.hpp"
+#include "math/Matrix.hpp"
+
+#include <vector>
 
 
 
@@ -31,11 +34,58 @@ namespace GQCP {
 
 
 /**
- *  An eigenproblem solver that stores a sparse representation of the matrix
+ *  An eigenproblem solver that uses Spectra's Lanczos algorithm on either
+ *      - a sparse representation of the matrix, which is assembled from the values added through addToMatrix() or is supplied as a whole
+ *      - a matrix-vector product function, in which case the matrix is never stored
  */
 class SparseSolver : public BaseMatrixSolver {
 private:
-    Eigen::SparseMatrix<double> matrix;
+    mutable Eigen::SparseMatrix<double> matrix;
+    mutable std::vector<Eigen::Triplet<double>> triplets;  // the values that have been added, but are not yet assembled into the sparse matrix
+
+    VectorFunction matrixVectorProduct;  // if set, the solver is matrix-free
+
+
+    /**
+     *  An adapter that lets Spectra use a matrix-vector product function as its matrix operation
+     */
+    class VectorFunctionOperator {
+    private:
+        const VectorFunction& matrixVectorProduct;
+        size_t dim;
+
+    public:
+        VectorFunctionOperator(const VectorFunction& matrixVectorProduct, size_t dim) : matrixVectorProduct (matrixVectorProduct), dim (dim) {}
+
+        int rows() const { return static_cast<int>(this->dim); }
+        int cols() const { return static_cast<int>(this->dim); }
+
+        /**
+         *  Calculate y = A x, as required by Spectra
+         */
+        void perform_op(const double* x_in, double* y_out) const {
+            Eigen::Map<const Eigen::VectorXd> x (x_in, this->dim);
+            Eigen::Map<Eigen::VectorXd> y (y_out, this->dim);
+            y = this->matrixVectorProduct(x);
+        }
+    };
+
+
+    // PRIVATE METHODS
+    /**
+     *  Add the pending triplets to the sparse matrix, summing duplicate entries
+     */
+    void assemble() const;
+
+    /**
+     *  Run Spectra's symmetric eigensolver with the given matrix operation and store the requested eigenpairs
+     *
+     *  @tparam MatrixOperation     the type of the Spectra matrix operation
+     *
+     *  @param matrix_operation     the matrix operation that Spectra should use
+     */
+    template <typename MatrixOperation>
+    void solveWith(MatrixOperation& matrix_operation);
 
 
 public:
@@ -56,13 +106,31 @@ public:
      */
     SparseSolver(size_t dim, const SparseSolverOptions& sparse_solver_options);
 
+    /**
+     *  @param matrix                   the preassembled compressed sparse representation of the matrix
+     *  @param sparse_solver_options    the options to be used for the sparse eigenproblem algorithm
+     */
+    SparseSolver(const Eigen::SparseMatrix<double>& matrix, const SparseSolverOptions& sparse_solver_options);
+
+    /**
+     *  A matrix-free constructor
+     *
+     *  @param matrixVectorProduct      a vector function that returns the matrix-vector product
+     *  @param dim                      the dimension of the matrix
+     *  @param sparse_solver_options    the options to be used for the sparse eigenproblem algorithm
+     */
+    SparseSolver(const VectorFunction& matrixVectorProduct, size_t dim, const SparseSolverOptions& sparse_solver_options);
+
 
     // DESTRUCTOR
     ~SparseSolver() override = default;
 
 
     // GETTERS
-    const Eigen::SparseMatrix<double>& get_matrix() const { return this->matrix; }
+    /**
+     *  @return the sparse matrix, in which all values that have been added are assembled
+     */
+    const Eigen::SparseMatrix<double>& get_matrix() const;
 
 
     // PUBLIC OVERRIDDEN METHODS
@@ -75,12 +143,21 @@ public:
      */
     void solve() override;
 
+    /**
+     *  Reserve memory for a number of values that will be added through addToMatrix()
+     *
+     *  @param number_of_values     the expected number of values
+     */
+    void reserve(size_t number_of_values) { this->triplets.reserve(number_of_values); }
+
     /**
      *  @param value        the value to be added
      *  @param index1       the first index of the matrix
      *  @param index2       the second index of the matrix
      *
      *  Add the value to the matrix at (index1, index2)
+     *
+     *  The values are collected as triplets and are only assembled into the sparse matrix when it is needed
      */
     void addToMatrix(double value, size_t index1, size_t index2) override;
 };
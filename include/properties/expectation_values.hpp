@@ -20,6 +20,7 @@
 
 #include "RDM/OneRDM.hpp"
 #include "RDM/TwoRDM.hpp"
+#include "RDM/SeniorityZeroTwoRDM.hpp"
 #include "HamiltonianParameters/HamiltonianParameters.hpp"
 
 
@@ -72,6 +73,14 @@ std::array<double, N> calculateExpectationValues(const std::array<OneElectronOpe
  */
 double calculateExpectationValue(const TwoElectronOperator<double>& two_op, const TwoRDM<double>& two_rdm);
 
+/**
+ *  @param two_op       the two-electron operator whose expectation value should be calculated
+ *  @param two_rdm      the 2-RDM of a seniority-zero wave function, in its compact representation
+ *
+ *  @return the expectation value of the two-electron operator, with the given 2-RDM: this includes the prefactor 1/2
+ */
+double calculateExpectationValue(const TwoElectronOperator<double>& two_op, const SeniorityZeroTwoRDM<double>& two_rdm);
+
 
 
 /*
@@ -87,6 +96,15 @@ double calculateExpectationValue(const TwoElectronOperator<double>& two_op, cons
  */
 double calculateExpectationValue(const HamiltonianParameters<double>& ham_par, const OneRDM<double>& one_rdm, const TwoRDM<double>& two_rdm);
 
+/**
+ *  @param ham_par      the Hamiltonian parameters containing the scalar interaction term and the one- and two-electron integrals
+ *  @param one_rdm      the 1-RDM
+ *  @param two_rdm      the 2-RDM of a seniority-zero wave function, in its compact representation
+ *
+ *  @return the expectation value of the 'Hamiltonian' represented by the Hamiltonian parameters
+ */
+double calculateExpectationValue(const HamiltonianParameters<double>& ham_par, const OneRDM<double>& one_rdm, const SeniorityZeroTwoRDM<double>& two_rdm);
+
 
 }  // namespace GQCP
 
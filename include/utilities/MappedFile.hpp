@@ -0,0 +1,67 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef GQCP_MAPPEDFILE_HPP
+#define GQCP_MAPPEDFILE_HPP
+
+
+#include <string>
+
+
+namespace GQCP {
+
+
+/**
+ *  A read-only view on the contents of a file, which is mapped into memory instead of being read into a buffer
+ *
+ *  The pages of the file are only loaded when they are accessed, and they are shared with the operating system's file cache
+ */
+class MappedFile {
+private:
+    const char* data = nullptr;  // the start of the mapped contents, nullptr for an empty file
+    size_t size = 0;  // the number of bytes in the file
+
+
+public:
+    // CONSTRUCTORS
+    /**
+     *  @param filename     the name of the file that should be mapped into memory
+     */
+    explicit MappedFile(const std::string& filename);
+
+    /**
+     *  Remove the copy constructor and the assignment operator, since the mapping should only be released once
+     */
+    MappedFile(const MappedFile& mapped_file) = delete;
+    MappedFile& operator=(const MappedFile& mapped_file) = delete;
+
+
+    // DESTRUCTOR
+    ~MappedFile();
+
+
+    // GETTERS
+    const char* get_data() const { return this->data; }
+    size_t get_size() const { return this->size; }
+    const char* get_end() const { return this->data + this->size; }
+};
+
+
+}  // namespace GQCP
+
+
+#endif  // GQCP_MAPPEDFILE_HPP
@@ -0,0 +1,178 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#ifndef GQCP_PARALLEL_HPP
+#define GQCP_PARALLEL_HPP
+
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+
+namespace GQCP {
+
+
+/**
+ *  @return the number of threads that the multithreaded algorithms in this library use
+ *
+ *  If no number of threads has been set explicitly, the environment variable GQCP_NUM_THREADS is used. If that isn't set either, the number of concurrent threads supported by the hardware is used
+ */
+size_t getNumberOfThreads();
+
+/**
+ *  @param number_of_threads        the number of threads that the multithreaded algorithms in this library should use: 0 restores the default (see getNumberOfThreads())
+ */
+void setNumberOfThreads(size_t number_of_threads);
+
+
+/**
+ *  Split the range [begin, end) in contiguous chunks of (almost) equal size and call the given function for every chunk, each in a separate thread
+ *
+ *  @tparam Function            the type of the callable, which should have the signature void(size_t chunk_begin, size_t chunk_end)
+ *
+ *  @param begin                the first index of the range
+ *  @param end                  the past-the-end index of the range
+ *  @param function             the function that is called for each chunk [chunk_begin, chunk_end)
+ *  @param number_of_threads    the number of threads (and chunks) that should be used
+ *
+ *  Note that the calling thread handles one of the chunks itself. If any of the calls throws, the first exception is re-thrown after all threads have finished
+ */
+template <typename Function>
+void parallelFor(size_t begin, size_t end, const Function& function, size_t number_of_threads = getNumberOfThreads()) {
+
+    if (end <= begin) {
+        return;
+    }
+
+    size_t length = end - begin;
+    number_of_threads = std::max<size_t>(std::min(number_of_threads, length), 1);
+
+    if (number_of_threads == 1) {  // don't bother creating threads
+        function(begin, end);
+        return;
+    }
+
+
+    // Distribute the remainder of the division over the first chunks
+    size_t chunk_size = length / number_of_threads;
+    size_t remainder = length % number_of_threads;
+
+    std::vector<std::exception_ptr> exceptions (number_of_threads);
+    auto run_chunk = [&function, &exceptions] (size_t thread_index, size_t chunk_begin, size_t chunk_end) {
+        try {
+            function(chunk_begin, chunk_end);
+        } catch (...) {
+            exceptions[thread_index] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(number_of_threads - 1);
+    size_t chunk_begin = begin;
+    for (size_t t = 0; t < number_of_threads; t++) {
+        size_t chunk_end = chunk_begin + chunk_size + (t < remainder ? 1 : 0);
+
+        if (t < number_of_threads - 1) {
+            threads.emplace_back(run_chunk, t, chunk_begin, chunk_end);
+        } else {  // the calling thread handles the last chunk
+            run_chunk(t, chunk_begin, chunk_end);
+        }
+
+        chunk_begin = chunk_end;
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+
+/**
+ *  Call the given function for every index in the range [begin, end), where the indices are handed out one at a time to the first thread that is available
+ *
+ *  @tparam Function            the type of the callable, which should have the signature void(size_t index, size_t thread_index)
+ *
+ *  @param begin                the first index of the range
+ *  @param end                  the past-the-end index of the range
+ *  @param function             the function that is called for each index, together with the index (in [0, number_of_threads)) of the thread that calls it
+ *  @param number_of_threads    the number of threads that should be used
+ *
+ *  This dynamic scheduling is preferred over parallelFor() if the cost of the calls varies strongly between indices. The thread index can be used to access per-thread resources
+ *  Note that the calling thread participates as the last thread. If any of the calls throws, the remaining indices are skipped and the first exception is re-thrown after all threads have finished
+ */
+template <typename Function>
+void parallelForDynamic(size_t begin, size_t end, const Function& function, size_t number_of_threads = getNumberOfThreads()) {
+
+    if (end <= begin) {
+        return;
+    }
+
+    number_of_threads = std::max<size_t>(std::min(number_of_threads, end - begin), 1);
+
+    if (number_of_threads == 1) {  // don't bother creating threads
+        for (size_t index = begin; index < end; index++) {
+            function(index, 0);
+        }
+        return;
+    }
+
+
+    std::atomic<size_t> next_index (begin);
+    std::vector<std::exception_ptr> exceptions (number_of_threads);
+    auto run_thread = [&function, &exceptions, &next_index, end] (size_t thread_index) {
+        try {
+            for (size_t index = next_index++; index < end; index = next_index++) {
+                function(index, thread_index);
+            }
+        } catch (...) {
+            exceptions[thread_index] = std::current_exception();
+            next_index = end;  // let the other threads stop as well
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(number_of_threads - 1);
+    for (size_t t = 0; t < number_of_threads - 1; t++) {
+        threads.emplace_back(run_thread, t);
+    }
+    run_thread(number_of_threads - 1);  // the calling thread participates as well
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+
+}  // namespace GQCP
+
+
+#endif  // GQCP_PARALLEL_HPP
@@ -46,7 +46,25 @@ CISolver::CISolver(const HamiltonianBuilder& hamiltonian_builder, const Hamilton
 
 
 /*
- *  CONSTRUCTORS
+ *  PRIVATE METHODS
+ */
+
+/**
+ *  @return the Hamiltonian as a sparse matrix that stores its upper half, which is only assembled on the first call
+ */
+const SymmetricSparseMatrix<double>& CISolver::get_symmetric_sparse_hamiltonian() const {
+
+    if (!this->symmetric_sparse_hamiltonian) {
+        this->symmetric_sparse_hamiltonian = std::make_shared<const SymmetricSparseMatrix<double>>(this->hamiltonian_builder->constructSymmetricSparseHamiltonian(this->hamiltonian_parameters));
+    }
+
+    return *this->symmetric_sparse_hamiltonian;
+}
+
+
+
+/*
+ *  PUBLIC METHODS
  */
 
 /**
@@ -72,19 +90,69 @@ void CISolver::solve(const BaseSolverOptions& solver_options) {
 
         case SolverType::DAVIDSON: {
 
+            const auto& davidson_solver_options = dynamic_cast<const DavidsonSolverOptions&>(solver_options);
+
+            if (davidson_solver_options.preassemble) {  // use the stored sparse Hamiltonian for all matrix-vector products
+                const auto& matrix = this->get_symmetric_sparse_hamiltonian();
+                auto diagonal = matrix.diagonal();
+
+                if (davidson_solver_options.block_size > 1) {
+                    BlockVectorFunction blockMatrixVectorProduct = [&matrix](const MatrixX<double>& X) { return matrix.blockMatrixVectorProduct(X); };
+                    DavidsonSolver solver (blockMatrixVectorProduct, diagonal, davidson_solver_options);
+
+                    solver.solve();
+                    this->eigenpairs = solver.get_eigenpairs();
+                } else {
+                    VectorFunction matrixVectorProduct = [&matrix](const VectorX<double>& x) { return matrix.matrixVectorProduct(x); };
+                    DavidsonSolver solver (matrixVectorProduct, diagonal, davidson_solver_options);
+
+                    solver.solve();
+                    this->eigenpairs = solver.get_eigenpairs();
+                }
+
+                break;
+            }
+
             auto diagonal = this->hamiltonian_builder->calculateDiagonal(this->hamiltonian_parameters);
-            VectorFunction matrixVectorProduct = [this, &diagonal](const VectorX<double>& x) { return hamiltonian_builder->matrixVectorProduct(hamiltonian_parameters, x, diagonal); };
 
-            DavidsonSolver solver (matrixVectorProduct, diagonal, dynamic_cast<const DavidsonSolverOptions&>(solver_options));
+            if (davidson_solver_options.block_size > 1) {  // the block Davidson algorithm applies the Hamiltonian to several vectors at once
+                BlockVectorFunction blockMatrixVectorProduct = [this, &diagonal](const MatrixX<double>& X) { return hamiltonian_builder->blockMatrixVectorProduct(hamiltonian_parameters, X, diagonal); };
+                DavidsonSolver solver (blockMatrixVectorProduct, diagonal, davidson_solver_options);
 
-            solver.solve();
-            this->eigenpairs = solver.get_eigenpairs();
+                solver.solve();
+                this->eigenpairs = solver.get_eigenpairs();
+            } else {
+                VectorFunction matrixVectorProduct = [this, &diagonal](const VectorX<double>& x) { return hamiltonian_builder->matrixVectorProduct(hamiltonian_parameters, x, diagonal); };
+                DavidsonSolver solver (matrixVectorProduct, diagonal, davidson_solver_options);
+
+                solver.solve();
+                this->eigenpairs = solver.get_eigenpairs();
+            }
 
             break;
         }
 
         case SolverType::SPARSE: {
-            throw std::invalid_argument("CISolver::solve(BaseSolverOptions): Sparse not implemented");
+
+            const auto& sparse_solver_options = dynamic_cast<const SparseSolverOptions&>(solver_options);
+
+            if (sparse_solver_options.matrix_free) {  // the Lanczos algorithm calls the matrix-vector product of the HamiltonianBuilder directly
+                auto dim = this->hamiltonian_builder->get_fock_space()->get_dimension();
+                auto diagonal = this->hamiltonian_builder->calculateDiagonal(this->hamiltonian_parameters);
+                VectorFunction matrixVectorProduct = [this, &diagonal](const VectorX<double>& x) { return hamiltonian_builder->matrixVectorProduct(hamiltonian_parameters, x, diagonal); };
+                SparseSolver solver (matrixVectorProduct, dim, sparse_solver_options);
+
+                solver.solve();
+                this->eigenpairs = solver.get_eigenpairs();
+            } else {  // the Lanczos algorithm uses the (parallel) matrix-vector products of the stored upper half of the Hamiltonian
+                const auto& matrix = this->get_symmetric_sparse_hamiltonian();
+                VectorFunction matrixVectorProduct = [&matrix](const VectorX<double>& x) { return matrix.matrixVectorProduct(x); };
+                SparseSolver solver (matrixVectorProduct, matrix.get_dimension(), sparse_solver_options);
+
+                solver.solve();
+                this->eigenpairs = solver.get_eigenpairs();
+            }
+
             break;
         }
     }
@@ -20,7 +20,7 @@
 #include <unsupported/Eigen/MatrixFunctions>
 
 #include "CISolver/CISolver.hpp"
-#include "RDM/RDMCalculator.hpp"
+#include "RDM/DOCIRDMBuilder.hpp"
 
 #include "utilities/linalg.hpp"
 #include "math/optimization/step.hpp"
@@ -76,18 +76,19 @@ const Eigenpair& DOCINewtonOrbitalOptimizer::get_eigenpair(size_t index) const {
 void DOCINewtonOrbitalOptimizer::solve(BaseSolverOptions& solver_options, const OrbitalOptimizationOptions& oo_options) {
     this->is_converged = false;
     auto K = this->ham_par.get_K();
-    RDMCalculator rdm_calculator(*this->doci.get_fock_space());  // make the RDMCalculator beforehand, it doesn't have to be constructed in every iteration
+    const auto& fock_space = static_cast<const FockSpace&>(*this->doci.get_fock_space());  // the DOCI builder always uses a FockSpace
+    DOCIRDMBuilder rdm_builder (fock_space);  // make the DOCIRDMBuilder beforehand, it doesn't have to be constructed in every iteration
     size_t oo_iterations = 0;
     while (!(this->is_converged)) {
 
         // Solve the DOCI eigenvalue equation, using the options provided
         CISolver doci_solver (this->doci, this->ham_par);  // update the CI solver with the rotated Hamiltonian parameters
         doci_solver.solve(solver_options);
-        rdm_calculator.set_coefficients(doci_solver.get_eigenpair().get_eigenvector());
+        const auto& x = doci_solver.get_eigenpair().get_eigenvector();
 
-        // Calculate the 1- and 2-RDMs
-        auto D = rdm_calculator.calculate1RDMs().one_rdm;  // spin-summed 1-RDM
-        auto d = rdm_calculator.calculate2RDMs().two_rdm;  // spin-summed 2-RDM
+        // Calculate the 1- and 2-RDMs: the 2-RDM is kept in its compact seniority-zero representation
+        auto D = rdm_builder.calculate1RDMs(x).one_rdm;  // spin-summed 1-RDM
+        auto d = rdm_builder.calculateSeniorityZero2RDM(x);  // spin-summed 2-RDM
 
 
         // Calculate the electronic gradient at kappa = 0
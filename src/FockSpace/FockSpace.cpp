@@ -17,9 +17,13 @@
 // 
 #include "FockSpace/FockSpace.hpp"
 
+#include "FockSpace/SingleExcitationList.hpp"
+
 #include <boost/numeric/conversion/converter.hpp>
 #include <boost/math/special_functions.hpp>
 
+#include <memory>
+
 
 namespace GQCP {
 
@@ -37,8 +41,12 @@ FockSpace::FockSpace(size_t K, size_t N) :
         BaseFockSpace (K, FockSpace::calculateDimension(K, N)),
         FockPermutator (N)
 {
-    // Create a zero matrix of dimensions (K+1)x(N+1)
-    this->vertex_weights = Matrixu(this->K + 1, Vectoru(this->N + 1, 0));
+    if (K > ONVRepresentation::number_of_bits) {
+        throw std::invalid_argument("FockSpace::FockSpace(size_t, size_t): The representation of an ONV cannot hold more than " + std::to_string(ONVRepresentation::number_of_bits) + " spatial orbitals.");
+    }
+
+    // Create a zero matrix of dimensions (K+1)x(N+1), whose rows are stored one after the other
+    this->vertex_weights = Vectoru((this->K + 1) * (this->N + 1), 0);
 
     // K=5   N=2
     // [ 0 0 0 ]
@@ -55,7 +63,7 @@ FockSpace::FockSpace(size_t K, size_t N) :
     //      This means that there should be (K-N) vertical moves from (0,0).
     // Therefore, we may only set the weights of first (K-N+1) vertices of the first column to 1.
     for (size_t p = 0; p < this->K - this->N + 1; p++) {
-        this->vertex_weights[p][0] = 1;
+        this->vertex_weights[p * (this->N + 1)] = 1;
     }
 
     // K=5   N=2
@@ -73,7 +81,7 @@ FockSpace::FockSpace(size_t K, size_t N) :
 
     for (size_t m = 1; m < this->N + 1; m++) {
         for (size_t p = m; p < (this->K - this->N + m) + 1; p++) {
-            this->vertex_weights[p][m] = this->vertex_weights[p - 1][m] + this->vertex_weights[p - 1][m - 1];
+            this->vertex_weights[p * (this->N + 1) + m] = this->get_vertex_weights(p - 1, m) + this->get_vertex_weights(p - 1, m - 1);
         }
     }
 
@@ -88,6 +96,45 @@ FockSpace::FockSpace(size_t K, size_t N) :
 
 
 
+/*
+ *  GETTERS
+ */
+
+/**
+ *  @return the vertex weights of the addressing scheme as a (K+1)x(N+1) matrix
+ */
+Matrixu FockSpace::get_vertex_weights() const {
+
+    Matrixu vertex_weights (this->K + 1, Vectoru(this->N + 1));
+    for (size_t p = 0; p < this->K + 1; p++) {
+        for (size_t m = 0; m < this->N + 1; m++) {
+            vertex_weights[p][m] = this->get_vertex_weights(p, m);
+        }
+    }
+    return vertex_weights;
+}
+
+
+/**
+ *  @return the list of all single excitations E_pq |I> of this Fock space, which is generated on the first call and shared by all copies of this Fock space that are made afterwards
+ */
+std::shared_ptr<const SingleExcitationList> FockSpace::get_single_excitations() const {
+
+    auto single_excitations = std::atomic_load(&this->single_excitations);  // other threads may be generating the list as well
+    if (single_excitations) {
+        return single_excitations;
+    }
+
+    // If another thread stored its list in the meantime, that one is kept, so that all callers share the same list
+    auto generated_single_excitations = std::make_shared<const SingleExcitationList>(*this);
+    if (std::atomic_compare_exchange_strong(&this->single_excitations, &single_excitations, generated_single_excitations)) {
+        return generated_single_excitations;
+    }
+    return single_excitations;
+}
+
+
+
 /*
  *  STATIC PUBLIC METHODS
  */
@@ -122,14 +169,8 @@ size_t FockSpace::calculateDimension(size_t K, size_t N) {
  *          011 -> 101
  *          101 -> 110
  */
-size_t FockSpace::ulongNextPermutation(size_t representation) const {
-
-    // t gets this->representation's least significant 0 bits set to 1
-    unsigned long t = representation | (representation - 1UL);
-
-    // Next set to 1 the most significant bit to change,
-    // set to 0 the least significant ones, and add the necessary 1 bits.
-    return (t + 1UL) | (((~t & (t+1UL)) - 1UL) >> (__builtin_ctzl(representation) + 1UL));
+ONVRepresentation FockSpace::nextPermutation(const ONVRepresentation& representation) const {
+    return representation.nextPermutation();
 }
 
 
@@ -138,32 +179,62 @@ size_t FockSpace::ulongNextPermutation(size_t representation) const {
  *
  *  @return the address (i.e. the ordering number) of the given ONV
  */
-size_t FockSpace::getAddress(size_t unsigned_onv) const {
+size_t FockSpace::getAddress(const ONVRepresentation& representation) const {
     // An implementation of the formula in Helgaker, starting the addressing count from zero
     size_t address = 0;
     size_t electron_count = 0;  // counts the number of electrons in the spin string up to orbital p
-    while(unsigned_onv != 0) {  // we will remove the least significant bit each loop, we are finished when no bits are left
-        size_t p = __builtin_ctzl(unsigned_onv);  // p is the orbital index counter (starting from 1)
-        electron_count++;  // each bit is an electron hence we add it up to the electron count
-        address += this->get_vertex_weights(p , electron_count);
-        unsigned_onv ^= unsigned_onv & -unsigned_onv;  // flip the least significant bit
+
+    // Go over the set bits word by word, so that every electron costs a single ctz
+    const auto& words = representation.get_words();
+    for (size_t w = 0; w < words.size(); w++) {
+        size_t word = words[w];
+        while (word != 0) {  // we will remove the least significant bit each loop, we are finished when no bits are left
+            size_t p = w * ONVRepresentation::bits_per_word + __builtin_ctzl(word);  // p is the orbital index counter (starting from 1)
+            electron_count++;  // each bit is an electron hence we add it up to the electron count
+            address += this->get_vertex_weights(p , electron_count);
+            word &= word - 1;  // flip the least significant bit
+        }
     }
     return address;
+}
+
+
+/**
+ *  @param representations      representations of ONVs
+ *
+ *  @return the addresses (i.e. the ordering numbers) of the given ONVs
+ */
+Vectoru FockSpace::getAddresses(const std::vector<ONVRepresentation>& representations) const {
+
+    const size_t number_of_onvs = representations.size();
+    Vectoru addresses (number_of_onvs, 0);
+    std::vector<ONVRepresentation> remaining = representations;  // the bits that haven't been processed yet
+
+    // Every ONV has exactly N electrons, so we can handle the e-th electron of all ONVs at once: the inner loop has no dependencies between its iterations
+    const size_t stride = this->N + 1;
+    const size_t* weights = this->vertex_weights.data();
+    for (size_t e = 1; e < this->N + 1; e++) {
+        for (size_t i = 0; i < number_of_onvs; i++) {
+            size_t p = remaining[i].countTrailingZeros();
+            addresses[i] += weights[p * stride + e];
+            remaining[i].resetLeastSignificantBit();
+        }
+    }
 
+    return addresses;
 }
 
 
 /**
- *  Calculate unsigned representation for a given address
+ *  Calculate the representation for a given address
  *
  *  @param address                 the address of the representation is calculated
  *
- *  @return unsigned representation of the address
+ *  @return the representation of the address
  */
-size_t FockSpace::calculateRepresentation(size_t address) const {
-    size_t representation = 0;
+ONVRepresentation FockSpace::calculateRepresentation(size_t address) const {
+    ONVRepresentation representation;
     if (this->N != 0) {
-        representation = 0;
         size_t m = this->N;  // counts the number of electrons in the spin string up to orbital p
 
         for (size_t p = this->K; p > 0; p--) {  // p is an orbital index
@@ -171,7 +242,7 @@ size_t FockSpace::calculateRepresentation(size_t address) const {
 
             if (weight <= address) {  // the algorithm can move diagonally, so we found an occupied orbital
                 address -= weight;
-                representation |= ((1) << (p - 1));  // set the (p-1)th bit: see (https://stackoverflow.com/a/47990)
+                representation.set(p - 1);  // set the (p-1)th bit
 
                 m--;  // since we found an occupied orbital, we have one electron less
                 if (m == 0) {
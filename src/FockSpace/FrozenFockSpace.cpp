@@ -61,13 +61,11 @@ FrozenFockSpace::FrozenFockSpace(const FockSpace& fock_space, size_t X) :
  *          0101 -> 1001
  *         01101 -> 10011
  */
-size_t FrozenFockSpace::ulongNextPermutation(size_t representation) const {
+ONVRepresentation FrozenFockSpace::nextPermutation(const ONVRepresentation& representation) const {
     // generate the permutation from the active space, bitshift left X amount of times to remove the frozen orbital indices before passing it to the active space
-    size_t sub_permutation = this->active_fock_space.ulongNextPermutation(representation >> this->X);
-    // transform the permutation to the frozen core space, by bitshifting right X amount of times and filling the new 0 bits with 1's (by adding 2^X - 1)
-    sub_permutation <<= X;
-    sub_permutation += static_cast<size_t>(pow(2,X)-1);
-    return sub_permutation;
+    ONVRepresentation sub_permutation = this->active_fock_space.nextPermutation(representation >> this->X);
+    // transform the permutation to the frozen core space, by bitshifting right X amount of times and filling the new 0 bits with 1's
+    return (sub_permutation << this->X) | ONVRepresentation::LowestBits(this->X);
 };
 
 /**
@@ -75,27 +73,25 @@ size_t FrozenFockSpace::ulongNextPermutation(size_t representation) const {
  *
  *  @return the address (i.e. the ordering number) of the given ONV
  */
-size_t FrozenFockSpace::getAddress(size_t representation) const {
+size_t FrozenFockSpace::getAddress(const ONVRepresentation& representation) const {
     // transform the representation to the sub space, by bitshifting left X amount of times to remove the frozen orbital indices
     // address of the total ONV in the frozen Fock space is identical to that of the sub ONV in the sub Fock space.
     return this->active_fock_space.getAddress(representation >> this->X);
 };
 
 /**
-  *  Calculate unsigned representation for a given address
+  *  Calculate the representation for a given address
   *
   *  @param address                 the address of the representation is calculated
   *
-  *  @return unsigned representation of the address
+  *  @return the representation of the address
   */
-size_t FrozenFockSpace::calculateRepresentation(size_t address) const {
+ONVRepresentation FrozenFockSpace::calculateRepresentation(size_t address) const {
     // generate the representation in the active space
-    size_t representation = this->active_fock_space.calculateRepresentation(address);
+    ONVRepresentation representation = this->active_fock_space.calculateRepresentation(address);
 
-    // transform the permutation to the frozen core space, by bitshifting right X amount of times and filling the new 0 bits with 1's (by adding 2^X - 1)
-    representation <<= X;
-    representation += static_cast<size_t>(pow(2,X)-1);
-    return representation;
+    // transform the permutation to the frozen core space, by bitshifting right X amount of times and filling the new 0 bits with 1's
+    return (representation << this->X) | ONVRepresentation::LowestBits(this->X);
 };
 
 
@@ -17,7 +17,7 @@
 // 
 #include "FockSpace/ONV.hpp"
 
-#include <boost/dynamic_bitset.hpp>
+#include <string>
 
 
 namespace GQCP {
@@ -30,12 +30,12 @@ namespace GQCP {
 /**
  *  @param K                        the number of orbitals
  *  @param N                        the number of electrons
- *  @param unsigned_representation  the representation for the ONV as an unsigned integer
+ *  @param representation           the representation for the ONV, e.g. as an unsigned integer
  */
-ONV::ONV(size_t K, size_t N, size_t unsigned_representation) :
+ONV::ONV(size_t K, size_t N, const ONVRepresentation& representation) :
     ONV(K, N)
 {
-    this->unsigned_representation = unsigned_representation;
+    this->representation = representation;
     this->updateOccupationIndices();  // throws error if the representation and N are not compatible
 }
 
@@ -51,6 +51,10 @@ ONV::ONV(size_t K, size_t N) :
     N (N),
     occupation_indices (VectorXs::Zero(N))
 {
+    if (K > ONVRepresentation::number_of_bits) {
+        throw std::invalid_argument("ONV::ONV(size_t, size_t): The representation of an ONV cannot hold more than " + std::to_string(ONVRepresentation::number_of_bits) + " spatial orbitals.");
+    }
+
     this->occupation_indices = VectorXs::Zero(N);
 }
 
@@ -77,7 +81,7 @@ std::ostream& operator<<(std::ostream& os, const ONV& onv) {
  *  @return if this ONV is the same as the other ONV
  */
 bool ONV::operator==(ONV& other) const {
-    return this->unsigned_representation == other.unsigned_representation && this->K == other.K;  // this ensures that N, K and representation are equal
+    return this->representation == other.representation && this->K == other.K;  // this ensures that N, K and representation are equal
 }
 
 
@@ -97,12 +101,12 @@ bool ONV::operator!=(ONV& other) const {
  */
 
 /**
- *  @param unsigned_representation      the new representation as an unsigned integer
+ *  @param representation       the new representation, e.g. as an unsigned integer
  *
  *  Set the representation of an ONV to a new representation and call update the occupation indices accordingly
  */
-void ONV::set_representation(size_t unsigned_representation) {
-    this->unsigned_representation = unsigned_representation;
+void ONV::set_representation(const ONVRepresentation& representation) {
+    this->representation = representation;
     this->updateOccupationIndices();
 }
 
@@ -113,22 +117,29 @@ void ONV::set_representation(size_t unsigned_representation) {
  */
 
 /**
- *  Extracts the positions of the set bits from the this->unsigned_representation and places them in the this->occupation_indices
+ *  Extracts the positions of the set bits from the this->representation and places them in the this->occupation_indices
  */
 void ONV::updateOccupationIndices() {
-    size_t l = this->unsigned_representation;
-    int representation_electron = 0;
-    while (l != 0) {
-        this->occupation_indices(representation_electron) = __builtin_ctzl(l);  // retrieves occupation index
-        representation_electron++;
-        l ^= (l & -l);  // flip the least significant bit
-    }
-    if (representation_electron != this->N) {
+
+    if (this->representation.count() != this->N) {
         throw std::invalid_argument("ONV::updateOccupationIndices(): The current representation and electron count are not compatible");
     }
+
+    // Go over the set bits word by word
+    size_t representation_electron = 0;
+    const auto& words = this->representation.get_words();
+    for (size_t w = 0; w < words.size(); w++) {
+        size_t l = words[w];
+        while (l != 0) {
+            this->occupation_indices(representation_electron) = w * ONVRepresentation::bits_per_word + __builtin_ctzl(l);  // retrieves occupation index
+            representation_electron++;
+            l &= l - 1;  // flip the least significant bit
+        }
+    }
 }
 
 
+
 /**
  *  @param p    the orbital index starting from 0, counted from right to left
  *
@@ -140,8 +151,7 @@ bool ONV::isOccupied(size_t p) const {
         throw std::invalid_argument("ONV::isOccupied(size_t): The index is out of the bitset bounds");
     }
 
-    size_t operator_string = 1U << p;
-    return this->unsigned_representation & operator_string;
+    return this->representation.isSet(p);
 }
 
 
@@ -195,7 +205,7 @@ bool ONV::areUnoccupied(const std::vector<size_t>& indices) const {
  *  @param index_start      the starting index (included), read from right to left
  *  @param index_end        the ending index (not included), read from right to left
  *
- *  @return the representation of a slice (i.e. a subset) of the spin string (read from right to left) between index_start (included) and index_end (not included)
+ *  @return the representation of a slice (i.e. a subset) of the spin string (read from right to left) between index_start (included) and index_end (not included), which should fit in an unsigned integer
  *
  *      Example:
  *          "010011".slice(1, 4) => "01[001]1" -> "001"
@@ -215,16 +225,15 @@ size_t ONV::slice(size_t index_start, size_t index_end) const {
 
 
     // Shift bits to the right
-    size_t u = this->unsigned_representation >> index_start;
+    ONVRepresentation u = this->representation >> index_start;
 
 
     // Create the correct mask
-    size_t mask_length = index_end - index_start;
-    size_t mask = ((1U) << mask_length) - 1;
+    ONVRepresentation mask = ONVRepresentation::LowestBits(index_end - index_start);
 
 
     // Use the mask
-    return u & mask;
+    return (u & mask).asUnsigned();
 }
 
 
@@ -237,10 +246,7 @@ size_t ONV::slice(size_t index_start, size_t index_end) const {
  */
 int ONV::operatorPhaseFactor(size_t p) const {
 
-    if (p == 0) {  // we can't give this to this->slice(0, 0)
-        return 1;
-    }
-    size_t m = __builtin_popcountl(this->slice(0, p));  // count the number of set bits in the slice [0,p-1]
+    size_t m = this->representation.countBefore(p);  // count the number of set bits in the slice [0,p-1]
 
     if ( m % 2 == 0 ) {  // even number of electrons: phase factor (+1)
         return 1;
@@ -260,8 +266,7 @@ int ONV::operatorPhaseFactor(size_t p) const {
 bool ONV::annihilate(size_t p) {
 
     if (this->isOccupied(p)) {
-        size_t operator_string = 1U << p;
-        this->unsigned_representation &= ~operator_string;
+        this->representation.reset(p);
         return true;
     } else {
         return false;
@@ -338,8 +343,7 @@ bool ONV::annihilateAll(const std::vector<size_t>& indices, int& sign) {
 bool ONV::create(size_t p) {
 
     if (!this->isOccupied(p)) {
-        size_t operator_string = 1U << p;
-        this->unsigned_representation ^= operator_string;
+        this->representation.set(p);
         return true;
     } else {
         return false;
@@ -411,7 +415,7 @@ bool ONV::createAll(const std::vector<size_t>& indices, int& sign) {
  *  @return the number of different occupations between this ONV and the other, i.e. two times the number of electron excitations
  */
 size_t ONV::countNumberOfDifferences(const ONV& other) const {
-    return __builtin_popcountl(this->unsigned_representation ^ other.unsigned_representation);
+    return (this->representation ^ other.representation).count();
 }
 
 
@@ -422,19 +426,19 @@ size_t ONV::countNumberOfDifferences(const ONV& other) const {
  */
 std::vector<size_t> ONV::findDifferentOccupations(const ONV &other) const {
 
-    size_t differences = this->unsigned_representation ^ other.unsigned_representation;
-    size_t occupied_differences = differences & this->unsigned_representation;  // this holds all indices occupied in this, but unoccupied in other
+    ONVRepresentation differences = this->representation ^ other.representation;
+    ONVRepresentation occupied_differences = differences & this->representation;  // this holds all indices occupied in this, but unoccupied in other
 
-    size_t number_of_occupied_differences = __builtin_popcountl(occupied_differences);
+    size_t number_of_occupied_differences = occupied_differences.count();
     std::vector<size_t> positions (number_of_occupied_differences);
 
 
     // Find the positions of the set bits in occupied_differences
     for (size_t counter = 0; counter < number_of_occupied_differences; counter++) {  // counts the number of occupied differences we have already encountered
-        size_t position = __builtin_ctzl(occupied_differences);  // count trailing zeros
+        size_t position = occupied_differences.countTrailingZeros();
         positions[counter] = position;
 
-        occupied_differences ^= occupied_differences & -occupied_differences;  // annihilate the least significant set bit
+        occupied_differences.resetLeastSignificantBit();
     }
 
     return positions;
@@ -448,17 +452,17 @@ std::vector<size_t> ONV::findDifferentOccupations(const ONV &other) const {
  */
 std::vector<size_t> ONV::findMatchingOccupations(const ONV& other) const {
 
-    size_t matches = this->unsigned_representation & other.unsigned_representation;
-    size_t number_of_occupied_matches = __builtin_popcountl(matches);
+    ONVRepresentation matches = this->representation & other.representation;
+    size_t number_of_occupied_matches = matches.count();
     Vectoru positions (number_of_occupied_matches);
 
 
     // Find the positions of the set bits in occupied_differences
     for (size_t counter = 0; counter < number_of_occupied_matches; counter++) {  // counts the number of occupied differences we have already encountered
-        size_t position = __builtin_ctzl(matches);  // count trailing zeros
+        size_t position = matches.countTrailingZeros();
         positions[counter] = position;
 
-        matches ^= matches & -matches;  // annihilate the least significant set bit
+        matches.resetLeastSignificantBit();
     }
 
     return positions;
@@ -469,9 +473,12 @@ std::vector<size_t> ONV::findMatchingOccupations(const ONV& other) const {
  *  @return a string representation of the ONV
  */
 std::string ONV::asString() const {
-    boost::dynamic_bitset<> transfer_set (this->K, this->unsigned_representation);
-    std::string buffer;
-    boost::to_string(transfer_set, buffer);
+    std::string buffer (this->K, '0');
+    for (size_t p = 0; p < this->K; p++) {
+        if (this->representation.isSet(p)) {
+            buffer[this->K - 1 - p] = '1';  // the string is read from right to left
+        }
+    }
     return buffer;
 }
 
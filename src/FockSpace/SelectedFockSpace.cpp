@@ -17,25 +17,47 @@
 // 
 #include "FockSpace/SelectedFockSpace.hpp"
 
+#include "utilities/parallel.hpp"
+
 #include <boost/dynamic_bitset.hpp>
 #include <boost/numeric/conversion/converter.hpp>
 #include <boost/math/special_functions.hpp>
 
+#include <algorithm>
+#include <string>
+
 
 namespace GQCP {
 
 
+constexpr size_t SelectedFockSpace::not_found;
+
+
+
 /*
  *  PRIVATE METHODS
  */
 
+/**
+ *  Rebuild the hash index from the current configurations
+ */
+void SelectedFockSpace::updateAddresses() {
+
+    this->addresses.clear();
+    this->addresses.reserve(this->configurations.size());
+
+    for (size_t I = 0; I < this->configurations.size(); I++) {
+        const auto& configuration = this->configurations[I];
+        this->addresses.emplace(std::make_pair(configuration.onv_alpha.get_representation(), configuration.onv_beta.get_representation()), I);
+    }
+}
+
+
 /**
  *  @param onv1     the alpha ONV as a string representation read from right to left
  *  @param onv2     the beta ONV as a string representation read from right to left
  *
  *  @return the configuration that holds both ONVs
- *
- *  IMPORTANT: only works for up to 64 bits!
  */
 Configuration SelectedFockSpace::makeConfiguration(const std::string& onv1, const std::string& onv2) const {
 
@@ -50,8 +72,16 @@ Configuration SelectedFockSpace::makeConfiguration(const std::string& onv1, cons
         throw std::invalid_argument("SelectedFockSpace::makeConfiguration(std::string, std::string): Given string representations for ONVs are not compatible with the number of orbitals of the Fock space");
     }
 
-    size_t alpha_s = alpha_transfer.to_ulong();
-    size_t beta_s = beta_transfer.to_ulong();
+    ONVRepresentation alpha_s;
+    ONVRepresentation beta_s;
+    for (size_t p = 0; p < this->K; p++) {
+        if (alpha_transfer[p]) {
+            alpha_s.set(p);
+        }
+        if (beta_transfer[p]) {
+            beta_s.set(p);
+        }
+    }
 
     ONV alpha (this->K, this->N_alpha, alpha_s);
     ONV beta (this->K, this->N_beta, beta_s);
@@ -76,7 +106,11 @@ SelectedFockSpace::SelectedFockSpace(size_t K, size_t N_alpha, size_t N_beta) :
     BaseFockSpace(K, 0),
     N_alpha (N_alpha),
     N_beta (N_beta)
-{}
+{
+    if (K > ONVRepresentation::number_of_bits) {
+        throw std::invalid_argument("SelectedFockSpace::SelectedFockSpace(size_t, size_t, size_t): The representation of an ONV cannot hold more than " + std::to_string(ONVRepresentation::number_of_bits) + " spatial orbitals.");
+    }
+}
 
 
 /**
@@ -114,6 +148,7 @@ SelectedFockSpace::SelectedFockSpace(const ProductFockSpace& fock_space) :
     }
     this->dim = fock_space.get_dimension();
     this->configurations = configurations;
+    this->updateAddresses();
 
 }
 
@@ -143,6 +178,7 @@ SelectedFockSpace::SelectedFockSpace(const FockSpace& fock_space) :
 
     this->dim = dim;
     this->configurations = configurations;
+    this->updateAddresses();
 }
 
 
@@ -180,6 +216,7 @@ SelectedFockSpace::SelectedFockSpace(const FrozenProductFockSpace& fock_space) :
     }
     this->dim = fock_space.get_dimension();
     this->configurations = configurations;
+    this->updateAddresses();
 }
 
 
@@ -203,6 +240,7 @@ SelectedFockSpace::SelectedFockSpace(const FrozenFockSpace& fock_space) :
 
     this->dim = dim;
     this->configurations = configurations;
+    this->updateAddresses();
 }
 
 /*
@@ -210,22 +248,97 @@ SelectedFockSpace::SelectedFockSpace(const FrozenFockSpace& fock_space) :
  */
 
 /**
- *  Make a configuration (see makeConfiguration()) and add it to this Fock space
+ *  @param alpha_representation     the representation of the alpha ONV
+ *  @param beta_representation      the representation of the beta ONV
  *
- *  @param onv1     the alpha ONV as a string representation read from right to left
- *  @param onv2     the beta ONV as a string representation read from right to left
+ *  @return the address of the configuration with the given representations, or SelectedFockSpace::not_found if it isn't in this Fock space
+ */
+size_t SelectedFockSpace::findAddress(const ONVRepresentation& alpha_representation, const ONVRepresentation& beta_representation) const {
+
+    auto it = this->addresses.find(std::make_pair(alpha_representation, beta_representation));
+    if (it == this->addresses.end()) {
+        return not_found;
+    }
+
+    return it->second;
+}
+
+
+/**
+ *  @param configuration        the configuration
+ *
+ *  @return the address of the given configuration, or SelectedFockSpace::not_found if it isn't in this Fock space
+ */
+size_t SelectedFockSpace::findAddress(const Configuration& configuration) const {
+    return this->findAddress(configuration.onv_alpha.get_representation(), configuration.onv_beta.get_representation());
+}
+
+
+/**
+ *  Reserve memory for a number of configurations
+ *
+ *  @param number_of_configurations     the total number of configurations that is expected
+ */
+void SelectedFockSpace::reserve(size_t number_of_configurations) {
+    this->configurations.reserve(number_of_configurations);
+    this->addresses.reserve(number_of_configurations);
+}
+
+
+/**
+ *  Add a configuration to this Fock space, if it isn't present yet
+ *
+ *  @param configuration        the configuration
+ *
+ *  @return the address of the given configuration
+ */
+size_t SelectedFockSpace::addConfiguration(const Configuration& configuration) {
+
+    if ((configuration.onv_alpha.get_K() != this->K) || (configuration.onv_beta.get_K() != this->K) || (configuration.onv_alpha.get_N() != this->N_alpha) || (configuration.onv_beta.get_N() != this->N_beta)) {
+        throw std::invalid_argument("SelectedFockSpace::addConfiguration(Configuration): The given configuration is not compatible with the number of orbitals and electrons of the Fock space");
+    }
+
+    // Only add the configuration if it isn't present yet
+    auto insertion = this->addresses.emplace(std::make_pair(configuration.onv_alpha.get_representation(), configuration.onv_beta.get_representation()), this->configurations.size());
+    if (insertion.second) {
+        this->configurations.push_back(configuration);
+        this->dim++;
+    }
+
+    return insertion.first->second;
+}
+
+
+/**
+ *  Add configurations to this Fock space, skipping the ones that are already present
+ *
+ *  @param configurations       the configurations
  */
-void SelectedFockSpace::addConfiguration(const std::string& onv1, const std::string& onv2) {
+void SelectedFockSpace::addConfiguration(const std::vector<Configuration>& configurations) {
+
+    this->reserve(this->configurations.size() + configurations.size());
 
-    this->dim++;
+    for (const auto& configuration : configurations) {
+        this->addConfiguration(configuration);
+    }
+}
 
-    Configuration configuration = makeConfiguration(onv1, onv2);
-    configurations.push_back(configuration);
+
+/**
+ *  Make a configuration (see makeConfiguration()) and add it to this Fock space, if it isn't present yet
+ *
+ *  @param onv1     the alpha ONV as a string representation read from right to left
+ *  @param onv2     the beta ONV as a string representation read from right to left
+ *
+ *  @return the address of the configuration
+ */
+size_t SelectedFockSpace::addConfiguration(const std::string& onv1, const std::string& onv2) {
+    return this->addConfiguration(this->makeConfiguration(onv1, onv2));
 }
 
 
 /**
- *  Make configurations (see makeConfiguration()) and add them to the Fock space
+ *  Make configurations (see makeConfiguration()) and add them to the Fock space, skipping the ones that are already present
  *
  *  @param onv1s     the alpha ONVs as string representations read from right to left
  *  @param onv2s     the beta ONVs as string representations read from right to left
@@ -236,10 +349,133 @@ void SelectedFockSpace::addConfiguration(const std::vector<std::string>& onv1s,
         throw std::invalid_argument("SelectedFockSpace::addConfiguration(const std::string&, const std::string&): Size of both ONV entry vectors do not match");
     }
 
+    this->reserve(this->configurations.size() + onv1s.size());
+
     for (size_t i = 0; i < onv1s.size(); i++) {
         this->addConfiguration(onv1s[i], onv2s[i]);
     }
 }
 
 
+/**
+ *  Sort the configurations by their alpha and then their beta representation, so that configurations sharing an alpha ONV are contiguous
+ *
+ *  Note that this changes the addresses of the configurations
+ */
+void SelectedFockSpace::sort() {
+
+    std::stable_sort(this->configurations.begin(), this->configurations.end(), [] (const Configuration& lhs, const Configuration& rhs) {
+        const auto& lhs_alpha = lhs.onv_alpha.get_representation();
+        const auto& rhs_alpha = rhs.onv_alpha.get_representation();
+
+        return (lhs_alpha < rhs_alpha) || ((lhs_alpha == rhs_alpha) && (lhs.onv_beta.get_representation() < rhs.onv_beta.get_representation()));
+    });
+
+    this->updateAddresses();
+}
+
+
+/**
+ *  Find, for every configuration, the configurations that are at most doubly excited with respect to it
+ *
+ *  @return for every address I, the sorted addresses J > I of the configurations that differ from configuration I by a single or double excitation
+ */
+std::vector<std::vector<size_t>> SelectedFockSpace::calculateConnections() const {
+
+    const size_t dim = this->configurations.size();
+
+    // Gather the unique alpha and beta ONVs and group the configurations by them
+    std::unordered_map<ONVRepresentation, size_t> alpha_indices;  // maps an alpha representation to its index in the unique alpha list
+    std::unordered_map<ONVRepresentation, size_t> beta_indices;  // maps a beta representation to its index in the unique beta list
+    std::vector<ONVRepresentation> unique_alpha_representations;
+    std::vector<std::vector<size_t>> configurations_per_alpha;  // the addresses of the configurations that contain a unique alpha ONV
+    std::vector<std::vector<size_t>> configurations_per_beta;  // the addresses of the configurations that contain a unique beta ONV
+    std::vector<size_t> alpha_index_of (dim);
+    std::vector<size_t> beta_index_of (dim);
+
+    for (size_t I = 0; I < dim; I++) {
+        const auto& configuration = this->configurations[I];
+
+        auto alpha_insertion = alpha_indices.emplace(configuration.onv_alpha.get_representation(), unique_alpha_representations.size());
+        if (alpha_insertion.second) {
+            unique_alpha_representations.push_back(configuration.onv_alpha.get_representation());
+            configurations_per_alpha.emplace_back();
+        }
+        alpha_index_of[I] = alpha_insertion.first->second;
+        configurations_per_alpha[alpha_index_of[I]].push_back(I);
+
+        auto beta_insertion = beta_indices.emplace(configuration.onv_beta.get_representation(), configurations_per_beta.size());
+        if (beta_insertion.second) {
+            configurations_per_beta.emplace_back();
+        }
+        beta_index_of[I] = beta_insertion.first->second;
+        configurations_per_beta[beta_index_of[I]].push_back(I);
+    }
+
+
+    // For every unique alpha ONV, find the unique alpha ONVs that are singly excited with respect to it
+    std::vector<std::vector<size_t>> alpha_single_excitations (unique_alpha_representations.size());
+    for (size_t a = 0; a < unique_alpha_representations.size(); a++) {
+        const ONVRepresentation& representation = unique_alpha_representations[a];
+
+        for (size_t p = 0; p < this->K; p++) {  // p annihilates
+            if (!representation.isSet(p)) {
+                continue;
+            }
+
+            for (size_t q = 0; q < this->K; q++) {  // q creates
+                if (representation.isSet(q)) {
+                    continue;
+                }
+
+                ONVRepresentation excited_representation = representation;
+                excited_representation.reset(p);
+                excited_representation.set(q);
+                auto it = alpha_indices.find(excited_representation);
+                if (it != alpha_indices.end()) {
+                    alpha_single_excitations[a].push_back(it->second);
+                }
+            }
+        }
+    }
+
+
+    // Every configuration only writes to its own list. Since only J > I is stored, the work decreases with I, so the configurations are handed out dynamically
+    std::vector<std::vector<size_t>> connections (dim);
+    parallelForDynamic(0, dim, [&] (size_t I, size_t) {
+        const ONV& alpha_I = this->configurations[I].onv_alpha;
+        const ONV& beta_I = this->configurations[I].onv_beta;
+
+        auto& connections_I = connections[I];
+
+        // Excitations in beta only: go over the configurations with the same alpha ONV
+        for (size_t J : configurations_per_alpha[alpha_index_of[I]]) {
+            if ((J > I) && (beta_I.countNumberOfDifferences(this->configurations[J].onv_beta) <= 4)) {
+                connections_I.push_back(J);
+            }
+        }
+
+        // Excitations in alpha only: go over the configurations with the same beta ONV
+        for (size_t J : configurations_per_beta[beta_index_of[I]]) {
+            if ((J > I) && (alpha_I.countNumberOfDifferences(this->configurations[J].onv_alpha) <= 4)) {
+                connections_I.push_back(J);
+            }
+        }
+
+        // Mixed excitations: go over the configurations containing a singly excited alpha ONV, whose beta ONV should be singly excited as well
+        for (size_t a : alpha_single_excitations[alpha_index_of[I]]) {
+            for (size_t J : configurations_per_alpha[a]) {
+                if ((J > I) && (beta_I.countNumberOfDifferences(this->configurations[J].onv_beta) == 2)) {
+                    connections_I.push_back(J);
+                }
+            }
+        }
+
+        std::sort(connections_I.begin(), connections_I.end());
+    });
+
+    return connections;
+}
+
+
 }  // namespace GQCP
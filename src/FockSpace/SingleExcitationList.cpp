@@ -0,0 +1,231 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "FockSpace/SingleExcitationList.hpp"
+
+#include "FockSpace/FockSpace.hpp"
+#include "utilities/MappedFile.hpp"
+#include "utilities/parallel.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+
+namespace GQCP {
+
+
+constexpr size_t SingleExcitation::max_address;
+
+
+
+/*
+ *  PRIVATE CONSTRUCTORS
+ */
+
+/**
+ *  Allocate the list of single excitations for a Fock space with K orbitals, N electrons and the given dimension, without filling it in
+ *
+ *  @param K        the number of orbitals
+ *  @param N        the number of electrons
+ *  @param dim      the dimension of the Fock space
+ */
+SingleExcitationList::SingleExcitationList(size_t K, size_t N, size_t dim) :
+    K (K),
+    N (N)
+{
+    if ((dim > 0) && (dim - 1 > SingleExcitation::max_address)) {
+        throw std::invalid_argument("SingleExcitationList::SingleExcitationList(size_t, size_t, size_t): The addresses of the Fock space don't fit in a packed single excitation.");
+    }
+
+    // Every ONV has N annihilations, each followed by (K-N) creations in an unoccupied orbital and the creation in the annihilated orbital itself, so the rows all have the same length
+    const size_t excitations_per_onv = N * (K - N + 1);
+    this->offsets = Vectoru(dim + 1);
+    for (size_t I = 0; I < dim + 1; I++) {
+        this->offsets[I] = I * excitations_per_onv;
+    }
+    this->excitations = std::vector<SingleExcitation>(dim * excitations_per_onv);
+}
+
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  Generate all single excitations of the given Fock space
+ *
+ *  @param fock_space       the Fock space
+ */
+SingleExcitationList::SingleExcitationList(const FockSpace& fock_space) :
+    SingleExcitationList (fock_space.get_K(), fock_space.get_N(), fock_space.get_dimension())
+{
+    const size_t K = this->K;
+    const size_t dim = fock_space.get_dimension();
+
+    // Every ONV fills in its own part of the list, so the ONVs can be handled in parallel
+    parallelFor(0, dim, [this, &fock_space, K] (size_t I_begin, size_t I_end) {
+
+        ONVRepresentation representation = fock_space.calculateRepresentation(I_begin);
+        for (size_t I = I_begin; I < I_end; I++) {
+
+            SingleExcitation* excitation = this->excitations.data() + this->offsets[I];
+
+            ONVRepresentation occupied = representation;
+            while (!occupied.none()) {
+                size_t q = occupied.countTrailingZeros();  // the annihilated orbital
+                occupied.resetLeastSignificantBit();
+
+                for (size_t p = 0; p < K; p++) {
+                    if ((p != q) && representation.isSet(p)) {  // we can't create an electron in an occupied orbital
+                        continue;
+                    }
+
+                    size_t J = I;
+                    int sign = 1;
+                    if (p != q) {
+                        ONVRepresentation excited_representation = representation;
+                        excited_representation.reset(q);
+                        excited_representation.set(p);
+                        J = fock_space.getAddress(excited_representation);
+
+                        // The phase factor is determined by the number of electrons in the orbitals between p and q
+                        size_t lower = std::min(p, q);
+                        size_t upper = std::max(p, q);
+                        if ((representation.countBefore(upper) - representation.countBefore(lower + 1)) % 2 == 1) {
+                            sign = -1;
+                        }
+                    }
+
+                    *excitation = SingleExcitation {p, q, J, sign};
+                    excitation++;
+                }
+            }
+
+            if (I < I_end - 1) {
+                representation = fock_space.nextPermutation(representation);
+            }
+        }
+    });
+}
+
+
+
+/*
+ *  NAMED CONSTRUCTORS
+ */
+
+/**
+ *  @param filename     the name of a binary single excitation file (see the class documentation for the format)
+ *
+ *  @return the single excitations in the given file, which is mapped into memory to read them
+ */
+SingleExcitationList SingleExcitationList::ReadBinary(const std::string& filename) {
+
+    MappedFile file (filename);
+
+    // Read the header
+    char magic[8];
+    std::uint64_t header[4];  // the version, K, N and the dimension
+    if (file.get_size() < sizeof(magic) + sizeof(header)) {
+        throw std::invalid_argument("SingleExcitationList::ReadBinary(std::string): The given file is not a binary single excitation file.");
+    }
+    std::memcpy(magic, file.get_data(), sizeof(magic));
+    std::memcpy(header, file.get_data() + sizeof(magic), sizeof(header));
+
+    if (std::memcmp(magic, "GQCPSEXL", sizeof(magic)) != 0) {
+        throw std::invalid_argument("SingleExcitationList::ReadBinary(std::string): The given file is not a binary single excitation file.");
+    }
+    if (header[0] != 1) {
+        throw std::invalid_argument("SingleExcitationList::ReadBinary(std::string): The binary single excitation file has an unsupported version.");
+    }
+
+    const size_t K = header[1];
+    const size_t N = header[2];
+    const size_t dim = header[3];
+
+    // Validate the header against the size of the file before allocating anything
+    //  Since K and the dimension are bounded first, the expected size can't overflow
+    bool header_is_valid = (N <= K) && (K <= ONVRepresentation::number_of_bits) && (dim > 0) && (dim - 1 <= SingleExcitation::max_address) && (file.get_size() - sizeof(magic) - sizeof(header) == dim * N * (K - N + 1) * sizeof(SingleExcitation));
+    try {
+        header_is_valid = header_is_valid && (dim == FockSpace::calculateDimension(K, N));
+    } catch (std::overflow_error&) {
+        header_is_valid = false;
+    }
+
+    if (!header_is_valid) {
+        throw std::invalid_argument("SingleExcitationList::ReadBinary(std::string): The header doesn't match the size of the binary single excitation file.");
+    }
+
+
+    // Read the packed excitations
+    SingleExcitationList single_excitations (K, N, dim);
+    std::memcpy(single_excitations.excitations.data(), file.get_data() + sizeof(magic) + sizeof(header), single_excitations.excitations.size() * sizeof(SingleExcitation));
+
+    return single_excitations;
+}
+
+
+
+/*
+ *  STATIC PUBLIC METHODS
+ */
+
+/**
+ *  @param K        the number of orbitals
+ *  @param N        the number of electrons
+ *
+ *  @return the number of bytes that are needed to store the single excitation list of the Fock space with K orbitals and N electrons
+ */
+size_t SingleExcitationList::calculateMemoryRequirement(size_t K, size_t N) {
+
+    size_t dim = FockSpace::calculateDimension(K, N);
+    return dim * N * (K - N + 1) * sizeof(SingleExcitation) + (dim + 1) * sizeof(size_t);
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  Write the single excitations to a binary file (see the class documentation for the format)
+ *
+ *  @param filename     the name of the binary single excitation file
+ */
+void SingleExcitationList::writeBinary(const std::string& filename) const {
+
+    std::ofstream output_file_stream (filename, std::ios::binary);
+    if (!output_file_stream.good()) {
+        throw std::runtime_error("SingleExcitationList::writeBinary(std::string): The file " + filename + " could not be opened for writing.");
+    }
+
+    std::uint64_t header[4] = {1, this->K, this->N, this->get_dimension()};  // the version, K, N and the dimension
+    output_file_stream.write("GQCPSEXL", 8);
+    output_file_stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+    output_file_stream.write(reinterpret_cast<const char*>(this->excitations.data()), this->excitations.size() * sizeof(SingleExcitation));
+
+    if (!output_file_stream.good()) {
+        throw std::runtime_error("SingleExcitationList::writeBinary(std::string): Something went wrong while writing " + filename + ".");
+    }
+}
+
+
+}  // namespace GQCP
@@ -17,6 +17,8 @@
 // 
 #include "HamiltonianBuilder/DOCI.hpp"
 
+#include "utilities/parallel.hpp"
+
 
 namespace GQCP {
 
@@ -36,32 +38,28 @@ DOCI::DOCI(const FockSpace& fock_space) :
 
 
 /*
- *  OVERRIDDEN PUBLIC METHODS
+ *  PRIVATE METHODS
  */
 
 /**
- *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *  Evaluate the off-diagonal elements of the DOCI Hamiltonian, i.e. the pair hopping couplings between different ONVs
  *
- *  @return the DOCI Hamiltonian matrix
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *  @param method                       the method that is called for every coupling H(I,J), in both the upper and the lower half
  */
-SquareMatrix<double> DOCI::constructHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const {
-    
-    auto K = hamiltonian_parameters.get_h().get_dim();
-    if (K != this->fock_space.get_K()) {
-        throw std::invalid_argument("DOCI::constructHamiltonian(HamiltonianParameters<double>): The number of orbitals for the Fock space and Hamiltonian parameters are incompatible.");
-    }
+void DOCI::evaluateHamiltonianElements(const HamiltonianParameters<double>& hamiltonian_parameters, const PassToMethod& method) const {
+
+    size_t K = this->fock_space.get_K();
     size_t dim = this->fock_space.get_dimension();
-    VectorX<double> diagonal = calculateDiagonal(hamiltonian_parameters);
-    SquareMatrix<double> result_matrix = SquareMatrix<double>::Zero(dim, dim);
     size_t N = this->fock_space.get_N();
+    auto pair_integrals = hamiltonian_parameters.get_pair_integrals();
+    const auto& pair_hopping = pair_integrals->get_pair_hopping();  // g(p,q,p,q)
 
     // Create the first spin string. Since in DOCI, alpha == beta, we can just treat them as one and multiply all contributions by 2
     ONV onv = this->fock_space.makeONV(0);  // spin string with address 0
 
     for (size_t I = 0; I < dim; I++) {  // I loops over all the addresses of the onv
 
-        result_matrix(I, I) += diagonal(I);
-
         for (size_t e1 = 0; e1 < N; e1++) {  // e1 (electron 1) loops over the (number of) electrons
             size_t p = onv.get_occupation_index(e1);  // retrieve the index of a given electron
 
@@ -79,8 +77,8 @@ SquareMatrix<double> DOCI::constructHamiltonian(const HamiltonianParameters<doub
             while (q < K) {
                 size_t J = address + this->fock_space.get_vertex_weights(q, e2);
 
-                result_matrix(I, J) += hamiltonian_parameters.get_g()(p, q, p, q);
-                result_matrix(J, I) += hamiltonian_parameters.get_g()(p, q, p, q);
+                method(I, J, pair_hopping(p, q));
+                method(J, I, pair_hopping(p, q));
 
                 q++;  // go to the next orbital
 
@@ -98,7 +96,32 @@ SquareMatrix<double> DOCI::constructHamiltonian(const HamiltonianParameters<doub
 
 
     }  // address (I) loop
+}
+
+
+
+/*
+ *  OVERRIDDEN PUBLIC METHODS
+ */
+
+/**
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the DOCI Hamiltonian matrix
+ */
+SquareMatrix<double> DOCI::constructHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const {
+    
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("DOCI::constructHamiltonian(HamiltonianParameters<double>): The number of orbitals for the Fock space and Hamiltonian parameters are incompatible.");
+    }
 
+    size_t dim = this->fock_space.get_dimension();
+    SquareMatrix<double> result_matrix = SquareMatrix<double>::Zero(dim, dim);
+    result_matrix.diagonal() = this->calculateDiagonal(hamiltonian_parameters);
+
+    auto addToMatrix = [&result_matrix](size_t I, size_t J, double value) { result_matrix(I, J) += value; };
+    this->evaluateHamiltonianElements(hamiltonian_parameters, addToMatrix);
 
     return result_matrix;
 }
@@ -118,62 +141,217 @@ VectorX<double> DOCI::matrixVectorProduct(const HamiltonianParameters<double>& h
         throw std::invalid_argument("DOCI::matrixVectorProduct(HamiltonianParameters<double>, VectorX<double>, VectorX<double>): The number of orbitals for the Fock space and Hamiltonian parameters are incompatible.");
     }
     size_t dim = this->fock_space.get_dimension();
-
-    // Create the first spin string. Since in DOCI, alpha == beta, we can just treat them as one and multiply all contributions by 2
-    ONV onv = this->fock_space.makeONV(0);  // spin string with address
     size_t N = this->fock_space.get_N();
+    auto pair_integrals = hamiltonian_parameters.get_pair_integrals();
+    const auto& pair_hopping = pair_integrals->get_pair_hopping();  // g(p,q,p,q): the only two-electron integrals that couple DOCI ONVs
 
     // Diagonal contributions
     VectorX<double> matvec = diagonal.cwiseProduct(x);
 
-    for (size_t I = 0; I < dim; I++) {  // I loops over all the addresses of the onv
+    // Every thread gathers the contributions for a contiguous range of addresses: since only matvec(I) is written, no synchronization is needed
+    parallelFor(0, dim, [this, &pair_hopping, &x, &matvec, K, N] (size_t begin, size_t end) {
 
-        // double_I and J reduce vector accessing and writing
-        double double_I = 0;
-        double double_J = x(I);
+        // Since in DOCI, alpha == beta, we can just treat them as one and multiply all contributions by 2
+        ONV onv = this->fock_space.makeONV(begin);  // start at the first address of this range, without walking through the previous ones
 
-        for (size_t e1 = 0; e1 < N; e1++) {  // e1 (electron 1) loops over the (number of) electrons
-            size_t p = onv.get_occupation_index(e1);  // retrieve the index of a given electron
+        for (size_t I = begin; I < end; I++) {  // I loops over the addresses of this range
 
-            // Remove the weight from the initial address I, because we annihilate
-            size_t address = I - this->fock_space.get_vertex_weights(p, e1 + 1);
-            // The e2 iteration counts the amount of encountered electrons for the creation operator
-            // We only consider greater addresses than the initial one (because of symmetry)
-            // Hence we only count electron after the annihilated electron (e1)
-            size_t e2 = e1 + 1;
-            size_t q = p + 1;
+            double value_I = 0;
 
-            // perform a shift
-            this->fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2);
+            for (size_t e1 = 0; e1 < N; e1++) {  // e1 (electron 1) loops over the (number of) electrons
+                size_t p = onv.get_occupation_index(e1);  // retrieve the index of a given electron
 
-            while (q < K) {
-                size_t J = address + this->fock_space.get_vertex_weights(q, e2);
+                // Remove the weight from the initial address I, because we annihilate
+                size_t address = I - this->fock_space.get_vertex_weights(p, e1 + 1);
 
-                double_I += hamiltonian_parameters.get_g()(p, q, p, q) * x(J);
-                matvec(J) += hamiltonian_parameters.get_g()(p, q, p, q) * double_J;
+                // Create in the orbitals after p: the electrons encountered in between shift one electron index down
+                size_t e2 = e1 + 1;
+                size_t q = p + 1;
+                this->fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2);
 
-                q++;  // go to the next orbital
+                while (q < K) {
+                    size_t J = address + this->fock_space.get_vertex_weights(q, e2);
+                    value_I += pair_hopping(p, q) * x(J);
 
-                // perform a shift
-                this->fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2);
+                    q++;  // go to the next orbital
+                    this->fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2);
+                }
 
-            }  // (creation)
+                // Create in the orbitals before p: the electrons encountered in between shift one electron index up
+                // The sign isn't needed, since the alpha and beta signs cancel in DOCI
+                int sign = 1;
+                address = I - this->fock_space.get_vertex_weights(p, e1 + 1);
+                e2 = e1 - 1;  // may wrap around for e1 == 0, which is recognized as -1
+                q = p - 1;  // may wrap around for p == 0, which is recognized as -1
+                this->fock_space.shiftUntilPreviousUnoccupiedOrbital<1>(onv, address, q, e2, sign);
 
-        } // e1 loop (annihilation)
+                while (q != static_cast<size_t>(-1)) {
+                    size_t J = address + this->fock_space.get_vertex_weights(q, e2 + 2);
+                    value_I += pair_hopping(q, p) * x(J);
 
-        // Prevent last permutation
-        if (I < dim - 1) {
-            this->fock_space.setNextONV(onv);
-        }
+                    q--;  // go to the previous orbital
+                    this->fock_space.shiftUntilPreviousUnoccupiedOrbital<1>(onv, address, q, e2, sign);
+                }
+            } // e1 loop (annihilation)
 
-        matvec(I) += double_I;
+            matvec(I) += value_I;
 
-    }  // address (I) loop
+            // Prevent the permutation after the last address of this range
+            if (I < end - 1) {
+                this->fock_space.setNextONV(onv);
+            }
+        }  // address (I) loop
+    });
 
     return matvec;
 }
 
 
+/**
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *  @param X                            the vectors upon which the DOCI Hamiltonian acts, as the columns of a (dim x m)-matrix
+ *  @param diagonal                     the diagonal of the DOCI Hamiltonian matrix
+ *
+ *  @return the action of the DOCI Hamiltonian on every column of X
+ */
+MatrixX<double> DOCI::blockMatrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const MatrixX<double>& X, const VectorX<double>& diagonal) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("DOCI::blockMatrixVectorProduct(HamiltonianParameters<double>, MatrixX<double>, VectorX<double>): The number of orbitals for the Fock space and Hamiltonian parameters are incompatible.");
+    }
+    size_t dim = this->fock_space.get_dimension();
+    auto pair_integrals = hamiltonian_parameters.get_pair_integrals();
+    const auto& pair_hopping = pair_integrals->get_pair_hopping();  // g(p,q,p,q): the only two-electron integrals that couple DOCI ONVs
+
+    // Work with the transposed vectors, so that the coefficients of one ONV for all vectors are contiguous
+    MatrixX<double> X_transposed = X.transpose();
+    MatrixX<double> matvecs_transposed = MatrixX<double>::Zero(X.cols(), dim);
+    size_t N = this->fock_space.get_N();
+
+    // Every thread gathers the contributions for a contiguous range of addresses: since only column I is written, no synchronization is needed
+    parallelFor(0, dim, [this, &pair_hopping, &X_transposed, &matvecs_transposed, K, N] (size_t begin, size_t end) {
+
+        // Since in DOCI, alpha == beta, we can just treat them as one and multiply all contributions by 2
+        ONV onv = this->fock_space.makeONV(begin);  // start at the first address of this range, without walking through the previous ones
+
+        for (size_t I = begin; I < end; I++) {  // I loops over the addresses of this range
+
+            for (size_t e1 = 0; e1 < N; e1++) {  // e1 (electron 1) loops over the (number of) electrons
+                size_t p = onv.get_occupation_index(e1);  // retrieve the index of a given electron
+
+                // Remove the weight from the initial address I, because we annihilate
+                size_t address = I - this->fock_space.get_vertex_weights(p, e1 + 1);
+
+                // Create in the orbitals after p: the electrons encountered in between shift one electron index down
+                size_t e2 = e1 + 1;
+                size_t q = p + 1;
+                this->fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2);
+
+                while (q < K) {
+                    size_t J = address + this->fock_space.get_vertex_weights(q, e2);
+
+                    // Every coupling (and its integral) is used for all vectors at once
+                    matvecs_transposed.col(I) += pair_hopping(p, q) * X_transposed.col(J);
+
+                    q++;  // go to the next orbital
+                    this->fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2);
+                }
+
+                // Create in the orbitals before p: the electrons encountered in between shift one electron index up
+                // The sign isn't needed, since the alpha and beta signs cancel in DOCI
+                int sign = 1;
+                address = I - this->fock_space.get_vertex_weights(p, e1 + 1);
+                e2 = e1 - 1;  // may wrap around for e1 == 0, which is recognized as -1
+                q = p - 1;  // may wrap around for p == 0, which is recognized as -1
+                this->fock_space.shiftUntilPreviousUnoccupiedOrbital<1>(onv, address, q, e2, sign);
+
+                while (q != static_cast<size_t>(-1)) {
+                    size_t J = address + this->fock_space.get_vertex_weights(q, e2 + 2);
+                    matvecs_transposed.col(I) += pair_hopping(q, p) * X_transposed.col(J);
+
+                    q--;  // go to the previous orbital
+                    this->fock_space.shiftUntilPreviousUnoccupiedOrbital<1>(onv, address, q, e2, sign);
+                }
+            } // e1 loop (annihilation)
+
+            // Prevent the permutation after the last address of this range
+            if (I < end - 1) {
+                this->fock_space.setNextONV(onv);
+            }
+        }  // address (I) loop
+    });
+
+    return diagonal.asDiagonal() * X + matvecs_transposed.transpose();
+}
+
+
+/**
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the compressed sparse representation of the DOCI Hamiltonian matrix, assembled from the evaluated elements
+ */
+Eigen::SparseMatrix<double> DOCI::constructSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("DOCI::constructSparseHamiltonian(HamiltonianParameters<double>): The number of orbitals for the Fock space and Hamiltonian parameters are incompatible.");
+    }
+
+    size_t dim = this->fock_space.get_dimension();
+    size_t N = this->fock_space.get_N();
+    VectorX<double> diagonal = this->calculateDiagonal(hamiltonian_parameters);
+
+    // Every ONV couples to N*(K-N) other ONVs through a pair hopping
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(dim * (1 + N * (K - N)));
+    for (size_t I = 0; I < dim; I++) {
+        triplets.emplace_back(static_cast<int>(I), static_cast<int>(I), diagonal(I));
+    }
+
+    auto addToTriplets = [&triplets](size_t I, size_t J, double value) { triplets.emplace_back(static_cast<int>(I), static_cast<int>(J), value); };
+    this->evaluateHamiltonianElements(hamiltonian_parameters, addToTriplets);
+
+    Eigen::SparseMatrix<double> result_matrix (dim, dim);
+    result_matrix.setFromTriplets(triplets.begin(), triplets.end());
+    return result_matrix;
+}
+
+
+/**
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the DOCI Hamiltonian matrix, assembled from the evaluated elements in its upper half
+ */
+SymmetricSparseMatrix<double> DOCI::constructSymmetricSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("DOCI::constructSymmetricSparseHamiltonian(HamiltonianParameters<double>): The number of orbitals for the Fock space and Hamiltonian parameters are incompatible.");
+    }
+
+    size_t dim = this->fock_space.get_dimension();
+    size_t N = this->fock_space.get_N();
+    VectorX<double> diagonal = this->calculateDiagonal(hamiltonian_parameters);
+
+    // Only collect the elements in the upper triangle: the lower ones follow from symmetry
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(dim * (1 + N * (K - N) / 2));
+    for (size_t I = 0; I < dim; I++) {
+        triplets.emplace_back(static_cast<int>(I), static_cast<int>(I), diagonal(I));
+    }
+
+    auto addToTriplets = [&triplets](size_t I, size_t J, double value) {
+        if (I < J) {
+            triplets.emplace_back(static_cast<int>(I), static_cast<int>(J), value);
+        }
+    };
+    this->evaluateHamiltonianElements(hamiltonian_parameters, addToTriplets);
+
+    return SymmetricSparseMatrix<double>(dim, triplets);
+}
+
+
 /**
  *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
  *
@@ -187,33 +365,41 @@ VectorX<double> DOCI::calculateDiagonal(const HamiltonianParameters<double>& ham
     }
 
     size_t dim = this->fock_space.get_dimension();
-    VectorX<double> diagonal = VectorX<double>::Zero(dim);
-
-    // Create the first spin string. Since in DOCI, alpha == beta, we can just treat them as one and multiply all contributions by 2
-    ONV onv = this->fock_space.makeONV(0);  // onv with address 0
-
-    for (size_t I = 0; I < dim; I++) {  // I loops over addresses of spin strings
-        double double_I = 0;
-        for (size_t e1 = 0; e1 < this->fock_space.get_N(); e1++) {  // e1 (electron 1) loops over the (number of) electrons
-            size_t p = onv.get_occupation_index(e1);  // retrieve the index of the orbital the electron occupies
-            double_I += 2 * hamiltonian_parameters.get_h()(p,p) + hamiltonian_parameters.get_g()(p,p,p,p);
-            for (size_t e2 = 0; e2 < e1; e2++) {  // e2 (electron 2) loops over the (number of) electrons
-                // Since we are doing a restricted summation q<p (and thus e2<e1), we should multiply by 2 since the summand argument is symmetric.
-                size_t q = onv.get_occupation_index(e2);  // retrieve the index of the orbital the electron occupies
-                double_I += 2 * (2*hamiltonian_parameters.get_g()(p,p,q,q) - hamiltonian_parameters.get_g()(p,q,q,p));
-            }  // q or e2 loop
-        } // p or e1 loop
-
-        diagonal(I) += double_I;
-
-        // Skip the last permutation
-        if (I < dim-1) {
-            this->fock_space.setNextONV(onv);
-        }
+    size_t N = this->fock_space.get_N();
+    const auto& h = hamiltonian_parameters.get_h();
+    auto pair_integrals = hamiltonian_parameters.get_pair_integrals();
+    const auto& coulomb = pair_integrals->get_coulomb();  // g(p,p,q,q)
+    const auto& exchange = pair_integrals->get_exchange();  // g(p,q,q,p)
 
+    VectorX<double> diagonal = VectorX<double>::Zero(dim);
 
+    // Every thread calculates the diagonal elements for a contiguous range of addresses
+    parallelFor(0, dim, [this, &h, &coulomb, &exchange, &diagonal, N] (size_t begin, size_t end) {
+
+        // Since in DOCI, alpha == beta, we can just treat them as one and multiply all contributions by 2
+        ONV onv = this->fock_space.makeONV(begin);  // start at the first address of this range, without walking through the previous ones
+
+        for (size_t I = begin; I < end; I++) {  // I loops over the addresses of this range
+            double double_I = 0;
+            for (size_t e1 = 0; e1 < N; e1++) {  // e1 (electron 1) loops over the (number of) electrons
+                size_t p = onv.get_occupation_index(e1);  // retrieve the index of the orbital the electron occupies
+                double_I += 2 * h(p,p) + coulomb(p,p);
+                for (size_t e2 = 0; e2 < e1; e2++) {  // e2 (electron 2) loops over the (number of) electrons
+                    // Since we are doing a restricted summation q<p (and thus e2<e1), we should multiply by 2 since the summand argument is symmetric.
+                    size_t q = onv.get_occupation_index(e2);  // retrieve the index of the orbital the electron occupies
+                    double_I += 2 * (2*coulomb(p,q) - exchange(p,q));
+                }  // q or e2 loop
+            } // p or e1 loop
+
+            diagonal(I) = double_I;
+
+            // Skip the permutation after the last address of this range
+            if (I < end - 1) {
+                this->fock_space.setNextONV(onv);
+            }
+        }  // address (I) loop
+    });
 
-    }  // address (I) loop
     return diagonal;
 }
 
@@ -32,8 +32,8 @@ FCI::FCI(const ProductFockSpace& fock_space) :
         HamiltonianBuilder(),
         fock_space (fock_space)
 {
-    FockSpace alpha_fock_space = fock_space.get_fock_space_alpha();
-    this->alpha_couplings = this->calculateOneElectronCouplingsIntermediates(alpha_fock_space);
+    SingleExcitationList alpha_single_excitations (fock_space.get_fock_space_alpha());  // only needed here, so we don't keep it alive on the Fock space
+    this->alpha_couplings = std::make_shared<const std::vector<Eigen::SparseMatrix<double>>>(this->calculateOneElectronCouplingsIntermediates(alpha_single_excitations));
 }
 
 
@@ -243,64 +243,43 @@ Eigen::SparseMatrix<double> FCI::calculateSpinSeparatedHamiltonian(const FockSpa
  *
  *  @param r                        First index of the two-electron integral
  *  @param s                        Second index of the two-electron integral
- *  @param fock_space               Fock space for the spin specific Hamiltonian
  *  @param hamiltonian_parameters   The Hamiltonian parameters in an orthonormal orbital basis
+ *  @param single_excitations       the single excitations of the (spin) Fock space
  *
  *  @return The sparse matrix containing the calculated two-electron integrals mapped to one-electron couplings
  */
-Eigen::SparseMatrix<double> FCI::calculateTwoElectronIntermediate(size_t r, size_t s, const HamiltonianParameters<double>& hamiltonian_parameters, const FockSpace& fock_space) const {
+Eigen::SparseMatrix<double> FCI::calculateTwoElectronIntermediate(size_t r, size_t s, const HamiltonianParameters<double>& hamiltonian_parameters, const SingleExcitationList& single_excitations) const {
 
     const bool do_diagonal = (r != s);
 
-    size_t K = fock_space.get_K();
-    size_t N = fock_space.get_N();
-    size_t dim = fock_space.get_dimension();
+    size_t K = single_excitations.get_K();
+    size_t N = single_excitations.get_N();
+    size_t dim = single_excitations.get_dimension();
     Eigen::SparseMatrix<double> sparse_matrix(dim, dim);
     std::vector<Eigen::Triplet<double>> triplet_vector;
 
     size_t mod = 0;
     if (do_diagonal){  // we will need to reserve more memory if we do inplace-couplings/diagonal
-        mod += dim;
+        mod += dim * N;
     }
 
-    triplet_vector.reserve(fock_space.countTotalOneElectronCouplings() + mod);
-    ONV onv = fock_space.makeONV(0);  // onv with address 0
+    triplet_vector.reserve(dim * N * (K - N) + mod);
+    const auto& g = hamiltonian_parameters.get_g();
     for (size_t I = 0; I < dim; I++) {  // I loops over all the addresses of the onv
-        for (size_t e1 = 0; e1 < N; e1++) {  // e1 (electron 1) loops over the (number of) electrons
-            size_t p = onv.get_occupation_index(e1);  // retrieve the index of a given electron
-            // remove the weight from the initial address I, because we annihilate
-            size_t address = I - fock_space.get_vertex_weights(p, e1 + 1);
-
-            if(do_diagonal){
-                triplet_vector.emplace_back(I, I, hamiltonian_parameters.get_g()(r, s, p, p));
-            }
-
-            // The e2 iteration counts the amount of encountered electrons for the creation operator
-            // We only consider greater addresses than the initial one (because of symmetry)
-            // Hence we only count electron after the annihilated electron (e1)
-            size_t e2 = e1 + 1;
-            size_t q = p + 1;
+        for (const SingleExcitation* excitation = single_excitations.begin(I); excitation != single_excitations.end(I); excitation++) {
+            size_t p = excitation->get_p();  // the created orbital
+            size_t q = excitation->get_q();  // the annihilated orbital
 
-            int sign_e2 = 1;
-            // perform a shift
-            fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2, sign_e2);
-
-            while (q < K) {
-                size_t J = address + fock_space.get_vertex_weights(q, e2);
-                double value = sign_e2*hamiltonian_parameters.get_g()(r, s, p, q);
+            if (p == q) {
+                if (do_diagonal) {
+                    triplet_vector.emplace_back(I, I, g(r, s, p, p));
+                }
+            } else if (p > q) {  // we only consider the excitations to greater addresses (because of symmetry)
+                size_t J = excitation->get_J();
+                double value = excitation->get_sign() * g(r, s, q, p);
                 triplet_vector.emplace_back(I, J, value);
                 triplet_vector.emplace_back(J, I, value);
-
-                q++; // go to the next orbital
-
-                // perform a shift
-                fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2, sign_e2);
-            }  //  (creation)
-        } // e1 loop (annihilation)
-
-        // Prevent last permutation
-        if (I < dim - 1) {
-            fock_space.setNextONV(onv);
+            }
         }
     }
     sparse_matrix.setFromTriplets(triplet_vector.begin(),triplet_vector.end());
@@ -312,14 +291,16 @@ Eigen::SparseMatrix<double> FCI::calculateTwoElectronIntermediate(size_t r, size
  *  Calculates sigma(pq) + sigma(qp)'s: all one-electron couplings for each annihilation-creation pair in the (spin) Fock space
  *  and stores them in sparse matrices for each pair combination
  *
+ *  @param single_excitations       the single excitations of the (spin) Fock space
+ *
  *  @return vector of sparse matrices containing the one-electron couplings for the (spin) Fock space
  *      Ordered as: sigma(00), sigma(01) + sigma(10), sigma(02)+ sigma(20), ...
  */
-std::vector<Eigen::SparseMatrix<double>> FCI::calculateOneElectronCouplingsIntermediates(const FockSpace& fock_space) const {
+std::vector<Eigen::SparseMatrix<double>> FCI::calculateOneElectronCouplingsIntermediates(const SingleExcitationList& single_excitations) const {
 
-    size_t K = fock_space.get_K();
-    size_t N = fock_space.get_N();
-    size_t dim = fock_space.get_dimension();
+    size_t K = single_excitations.get_K();
+    size_t N = single_excitations.get_N();
+    size_t dim = single_excitations.get_dimension();
 
     std::vector<std::vector<Eigen::Triplet<double>>> sparse_entries(K*(K+1)/2);
     std::vector<Eigen::SparseMatrix<double>> sparse_matrices(K*(K+1)/2, Eigen::SparseMatrix<double>(dim, dim));
@@ -333,38 +314,18 @@ std::vector<Eigen::SparseMatrix<double>> FCI::calculateOneElectronCouplingsInter
         }
     }
 
-    ONV onv = fock_space.makeONV(0);  // onv with address 0
     for (size_t I = 0; I < dim; I++) {  // I loops over all the addresses of the onv
-        for (size_t e1 = 0; e1 < N; e1++) {  // e1 (electron 1) loops over the (number of) electrons
-            size_t p = onv.get_occupation_index(e1);  // retrieve the index of a given electron
-            // remove the weight from the initial address I, because we annihilate
-            size_t address = I - fock_space.get_vertex_weights(p, e1 + 1);
-            // The e2 iteration counts the amount of encountered electrons for the creation operator
-            // We only consider greater addresses than the initial one (because of symmetry)
-            // Hence we only count electron after the annihilated electron (e1)
-            sparse_entries[p*(K+K+1-p)/2].emplace_back(I, I, 1);
-            size_t e2 = e1 + 1;
-            size_t q = p + 1;
-            int sign_e2 = 1;
-            // perform a shift
-            fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2, sign_e2);
-            size_t dex = 0;
-            while (q < K) {
-                size_t J = address + fock_space.get_vertex_weights(q, e2);
-
-                sparse_entries[p*(K+K+1-p)/2 + q - p].emplace_back(I, J, sign_e2);
-                sparse_entries[p*(K+K+1-p)/2 + q - p].emplace_back(J, I, sign_e2);
-
-                q++; // go to the next orbital
-                dex++;
-                // perform a shift
-                fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2, sign_e2);
-            }  //  (creation)
-        } // e1 loop (annihilation)
-
-        // Prevent last permutation
-        if (I < dim - 1) {
-            fock_space.setNextONV(onv);
+        for (const SingleExcitation* excitation = single_excitations.begin(I); excitation != single_excitations.end(I); excitation++) {
+            size_t p = excitation->get_p();  // the created orbital
+            size_t q = excitation->get_q();  // the annihilated orbital
+
+            if (p == q) {
+                sparse_entries[q*(K+K+1-q)/2].emplace_back(I, I, 1);
+            } else if (p > q) {  // we only consider the excitations to greater addresses (because of symmetry)
+                size_t J = excitation->get_J();
+                sparse_entries[q*(K+K+1-q)/2 + p - q].emplace_back(I, J, excitation->get_sign());
+                sparse_entries[q*(K+K+1-q)/2 + p - q].emplace_back(J, I, excitation->get_sign());
+            }
         }
     }
 
@@ -376,6 +337,105 @@ std::vector<Eigen::SparseMatrix<double>> FCI::calculateOneElectronCouplingsInter
 }
 
 
+/**
+ *  Evaluate the elements of the FCI Hamiltonian from its prepared alpha, beta and mixed intermediates, apart from the contributions in calculateDiagonal()
+ *
+ *  @param prepared_fci     the FCI Hamiltonian bound to the Hamiltonian parameters
+ *  @param method           the method that is called for every contribution to H(I,J), in both the upper and the lower half
+ */
+void FCI::evaluateHamiltonianElements(const PreparedFCI& prepared_fci, const PassToMethod& method) const {
+
+    size_t K = this->fock_space.get_K();
+    auto dim_alpha = fock_space.get_fock_space_alpha().get_dimension();
+    auto dim_beta = fock_space.get_fock_space_beta().get_dimension();
+
+    const Eigen::SparseMatrix<double>& beta_hamiltonian = prepared_fci.get_beta_hamiltonian();
+    const Eigen::SparseMatrix<double>& alpha_hamiltonian = prepared_fci.get_alpha_hamiltonian();
+
+    // BETA separated evaluations: the beta Hamiltonian on the diagonal blocks
+    for (int i = 0; i < beta_hamiltonian.outerSize(); ++i){
+        for (Eigen::SparseMatrix<double>::InnerIterator it(beta_hamiltonian, i); it; ++it) {
+            for (size_t I_alpha = 0; I_alpha < dim_alpha; I_alpha++) {
+                method(I_alpha * dim_beta + it.row(), I_alpha * dim_beta + it.col(), it.value());
+            }
+        }
+    }
+
+    // ALPHA separated evaluations: the alpha Hamiltonian elements on the diagonals of the blocks
+    for (int i = 0; i < alpha_hamiltonian.outerSize(); ++i){
+        for (Eigen::SparseMatrix<double>::InnerIterator it(alpha_hamiltonian, i); it; ++it) {
+            for (size_t I_beta = 0; I_beta < dim_beta; I_beta++) {
+                method(it.row() * dim_beta + I_beta, it.col() * dim_beta + I_beta, it.value());
+            }
+        }
+    }
+
+    // MIXED evaluations: the Kronecker products of (sigma(pq) + sigma(qp)) and theta(pq)
+    for (size_t pq = 0; pq < K*(K+1)/2; pq++) {
+
+        const Eigen::SparseMatrix<double>& alpha_coupling = prepared_fci.get_alpha_couplings()[pq];
+        const Eigen::SparseMatrix<double>& beta_two_electron_intermediate = prepared_fci.get_beta_two_electron_intermediates()[pq];
+
+        for (int i = 0; i < alpha_coupling.outerSize(); ++i){
+            for (Eigen::SparseMatrix<double>::InnerIterator it(alpha_coupling, i); it; ++it) {
+                for (int j = 0; j < beta_two_electron_intermediate.outerSize(); ++j){
+                    for (Eigen::SparseMatrix<double>::InnerIterator it_beta(beta_two_electron_intermediate, j); it_beta; ++it_beta) {
+                        method(it.row() * dim_beta + it_beta.row(), it.col() * dim_beta + it_beta.col(), it.value() * it_beta.value());
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the FCI Hamiltonian bound to the given Hamiltonian parameters, in which all intermediates of the matrix-vector product are calculated once
+ *
+ *  Note that the most recently prepared operator is kept, so that preparing again for unmodified Hamiltonian parameters (i.e. with the same revision) doesn't recalculate the intermediates
+ */
+std::shared_ptr<const PreparedFCI> FCI::prepare(const HamiltonianParameters<double>& hamiltonian_parameters) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("FCI::prepare(HamiltonianParameters<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
+    }
+
+    if (this->prepared_fci && (this->prepared_fci->get_revision() == hamiltonian_parameters.get_revision())) {
+        return this->prepared_fci;
+    }
+
+    // Release the previous intermediates before calculating the new ones
+    this->prepared_fci.reset();
+
+    const FockSpace& fock_space_alpha = fock_space.get_fock_space_alpha();
+    const FockSpace& fock_space_beta = fock_space.get_fock_space_beta();
+
+    SingleExcitationList beta_single_excitations (fock_space_beta);  // shared by all K(K+1)/2 intermediates
+    std::vector<Eigen::SparseMatrix<double>> beta_two_electron_intermediates;
+    beta_two_electron_intermediates.reserve(K*(K+1)/2);
+    for (size_t p = 0; p<K; p++) {
+        for (size_t q = p; q<K; q++) {
+            beta_two_electron_intermediates.push_back(this->calculateTwoElectronIntermediate(p, q, hamiltonian_parameters, beta_single_excitations));
+        }
+    }
+
+    Eigen::SparseMatrix<double> alpha_hamiltonian = this->calculateSpinSeparatedHamiltonian(fock_space_alpha, hamiltonian_parameters);
+    Eigen::SparseMatrix<double> beta_hamiltonian = this->calculateSpinSeparatedHamiltonian(fock_space_beta, hamiltonian_parameters);
+
+    this->prepared_fci = std::make_shared<const PreparedFCI>(K, hamiltonian_parameters.get_revision(), this->alpha_couplings, std::move(beta_two_electron_intermediates), std::move(alpha_hamiltonian), std::move(beta_hamiltonian));
+    return this->prepared_fci;
+}
+
+
+
 /*
  *  OVERRIDDEN PUBLIC METHODS
  */
@@ -393,15 +453,13 @@ SquareMatrix<double> FCI::constructHamiltonian(const HamiltonianParameters<doubl
     }
 
     SquareMatrix<double> total_hamiltonian = SquareMatrix<double>::Zero(this->fock_space.get_dimension(), this->fock_space.get_dimension());
-    
-    FockSpace fock_space_alpha = fock_space.get_fock_space_alpha();
-    FockSpace fock_space_beta = fock_space.get_fock_space_beta();
 
-    auto dim_alpha = fock_space_alpha.get_dimension();
-    auto dim_beta = fock_space_beta.get_dimension();
+    auto dim_alpha = fock_space.get_fock_space_alpha().get_dimension();
+    auto dim_beta = fock_space.get_fock_space_beta().get_dimension();
 
-    Eigen::SparseMatrix<double> beta_hamiltonian = this->calculateSpinSeparatedHamiltonian(fock_space_beta, hamiltonian_parameters);
-    Eigen::SparseMatrix<double> alpha_hamiltonian = this->calculateSpinSeparatedHamiltonian(fock_space_alpha, hamiltonian_parameters);
+    auto prepared_fci = this->prepare(hamiltonian_parameters);
+    const Eigen::SparseMatrix<double>& beta_hamiltonian = prepared_fci->get_beta_hamiltonian();
+    const Eigen::SparseMatrix<double>& alpha_hamiltonian = prepared_fci->get_alpha_hamiltonian();
 
     // BETA separated evaluations
     for (size_t i = 0; i < dim_alpha; i++) {
@@ -417,27 +475,15 @@ SquareMatrix<double> FCI::constructHamiltonian(const HamiltonianParameters<doubl
     }
 
     // MIXED evaluations
-    for (size_t p = 0; p<K; p++) {
+    for (size_t pq = 0; pq < K*(K+1)/2; pq++) {
 
-        const Eigen::SparseMatrix<double> alpha_coupling = this->alpha_couplings[p*(K+K+1-p)/2];
-        const Eigen::SparseMatrix<double> beta_two_electron_intermediate = calculateTwoElectronIntermediate(p, p, hamiltonian_parameters, fock_space_beta);
+        const Eigen::SparseMatrix<double>& alpha_coupling = prepared_fci->get_alpha_couplings()[pq];
+        const Eigen::SparseMatrix<double>& beta_two_electron_intermediate = prepared_fci->get_beta_two_electron_intermediates()[pq];
 
         for (int i = 0; i < alpha_coupling.outerSize(); ++i){
             for (Eigen::SparseMatrix<double>::InnerIterator it(alpha_coupling, i); it; ++it) {
-                // it.value sigma(pp) element multiplied with the sparse matrix theta(pp) : beta_two_electron_intermediate
+                // it.value (sigma(pq) + sigma(qp)) element multiplied with the sparse matrix theta(pq) : beta_two_electron_intermediate
                 total_hamiltonian.block(it.row() * dim_beta, it.col() * dim_beta, dim_beta, dim_beta) += it.value()*beta_two_electron_intermediate;
-
-            }
-        }
-
-        for (size_t q = p + 1; q<K; q++) {
-            const Eigen::SparseMatrix<double> alpha_coupling = this->alpha_couplings[p*(K+K+1-p)/2 + q - p];
-            const Eigen::SparseMatrix<double> beta_two_electron_intermediate = calculateTwoElectronIntermediate(p, q, hamiltonian_parameters, fock_space_beta);
-            for (int i = 0; i < alpha_coupling.outerSize(); ++i){
-                for (Eigen::SparseMatrix<double>::InnerIterator it(alpha_coupling, i); it; ++it) {
-                    // it.value (sigma(pq) + sigma(qp)) element multiplied with the sparse matrix theta(pq) : beta_two_electron_intermediate
-                    total_hamiltonian.block(it.row() * dim_beta, it.col() * dim_beta, dim_beta, dim_beta) += it.value()*beta_two_electron_intermediate;
-                }
             }
         }
     }
@@ -461,32 +507,90 @@ VectorX<double> FCI::matrixVectorProduct(const HamiltonianParameters<double>& ha
         throw std::invalid_argument("FCI::matrixVectorProduct(HamiltonianParameters<double>, VectorX<double>, VectorX<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
     }
 
-    FockSpace fock_space_alpha = fock_space.get_fock_space_alpha();
-    FockSpace fock_space_beta = fock_space.get_fock_space_beta();
+    return this->prepare(hamiltonian_parameters)->matrixVectorProduct(x, diagonal);
+}
 
-    auto dim_alpha = fock_space_alpha.get_dimension();
-    auto dim_beta = fock_space_beta.get_dimension();
 
-    VectorX<double> matvec = diagonal.cwiseProduct(x);
+/**
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *  @param X                            the vectors upon which the FCI Hamiltonian acts, as the columns of a (dim x m)-matrix
+ *  @param diagonal                     the diagonal of the FCI Hamiltonian matrix
+ *
+ *  @return the action of the FCI Hamiltonian on every column of X
+ */
+MatrixX<double> FCI::blockMatrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const MatrixX<double>& X, const VectorX<double>& diagonal) const {
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("FCI::blockMatrixVectorProduct(HamiltonianParameters<double>, MatrixX<double>, VectorX<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
+    }
+
+    return this->prepare(hamiltonian_parameters)->blockMatrixVectorProduct(X, diagonal);
+}
 
-    Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> matvecmap(matvec.data(), dim_alpha, dim_beta);
-    Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> xmap(x.data(), dim_alpha, dim_beta);
 
-    for (size_t p = 0; p<K; p++) {
-        // sigma(pp) * X * theta(pp)
-        matvecmap += this->alpha_couplings[p*(K+K+1-p)/2] * xmap * calculateTwoElectronIntermediate(p, p, hamiltonian_parameters, fock_space_beta);
-        for (size_t q = p + 1; q<K; q++) {
-            // (sigma(pq) + sigma(qp)) * X * theta(pq)
-            matvecmap += this->alpha_couplings[p*(K+K+1-p)/2 + q - p] * xmap * calculateTwoElectronIntermediate(p, q, hamiltonian_parameters, fock_space_beta);
-        }
+/**
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the compressed sparse representation of the FCI Hamiltonian matrix, assembled from the evaluated elements
+ */
+Eigen::SparseMatrix<double> FCI::constructSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("FCI::constructSparseHamiltonian(HamiltonianParameters<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
     }
 
-    Eigen::SparseMatrix<double> beta_hamiltonian = this->calculateSpinSeparatedHamiltonian(fock_space_beta, hamiltonian_parameters);
-    Eigen::SparseMatrix<double> alpha_hamiltonian = this->calculateSpinSeparatedHamiltonian(fock_space_alpha, hamiltonian_parameters);
+    auto dim = this->fock_space.get_dimension();
+    VectorX<double> diagonal = this->calculateDiagonal(hamiltonian_parameters);
+    auto prepared_fci = this->prepare(hamiltonian_parameters);
+
+    // Collect the elements as triplets: the contributions to the same element are summed upon assembly
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(dim);
+    for (size_t I = 0; I < dim; I++) {
+        triplets.emplace_back(static_cast<int>(I), static_cast<int>(I), diagonal(I));
+    }
+
+    auto addToTriplets = [&triplets](size_t I, size_t J, double value) { triplets.emplace_back(static_cast<int>(I), static_cast<int>(J), value); };
+    this->evaluateHamiltonianElements(*prepared_fci, addToTriplets);
+
+    Eigen::SparseMatrix<double> result_matrix (dim, dim);
+    result_matrix.setFromTriplets(triplets.begin(), triplets.end());
+    return result_matrix;
+}
+
+
+/**
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the FCI Hamiltonian matrix, assembled from the evaluated elements in its upper half
+ */
+SymmetricSparseMatrix<double> FCI::constructSymmetricSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("FCI::constructSymmetricSparseHamiltonian(HamiltonianParameters<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
+    }
 
-    matvecmap += alpha_hamiltonian * xmap + xmap * beta_hamiltonian;
+    auto dim = this->fock_space.get_dimension();
+    VectorX<double> diagonal = this->calculateDiagonal(hamiltonian_parameters);
+    auto prepared_fci = this->prepare(hamiltonian_parameters);
+
+    // Only collect the elements in the upper triangle (including the diagonal, to which the intermediates also contribute): the lower ones follow from symmetry
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(dim);
+    for (size_t I = 0; I < dim; I++) {
+        triplets.emplace_back(static_cast<int>(I), static_cast<int>(I), diagonal(I));
+    }
+
+    auto addToTriplets = [&triplets](size_t I, size_t J, double value) {
+        if (I <= J) {
+            triplets.emplace_back(static_cast<int>(I), static_cast<int>(J), value);
+        }
+    };
+    this->evaluateHamiltonianElements(*prepared_fci, addToTriplets);
 
-    return matvec;
+    return SymmetricSparseMatrix<double>(dim, triplets);
 }
 
 
@@ -51,10 +51,10 @@ FrozenCoreCI::FrozenCoreCI(std::shared_ptr<GQCP::HamiltonianBuilder> hamiltonian
 SquareMatrix<double> FrozenCoreCI::constructHamiltonian(const HamiltonianParameters<double>& ham_par) const {
 
     // Freeze Hamiltonian parameters
-    HamiltonianParameters<double> frozen_ham_par = this->freezeHamiltonianParameters(ham_par, X);
+    auto frozen_ham_par = this->prepareFrozenHamiltonianParameters(ham_par);
 
     // calculate Hamiltonian matrix through conventional CI
-    SquareMatrix<double> total_hamiltonian = this->active_hamiltonian_builder->constructHamiltonian(frozen_ham_par);
+    SquareMatrix<double> total_hamiltonian = this->active_hamiltonian_builder->constructHamiltonian(*frozen_ham_par);
 
     // diagonal correction
     VectorX<double> diagonal = VectorX<double>::Ones(this->get_fock_space()->get_dimension());
@@ -74,10 +74,26 @@ SquareMatrix<double> FrozenCoreCI::constructHamiltonian(const HamiltonianParamet
  */
 VectorX<double> FrozenCoreCI::matrixVectorProduct(const HamiltonianParameters<double>& ham_par, const VectorX<double>& x, const VectorX<double>& diagonal) const {
 
-    HamiltonianParameters<double> frozen_ham_par = this->freezeHamiltonianParameters(ham_par, X);
+    auto frozen_ham_par = this->prepareFrozenHamiltonianParameters(ham_par);
 
     // perform matvec in the active space with "frozen" Hamiltonian parameters
-    return this->active_hamiltonian_builder->matrixVectorProduct(frozen_ham_par, x, diagonal);
+    return this->active_hamiltonian_builder->matrixVectorProduct(*frozen_ham_par, x, diagonal);
+}
+
+
+/**
+ *  @param ham_par      the Hamiltonian parameters in an orthonormal orbital basis
+ *  @param V            the vectors upon which the frozen core Hamiltonian acts, as the columns of a (dim x m)-matrix
+ *  @param diagonal     the diagonal of the frozen core Hamiltonian matrix
+ *
+ *  @return the action of the frozen core Hamiltonian on every column of V
+ */
+MatrixX<double> FrozenCoreCI::blockMatrixVectorProduct(const HamiltonianParameters<double>& ham_par, const MatrixX<double>& V, const VectorX<double>& diagonal) const {
+
+    auto frozen_ham_par = this->prepareFrozenHamiltonianParameters(ham_par);
+
+    // perform the block matvec in the active space with "frozen" Hamiltonian parameters
+    return this->active_hamiltonian_builder->blockMatrixVectorProduct(*frozen_ham_par, V, diagonal);
 }
 
 
@@ -88,10 +104,10 @@ VectorX<double> FrozenCoreCI::matrixVectorProduct(const HamiltonianParameters<do
  */
 VectorX<double> FrozenCoreCI::calculateDiagonal(const HamiltonianParameters<double>& ham_par) const {
 
-    HamiltonianParameters<double> frozen_ham_par = this->freezeHamiltonianParameters(ham_par, this->X);
+    auto frozen_ham_par = this->prepareFrozenHamiltonianParameters(ham_par);
 
     // calculate diagonal in the active space with the "frozen" Hamiltonian parameters
-    VectorX<double> diagonal = this->active_hamiltonian_builder->calculateDiagonal(frozen_ham_par);
+    VectorX<double> diagonal = this->active_hamiltonian_builder->calculateDiagonal(*frozen_ham_par);
 
     // calculate diagonal for the frozen orbitals
     auto frozen_core_diagonal = this->calculateFrozenCoreDiagonal(ham_par, this->X);
@@ -100,6 +116,28 @@ VectorX<double> FrozenCoreCI::calculateDiagonal(const HamiltonianParameters<doub
 }
 
 
+/**
+ *  @param ham_par      the Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the compressed sparse representation of the frozen core Hamiltonian matrix
+ */
+Eigen::SparseMatrix<double> FrozenCoreCI::constructSparseHamiltonian(const HamiltonianParameters<double>& ham_par) const {
+
+    auto frozen_ham_par = this->prepareFrozenHamiltonianParameters(ham_par);
+
+    // calculate the sparse Hamiltonian matrix in the active space with the "frozen" Hamiltonian parameters
+    Eigen::SparseMatrix<double> total_hamiltonian = this->active_hamiltonian_builder->constructSparseHamiltonian(*frozen_ham_par);
+
+    // diagonal correction
+    auto frozen_core_diagonal = this->calculateFrozenCoreDiagonal(ham_par, this->X);
+    for (size_t I = 0; I < static_cast<size_t>(frozen_core_diagonal.size()); I++) {
+        total_hamiltonian.coeffRef(I, I) += frozen_core_diagonal(I);
+    }
+
+    return total_hamiltonian;
+}
+
+
 
 /*
  *  PUBLIC METHODS
@@ -155,6 +193,29 @@ HamiltonianParameters<double> FrozenCoreCI::freezeHamiltonianParameters(const Ha
 }
 
 
+/**
+ *  @param ham_par      the Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the 'frozen' Hamiltonian parameters (see freezeHamiltonianParameters()) for this builder's number of frozen orbitals
+ *
+ *  Note that the most recently frozen Hamiltonian parameters are kept, so that preparing again for unmodified Hamiltonian parameters (i.e. with the same revision) doesn't copy the integrals again.
+ *  Since the frozen Hamiltonian parameters then also keep their revision, the active Hamiltonian builder can re-use its own prepared quantities
+ */
+std::shared_ptr<const HamiltonianParameters<double>> FrozenCoreCI::prepareFrozenHamiltonianParameters(const HamiltonianParameters<double>& ham_par) const {
+
+    if (this->frozen_ham_par && (this->frozen_ham_par_revision == ham_par.get_revision())) {
+        return this->frozen_ham_par;
+    }
+
+    // Release the previous frozen Hamiltonian parameters before freezing the new ones
+    this->frozen_ham_par.reset();
+
+    this->frozen_ham_par = std::make_shared<const HamiltonianParameters<double>>(this->freezeHamiltonianParameters(ham_par, this->X));
+    this->frozen_ham_par_revision = ham_par.get_revision();
+    return this->frozen_ham_par;
+}
+
+
 /**
  *  @param ham_par      the Hamiltonian parameters in an orthonormal orbital basis
  *  @param X            the number of frozen orbitals
@@ -163,10 +224,23 @@ HamiltonianParameters<double> FrozenCoreCI::freezeHamiltonianParameters(const Ha
  */
 VectorX<double> FrozenCoreCI::calculateFrozenCoreDiagonal(const HamiltonianParameters<double>& ham_par, size_t X) const {
 
+    // The diagonal value for the frozen orbitals is the same for each ONV
+    VectorX<double> diagonal = VectorX<double>::Ones(this->get_fock_space()->get_dimension());
+    return this->calculateFrozenCoreEnergy(ham_par, X) * diagonal;
+}
+
+
+/**
+ *  @param ham_par      the Hamiltonian parameters in an orthonormal orbital basis
+ *  @param X            the number of frozen orbitals
+ *
+ *  @return the energy of the doubly occupied frozen orbitals, which is the same for every ONV
+ */
+double FrozenCoreCI::calculateFrozenCoreEnergy(const HamiltonianParameters<double>& ham_par, size_t X) const {
+
     const auto& g = ham_par.get_g();
     const auto& h = ham_par.get_h();
 
-    // The diagonal value for the frozen orbitals is the same for each ONV
     double value = 0;
     for (size_t i = 0; i < X; i++) {
 
@@ -178,8 +252,7 @@ VectorX<double> FrozenCoreCI::calculateFrozenCoreDiagonal(const HamiltonianParam
         }
     }
 
-    VectorX<double> diagonal = VectorX<double>::Ones(this->get_fock_space()->get_dimension());
-    return value * diagonal;
+    return value;
 }
 
 
@@ -32,4 +32,53 @@ HamiltonianBuilder::~HamiltonianBuilder() {}
 
 
 
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *  @param X                            the vectors upon which the Hamiltonian acts, as the columns of a (dim x m)-matrix
+ *  @param diagonal                     the diagonal of the Hamiltonian matrix
+ *
+ *  @return the action of the Hamiltonian on every column of X, i.e. the (dim x m)-matrix H X
+ *
+ *  Note that this default implementation calls matrixVectorProduct() for every column
+ */
+MatrixX<double> HamiltonianBuilder::blockMatrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const MatrixX<double>& X, const VectorX<double>& diagonal) const {
+
+    MatrixX<double> matvecs (X.rows(), X.cols());
+    for (size_t k = 0; k < static_cast<size_t>(X.cols()); k++) {
+        matvecs.col(k) = this->matrixVectorProduct(hamiltonian_parameters, X.col(k), diagonal);
+    }
+
+    return matvecs;
+}
+
+
+/**
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the compressed sparse representation of the Hamiltonian matrix
+ *
+ *  Note that this default implementation throws instead of converting the dense Hamiltonian matrix: derived classes that can emit the non-zero elements directly should override it
+ */
+Eigen::SparseMatrix<double> HamiltonianBuilder::constructSparseHamiltonian(const HamiltonianParameters<double>&) const {
+    throw std::runtime_error("HamiltonianBuilder::constructSparseHamiltonian(HamiltonianParameters<double>): is not implemented for this HamiltonianBuilder");
+}
+
+
+/**
+ *  @param hamiltonian_parameters       the Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the Hamiltonian matrix in a compressed sparse row format, whose (parallel) matrix-vector products can be re-used in every iteration of an eigensolver
+ *
+ *  Note that this default implementation converts the sparse Hamiltonian matrix from constructSparseHamiltonian()
+ */
+SymmetricSparseMatrix<double> HamiltonianBuilder::constructSymmetricSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const {
+    return SymmetricSparseMatrix<double>(this->constructSparseHamiltonian(hamiltonian_parameters));
+}
+
+
+
 }  // namespace GQCP
@@ -17,6 +17,8 @@
 // 
 #include "HamiltonianBuilder/Hubbard.hpp"
 
+#include "FockSpace/SingleExcitationList.hpp"
+
 
 namespace GQCP {
 
@@ -25,18 +27,19 @@ namespace GQCP {
  */
 
 /**
- *  Evaluate the one-electron operators for alpha or beta and store the result in a matrix-vector product or a matrix, depending on the method passed
+ *  Evaluate the one-electron operators for alpha or beta and store the result in a matrix-vector product or a matrix, depending on the visitor passed
+ *
+ *  @tparam Visitor                 a callable with signature void(size_t I, size_t J, double value), whose calls are inlined in the coupling loop
  *
  *  @param fock_space_target        the Fock space that is used as a target, i.e. that is evaluated
  *  @param fock_space_fixed         the Fock space that is not evaluated
  *  @param target_is_major          whether or not the evaluated component is the major index
  *  @param hamiltonian_parameters   the Hubbard Hamiltonian parameters
- *  @param method                   the used method: constructHamiltonian() or matrixVectorProduct()
+ *  @param visit                    the visitor that is called for every coupling H(I,J)
  */
-void Hubbard::oneOperatorModule(const FockSpace& fock_space_target, const FockSpace& fock_space_fixed, bool target_is_major, const HamiltonianParameters<double>& hamiltonian_parameters, const PassToMethod& method) const {
+template <typename Visitor>
+void Hubbard::oneOperatorModule(const FockSpace& fock_space_target, const FockSpace& fock_space_fixed, bool target_is_major, const HamiltonianParameters<double>& hamiltonian_parameters, const Visitor& visit) const {
 
-    size_t K = fock_space_target.get_K();
-    size_t N = fock_space_target.get_N();
     size_t dim = fock_space_target.get_dimension();
     size_t dim_fixed = fock_space_fixed.get_dimension();
 
@@ -56,75 +59,42 @@ void Hubbard::oneOperatorModule(const FockSpace& fock_space_target, const FockSp
         target_interval = 1;
     }
 
-    ONV onv = fock_space_target.makeONV(0);  // onv with address 0
+    const auto single_excitations = fock_space_target.get_single_excitations();
+    const auto& h = hamiltonian_parameters.get_h();
     for (size_t I = 0; I < dim; I++) {  // I loops over all the addresses of the onv
-        for (size_t e1 = 0; e1 < N; e1++) {  // e1 (electron 1) loops over the (number of) electrons
-            size_t p = onv.get_occupation_index(e1);  // retrieve the index of a given electron
+        for (const SingleExcitation* excitation = single_excitations->begin(I); excitation != single_excitations->end(I); excitation++) {
+            size_t p = excitation->get_p();  // the created orbital
+            size_t q = excitation->get_q();  // the annihilated orbital
 
-            // remove the weight from the initial address I, because we annihilate
-            size_t address = I - fock_space_target.get_vertex_weights(p, e1 + 1);
-            // The e2 iteration counts the amount of encountered electrons for the creation operator
             // We only consider greater addresses than the initial one (because of symmetry)
-            // Hence we are only required to start counting from the annihilated electron (e1)
-            size_t e2 = e1;
-
-            // Starting from e2, the sign is always 1
-            // Because the initial sign of the annihilation will also be evaluated for the creation
-            // 1*1 or -1*-1 is always 1.
-            int sign_e2 = 1;
-
-            // Test whether next orbital is occupied, until we reach unoccupied orbital
-            while (e2 < N - 1 && onv.get_occupation_index(e2 + 1) - onv.get_occupation_index(e2) == 1) {
-                // Shift the address for the electrons encountered after the annihilation but before the creation
-                // Their currents weights are no longer correct, the corresponding weights can be calculated
-                // initial weight can be found in the addressing scheme, on the index of the orbital (row) and electron count (column)
-                // since e2 starts at the annihilated position, the first shifted electron is at e2's position + 1, (given the while loop condition this is also (e2+1)'s position)
-                // The nature of the addressing scheme requires us the add 1 to the electron count (because we start with the 0'th electron
-                // And for the initial weight we are at an extra electron (before the annihilation) hence the difference in weight is:
-                // the new weight at (e2+1) position (row) and e2+1 (column) - the old weight at  (e2+1) position (row) and e2+2 (column)
-                address += fock_space_target.get_vertex_weights(onv.get_occupation_index(e2) + 1, e2 + 1) - fock_space_target.get_vertex_weights(onv.get_occupation_index(e2) + 1, e2 + 2);
-                e2++;  // adding occupied orbitals to the electron count
-                sign_e2 *= -1;  // skipping over non-annihilated electrons will cause a phase change
+            if (p <= q) {
+                continue;
+            }
+
+            size_t J = excitation->get_J();
+            double val = excitation->get_sign() * h(q, p);
+
+            // address has been calculated, update accordingly and at all instances of the fixed component
+            for (size_t I_fixed = 0; I_fixed < dim_fixed; I_fixed++){
+                visit(I * target_interval + I_fixed * fixed_intervals, J * target_interval + I_fixed * fixed_intervals, val);
+                visit(J * target_interval + I_fixed * fixed_intervals, I * target_interval + I_fixed * fixed_intervals, val);
             }
-            size_t q = onv.get_occupation_index(e2) + 1;
-            e2++;
-            while (q < K) {
-                size_t J = address + fock_space_target.get_vertex_weights(q, e2);
-
-                // address has been calculated, update accordingly and at all instances of the fixed component
-                for (size_t I_fixed = 0; I_fixed < dim_fixed; I_fixed++){
-                    double val = sign_e2 * hamiltonian_parameters.get_h()(p, q);
-                    method(I * target_interval + I_fixed * fixed_intervals, J * target_interval + I_fixed * fixed_intervals, val);
-                    method(J * target_interval + I_fixed * fixed_intervals, I * target_interval + I_fixed * fixed_intervals, val);
-                }
-
-                // go to the next orbital
-                q++;
-
-                // if we encounter an occupied orbital, perform the shift, and test whether the following orbitals are occupied (or not)
-                // then proceed to set q to the next non-occupied orbital.
-                if (e2 < N && q == onv.get_occupation_index(e2)) {
-                    address += fock_space_target.get_vertex_weights(q, e2) - fock_space_target.get_vertex_weights(q, e2 + 1);
-                    sign_e2 *= -1;
-                    while (e2 < N - 1 && onv.get_occupation_index(e2 + 1) - onv.get_occupation_index(e2) == 1) {
-                        // see previous
-                        address += fock_space_target.get_vertex_weights(onv.get_occupation_index(e2) + 1, e2 + 1) - fock_space_target.get_vertex_weights(onv.get_occupation_index(e2) + 1, e2 + 2);
-                        e2++;
-                        sign_e2 *= -1;
-                    }
-                    q = onv.get_occupation_index(e2) + 1;
-                    e2++;
-                }
-            }  //  (creation)
-
-        } // e1 loop (annihilation)
-
-        // Prevent last permutation
-        if (I < dim - 1) {
-            fock_space_target.setNextONV(onv);
         }
     }
+}
+
 
+/**
+ *  Evaluate the one-electron operators for alpha or beta through a type-erased method
+ *
+ *  @param fock_space_target        the Fock space that is used as a target, i.e. that is evaluated
+ *  @param fock_space_fixed         the Fock space that is not evaluated
+ *  @param target_is_major          whether or not the evaluated component is the major index
+ *  @param hamiltonian_parameters   the Hubbard Hamiltonian parameters
+ *  @param method                   the method that is called for every coupling H(I,J)
+ */
+void Hubbard::oneOperatorModule(const FockSpace& fock_space_target, const FockSpace& fock_space_fixed, bool target_is_major, const HamiltonianParameters<double>& hamiltonian_parameters, const PassToMethod& method) const {
+    this->oneOperatorModule<PassToMethod>(fock_space_target, fock_space_fixed, target_is_major, hamiltonian_parameters, method);
 }
 
 
@@ -157,16 +127,16 @@ SquareMatrix<double> Hubbard::constructHamiltonian(const HamiltonianParameters<d
         throw std::invalid_argument("Hubbard::constructHamiltonian(HamiltonianParameters<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
     }
 
-    FockSpace fock_space_alpha = fock_space.get_fock_space_alpha();
-    FockSpace fock_space_beta = fock_space.get_fock_space_beta();
+    const FockSpace& fock_space_alpha = fock_space.get_fock_space_alpha();
+    const FockSpace& fock_space_beta = fock_space.get_fock_space_beta();
 
     auto dim = fock_space.get_dimension();
 
     SquareMatrix<double> result_matrix = SquareMatrix<double>::Zero(dim, dim);
     result_matrix += this->calculateDiagonal(hamiltonian_parameters).asDiagonal();
 
-    // We pass to a matrix and create the corresponding lambda function
-    PassToMethod addToMatrix = [&result_matrix](size_t I, size_t J, double value) { result_matrix(I, J) += value; };
+    // We pass to a matrix through a lambda, whose calls are inlined in oneOperatorModule()
+    auto addToMatrix = [&result_matrix](size_t I, size_t J, double value) { result_matrix(I, J) += value; };
 
     // perform one electron evaluations, one for the alpha component and one for the beta component.
     // In our case alpha will be major and thus when alpha is the "target" (the operators evaluated)
@@ -192,13 +162,13 @@ VectorX<double> Hubbard::matrixVectorProduct(const HamiltonianParameters<double>
         throw std::invalid_argument("Hubbard::matrixVectorProduct(HamiltonianParameters<double>, VectorX<double>, VectorX<double>):Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
     }
 
-    FockSpace fock_space_alpha = fock_space.get_fock_space_alpha();
-    FockSpace fock_space_beta = fock_space.get_fock_space_beta();
+    const FockSpace& fock_space_alpha = fock_space.get_fock_space_alpha();
+    const FockSpace& fock_space_beta = fock_space.get_fock_space_beta();
 
     VectorX<double> matvec = diagonal.cwiseProduct(x);
 
     // We pass to a the matvec and create the corresponding lambda function
-    PassToMethod addToMatvec = [&matvec, &x](size_t I, size_t J, double value) { matvec(I) += value * x(J); };
+    auto addToMatvec = [&matvec, &x](size_t I, size_t J, double value) { matvec(I) += value * x(J); };
 
     // perform one electron evaluations, one for the alpha component and one for the beta component.
     // In our case alpha will be major and thus when alpha is the "target" (the operators evaluated)
@@ -210,6 +180,111 @@ VectorX<double> Hubbard::matrixVectorProduct(const HamiltonianParameters<double>
 }
 
 
+/**
+ *  @param hamiltonian_parameters       the Hubbard Hamiltonian parameters in an orthonormal orbital basis
+ *  @param X                            the vectors upon which the Hubbard Hamiltonian acts, as the columns of a (dim x m)-matrix
+ *  @param diagonal                     the diagonal of the Hubbard Hamiltonian matrix
+ *
+ *  @return the action of the Hubbard Hamiltonian on every column of X
+ */
+MatrixX<double> Hubbard::blockMatrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const MatrixX<double>& X, const VectorX<double>& diagonal) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("Hubbard::blockMatrixVectorProduct(HamiltonianParameters<double>, MatrixX<double>, VectorX<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
+    }
+
+    const FockSpace& fock_space_alpha = fock_space.get_fock_space_alpha();
+    const FockSpace& fock_space_beta = fock_space.get_fock_space_beta();
+
+    // Work with the transposed vectors, so that the coefficients of one ONV for all vectors are contiguous
+    MatrixX<double> X_transposed = X.transpose();
+    MatrixX<double> matvecs_transposed = MatrixX<double>::Zero(X.cols(), X.rows());
+
+    // We pass every coupling to all vectors at once
+    auto addToMatvecs = [&matvecs_transposed, &X_transposed](size_t I, size_t J, double value) { matvecs_transposed.col(I) += value * X_transposed.col(J); };
+
+    this->oneOperatorModule(fock_space_alpha, fock_space_beta, true, hamiltonian_parameters, addToMatvecs);
+    this->oneOperatorModule(fock_space_beta, fock_space_alpha, false, hamiltonian_parameters, addToMatvecs);
+
+    return diagonal.asDiagonal() * X + matvecs_transposed.transpose();
+}
+
+
+/**
+ *  @param hamiltonian_parameters       the Hubbard Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the compressed sparse representation of the Hubbard Hamiltonian matrix, assembled from the evaluated elements
+ */
+Eigen::SparseMatrix<double> Hubbard::constructSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("Hubbard::constructSparseHamiltonian(HamiltonianParameters<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
+    }
+
+    const FockSpace& fock_space_alpha = fock_space.get_fock_space_alpha();
+    const FockSpace& fock_space_beta = fock_space.get_fock_space_beta();
+
+    auto dim = fock_space.get_dimension();
+    VectorX<double> diagonal = this->calculateDiagonal(hamiltonian_parameters);
+
+    // Collect the elements as triplets: the contributions to the same element are summed upon assembly
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(dim);
+    for (size_t I = 0; I < dim; I++) {
+        triplets.emplace_back(static_cast<int>(I), static_cast<int>(I), diagonal(I));
+    }
+
+    auto addToTriplets = [&triplets](size_t I, size_t J, double value) { triplets.emplace_back(static_cast<int>(I), static_cast<int>(J), value); };
+
+    this->oneOperatorModule(fock_space_alpha, fock_space_beta, true, hamiltonian_parameters, addToTriplets);
+    this->oneOperatorModule(fock_space_beta, fock_space_alpha, false, hamiltonian_parameters, addToTriplets);
+
+    Eigen::SparseMatrix<double> result_matrix (dim, dim);
+    result_matrix.setFromTriplets(triplets.begin(), triplets.end());
+    return result_matrix;
+}
+
+
+/**
+ *  @param hamiltonian_parameters       the Hubbard Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the Hubbard Hamiltonian matrix, assembled from the evaluated elements in its upper half
+ */
+SymmetricSparseMatrix<double> Hubbard::constructSymmetricSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("Hubbard::constructSymmetricSparseHamiltonian(HamiltonianParameters<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
+    }
+
+    const FockSpace& fock_space_alpha = fock_space.get_fock_space_alpha();
+    const FockSpace& fock_space_beta = fock_space.get_fock_space_beta();
+
+    auto dim = fock_space.get_dimension();
+    VectorX<double> diagonal = this->calculateDiagonal(hamiltonian_parameters);
+
+    // Only collect the elements in the upper triangle: the lower ones follow from symmetry
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(dim);
+    for (size_t I = 0; I < dim; I++) {
+        triplets.emplace_back(static_cast<int>(I), static_cast<int>(I), diagonal(I));
+    }
+
+    auto addToTriplets = [&triplets](size_t I, size_t J, double value) {
+        if (I < J) {
+            triplets.emplace_back(static_cast<int>(I), static_cast<int>(J), value);
+        }
+    };
+
+    this->oneOperatorModule(fock_space_alpha, fock_space_beta, true, hamiltonian_parameters, addToTriplets);
+    this->oneOperatorModule(fock_space_beta, fock_space_alpha, false, hamiltonian_parameters, addToTriplets);
+
+    return SymmetricSparseMatrix<double>(dim, triplets);
+}
+
+
 /**
  *  @param hamiltonian_parameters       the Hubbard Hamiltonian parameters in an orthonormal orbital basis
  *
@@ -222,8 +297,8 @@ VectorX<double> Hubbard::calculateDiagonal(const HamiltonianParameters<double>&
         throw std::invalid_argument("Hubbard::calculateDiagonal(HamiltonianParameters<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
     }
 
-    FockSpace fock_space_alpha = fock_space.get_fock_space_alpha();
-    FockSpace fock_space_beta = fock_space.get_fock_space_beta();
+    const FockSpace& fock_space_alpha = fock_space.get_fock_space_alpha();
+    const FockSpace& fock_space_beta = fock_space.get_fock_space_beta();
 
     auto dim_alpha = fock_space_alpha.get_dimension();
     auto dim_beta = fock_space_beta.get_dimension();
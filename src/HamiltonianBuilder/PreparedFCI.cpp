@@ -0,0 +1,135 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "HamiltonianBuilder/PreparedFCI.hpp"
+
+#include "utilities/parallel.hpp"
+
+
+namespace GQCP {
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  @param K                                    the number of spatial orbitals
+ *  @param revision                             the revision of the Hamiltonian parameters the intermediates were calculated for
+ *  @param alpha_couplings                      sigma(pq) + sigma(qp) in the alpha Fock space, ordered as: sigma(00), sigma(01) + sigma(10), sigma(02)+ sigma(20), ...
+ *  @param beta_two_electron_intermediates      theta(pq) in the beta Fock space, ordered as the alpha couplings
+ *  @param alpha_hamiltonian                    the Hamiltonian in the alpha Fock space
+ *  @param beta_hamiltonian                     the Hamiltonian in the beta Fock space
+ */
+PreparedFCI::PreparedFCI(size_t K, size_t revision, std::shared_ptr<const std::vector<Eigen::SparseMatrix<double>>> alpha_couplings, std::vector<Eigen::SparseMatrix<double>> beta_two_electron_intermediates, Eigen::SparseMatrix<double> alpha_hamiltonian, Eigen::SparseMatrix<double> beta_hamiltonian) :
+    K (K),
+    dim_alpha (alpha_hamiltonian.rows()),
+    dim_beta (beta_hamiltonian.rows()),
+    revision (revision),
+    alpha_couplings (std::move(alpha_couplings)),
+    beta_two_electron_intermediates (std::move(beta_two_electron_intermediates)),
+    alpha_hamiltonian (std::move(alpha_hamiltonian)),
+    beta_hamiltonian (std::move(beta_hamiltonian))
+{
+    if ((this->alpha_couplings->size() != K*(K+1)/2) || (this->beta_two_electron_intermediates.size() != K*(K+1)/2)) {
+        throw std::invalid_argument("PreparedFCI::PreparedFCI(size_t, size_t, std::shared_ptr<const std::vector<Eigen::SparseMatrix<double>>>, std::vector<Eigen::SparseMatrix<double>>, Eigen::SparseMatrix<double>, Eigen::SparseMatrix<double>): The number of intermediates does not match the number of orbital pairs.");
+    }
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @param x            the vector upon which the FCI Hamiltonian acts
+ *  @param diagonal     the diagonal of the FCI Hamiltonian matrix
+ *
+ *  @return the action of the FCI Hamiltonian on the coefficient vector
+ *
+ *  Note that the calculation is divided over getNumberOfThreads() threads
+ */
+VectorX<double> PreparedFCI::matrixVectorProduct(const VectorX<double>& x, const VectorX<double>& diagonal) const {
+
+    MatrixX<double> X = x;
+    return this->blockMatrixVectorProduct(X, diagonal).col(0);
+}
+
+
+/**
+ *  @param X            the vectors upon which the FCI Hamiltonian acts, as the columns of a (dim x m)-matrix
+ *  @param diagonal     the diagonal of the FCI Hamiltonian matrix
+ *
+ *  @return the action of the FCI Hamiltonian on every column of X
+ *
+ *  Note that the calculation is divided over getNumberOfThreads() threads
+ */
+MatrixX<double> PreparedFCI::blockMatrixVectorProduct(const MatrixX<double>& X, const VectorX<double>& diagonal) const {
+
+    if ((static_cast<size_t>(X.rows()) != this->get_dimension()) || (static_cast<size_t>(diagonal.size()) != this->get_dimension())) {
+        throw std::invalid_argument("PreparedFCI::blockMatrixVectorProduct(MatrixX<double>, VectorX<double>): The dimensions of the given vectors do not match the dimension of the Fock space.");
+    }
+
+    using RowMajorMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    const auto& alpha_couplings = *this->alpha_couplings;
+    auto m = X.cols();  // the number of vectors
+    auto width = m * this->dim_beta;
+
+    // Gather all vectors in one (dim_alpha x m*dim_beta)-matrix, whose row for alpha address I_alpha contains [x_0(I_alpha, :), x_1(I_alpha, :), ...]
+    //  Its memory can also be read as a (dim_alpha*m x dim_beta)-matrix, whose row I_alpha*m + k is x_k(I_alpha, :), so that the alpha and beta operators act on all vectors at once
+    RowMajorMatrix X_gathered (this->dim_alpha, width);
+    for (Eigen::Index k = 0; k < m; k++) {
+        X_gathered.middleCols(k * this->dim_beta, this->dim_beta) = Eigen::Map<const RowMajorMatrix>(X.col(k).data(), this->dim_alpha, this->dim_beta);
+    }
+    RowMajorMatrix sigma_gathered = RowMajorMatrix::Zero(this->dim_alpha, width);
+
+
+    // Every thread calculates a contiguous block of rows (i.e. alpha addresses) of the result, so there are no write races
+    //  Since all alpha operators are symmetric, their rows can be read as (column-major) columns, which is efficient for Eigen's default sparse storage
+    parallelFor(0, this->dim_alpha, [&] (size_t row_begin, size_t row_end) {
+
+        auto rows = static_cast<Eigen::Index>(row_end - row_begin);
+        Eigen::Map<const RowMajorMatrix> X_rows (X_gathered.data() + row_begin * width, rows * m, this->dim_beta);
+        Eigen::Map<RowMajorMatrix> sigma_rows (sigma_gathered.data() + row_begin * width, rows * m, this->dim_beta);
+
+        // Mixed alpha-beta contributions: (sigma(pq) + sigma(qp)) * X * theta(pq)
+        RowMajorMatrix intermediate (rows, width);
+        for (size_t pq = 0; pq < this->K*(this->K+1)/2; pq++) {
+            intermediate.noalias() = alpha_couplings[pq].middleCols(row_begin, rows).transpose() * X_gathered;
+            sigma_rows.noalias() += Eigen::Map<const RowMajorMatrix>(intermediate.data(), rows * m, this->dim_beta) * this->beta_two_electron_intermediates[pq];
+        }
+
+        // Alpha-alpha and beta-beta contributions
+        sigma_gathered.middleRows(row_begin, rows).noalias() += this->alpha_hamiltonian.middleCols(row_begin, rows).transpose() * X_gathered;
+        sigma_rows.noalias() += X_rows * this->beta_hamiltonian;
+    });
+
+
+    // Scatter the gathered results back to the columns
+    MatrixX<double> matvecs = diagonal.asDiagonal() * X;
+    for (Eigen::Index k = 0; k < m; k++) {
+        Eigen::Map<RowMajorMatrix>(matvecs.col(k).data(), this->dim_alpha, this->dim_beta) += sigma_gathered.middleCols(k * this->dim_beta, this->dim_beta);
+    }
+
+    return matvecs;
+}
+
+
+
+}  // namespace GQCP
@@ -24,39 +24,53 @@ namespace GQCP {
  *  PRIVATE METHODS
  */
 
-void SelectedCI::evaluateHamiltonianElements(const HamiltonianParameters<double>& hamiltonian_parameters, const PassToMethod& method) const {
+/**
+ *  Evaluate all Hamiltonian elements, passing them to the given visitor
+ *  Only the pairs of configurations in `connections` are evaluated, instead of all pairs.
+ *
+ *  @tparam Visitor                 a callable with signature void(size_t I, size_t J, double value), whose calls are inlined in the evaluation loop
+ *
+ *  @param hamiltonian_parameters   the Hamiltonian parameters in an orthonormal basis
+ *  @param visit                    the visitor that is called once for both H(I,J) and H(J,I) of every connected pair
+ */
+template <typename Visitor>
+void SelectedCI::evaluateHamiltonianElements(const HamiltonianParameters<double>& hamiltonian_parameters, const Visitor& visit) const {
 
     size_t dim = fock_space.get_dimension();
     size_t K = fock_space.get_K();
 
-    auto h = hamiltonian_parameters.get_h();
-    auto g = hamiltonian_parameters.get_g();
+    const auto& h = hamiltonian_parameters.get_h();
+    const auto& g = hamiltonian_parameters.get_g();
 
     for (size_t I = 0; I < dim; I++) {  // loop over all addresses (1)
-        Configuration configuration_I = this->fock_space.get_configuration(I);
-        ONV alpha_I = configuration_I.onv_alpha;
-        ONV beta_I = configuration_I.onv_beta;
+        const Configuration& configuration_I = this->fock_space.get_configuration(I);
+        const ONV& alpha_I = configuration_I.onv_alpha;
+        const ONV& beta_I = configuration_I.onv_beta;
 
-        // Calculate the off-diagonal elements, by going over all other ONVs
-        for (size_t J = I+1; J < dim; J++) {
+        // Calculate the off-diagonal elements, by going over the connected ONVs
+        for (size_t J : this->connections[I]) {
 
-            Configuration configuration_J = this->fock_space.get_configuration(J);
-            ONV alpha_J = configuration_J.onv_alpha;
-            ONV beta_J = configuration_J.onv_beta;
+            const Configuration& configuration_J = this->fock_space.get_configuration(J);
+            const ONV& alpha_J = configuration_J.onv_alpha;
+            const ONV& beta_J = configuration_J.onv_beta;
+            auto alpha_excitation = alpha_I.analyzeExcitation(alpha_J);
+            auto beta_excitation = beta_I.analyzeExcitation(beta_J);
 
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 2) && (beta_I.countNumberOfDifferences(beta_J) == 0)) {
+            // Gather all contributions to the coupling between I and J, so that it is passed only once
+            double coupling = 0.0;
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                size_t p = alpha_I.findDifferentOccupations(alpha_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
-                size_t q = alpha_J.findDifferentOccupations(alpha_I)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+            if ((alpha_excitation.degree == 1) && (beta_excitation.degree == 0)) {
+
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = alpha_excitation.holes[0];
+                size_t q = alpha_excitation.particles[0];
 
                 // Calculate the total sign
-                int sign = alpha_I.operatorPhaseFactor(p) * alpha_J.operatorPhaseFactor(q);
+                int sign = alpha_excitation.sign;
 
                 double value = h(p,q);
 
-                method(I, J, sign*value);
-                method(J, I, sign*value);
+                coupling += sign * value;
 
                 for (size_t r = 0; r < K; r++) {  // r loops over spatial orbitals
 
@@ -68,8 +82,7 @@ void SelectedCI::evaluateHamiltonianElements(const HamiltonianParameters<double>
                                                - g(p,r,r,q)
                                                + g(r,r,p,q));
 
-                            method(I, J, sign*value);
-                            method(J, I, sign*value);
+                            coupling += sign * value;
                         }
                     }
 
@@ -78,27 +91,25 @@ void SelectedCI::evaluateHamiltonianElements(const HamiltonianParameters<double>
                         double value = 0.5 * (g(p,q,r,r)
                                            +  g(r,r,p,q));
 
-                        method(I, J, sign*value);
-                        method(J, I, sign*value);
+                        coupling += sign * value;
                     }
                 }
             }
 
             // 0 electron excitations in alpha, 1 in beta
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 0) && (beta_I.countNumberOfDifferences(beta_J) == 2)) {
+            if ((alpha_excitation.degree == 0) && (beta_excitation.degree == 1)) {
 
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                size_t p = beta_I.findDifferentOccupations(beta_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
-                size_t q = beta_J.findDifferentOccupations(beta_I)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = beta_excitation.holes[0];
+                size_t q = beta_excitation.particles[0];
 
                 // Calculate the total sign
-                int sign = beta_I.operatorPhaseFactor(p) * beta_J.operatorPhaseFactor(q);
+                int sign = beta_excitation.sign;
 
                 double value = h(p,q);
 
-                method(I, J, sign*value);
-                method(J, I, sign*value);
+                coupling += sign * value;
 
                 for (size_t r = 0; r < K; r++) {  // r loops over spatial orbitals
 
@@ -109,8 +120,7 @@ void SelectedCI::evaluateHamiltonianElements(const HamiltonianParameters<double>
                                                -  g(p,r,r,q)
                                                +  g(r,r,p,q));
 
-                            method(I, J, sign*value);
-                            method(J, I, sign*value);
+                            coupling += sign * value;
                         }
                     }
 
@@ -119,80 +129,86 @@ void SelectedCI::evaluateHamiltonianElements(const HamiltonianParameters<double>
                         double value =  0.5 * (g(p,q,r,r)
                                             +  g(r,r,p,q));
 
-                        method(I, J, sign*value);
-                        method(J, I, sign*value);
+                        coupling += sign * value;
                     }
                 }
             }
 
             // 1 electron excitation in alpha, 1 in beta
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 2) && (beta_I.countNumberOfDifferences(beta_J) == 2)) {
+            if ((alpha_excitation.degree == 1) && (beta_excitation.degree == 1)) {
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                size_t p = alpha_I.findDifferentOccupations(alpha_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
-                size_t q = alpha_J.findDifferentOccupations(alpha_I)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = alpha_excitation.holes[0];
+                size_t q = alpha_excitation.particles[0];
 
-                size_t r = beta_I.findDifferentOccupations(beta_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
-                size_t s = beta_J.findDifferentOccupations(beta_I)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+                size_t r = beta_excitation.holes[0];
+                size_t s = beta_excitation.particles[0];
 
-                int sign = alpha_I.operatorPhaseFactor(p) * alpha_J.operatorPhaseFactor(q) * beta_I.operatorPhaseFactor(r) * beta_J.operatorPhaseFactor(s);
+                int sign = alpha_excitation.sign * beta_excitation.sign;
                 double value = 0.5 * (g(p,q,r,s)
                                    +  g(r,s,p,q));
 
-                method(I, J, sign*value);
-                method(J, I, sign*value);
+                coupling += sign * value;
             }
 
             // 2 electron excitations in alpha, 0 in beta
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 4) && (beta_I.countNumberOfDifferences(beta_J) == 0)) {
+            if ((alpha_excitation.degree == 2) && (beta_excitation.degree == 0)) {
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                std::vector<size_t> occupied_indices_I = alpha_I.findDifferentOccupations(alpha_J);  // we're sure this has two elements
-                size_t p = occupied_indices_I[0];
-                size_t r = occupied_indices_I[1];
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = alpha_excitation.holes[0];
+                size_t r = alpha_excitation.holes[1];
 
-                std::vector<size_t> occupied_indices_J = alpha_J.findDifferentOccupations(alpha_I);  // we're sure this has two elements
-                size_t q = occupied_indices_J[0];
-                size_t s = occupied_indices_J[1];
+                size_t q = alpha_excitation.particles[0];
+                size_t s = alpha_excitation.particles[1];
 
-                int sign = alpha_I.operatorPhaseFactor(p) * alpha_I.operatorPhaseFactor(r) * alpha_J.operatorPhaseFactor(q) * alpha_J.operatorPhaseFactor(s);
+                int sign = alpha_excitation.sign;
 
                 double value = 0.5 * (g(p,q,r,s)
                                    -  g(p,s,r,q)
                                    -  g(r,q,p,s)
                                    +  g(r,s,p,q));
 
-                method(I, J, sign*value);
-                method(J, I, sign*value);
+                coupling += sign * value;
             }
 
             // 0 electron excitations in alpha, 2 in beta
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 0) && (beta_I.countNumberOfDifferences(beta_J) == 4)) {
+            if ((alpha_excitation.degree == 0) && (beta_excitation.degree == 2)) {
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                std::vector<size_t> occupied_indices_I = beta_I.findDifferentOccupations(beta_J);  // we're sure this has two elements
-                size_t p = occupied_indices_I[0];
-                size_t r = occupied_indices_I[1];
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = beta_excitation.holes[0];
+                size_t r = beta_excitation.holes[1];
 
-                std::vector<size_t> occupied_indices_J = beta_J.findDifferentOccupations(beta_I);  // we're sure this has two elements
-                size_t q = occupied_indices_J[0];
-                size_t s = occupied_indices_J[1];
+                size_t q = beta_excitation.particles[0];
+                size_t s = beta_excitation.particles[1];
 
-                int sign = beta_I.operatorPhaseFactor(p) * beta_I.operatorPhaseFactor(r) * beta_J.operatorPhaseFactor(q) * beta_J.operatorPhaseFactor(s);
+                int sign = beta_excitation.sign;
 
                 double value = 0.5 * (g(p,q,r,s)
                                    -  g(p,s,r,q)
                                    -  g(r,q,p,s)
                                    +  g(r,s,p,q));
 
-                method(I, J, sign*value);
-                method(J, I, sign*value);
+                coupling += sign * value;
             }
-        }  // loop over addresses J > I
+
+            visit(I, J, coupling);
+            visit(J, I, coupling);
+        }  // loop over connected addresses J > I
     }  // loop over addresses I
 }
 
 
+/**
+ *  Evaluate all Hamiltonian elements through a type-erased method
+ *
+ *  @param hamiltonian_parameters   the Hamiltonian parameters in an orthonormal basis
+ *  @param method                   the method that is called once for both H(I,J) and H(J,I) of every connected pair
+ */
+void SelectedCI::evaluateHamiltonianElements(const HamiltonianParameters<double>& hamiltonian_parameters, const PassToMethod& method) const {
+    this->evaluateHamiltonianElements<PassToMethod>(hamiltonian_parameters, method);
+}
+
+
 /*
  *  CONSTRUCTORS
  */
@@ -202,7 +218,8 @@ void SelectedCI::evaluateHamiltonianElements(const HamiltonianParameters<double>
  */
 SelectedCI::SelectedCI(const SelectedFockSpace& fock_space) :
     HamiltonianBuilder(),
-    fock_space(fock_space)
+    fock_space(fock_space),
+    connections(fock_space.calculateConnections())
 {}
 
 
@@ -228,7 +245,7 @@ SquareMatrix<double> SelectedCI::constructHamiltonian(const HamiltonianParameter
     result_matrix += this->calculateDiagonal(hamiltonian_parameters).asDiagonal();
 
     // We should put the calculated elements inside the result matrix
-    PassToMethod addToMatrix = [&result_matrix](size_t I, size_t J, double value) { result_matrix(I, J) += value; };
+    auto addToMatrix = [&result_matrix](size_t I, size_t J, double value) { result_matrix(I, J) += value; };
 
     this->evaluateHamiltonianElements(hamiltonian_parameters, addToMatrix);
     return result_matrix;
@@ -252,7 +269,7 @@ VectorX<double> SelectedCI::matrixVectorProduct(const HamiltonianParameters<doub
     VectorX<double> matvec = diagonal.cwiseProduct(x);
 
     // We should pass the calculated elements to the resulting vector and perform the product
-    PassToMethod addToMatvec = [&matvec, &x](size_t I, size_t J, double value) { matvec(I) += value * x(J); };
+    auto addToMatvec = [&matvec, &x](size_t I, size_t J, double value) { matvec(I) += value * x(J); };
 
     this->evaluateHamiltonianElements(hamiltonian_parameters, addToMatvec);
 
@@ -260,6 +277,107 @@ VectorX<double> SelectedCI::matrixVectorProduct(const HamiltonianParameters<doub
 }
 
 
+/**
+ *  @param hamiltonian_parameters       the SelectedCI Hamiltonian parameters in an orthonormal orbital basis
+ *  @param X                            the vectors upon which the SelectedCI Hamiltonian acts, as the columns of a (dim x m)-matrix
+ *  @param diagonal                     the diagonal of the SelectedCI Hamiltonian matrix
+ *
+ *  @return the action of the SelectedCI Hamiltonian on every column of X
+ */
+MatrixX<double> SelectedCI::blockMatrixVectorProduct(const HamiltonianParameters<double>& hamiltonian_parameters, const MatrixX<double>& X, const VectorX<double>& diagonal) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("SelectedCI::blockMatrixVectorProduct(HamiltonianParameters<double>, MatrixX<double>, VectorX<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
+    }
+
+    // Work with the transposed vectors, so that the coefficients of one configuration for all vectors are contiguous
+    MatrixX<double> X_transposed = X.transpose();
+    MatrixX<double> matvecs_transposed = MatrixX<double>::Zero(X.cols(), X.rows());
+
+    // We pass every calculated element to all vectors at once
+    auto addToMatvecs = [&matvecs_transposed, &X_transposed](size_t I, size_t J, double value) { matvecs_transposed.col(I) += value * X_transposed.col(J); };
+
+    this->evaluateHamiltonianElements(hamiltonian_parameters, addToMatvecs);
+
+    return diagonal.asDiagonal() * X + matvecs_transposed.transpose();
+}
+
+
+/**
+ *  @param hamiltonian_parameters       the SelectedCI Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the compressed sparse representation of the SelectedCI Hamiltonian matrix, assembled from the evaluated elements
+ */
+Eigen::SparseMatrix<double> SelectedCI::constructSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("SelectedCI::constructSparseHamiltonian(HamiltonianParameters<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
+    }
+
+    auto dim = fock_space.get_dimension();
+    VectorX<double> diagonal = this->calculateDiagonal(hamiltonian_parameters);
+
+    // Collect the elements as triplets: the contributions to the same element are summed upon assembly
+    size_t number_of_connections = 0;
+    for (const auto& connections_I : this->connections) {
+        number_of_connections += connections_I.size();
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(dim + 2*number_of_connections);
+    for (size_t I = 0; I < dim; I++) {
+        triplets.emplace_back(static_cast<int>(I), static_cast<int>(I), diagonal(I));
+    }
+
+    auto addToTriplets = [&triplets](size_t I, size_t J, double value) { triplets.emplace_back(static_cast<int>(I), static_cast<int>(J), value); };
+    this->evaluateHamiltonianElements(hamiltonian_parameters, addToTriplets);
+
+    Eigen::SparseMatrix<double> result_matrix (dim, dim);
+    result_matrix.setFromTriplets(triplets.begin(), triplets.end());
+    return result_matrix;
+}
+
+
+/**
+ *  @param hamiltonian_parameters       the SelectedCI Hamiltonian parameters in an orthonormal orbital basis
+ *
+ *  @return the SelectedCI Hamiltonian matrix, assembled from the evaluated elements in its upper half
+ */
+SymmetricSparseMatrix<double> SelectedCI::constructSymmetricSparseHamiltonian(const HamiltonianParameters<double>& hamiltonian_parameters) const {
+
+    auto K = hamiltonian_parameters.get_h().get_dim();
+    if (K != this->fock_space.get_K()) {
+        throw std::invalid_argument("SelectedCI::constructSymmetricSparseHamiltonian(HamiltonianParameters<double>): Basis functions of the Fock space and hamiltonian_parameters are incompatible.");
+    }
+
+    auto dim = fock_space.get_dimension();
+    VectorX<double> diagonal = this->calculateDiagonal(hamiltonian_parameters);
+
+    // Only collect the elements in the upper triangle: the lower ones follow from symmetry
+    size_t number_of_connections = 0;
+    for (const auto& connections_I : this->connections) {
+        number_of_connections += connections_I.size();
+    }
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(dim + number_of_connections);
+    for (size_t I = 0; I < dim; I++) {
+        triplets.emplace_back(static_cast<int>(I), static_cast<int>(I), diagonal(I));
+    }
+
+    auto addToTriplets = [&triplets](size_t I, size_t J, double value) {
+        if (I < J) {
+            triplets.emplace_back(static_cast<int>(I), static_cast<int>(J), value);
+        }
+    };
+    this->evaluateHamiltonianElements(hamiltonian_parameters, addToTriplets);
+
+    return SymmetricSparseMatrix<double>(dim, triplets);
+}
+
+
 /**
  *  @param hamiltonian_parameters       the SelectedCI Hamiltonian parameters in an orthonormal orbital basis
  *
@@ -281,9 +399,9 @@ VectorX<double> SelectedCI::calculateDiagonal(const HamiltonianParameters<double
     VectorX<double> diagonal = VectorX<double>::Zero(dim);
 
     for (size_t I = 0; I < dim; I++) {  // Ia loops over addresses of alpha onvs
-        Configuration configuration_I = this->fock_space.get_configuration(I);
-        ONV alpha_I = configuration_I.onv_alpha;
-        ONV beta_I = configuration_I.onv_beta;
+        const Configuration& configuration_I = this->fock_space.get_configuration(I);
+        const ONV& alpha_I = configuration_I.onv_alpha;
+        const ONV& beta_I = configuration_I.onv_beta;
 
         for (size_t p = 0; p < K; p++) {
             if (alpha_I.isOccupied(p)) {
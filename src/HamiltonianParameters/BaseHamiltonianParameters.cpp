@@ -17,6 +17,8 @@
 // 
 #include "HamiltonianParameters/BaseHamiltonianParameters.hpp"
 
+#include <atomic>
+
 
 namespace GQCP {
 
@@ -31,7 +33,8 @@ namespace GQCP {
  */
 BaseHamiltonianParameters::BaseHamiltonianParameters(std::shared_ptr<AOBasis> ao_basis, double scalar) :
     ao_basis (std::move(ao_basis)),
-    scalar (scalar)
+    scalar (scalar),
+    revision (nextRevision())
 {}
 
 
@@ -47,4 +50,31 @@ BaseHamiltonianParameters::~BaseHamiltonianParameters() {}
 
 
 
+/*
+ *  PRIVATE STATIC METHODS
+ */
+
+/**
+ *  @return a revision that hasn't been handed out before
+ */
+size_t BaseHamiltonianParameters::nextRevision() {
+    static std::atomic<size_t> counter (0);
+    return ++counter;
+}
+
+
+
+/*
+ *  PROTECTED METHODS
+ */
+
+/**
+ *  Assign a new, unique revision to these Hamiltonian parameters: this should be called every time the parameters are modified
+ */
+void BaseHamiltonianParameters::updateRevision() {
+    this->revision = nextRevision();
+}
+
+
+
 }  // namespace GQCP
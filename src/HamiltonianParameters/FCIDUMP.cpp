@@ -0,0 +1,488 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "HamiltonianParameters/FCIDUMP.hpp"
+
+#include "utilities/MappedFile.hpp"
+#include "utilities/parallel.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+
+namespace GQCP {
+
+
+/*
+ *  PRIVATE STATIC METHODS
+ */
+
+/**
+ *  Skip the whitespace in the given buffer
+ *
+ *  @param position     the current position in the buffer, which is advanced
+ *  @param end          the end of the buffer
+ */
+void FCIDUMP::skipWhitespace(const char*& position, const char* end) {
+    while ((position != end) && std::isspace(static_cast<unsigned char>(*position))) {
+        position++;
+    }
+}
+
+
+/**
+ *  Parse a floating point number (possibly with a Fortran 'D' exponent) from the given buffer
+ *
+ *  @param position     the current position in the buffer, which is advanced past the number
+ *  @param end          the end of the buffer
+ *
+ *  @return the parsed number
+ */
+double FCIDUMP::parseDouble(const char*& position, const char* end) {
+
+    // The mapped buffer isn't null-terminated, so copy the (short) token before handing it to strtod
+    char token[64];
+    size_t length = 0;
+    while ((position != end) && !std::isspace(static_cast<unsigned char>(*position))) {
+        if (length == sizeof(token) - 1) {
+            throw std::invalid_argument("FCIDUMP::parseDouble(const char*&, const char*): The FCIDUMP file contains a number that is too long.");
+        }
+
+        char c = *position++;
+        token[length++] = ((c == 'D') || (c == 'd')) ? 'E' : c;
+    }
+    token[length] = '\0';
+
+    char* token_end;
+    double value = std::strtod(token, &token_end);
+    if ((length == 0) || (token_end != token + length)) {
+        throw std::invalid_argument("FCIDUMP::parseDouble(const char*&, const char*): The FCIDUMP file contains an invalid number: " + std::string(token));
+    }
+
+    return value;
+}
+
+
+/**
+ *  Parse an orbital index from the given buffer
+ *
+ *  @param position     the current position in the buffer, which is advanced past the index
+ *  @param end          the end of the buffer
+ *
+ *  @return the parsed index
+ */
+size_t FCIDUMP::parseIndex(const char*& position, const char* end) {
+
+    skipWhitespace(position, end);
+    if ((position == end) || !std::isdigit(static_cast<unsigned char>(*position))) {
+        throw std::invalid_argument("FCIDUMP::parseIndex(const char*&, const char*): The FCIDUMP file contains an invalid line: expected an orbital index.");
+    }
+
+    size_t index = 0;
+    while ((position != end) && std::isdigit(static_cast<unsigned char>(*position))) {
+        index = 10 * index + static_cast<size_t>(*position - '0');
+        position++;
+    }
+
+    return index;
+}
+
+
+/**
+ *  @param header       the namelist header of an FCIDUMP file
+ *  @param key          the name of the variable
+ *  @param values       the number of values that should be read
+ *
+ *  @return the integer values that are assigned to the given variable, or an empty vector if the variable is not present
+ */
+std::vector<long> FCIDUMP::parseHeaderValues(const std::string& header, const std::string& key, size_t values) {
+
+    // Find the key as a separate word, followed by '='
+    size_t key_position = header.find(key);
+    while (key_position != std::string::npos) {
+        bool is_word_start = (key_position == 0) || !std::isalnum(static_cast<unsigned char>(header[key_position - 1]));
+        size_t after_key = header.find_first_not_of(" \t", key_position + key.size());
+        if (is_word_start && (after_key != std::string::npos) && (header[after_key] == '=')) {
+            key_position = after_key + 1;
+            break;
+        }
+        key_position = header.find(key, key_position + 1);
+    }
+
+    if (key_position == std::string::npos) {
+        return std::vector<long> {};
+    }
+
+
+    // Read the comma- or whitespace-separated values
+    std::vector<long> parsed_values;
+    const char* position = header.c_str() + key_position;
+    while (parsed_values.size() < values) {
+        while ((*position == ',') || std::isspace(static_cast<unsigned char>(*position))) {
+            position++;
+        }
+
+        char* value_end;
+        long value = std::strtol(position, &value_end, 10);
+        if (value_end == position) {
+            throw std::invalid_argument("FCIDUMP::parseHeaderValues(std::string, std::string, size_t): The FCIDUMP header has an invalid value for " + key + ".");
+        }
+        parsed_values.push_back(value);
+        position = value_end;
+    }
+
+    return parsed_values;
+}
+
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  @param N                                    the number of electrons
+ *  @param MS2                                  twice the spin projection
+ *  @param orbital_symmetries                   the irreducible representation of every orbital
+ *  @param core_energy                          the scalar energy term
+ *  @param h                                    the one-electron integrals
+ *  @param unique_two_electron_integrals        the two-electron integrals (pq|rs) with p >= q, r >= s and pq >= rs, in the order of FCIDUMP::uniqueIndex()
+ */
+FCIDUMP::FCIDUMP(size_t N, int MS2, const std::vector<size_t>& orbital_symmetries, double core_energy, const OneElectronOperator<double>& h, const std::vector<double>& unique_two_electron_integrals) :
+    K (h.get_dim()),
+    N (N),
+    MS2 (MS2),
+    orbital_symmetries (orbital_symmetries),
+    core_energy (core_energy),
+    h (h),
+    unique_two_electron_integrals (unique_two_electron_integrals)
+{
+    if (this->orbital_symmetries.size() != this->K) {
+        throw std::invalid_argument("FCIDUMP::FCIDUMP(size_t, int, std::vector<size_t>, double, OneElectronOperator<double>, std::vector<double>): The number of orbital symmetries doesn't match the number of orbitals.");
+    }
+
+    const size_t number_of_pairs = this->K * (this->K + 1) / 2;
+    if (this->unique_two_electron_integrals.size() != number_of_pairs * (number_of_pairs + 1) / 2) {
+        throw std::invalid_argument("FCIDUMP::FCIDUMP(size_t, int, std::vector<size_t>, double, OneElectronOperator<double>, std::vector<double>): The number of unique two-electron integrals doesn't match the number of orbitals.");
+    }
+}
+
+
+/**
+ *  @param N                        the number of electrons
+ *  @param MS2                      twice the spin projection
+ *  @param orbital_symmetries       the irreducible representation of every orbital
+ *  @param core_energy              the scalar energy term
+ *  @param h                        the one-electron integrals
+ *  @param g                        the two-electron integrals in chemist's notation, which should have the permutational symmetries of real integrals
+ */
+FCIDUMP::FCIDUMP(size_t N, int MS2, const std::vector<size_t>& orbital_symmetries, double core_energy, const OneElectronOperator<double>& h, const TwoElectronOperator<double>& g) :
+    FCIDUMP(N, MS2, orbital_symmetries, core_energy, h, std::vector<double>((h.get_dim() * (h.get_dim() + 1) / 2) * (h.get_dim() * (h.get_dim() + 1) / 2 + 1) / 2))
+{
+    if (g.get_dim() != this->K) {
+        throw std::invalid_argument("FCIDUMP::FCIDUMP(size_t, int, std::vector<size_t>, double, OneElectronOperator<double>, TwoElectronOperator<double>): The dimensions of the one- and two-electron integrals are incompatible.");
+    }
+
+    for (size_t p = 0; p < this->K; p++) {
+        for (size_t q = 0; q <= p; q++) {
+            for (size_t r = 0; r <= p; r++) {
+                for (size_t s = 0; s <= r; s++) {
+                    if (pairIndex(r, s) > pairIndex(p, q)) {
+                        break;
+                    }
+                    this->unique_two_electron_integrals[uniqueIndex(p, q, r, s)] = g(p,q,r,s);
+                }
+            }
+        }
+    }
+}
+
+
+
+/*
+ *  NAMED CONSTRUCTORS
+ */
+
+/**
+ *  @param filename     the name of a text FCIDUMP file
+ *
+ *  @return the contents of the given FCIDUMP file
+ *
+ *  The file is mapped into memory and parsed in place
+ */
+FCIDUMP FCIDUMP::ReadText(const std::string& filename) {
+
+    MappedFile file (filename);
+    const char* position = file.get_data();
+    const char* end = file.get_end();
+
+
+    // The namelist header ends with a line containing '&END' (or '$END'), or with a line starting with '/'
+    std::string header;
+    bool header_is_finished = false;
+    while ((position != end) && !header_is_finished) {
+        const char* line_end = static_cast<const char*>(std::memchr(position, '\n', static_cast<size_t>(end - position)));
+        if (!line_end) {
+            line_end = end;
+        }
+
+        std::string line (position, line_end);
+        size_t first_character = line.find_first_not_of(" \t\r");
+        header_is_finished = (line.find("&END") != std::string::npos) || (line.find("$END") != std::string::npos) || ((first_character != std::string::npos) && (line[first_character] == '/'));
+
+        header += line + '\n';
+        position = (line_end == end) ? end : line_end + 1;
+    }
+
+    if (!header_is_finished) {
+        throw std::invalid_argument("FCIDUMP::ReadText(std::string): The .FCIDUMP-file is invalid: could not find the end of the header.");
+    }
+
+    auto norb = parseHeaderValues(header, "NORB", 1);
+    if (norb.empty() || (norb[0] <= 0)) {
+        throw std::invalid_argument("FCIDUMP::ReadText(std::string): The .FCIDUMP-file is invalid: could not read a number of orbitals.");
+    }
+    const auto K = static_cast<size_t>(norb[0]);
+
+    auto nelec = parseHeaderValues(header, "NELEC", 1);
+    auto ms2 = parseHeaderValues(header, "MS2", 1);
+    auto orbsym = parseHeaderValues(header, "ORBSYM", K);
+
+    size_t N = nelec.empty() ? 0 : static_cast<size_t>(nelec[0]);
+    int MS2 = ms2.empty() ? 0 : static_cast<int>(ms2[0]);
+    std::vector<size_t> orbital_symmetries (K, 1);  // C1 symmetry if no symmetries are given
+    for (size_t p = 0; p < orbsym.size(); p++) {
+        orbital_symmetries[p] = static_cast<size_t>(orbsym[p]);
+    }
+
+
+    // Read the integrals, which are given on lines 'x i a j b'
+    double core_energy = 0.0;
+    OneElectronOperator<double> h = OneElectronOperator<double>::Zero(K, K);
+    const size_t number_of_pairs = K * (K + 1) / 2;
+    std::vector<double> unique_two_electron_integrals (number_of_pairs * (number_of_pairs + 1) / 2, 0.0);
+
+    skipWhitespace(position, end);
+    while (position != end) {
+        double x = parseDouble(position, end);
+        size_t i = parseIndex(position, end);
+        size_t a = parseIndex(position, end);
+        size_t j = parseIndex(position, end);
+        size_t b = parseIndex(position, end);
+        skipWhitespace(position, end);
+
+        if ((i > K) || (a > K) || (j > K) || (b > K)) {
+            throw std::invalid_argument("FCIDUMP::ReadText(std::string): The .FCIDUMP-file is invalid: an orbital index is larger than the number of orbitals.");
+        }
+
+        // Based on what the values of the indices are, we can read one-electron integrals, two-electron integrals and the internuclear repulsion energy
+        //  See also (http://hande.readthedocs.io/en/latest/manual/integrals.html)
+        //  FCIDUMP files give the two-electron integrals in CHEMIST'S notation
+
+        //  Internuclear repulsion energy
+        if ((i == 0) && (j == 0) && (a == 0) && (b == 0)) {
+            core_energy = x;
+        }
+
+        //  Single-particle eigenvalues (skipped)
+        else if ((a == 0) && (j == 0) && (b == 0)) {}
+
+        //  One-electron integrals (h_core), with the permutational symmetry for real orbitals
+        else if ((j == 0) && (b == 0)) {
+            h(i-1,a-1) = x;
+            h(a-1,i-1) = x;
+        }
+
+        //  Two-electron integrals: only the symmetry-unique ones are stored
+        else if ((i > 0) && (a > 0) && (j > 0) && (b > 0)) {
+            unique_two_electron_integrals[uniqueIndex(i-1, a-1, j-1, b-1)] = x;
+        }
+    }
+
+    return FCIDUMP(N, MS2, orbital_symmetries, core_energy, h, unique_two_electron_integrals);
+}
+
+
+/**
+ *  @param filename     the name of a binary integral file (see the class documentation for the format)
+ *
+ *  @return the contents of the given binary integral file
+ */
+FCIDUMP FCIDUMP::ReadBinary(const std::string& filename) {
+
+    MappedFile file (filename);
+    const char* position = file.get_data();
+    const char* end = file.get_end();
+
+    // Copy a number of values from the mapped file, checking that the file is large enough
+    auto read = [&position, end] (void* destination, size_t number_of_bytes) {
+        if (static_cast<size_t>(end - position) < number_of_bytes) {
+            throw std::invalid_argument("FCIDUMP::ReadBinary(std::string): The binary integral file is truncated.");
+        }
+        std::memcpy(destination, position, number_of_bytes);
+        position += number_of_bytes;
+    };
+
+
+    // Read the header
+    char magic[8];
+    std::uint64_t version, K, N;
+    std::int64_t MS2;
+    double core_energy;
+
+    if (file.get_size() < sizeof(magic)) {
+        throw std::invalid_argument("FCIDUMP::ReadBinary(std::string): The given file is not a binary integral file.");
+    }
+    read(magic, sizeof(magic));
+    if (std::memcmp(magic, "GQCPFCID", sizeof(magic)) != 0) {
+        throw std::invalid_argument("FCIDUMP::ReadBinary(std::string): The given file is not a binary integral file.");
+    }
+
+    read(&version, sizeof(version));
+    if (version != 1) {
+        throw std::invalid_argument("FCIDUMP::ReadBinary(std::string): The binary integral file has an unsupported version.");
+    }
+
+    read(&K, sizeof(K));
+    read(&N, sizeof(N));
+    read(&MS2, sizeof(MS2));
+    read(&core_energy, sizeof(core_energy));
+
+    // Validate the number of orbitals against the size of the file before allocating anything: the orbital symmetries, the one-electron integrals and the symmetry-unique two-electron integrals follow the header
+    //  Since a file for 2^15 orbitals would already be about 2^60 bytes large, bounding the number of orbitals first prevents overflow in the expected size
+    const size_t number_of_pairs = K * (K + 1) / 2;
+    if ((K >= (1UL << 15)) || (static_cast<size_t>(end - position) != (K + number_of_pairs + number_of_pairs * (number_of_pairs + 1) / 2) * sizeof(double))) {
+        throw std::invalid_argument("FCIDUMP::ReadBinary(std::string): The number of orbitals in the header doesn't match the size of the binary integral file.");
+    }
+
+    std::vector<std::uint64_t> orbsym (K);
+    read(orbsym.data(), K * sizeof(std::uint64_t));
+    std::vector<size_t> orbital_symmetries (orbsym.begin(), orbsym.end());
+
+
+    // Read the integrals
+    OneElectronOperator<double> h (K);
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q <= p; q++) {
+            double h_pq;
+            read(&h_pq, sizeof(double));
+            h(p,q) = h_pq;
+            h(q,p) = h_pq;
+        }
+    }
+
+    std::vector<double> unique_two_electron_integrals (number_of_pairs * (number_of_pairs + 1) / 2);
+    read(unique_two_electron_integrals.data(), unique_two_electron_integrals.size() * sizeof(double));
+
+    return FCIDUMP(static_cast<size_t>(N), static_cast<int>(MS2), orbital_symmetries, core_energy, h, unique_two_electron_integrals);
+}
+
+
+
+/*
+ *  PUBLIC METHODS
+ */
+
+/**
+ *  @return the full two-electron integrals in chemist's notation, unfolded from the symmetry-unique ones
+ */
+TwoElectronOperator<double> FCIDUMP::calculateTwoElectronIntegrals() const {
+
+    TwoElectronOperator<double> g (this->K);
+
+    // Every element of g belongs to exactly one symmetry-unique integral, so the threads write to different elements
+    // The work for an index p grows with p, so the indices are handed out dynamically
+    parallelForDynamic(0, this->K, [this, &g] (size_t p, size_t) {
+        for (size_t q = 0; q <= p; q++) {
+            for (size_t r = 0; r <= p; r++) {
+                for (size_t s = 0; s <= r; s++) {
+                    if (pairIndex(r, s) > pairIndex(p, q)) {
+                        break;
+                    }
+
+                    double x = this->unique_two_electron_integrals[uniqueIndex(p, q, r, s)];
+
+                    // Apply the permutational symmetries for real orbitals
+                    g(p,q,r,s) = x;
+                    g(p,q,s,r) = x;
+                    g(q,p,r,s) = x;
+                    g(q,p,s,r) = x;
+
+                    g(r,s,p,q) = x;
+                    g(s,r,p,q) = x;
+                    g(r,s,q,p) = x;
+                    g(s,r,q,p) = x;
+                }
+            }
+        }
+    });
+
+    return g;
+}
+
+
+/**
+ *  Write the integrals to a binary integral file (see the class documentation for the format)
+ *
+ *  @param filename     the name of the binary integral file
+ */
+void FCIDUMP::writeBinary(const std::string& filename) const {
+
+    std::ofstream output_file_stream (filename, std::ios::binary);
+    if (!output_file_stream.good()) {
+        throw std::runtime_error("FCIDUMP::writeBinary(std::string): The file " + filename + " could not be opened for writing.");
+    }
+
+    // Write the header
+    std::uint64_t version = 1;
+    std::uint64_t K = this->K;
+    std::uint64_t N = this->N;
+    std::int64_t MS2 = this->MS2;
+    std::vector<std::uint64_t> orbsym (this->orbital_symmetries.begin(), this->orbital_symmetries.end());
+
+    output_file_stream.write("GQCPFCID", 8);
+    output_file_stream.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    output_file_stream.write(reinterpret_cast<const char*>(&K), sizeof(K));
+    output_file_stream.write(reinterpret_cast<const char*>(&N), sizeof(N));
+    output_file_stream.write(reinterpret_cast<const char*>(&MS2), sizeof(MS2));
+    output_file_stream.write(reinterpret_cast<const char*>(&this->core_energy), sizeof(double));
+    output_file_stream.write(reinterpret_cast<const char*>(orbsym.data()), orbsym.size() * sizeof(std::uint64_t));
+
+
+    // Write the integrals
+    std::vector<double> h_packed;
+    h_packed.reserve(this->K * (this->K + 1) / 2);
+    for (size_t p = 0; p < this->K; p++) {
+        for (size_t q = 0; q <= p; q++) {
+            h_packed.push_back(this->h(p,q));
+        }
+    }
+
+    output_file_stream.write(reinterpret_cast<const char*>(h_packed.data()), h_packed.size() * sizeof(double));
+    output_file_stream.write(reinterpret_cast<const char*>(this->unique_two_electron_integrals.data()), this->unique_two_electron_integrals.size() * sizeof(double));
+
+    if (!output_file_stream.good()) {
+        throw std::runtime_error("FCIDUMP::writeBinary(std::string): Something went wrong while writing " + filename + ".");
+    }
+}
+
+
+}  // namespace GQCP
@@ -17,8 +17,11 @@
 // 
 #include "LibintCommunicator.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <sstream>
+#include <tuple>
 
 
 
@@ -50,12 +53,90 @@ LibintCommunicator::~LibintCommunicator() {
  */
 
 /**
+ *  @param shell_pair       the compound index sh1 (sh1 + 1) / 2 + sh2 of a shell pair with sh1 >= sh2
+ *
+ *  @return the shell indices (sh1, sh2) that correspond to the given compound shell pair index
+ */
+std::pair<size_t, size_t> LibintCommunicator::unpackShellPair(size_t shell_pair) {
+
+    size_t sh1 = 0;
+    while ((sh1 + 1) * (sh1 + 2) / 2 <= shell_pair) {
+        sh1++;
+    }
+
+    return std::make_pair(sh1, shell_pair - sh1 * (sh1 + 1) / 2);
+}
+
+
+/**
+ *  Calculate the diagonal shell quartets (ab|ab) for all shell pairs sh1 >= sh2, without screening them
+ *
  *  @param operator_type    the name of the operator as specified by the enumeration
- *  @param ao_basis         the AO basis in which the two-electron operator should be expressed
+ *  @param basisset         the libint2 basis set representing the AO basis
+ *  @param method           the function that is called (in parallel) for every shell pair whose integrals are not exhausted, with the integrals (ab|ab) as a square (nbf_sh1 * nbf_sh2)-matrix in which ab = f2 + nbf_sh2 * f1
+ */
+void LibintCommunicator::calculateDiagonalShellQuartets(libint2::Operator operator_type, const libint2::BasisSet& basisset, const DiagonalShellQuartetMethod& method) const {
+
+    const auto nsh = static_cast<size_t>(basisset.size());  // nsh: number of shells in the basisset
+
+    libint2::Engine engine (operator_type, basisset.max_nprim(), static_cast<int>(basisset.max_l()));  // libint2 requires an int
+    engine.set_precision(0.0);  // the diagonal quartets determine Cauchy-Schwarz bounds and Cholesky pivots, so they should not be screened
+
+    const auto number_of_threads = getNumberOfThreads();
+    std::vector<libint2::Engine> engines (number_of_threads, engine);  // every thread uses its own engine
+
+    // The shell pairs (sh1 >= sh2) are handed out dynamically to the threads
+    parallelForDynamic(0, nsh * (nsh + 1) / 2, [&] (size_t shell_pair, size_t thread_index) {
+        size_t sh1, sh2;  // sh1: shell 1, sh2: shell 2
+        std::tie(sh1, sh2) = LibintCommunicator::unpackShellPair(shell_pair);
+
+        auto& thread_engine = engines[thread_index];
+        const auto& buffer = thread_engine.results();
+        thread_engine.compute(basisset[sh1], basisset[sh2], basisset[sh1], basisset[sh2]);
+
+        if (buffer[0] == nullptr) {  // the integrals are exhausted
+            return;
+        }
+
+        const auto nbf_sh1_sh2 = static_cast<long>(basisset[sh1].size() * basisset[sh2].size());
+        const Eigen::Map<const Eigen::MatrixXd> ab_ab (buffer[0], nbf_sh1_sh2, nbf_sh1_sh2);
+        method(sh1, sh2, ab_ab);
+    }, number_of_threads);
+}
+
+
+/**
+ *  @param operator_type    the name of the operator as specified by the enumeration
+ *  @param basisset         the libint2 basis set representing the AO basis
+ *
+ *  @return the Cauchy-Schwarz bounds for all shell pairs, i.e. the matrix with elements sqrt(max |(ab|ab)|) for the basis functions a, b in the shells
+ */
+MatrixX<double> LibintCommunicator::calculateSchwarzBounds(libint2::Operator operator_type, const libint2::BasisSet& basisset) const {
+
+    const auto nsh = static_cast<size_t>(basisset.size());  // nsh: number of shells in the basisset
+    MatrixX<double> K = MatrixX<double>::Zero(nsh, nsh);  // the bounds of exhausted shell pairs are zero
+
+    // The largest element of the diagonal shell quartet determines the bound
+    this->calculateDiagonalShellQuartets(operator_type, basisset, [&K] (size_t sh1, size_t sh2, const Eigen::Map<const Eigen::MatrixXd>& ab_ab) {
+        const double bound = std::sqrt(ab_ab.lpNorm<Eigen::Infinity>());
+        K(sh1, sh2) = bound;
+        K(sh2, sh1) = bound;
+    });
+
+    return K;
+}
+
+
+/**
+ *  @param operator_type        the name of the operator as specified by the enumeration
+ *  @param ao_basis             the AO basis in which the two-electron operator should be expressed
+ *  @param schwarz_threshold    the shell quartets whose Cauchy-Schwarz bound is smaller than this threshold are not calculated
  *
  *  @return the matrix representation of a two-electron operator in the given AO basis
+ *
+ *  Only the symmetry-unique shell quartets are calculated: their integrals are unfolded using the 8-fold permutational symmetry of real two-electron integrals
  */
-TwoElectronOperator<double> LibintCommunicator::calculateTwoElectronIntegrals(libint2::Operator operator_type, const AOBasis& ao_basis) const {
+TwoElectronOperator<double> LibintCommunicator::calculateTwoElectronIntegrals(libint2::Operator operator_type, const AOBasis& ao_basis, double schwarz_threshold) const {
 
     // Use the basis_functions that is currently a libint2::BasisSet
     auto libint_basisset = ao_basis.get_basis_functions();
@@ -67,65 +148,94 @@ TwoElectronOperator<double> LibintCommunicator::calculateTwoElectronIntegrals(li
     g.setZero();
 
 
-    // Construct the libint2 engine
-    libint2::Engine engine(libint2::Operator::coulomb, libint_basisset.max_nprim(), static_cast<int>(libint_basisset.max_l()));  // libint2 requires an int
+    // Construct the libint2 engine, and give every thread its own copy
+    libint2::Engine engine (operator_type, libint_basisset.max_nprim(), static_cast<int>(libint_basisset.max_l()));  // libint2 requires an int
+
+    const auto number_of_threads = getNumberOfThreads();
+    std::vector<libint2::Engine> engines (number_of_threads, engine);
 
     const auto shell2bf = libint_basisset.shell2bf();  // maps shell index to bf index
 
-    const auto &buffer = engine.results();  // vector that holds pointers to computed shell sets
-    // actually, buffer.size() is always 1, so buffer[0] is a pointer to
-    //      the first calculated integral of these specific shells
-    // the values that buffer[0] points to will change after every compute() call
+
+    // The Cauchy-Schwarz inequality |(ab|cd)| <= sqrt((ab|ab)) sqrt((cd|cd)) gives an upper bound for every shell quartet
+    const auto K = this->calculateSchwarzBounds(operator_type, libint_basisset);
 
 
     // Two-electron integrals are between four basis functions, so we'll need four loops
     // Libint calculates integrals between libint2::Shells, so we will loop over the shells (sh) in the basisset
+    // Because (12|34) = (21|34) = (12|43) = (21|43) = (34|12) = (43|12) = (34|21) = (43|21), we only need the quartets with sh1 >= sh2, sh3 >= sh4 and (sh1 sh2) >= (sh3 sh4)
+    // The bra shell pairs (sh1 >= sh2) are handed out dynamically to the threads. Every integral belongs to exactly one unique shell quartet, so the threads write to different elements of g
     const auto nsh = static_cast<size_t>(libint_basisset.size());  // nsh: number of shells in the basisset
-    for (auto sh1 = 0; sh1 != nsh; ++sh1) {  // sh1: shell 1
-        for (auto sh2 = 0; sh2 != nsh; ++sh2) {  // sh2: shell 2
-            for (auto sh3 = 0; sh3 != nsh; ++sh3) {  // sh3: shell 3
-                for (auto sh4 = 0; sh4 != nsh; ++sh4) {  //sh4: shell 4
-                    // Calculate integrals between the two shells (obs is a decorated std::vector<libint2::Shell>)
-                    engine.compute(libint_basisset[sh1], libint_basisset[sh2], libint_basisset[sh3], libint_basisset[sh4]);
-
-                    auto calculated_integrals = buffer[0];
-
-                    if (calculated_integrals == nullptr) {  // if the zeroth element is nullptr, then the whole shell has been exhausted
-                        // or the libint engine predicts that the integrals are below a certain threshold
-                        // in this case the value does not need to be filled in, and we are safe because we have properly initialized to zero
-                        continue;
-                    }
-
-                    // Extract the calculated integrals from calculated_integrals.
-                    // In calculated_integrals, the integrals are stored in row major form.
-                    auto bf1 = static_cast<long>(shell2bf[sh1]);  // (index of) first bf in sh1
-                    auto bf2 = static_cast<long>(shell2bf[sh2]);  // (index of) first bf in sh2
-                    auto bf3 = static_cast<long>(shell2bf[sh3]);  // (index of) first bf in sh3
-                    auto bf4 = static_cast<long>(shell2bf[sh4]);  // (index of) first bf in sh4
+    parallelForDynamic(0, nsh * (nsh + 1) / 2, [&] (size_t shell_pair, size_t thread_index) {
+        size_t sh1, sh2;  // sh1: shell 1, sh2: shell 2
+        std::tie(sh1, sh2) = LibintCommunicator::unpackShellPair(shell_pair);
+
+        auto& thread_engine = engines[thread_index];
+        const auto &buffer = thread_engine.results();  // vector that holds pointers to computed shell sets
+        // actually, buffer.size() is always 1, so buffer[0] is a pointer to
+        //      the first calculated integral of these specific shells
+        // the values that buffer[0] points to will change after every compute() call
+
+        for (size_t sh3 = 0; sh3 <= sh1; sh3++) {  // sh3: shell 3
+            const auto sh4_max = (sh1 == sh3) ? sh2 : sh3;
+            for (size_t sh4 = 0; sh4 <= sh4_max; sh4++) {  // sh4: shell 4
+                // Skip the shell quartets that are negligible according to their Cauchy-Schwarz bound
+                if (K(sh1, sh2) * K(sh3, sh4) < schwarz_threshold) {
+                    continue;
+                }
 
+                // Calculate integrals between the two shells (obs is a decorated std::vector<libint2::Shell>)
+                thread_engine.compute(libint_basisset[sh1], libint_basisset[sh2], libint_basisset[sh3], libint_basisset[sh4]);
 
-                    auto nbf_sh1 = static_cast<long>(libint_basisset[sh1].size());  // number of basis functions in first shell
-                    auto nbf_sh2 = static_cast<long>(libint_basisset[sh2].size());  // number of basis functions in second shell
-                    auto nbf_sh3 = static_cast<long>(libint_basisset[sh3].size());  // number of basis functions in third shell
-                    auto nbf_sh4 = static_cast<long>(libint_basisset[sh4].size());  // number of basis functions in fourth shell
+                auto calculated_integrals = buffer[0];
 
-                    for (auto f1 = 0L; f1 != nbf_sh1; ++f1) {
-                        for (auto f2 = 0L; f2 != nbf_sh2; ++f2) {
-                            for (auto f3 = 0L; f3 != nbf_sh3; ++f3) {
-                                for (auto f4 = 0L; f4 != nbf_sh4; ++f4) {
-                                    auto computed_integral = calculated_integrals[f4 + nbf_sh4 * (f3 + nbf_sh3 * (f2 + nbf_sh2 * (f1)))];  // integrals are packed in row-major form
+                if (calculated_integrals == nullptr) {  // if the zeroth element is nullptr, then the whole shell has been exhausted
+                    // or the libint engine predicts that the integrals are below a certain threshold
+                    // in this case the value does not need to be filled in, and we are safe because we have properly initialized to zero
+                    continue;
+                }
 
-                                    // Two-electron integrals are given in CHEMIST'S notation: (11|22)
-                                    g(f1 + bf1, f2 + bf2, f3 + bf3, f4 + bf4) = computed_integral;
-                                }
+                // Extract the calculated integrals from calculated_integrals.
+                // In calculated_integrals, the integrals are stored in row major form.
+                auto bf1 = static_cast<long>(shell2bf[sh1]);  // (index of) first bf in sh1
+                auto bf2 = static_cast<long>(shell2bf[sh2]);  // (index of) first bf in sh2
+                auto bf3 = static_cast<long>(shell2bf[sh3]);  // (index of) first bf in sh3
+                auto bf4 = static_cast<long>(shell2bf[sh4]);  // (index of) first bf in sh4
+
+
+                auto nbf_sh1 = static_cast<long>(libint_basisset[sh1].size());  // number of basis functions in first shell
+                auto nbf_sh2 = static_cast<long>(libint_basisset[sh2].size());  // number of basis functions in second shell
+                auto nbf_sh3 = static_cast<long>(libint_basisset[sh3].size());  // number of basis functions in third shell
+                auto nbf_sh4 = static_cast<long>(libint_basisset[sh4].size());  // number of basis functions in fourth shell
+
+                for (auto f1 = 0L; f1 != nbf_sh1; ++f1) {
+                    const auto p = f1 + bf1;
+                    for (auto f2 = 0L; f2 != nbf_sh2; ++f2) {
+                        const auto q = f2 + bf2;
+                        for (auto f3 = 0L; f3 != nbf_sh3; ++f3) {
+                            const auto r = f3 + bf3;
+                            for (auto f4 = 0L; f4 != nbf_sh4; ++f4) {
+                                const auto s = f4 + bf4;
+                                auto computed_integral = calculated_integrals[f4 + nbf_sh4 * (f3 + nbf_sh3 * (f2 + nbf_sh2 * (f1)))];  // integrals are packed in row-major form
+
+                                // Two-electron integrals are given in CHEMIST'S notation: (11|22)
+                                // Unfold the integral to all its permutationally equivalent positions
+                                g(p,q,r,s) = computed_integral;
+                                g(q,p,r,s) = computed_integral;
+                                g(p,q,s,r) = computed_integral;
+                                g(q,p,s,r) = computed_integral;
+                                g(r,s,p,q) = computed_integral;
+                                g(s,r,p,q) = computed_integral;
+                                g(r,s,q,p) = computed_integral;
+                                g(s,r,q,p) = computed_integral;
                             }
                         }
-                    } // data access loops
+                    }
+                } // data access loops
 
-                }
             }
         }
-    } // shell loops
+    }, number_of_threads);  // shell loops
 
     return g;
 };
@@ -216,12 +326,460 @@ std::array<OneElectronOperator<double>, 3> LibintCommunicator::calculateDipoleIn
 
 
 /**
- *  @param ao_basis     the AO basis used for the calculation of the Coulomb repulsion integrals
+ *  @param ao_basis             the AO basis used for the calculation of the Coulomb repulsion integrals
+ *  @param schwarz_threshold    the shell quartets whose Cauchy-Schwarz bound is smaller than this threshold are not calculated, i.e. set to zero
  *
  *  @return the Coulomb repulsion integrals expressed in the given AO basis
  */
-TwoElectronOperator<double> LibintCommunicator::calculateCoulombRepulsionIntegrals(const AOBasis& ao_basis) const {
-    return this->calculateTwoElectronIntegrals(libint2::Operator::coulomb, ao_basis);
+TwoElectronOperator<double> LibintCommunicator::calculateCoulombRepulsionIntegrals(const AOBasis& ao_basis, double schwarz_threshold) const {
+    return this->calculateTwoElectronIntegrals(libint2::Operator::coulomb, ao_basis, schwarz_threshold);
+}
+
+
+/**
+ *  @param ao_basis     the AO basis used for the calculation of the Coulomb repulsion integrals
+ *
+ *  @return the Cauchy-Schwarz bounds of the Coulomb repulsion integrals for all shell pairs, i.e. the matrix with elements sqrt(max |(ab|ab)|) for the basis functions a, b in the shells
+ */
+MatrixX<double> LibintCommunicator::calculateCoulombRepulsionSchwarzBounds(const AOBasis& ao_basis) const {
+    return this->calculateSchwarzBounds(libint2::Operator::coulomb, ao_basis.get_basis_functions());
+}
+
+
+/**
+ *  Calculate the two-electron part G = J - 1/2 K of the RHF Fock matrix directly from the Coulomb repulsion shell quartets, without storing the integrals
+ *
+ *  @param ao_basis                 the AO basis in which the density matrix is expressed
+ *  @param D_AO                     the (symmetric) density matrix in AO basis, or a difference of two of them
+ *  @param schwarz_bounds           the Cauchy-Schwarz bounds of the shell pairs, see calculateCoulombRepulsionSchwarzBounds()
+ *  @param screening_threshold      the shell quartets whose Cauchy-Schwarz bound, weighted with the largest density matrix element they are contracted with, is smaller than this threshold are not calculated
+ *
+ *  @return the two-electron part of the RHF Fock matrix expressed in the AO basis
+ */
+SquareMatrix<double> LibintCommunicator::calculateRHFTwoElectronFockMatrix(const AOBasis& ao_basis, const OneRDM<double>& D_AO, const MatrixX<double>& schwarz_bounds, double screening_threshold) const {
+
+    const auto& libint_basisset = ao_basis.get_basis_functions();
+    const auto nbf = static_cast<size_t>(libint_basisset.nbf());  // nbf: number of basis functions in the basisset
+    const auto nsh = static_cast<size_t>(libint_basisset.size());  // nsh: number of shells in the basisset
+
+    if (D_AO.get_dim() != nbf) {
+        throw std::invalid_argument("LibintCommunicator::calculateRHFTwoElectronFockMatrix(AOBasis, OneRDM<double>, MatrixX<double>, double): The dimension of the density matrix is incompatible with the AO basis.");
+    }
+
+    if ((static_cast<size_t>(schwarz_bounds.rows()) != nsh) || (static_cast<size_t>(schwarz_bounds.cols()) != nsh)) {
+        throw std::invalid_argument("LibintCommunicator::calculateRHFTwoElectronFockMatrix(AOBasis, OneRDM<double>, MatrixX<double>, double): The dimensions of the Cauchy-Schwarz bounds are incompatible with the AO basis.");
+    }
+
+    const auto shell2bf = libint_basisset.shell2bf();  // maps shell index to bf index
+
+
+    // The largest absolute density matrix element in every block of shell pairs is used to weigh the Cauchy-Schwarz bounds
+    MatrixX<double> D_shell = MatrixX<double>::Zero(nsh, nsh);
+    for (size_t sh1 = 0; sh1 < nsh; sh1++) {
+        for (size_t sh2 = 0; sh2 < nsh; sh2++) {
+            D_shell(sh1, sh2) = D_AO.block(shell2bf[sh1], shell2bf[sh2], libint_basisset[sh1].size(), libint_basisset[sh2].size()).lpNorm<Eigen::Infinity>();
+        }
+    }
+    const double D_max = (nsh > 0) ? D_shell.maxCoeff() : 0.0;
+    const double schwarz_max = (nsh > 0) ? schwarz_bounds.maxCoeff() : 0.0;
+
+
+    // Construct the libint2 engine, and give every thread its own copy and its own contribution to G
+    libint2::Engine engine (libint2::Operator::coulomb, libint_basisset.max_nprim(), static_cast<int>(libint_basisset.max_l()));  // libint2 requires an int
+
+    const auto number_of_threads = getNumberOfThreads();
+    std::vector<libint2::Engine> engines (number_of_threads, engine);
+    std::vector<SquareMatrix<double>> G_partial (number_of_threads, SquareMatrix<double>::Zero(nbf, nbf));
+
+
+    // Only the symmetry-unique shell quartets with sh1 >= sh2, sh3 >= sh4 and (sh1 sh2) >= (sh3 sh4) are calculated (see calculateTwoElectronIntegrals())
+    // Every quartet is contracted with the density matrix as if it were all of its permutationally equivalent quartets, which is compensated for by symmetrizing G afterwards
+    parallelForDynamic(0, nsh * (nsh + 1) / 2, [&] (size_t shell_pair, size_t thread_index) {
+        size_t sh1, sh2;  // sh1: shell 1, sh2: shell 2
+        std::tie(sh1, sh2) = LibintCommunicator::unpackShellPair(shell_pair);
+
+        // Skip the bra shell pair if even its largest contribution would be negligible
+        if (schwarz_bounds(sh1, sh2) * schwarz_max * D_max < screening_threshold) {
+            return;
+        }
+
+        auto& thread_engine = engines[thread_index];
+        const auto& buffer = thread_engine.results();
+        auto& G = G_partial[thread_index];
+
+        for (size_t sh3 = 0; sh3 <= sh1; sh3++) {  // sh3: shell 3
+            const auto sh4_max = (sh1 == sh3) ? sh2 : sh3;
+            for (size_t sh4 = 0; sh4 <= sh4_max; sh4++) {  // sh4: shell 4
+
+                // Skip the shell quartets that are negligible according to their density-weighted Cauchy-Schwarz bound
+                const double D_quartet = std::max({D_shell(sh1, sh2), D_shell(sh3, sh4), D_shell(sh1, sh3), D_shell(sh2, sh4), D_shell(sh1, sh4), D_shell(sh2, sh3)});
+                if (schwarz_bounds(sh1, sh2) * schwarz_bounds(sh3, sh4) * D_quartet < screening_threshold) {
+                    continue;
+                }
+
+                thread_engine.compute(libint_basisset[sh1], libint_basisset[sh2], libint_basisset[sh3], libint_basisset[sh4]);
+                const auto calculated_integrals = buffer[0];
+                if (calculated_integrals == nullptr) {  // the integrals are exhausted
+                    continue;
+                }
+
+                // The number of permutationally equivalent shell quartets that this unique quartet represents
+                const double degeneracy = ((sh1 == sh2) ? 1.0 : 2.0) * ((sh3 == sh4) ? 1.0 : 2.0) * (((sh1 == sh3) && (sh2 == sh4)) ? 1.0 : 2.0);
+
+                const auto bf1 = static_cast<long>(shell2bf[sh1]);  // (index of) first bf in sh1
+                const auto bf2 = static_cast<long>(shell2bf[sh2]);  // (index of) first bf in sh2
+                const auto bf3 = static_cast<long>(shell2bf[sh3]);  // (index of) first bf in sh3
+                const auto bf4 = static_cast<long>(shell2bf[sh4]);  // (index of) first bf in sh4
+
+                const auto nbf_sh1 = static_cast<long>(libint_basisset[sh1].size());  // number of basis functions in first shell
+                const auto nbf_sh2 = static_cast<long>(libint_basisset[sh2].size());  // number of basis functions in second shell
+                const auto nbf_sh3 = static_cast<long>(libint_basisset[sh3].size());  // number of basis functions in third shell
+                const auto nbf_sh4 = static_cast<long>(libint_basisset[sh4].size());  // number of basis functions in fourth shell
+
+                for (auto f1 = 0L; f1 != nbf_sh1; ++f1) {
+                    const auto p = f1 + bf1;
+                    for (auto f2 = 0L; f2 != nbf_sh2; ++f2) {
+                        const auto q = f2 + bf2;
+                        for (auto f3 = 0L; f3 != nbf_sh3; ++f3) {
+                            const auto r = f3 + bf3;
+                            for (auto f4 = 0L; f4 != nbf_sh4; ++f4) {
+                                const auto s = f4 + bf4;
+                                const double value = degeneracy * calculated_integrals[f4 + nbf_sh4 * (f3 + nbf_sh3 * (f2 + nbf_sh2 * (f1)))];  // integrals are packed in row-major form
+
+                                // Coulomb contributions
+                                G(p,q) += D_AO(r,s) * value;
+                                G(r,s) += D_AO(p,q) * value;
+
+                                // Exchange contributions
+                                G(p,r) -= 0.25 * D_AO(q,s) * value;
+                                G(q,s) -= 0.25 * D_AO(p,r) * value;
+                                G(p,s) -= 0.25 * D_AO(q,r) * value;
+                                G(q,r) -= 0.25 * D_AO(p,s) * value;
+                            }
+                        }
+                    }
+                }  // data access loops
+            }
+        }
+    }, number_of_threads);  // shell loops
+
+
+    SquareMatrix<double> G = SquareMatrix<double>::Zero(nbf, nbf);
+    for (const auto& G_thread : G_partial) {
+        G += G_thread;
+    }
+
+    return 0.25 * (G + G.transpose());
+}
+
+
+/**
+ *  @param auxiliary_basis      the auxiliary basis used for the calculation of the two-center Coulomb repulsion integrals
+ *
+ *  @return the Coulomb metric (P|Q) of the auxiliary basis
+ */
+SquareMatrix<double> LibintCommunicator::calculateCoulombMetric(const AOBasis& auxiliary_basis) const {
+
+    const auto& libint_basisset = auxiliary_basis.get_basis_functions();
+    const auto nbf = static_cast<size_t>(libint_basisset.nbf());  // nbf: number of basis functions in the basisset
+    const auto nsh = static_cast<size_t>(libint_basisset.size());  // nsh: number of shells in the basisset
+
+    const auto shell2bf = libint_basisset.shell2bf();  // maps shell index to bf index
+
+
+    // Construct the libint2 engine for two-center integrals (P|Q), and give every thread its own copy
+    libint2::Engine engine (libint2::Operator::coulomb, libint_basisset.max_nprim(), static_cast<int>(libint_basisset.max_l()));  // libint2 requires an int
+    engine.set(libint2::BraKet::xs_xs);
+
+    const auto number_of_threads = getNumberOfThreads();
+    std::vector<libint2::Engine> engines (number_of_threads, engine);
+
+    SquareMatrix<double> metric = SquareMatrix<double>::Zero(nbf, nbf);
+
+
+    // Only the shell pairs with sh1 >= sh2 are calculated, every thread writing to its own elements of the metric
+    parallelForDynamic(0, nsh * (nsh + 1) / 2, [&] (size_t shell_pair, size_t thread_index) {
+        size_t sh1, sh2;  // sh1: shell 1, sh2: shell 2
+        std::tie(sh1, sh2) = LibintCommunicator::unpackShellPair(shell_pair);
+
+        const auto& buffer = engines[thread_index].compute2<libint2::Operator::coulomb, libint2::BraKet::xs_xs, 0>(libint_basisset[sh1], libint2::Shell::unit(), libint_basisset[sh2], libint2::Shell::unit());
+        const auto calculated_integrals = buffer[0];
+        if (calculated_integrals == nullptr) {  // nullptr returned if all integrals in this shell pair were screened out
+            return;
+        }
+
+        const auto bf1 = shell2bf[sh1];  // (index of) first bf in sh1
+        const auto bf2 = shell2bf[sh2];  // (index of) first bf in sh2
+
+        const auto nbf_sh1 = libint_basisset[sh1].size();  // number of basis functions in first shell
+        const auto nbf_sh2 = libint_basisset[sh2].size();  // number of basis functions in second shell
+
+        for (size_t f1 = 0; f1 < nbf_sh1; f1++) {  // f1: index of basis function within shell 1
+            for (size_t f2 = 0; f2 < nbf_sh2; f2++) {  // f2: index of basis function within shell 2
+                const double value = calculated_integrals[f2 + f1 * nbf_sh2];  // integrals are packed in row-major form
+
+                metric(bf1 + f1, bf2 + f2) = value;
+                metric(bf2 + f2, bf1 + f1) = value;
+            }
+        }  // data access loops
+    }, number_of_threads);  // shell pair loop
+
+    return metric;
+}
+
+
+/**
+ *  @param ao_basis             the AO basis used for the calculation of the three-center Coulomb repulsion integrals
+ *  @param auxiliary_basis      the auxiliary basis used for the calculation of the three-center Coulomb repulsion integrals
+ *
+ *  @return the three-center Coulomb repulsion integrals (mu nu|P) as a (K^2 x N_aux)-matrix, in which the element (mu + K nu, P) is (mu nu|P)
+ */
+MatrixX<double> LibintCommunicator::calculateThreeCenterCoulombRepulsionIntegrals(const AOBasis& ao_basis, const AOBasis& auxiliary_basis) const {
+
+    const auto& aux_basisset = auxiliary_basis.get_basis_functions();
+    const auto& ao_basisset = ao_basis.get_basis_functions();
+
+    const auto naux = static_cast<size_t>(aux_basisset.nbf());  // naux: number of auxiliary basis functions
+    const auto nbf = static_cast<size_t>(ao_basisset.nbf());  // nbf: number of basis functions in the AO basis
+    const auto nsh_aux = static_cast<size_t>(aux_basisset.size());  // nsh_aux: number of shells in the auxiliary basis
+    const auto nsh = static_cast<size_t>(ao_basisset.size());  // nsh: number of shells in the AO basis
+
+    const auto aux_shell2bf = aux_basisset.shell2bf();  // maps auxiliary shell index to auxiliary bf index
+    const auto shell2bf = ao_basisset.shell2bf();  // maps shell index to bf index
+
+
+    // Construct the libint2 engine for three-center integrals (P|mu nu), and give every thread its own copy
+    const auto max_nprim = std::max(aux_basisset.max_nprim(), ao_basisset.max_nprim());
+    const auto max_l = std::max(aux_basisset.max_l(), ao_basisset.max_l());
+    libint2::Engine engine (libint2::Operator::coulomb, max_nprim, static_cast<int>(max_l));  // libint2 requires an int
+    engine.set(libint2::BraKet::xs_xx);
+
+    const auto number_of_threads = getNumberOfThreads();
+    std::vector<libint2::Engine> engines (number_of_threads, engine);
+
+    MatrixX<double> B = MatrixX<double>::Zero(nbf * nbf, naux);
+
+
+    // The auxiliary shells are handed out dynamically to the threads, which each write to their own columns of B
+    // Only the AO shell pairs with sh1 >= sh2 are calculated: (mu nu|P) = (nu mu|P)
+    parallelForDynamic(0, nsh_aux, [&] (size_t sh_aux, size_t thread_index) {
+        auto& thread_engine = engines[thread_index];
+
+        const auto bf_aux = aux_shell2bf[sh_aux];  // (index of) first bf in the auxiliary shell
+        const auto nbf_sh_aux = aux_basisset[sh_aux].size();  // number of basis functions in the auxiliary shell
+
+        for (size_t sh1 = 0; sh1 < nsh; sh1++) {  // sh1: shell 1
+            for (size_t sh2 = 0; sh2 <= sh1; sh2++) {  // sh2: shell 2
+
+                const auto& buffer = thread_engine.compute2<libint2::Operator::coulomb, libint2::BraKet::xs_xx, 0>(aux_basisset[sh_aux], libint2::Shell::unit(), ao_basisset[sh1], ao_basisset[sh2]);
+                const auto calculated_integrals = buffer[0];
+                if (calculated_integrals == nullptr) {  // nullptr returned if all integrals in this shell triplet were screened out
+                    continue;
+                }
+
+                const auto bf1 = shell2bf[sh1];  // (index of) first bf in sh1
+                const auto bf2 = shell2bf[sh2];  // (index of) first bf in sh2
+
+                const auto nbf_sh1 = ao_basisset[sh1].size();  // number of basis functions in first shell
+                const auto nbf_sh2 = ao_basisset[sh2].size();  // number of basis functions in second shell
+
+                for (size_t f_aux = 0; f_aux < nbf_sh_aux; f_aux++) {  // f_aux: index of basis function within the auxiliary shell
+                    for (size_t f1 = 0; f1 < nbf_sh1; f1++) {  // f1: index of basis function within shell 1
+                        for (size_t f2 = 0; f2 < nbf_sh2; f2++) {  // f2: index of basis function within shell 2
+                            const double value = calculated_integrals[f2 + nbf_sh2 * (f1 + nbf_sh1 * f_aux)];  // integrals are packed in row-major form
+
+                            const auto mu = bf1 + f1;
+                            const auto nu = bf2 + f2;
+                            B(mu + nbf * nu, bf_aux + f_aux) = value;
+                            B(nu + nbf * mu, bf_aux + f_aux) = value;
+                        }
+                    }
+                }  // data access loops
+            }
+        }
+    }, number_of_threads);  // auxiliary shell loop
+
+    return B;
+}
+
+
+/**
+ *  @param ao_basis             the AO basis used for the calculation of the Coulomb repulsion integrals
+ *  @param auxiliary_basis      the auxiliary basis used for the density fitting
+ *
+ *  @return the density-fitted Coulomb repulsion integrals expressed in the given AO basis
+ */
+FactorizedTwoElectronOperator<double> LibintCommunicator::calculateDensityFittedCoulombRepulsionIntegrals(const AOBasis& ao_basis, const AOBasis& auxiliary_basis) const {
+
+    return FactorizedTwoElectronOperator<double>::DensityFitted(this->calculateThreeCenterCoulombRepulsionIntegrals(ao_basis, auxiliary_basis), this->calculateCoulombMetric(auxiliary_basis));
+}
+
+
+
+/**
+ *  @param ao_basis             the AO basis used for the calculation of the Coulomb repulsion integrals
+ *
+ *  @return the diagonal (mu nu|mu nu) of the Coulomb repulsion integrals, in which the element mu + K nu is (mu nu|mu nu)
+ */
+VectorX<double> LibintCommunicator::calculateCoulombRepulsionIntegralsDiagonal(const AOBasis& ao_basis) const {
+
+    const auto& libint_basisset = ao_basis.get_basis_functions();
+    const auto nbf = static_cast<size_t>(libint_basisset.nbf());  // nbf: number of basis functions in the basisset
+
+    const auto shell2bf = libint_basisset.shell2bf();  // maps shell index to bf index
+
+    VectorX<double> diagonal = VectorX<double>::Zero(nbf * nbf);  // the diagonal elements of exhausted shell pairs are zero
+
+
+    // The diagonal of the diagonal shell quartet (ab|ab) contains the needed elements (mu nu|mu nu)
+    this->calculateDiagonalShellQuartets(libint2::Operator::coulomb, libint_basisset, [&] (size_t sh1, size_t sh2, const Eigen::Map<const Eigen::MatrixXd>& ab_ab) {
+        const auto bf1 = shell2bf[sh1];  // (index of) first bf in sh1
+        const auto bf2 = shell2bf[sh2];  // (index of) first bf in sh2
+
+        const auto nbf_sh1 = libint_basisset[sh1].size();  // number of basis functions in first shell
+        const auto nbf_sh2 = libint_basisset[sh2].size();  // number of basis functions in second shell
+
+        for (size_t f1 = 0; f1 < nbf_sh1; f1++) {  // f1: index of basis function within shell 1
+            for (size_t f2 = 0; f2 < nbf_sh2; f2++) {  // f2: index of basis function within shell 2
+                const auto f12 = f2 + nbf_sh2 * f1;  // integrals are packed in row-major form
+                const double value = ab_ab(f12, f12);
+
+                const auto mu = bf1 + f1;
+                const auto nu = bf2 + f2;
+                diagonal(mu + nbf * nu) = value;
+                diagonal(nu + nbf * mu) = value;
+            }
+        }  // data access loops
+    });
+
+    return diagonal;
+}
+
+
+/**
+ *  @param ao_basis             the AO basis used for the calculation of the Coulomb repulsion integrals
+ *  @param sh3                  the index of the first shell of the ket shell pair
+ *  @param sh4                  the index of the second shell of the ket shell pair
+ *
+ *  @return the Coulomb repulsion integrals (mu nu|rho lambda) for all rho in sh3 and lambda in sh4 as a (K^2 x nbf_sh3 nbf_sh4)-matrix, in which the element (mu + K nu, f3 + nbf_sh3 f4) is (mu nu|rho lambda) with rho the f3-th basis function in sh3 and lambda the f4-th basis function in sh4
+ */
+MatrixX<double> LibintCommunicator::calculateCoulombRepulsionIntegralsColumns(const AOBasis& ao_basis, size_t sh3, size_t sh4) const {
+
+    const auto& libint_basisset = ao_basis.get_basis_functions();
+    const auto nbf = static_cast<size_t>(libint_basisset.nbf());  // nbf: number of basis functions in the basisset
+    const auto nsh = static_cast<size_t>(libint_basisset.size());  // nsh: number of shells in the basisset
+
+    if ((sh3 >= nsh) || (sh4 >= nsh)) {
+        throw std::invalid_argument("LibintCommunicator::calculateCoulombRepulsionIntegralsColumns(AOBasis, size_t, size_t): The given shell indices are out of bounds.");
+    }
+
+    const auto shell2bf = libint_basisset.shell2bf();  // maps shell index to bf index
+
+    const auto nbf_sh3 = libint_basisset[sh3].size();  // number of basis functions in third shell
+    const auto nbf_sh4 = libint_basisset[sh4].size();  // number of basis functions in fourth shell
+
+
+    // Construct the libint2 engine, and give every thread its own copy
+    libint2::Engine engine (libint2::Operator::coulomb, libint_basisset.max_nprim(), static_cast<int>(libint_basisset.max_l()));  // libint2 requires an int
+
+    const auto number_of_threads = getNumberOfThreads();
+    std::vector<libint2::Engine> engines (number_of_threads, engine);
+
+    MatrixX<double> columns = MatrixX<double>::Zero(nbf * nbf, nbf_sh3 * nbf_sh4);
+
+
+    // Only the bra shell pairs with sh1 >= sh2 are calculated: (mu nu|rho lambda) = (nu mu|rho lambda)
+    // The bra shell pairs are handed out dynamically to the threads, which each write to their own rows of the columns
+    parallelForDynamic(0, nsh * (nsh + 1) / 2, [&] (size_t shell_pair, size_t thread_index) {
+        size_t sh1, sh2;  // sh1: shell 1, sh2: shell 2
+        std::tie(sh1, sh2) = LibintCommunicator::unpackShellPair(shell_pair);
+
+        auto& thread_engine = engines[thread_index];
+        const auto& buffer = thread_engine.results();
+        thread_engine.compute(libint_basisset[sh1], libint_basisset[sh2], libint_basisset[sh3], libint_basisset[sh4]);
+
+        const auto calculated_integrals = buffer[0];
+        if (calculated_integrals == nullptr) {  // nullptr returned if all integrals in this shell quartet were screened out
+            return;
+        }
+
+        const auto bf1 = shell2bf[sh1];  // (index of) first bf in sh1
+        const auto bf2 = shell2bf[sh2];  // (index of) first bf in sh2
+
+        const auto nbf_sh1 = libint_basisset[sh1].size();  // number of basis functions in first shell
+        const auto nbf_sh2 = libint_basisset[sh2].size();  // number of basis functions in second shell
+
+        for (size_t f1 = 0; f1 < nbf_sh1; f1++) {  // f1: index of basis function within shell 1
+            for (size_t f2 = 0; f2 < nbf_sh2; f2++) {  // f2: index of basis function within shell 2
+                const auto mu = bf1 + f1;
+                const auto nu = bf2 + f2;
+
+                for (size_t f3 = 0; f3 < nbf_sh3; f3++) {  // f3: index of basis function within shell 3
+                    for (size_t f4 = 0; f4 < nbf_sh4; f4++) {  // f4: index of basis function within shell 4
+                        const double value = calculated_integrals[f4 + nbf_sh4 * (f3 + nbf_sh3 * (f2 + nbf_sh2 * f1))];  // integrals are packed in row-major form
+
+                        columns(mu + nbf * nu, f3 + nbf_sh3 * f4) = value;
+                        columns(nu + nbf * mu, f3 + nbf_sh3 * f4) = value;
+                    }
+                }
+            }
+        }  // data access loops
+    }, number_of_threads);  // bra shell pair loop
+
+    return columns;
+}
+
+
+/**
+ *  @param ao_basis             the AO basis used for the calculation of the Coulomb repulsion integrals
+ *  @param threshold            the decomposition stops when the largest remaining diagonal element is smaller than this threshold
+ *
+ *  @return the pivoted incomplete Cholesky decomposition of the Coulomb repulsion integrals expressed in the given AO basis, which is calculated from the diagonal and the pivot columns only
+ */
+FactorizedTwoElectronOperator<double> LibintCommunicator::calculateCholeskyDecomposedCoulombRepulsionIntegrals(const AOBasis& ao_basis, double threshold) const {
+
+    const auto& libint_basisset = ao_basis.get_basis_functions();
+    const auto nbf = static_cast<size_t>(libint_basisset.nbf());  // nbf: number of basis functions in the basisset
+    const auto nsh = static_cast<size_t>(libint_basisset.size());  // nsh: number of shells in the basisset
+
+    const auto shell2bf = libint_basisset.shell2bf();  // maps shell index to bf index
+
+
+    // Construct the map between a basis function and its shell
+    std::vector<size_t> bf2shell (nbf);
+    for (size_t sh = 0; sh < nsh; sh++) {
+        for (size_t f = 0; f < libint_basisset[sh].size(); f++) {
+            bf2shell[shell2bf[sh] + f] = sh;
+        }
+    }
+
+
+    // Libint calculates the integrals of a whole shell pair at once, and consecutive pivots often lie in the same shell pair, so the columns of the last shell pair are kept
+    size_t cached_sh3 = nsh;  // nsh signals that nothing has been calculated yet
+    size_t cached_sh4 = nsh;
+    MatrixX<double> cached_columns;
+
+    const auto column = [&] (size_t pivot) {
+        auto rho = pivot % nbf;
+        auto lambda = pivot / nbf;
+        if (bf2shell[rho] < bf2shell[lambda]) {  // (mu nu|rho lambda) = (mu nu|lambda rho), so only the shell pairs with sh3 >= sh4 are calculated
+            std::swap(rho, lambda);
+        }
+
+        const auto sh3 = bf2shell[rho];
+        const auto sh4 = bf2shell[lambda];
+        if ((sh3 != cached_sh3) || (sh4 != cached_sh4)) {
+            cached_columns = this->calculateCoulombRepulsionIntegralsColumns(ao_basis, sh3, sh4);
+            cached_sh3 = sh3;
+            cached_sh4 = sh4;
+        }
+
+        const auto f3 = rho - shell2bf[sh3];
+        const auto f4 = lambda - shell2bf[sh4];
+        return VectorX<double>(cached_columns.col(f3 + libint_basisset[sh3].size() * f4));
+    };
+
+    return FactorizedTwoElectronOperator<double>::Cholesky(this->calculateCoulombRepulsionIntegralsDiagonal(ao_basis), column, threshold);
 }
 
 
@@ -17,6 +17,10 @@
 // 
 #include "RDM/DOCIRDMBuilder.hpp"
 
+#include "utilities/parallel.hpp"
+
+#include <mutex>
+
 
 namespace GQCP {
 
@@ -75,79 +79,110 @@ OneRDMs<double> DOCIRDMBuilder::calculate1RDMs(const VectorX<double>& x) const {
  */
 TwoRDMs<double> DOCIRDMBuilder::calculate2RDMs(const VectorX<double>& x) const {
 
-    // The formulas for the DOCI 2-RDMs can be found in (https://github.com/lelemmen/electronic_structure)
+    // For DOCI, we have additional symmetries (two_rdm_aaaa = two_rdm_bbbb, two_rdm_aabb = two_rdm_bbaa)
+    auto d = this->calculateSeniorityZero2RDM(x);
+    auto d_aaaa = d.expandSameSpin();
+    auto d_aabb = d.expandOppositeSpin();
 
-    size_t K = this->fock_space.get_K();
-    size_t dim = this->fock_space.get_dimension();
+    return TwoRDMs<double>(d_aaaa, d_aabb, d_aabb, d_aaaa);
+}
 
 
-    TwoRDM<double> d_aaaa (K);
-    d_aaaa.setZero();
+/**
+ *  @param bra_indices      the indices of the orbitals that should be annihilated on the left (on the bra)
+ *  @param ket_indices      the indices of the orbitals that should be annihilated on the right (on the ket)
+ *  @param x                the coefficient vector representing the DOCI wave function
+ *
+ *  @return an element of the N-RDM, as specified by the given bra and ket indices
+ *
+ *      calculateElement({0, 1}, {2, 1}) would calculate d^{(2)} (0, 1, 1, 2): the operator string would be a^\dagger_0 a^\dagger_1 a_2 a_1
+ */
+double DOCIRDMBuilder::calculateElement(const std::vector<size_t>& bra_indices, const std::vector<size_t>& ket_indices, const VectorX<double>& x) const {
+    throw std::runtime_error("DOCIRDMBuilder::calculateElement(std::vector<size_t>, std::vector<size_t>, VectorX<double>): is not implemented for DOCIRDMs");
+}
+
 
-    TwoRDM<double> d_aabb (K);
-    d_aabb.setZero();
+/*
+ *  PUBLIC METHODS
+ */
 
+/**
+ *  @param x        the coefficient vector representing the DOCI wave function
+ *
+ *  @return the 2-RDM in the compact seniority-zero representation, i.e. only its number-number and pair blocks
+ */
+SeniorityZeroTwoRDM<double> DOCIRDMBuilder::calculateSeniorityZero2RDM(const VectorX<double>& x) const {
 
-    // Create the first ONV (with address 0). In DOCI, the Fock space for alpha and beta is equal so we just use one
-    ONV onv = this->fock_space.makeONV(0);   
+    // The formulas for the DOCI 2-RDMs can be found in (https://github.com/lelemmen/electronic_structure)
 
+    size_t K = this->fock_space.get_K();
+    size_t N_P = this->fock_space.get_N();
+    size_t dim = this->fock_space.get_dimension();
 
-    for (size_t I = 0; I < dim; I++) {  // I loops over all the addresses of the spin strings
-        for (size_t p = 0; p < K; p++) {  // p loops over SOs
-            if (onv.annihilate(p)) {  // if p is occupied in I
+    // Only the lower triangles are calculated: both blocks are symmetric
+    SquareMatrix<double> number_block = SquareMatrix<double>::Zero(K, K);
+    SquareMatrix<double> pair_block = SquareMatrix<double>::Zero(K, K);
+    std::mutex mutex;  // guards the addition of the contributions of every range of addresses
 
-                double c_I = x(I);  // coefficient of the I-th basis vector
-                double c_I_2 = std::pow(c_I, 2);  // square of c_I
+    parallelFor(0, dim, [this, &x, &number_block, &pair_block, &mutex, K, N_P] (size_t begin, size_t end) {
 
-                d_aabb(p,p,p,p) += c_I_2;
+        SquareMatrix<double> range_number_block = SquareMatrix<double>::Zero(K, K);
+        SquareMatrix<double> range_pair_block = SquareMatrix<double>::Zero(K, K);
 
-                for (size_t q = 0; q < p; q++) {  // q loops over SOs with an index smaller than p
-                    if (onv.create(q)) {  // if q is not occupied in I
-                        size_t J = this->fock_space.getAddress(onv);  // the address of the coupling string
-                        double c_J = x(J);  // coefficient of the J-th basis vector
+        // In DOCI, the Fock space for alpha and beta is equal so we just use one
+        ONV onv = this->fock_space.makeONV(begin);  // start at the first address of this range, without walking through the previous ones
 
-                        d_aabb(p,q,p,q) += c_I * c_J;
-                        d_aabb(q,p,q,p) += c_I * c_J;  // since we're looping for q < p
+        for (size_t I = begin; I < end; I++) {  // I loops over the addresses of this range
+            double c_I = x(I);  // coefficient of the I-th basis vector
+            double c_I_2 = c_I * c_I;
+
+            for (size_t e1 = 0; e1 < N_P; e1++) {  // e1 (electron 1) loops over the (number of) electron pairs
+                size_t p = onv.get_occupation_index(e1);
 
-                        onv.annihilate(q);  // reset the spin string after previous creation on q
-                    }
+                // Number-number block: p and q are both occupied in I
+                for (size_t e2 = 0; e2 <= e1; e2++) {
+                    size_t q = onv.get_occupation_index(e2);  // q <= p
+                    range_number_block(p,q) += c_I_2;
+                }
 
-                    else {  // if q is occupied in I
-                        d_aaaa(p,p,q,q) += c_I_2;
-                        d_aaaa(q,q,p,p) += c_I_2;  // since we're looping for q < p
+                // Pair block: excite the pair in p to an unoccupied q > p, which leads to the coupling ONV J
+                size_t address = I - this->fock_space.get_vertex_weights(p, e1 + 1);
+                size_t e2 = e1 + 1;
+                size_t q = p + 1;
+                this->fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2);
 
-                        d_aaaa(p,q,q,p) -= c_I_2;
-                        d_aaaa(q,p,p,q) -= c_I_2;  // since we're looping for q < p
+                while (q < K) {
+                    size_t J = address + this->fock_space.get_vertex_weights(q, e2);
+                    range_pair_block(q,p) += c_I * x(J);
 
-                        d_aabb(p,p,q,q) += c_I_2;
-                        d_aabb(q,q,p,p) += c_I_2;  // since we're looping for q < p
-                    }
+                    q++;  // go to the next orbital
+                    this->fock_space.shiftUntilNextUnoccupiedOrbital<1>(onv, address, q, e2);
                 }
-                onv.create(p);  // reset the spin string after previous annihilation on p
+            }  // e1 loop
+
+            // Prevent the permutation after the last address of this range
+            if (I < end - 1) {
+                this->fock_space.setNextONV(onv);
             }
-        }
+        }  // address (I) loop
 
-        if ( I < dim-1) {
-            this->fock_space.setNextONV(onv);
-        }
-    }
+        std::lock_guard<std::mutex> lock (mutex);
+        number_block += range_number_block;
+        pair_block += range_pair_block;
+    });
 
-    // For DOCI, we have additional symmetries (two_rdm_aaaa = two_rdm_bbbb, two_rdm_aabb = two_rdm_bbaa)
-    return TwoRDMs<double>(d_aaaa, d_aabb, d_aabb, d_aaaa);
-}
 
+    // Fill in the upper triangles, and the diagonal of the pair block (which equals the diagonal of the number-number block)
+    for (size_t p = 0; p < K; p++) {
+        pair_block(p,p) = number_block(p,p);
 
-/**
- *  @param bra_indices      the indices of the orbitals that should be annihilated on the left (on the bra)
- *  @param ket_indices      the indices of the orbitals that should be annihilated on the right (on the ket)
- *  @param x                the coefficient vector representing the DOCI wave function
- *
- *  @return an element of the N-RDM, as specified by the given bra and ket indices
- *
- *      calculateElement({0, 1}, {2, 1}) would calculate d^{(2)} (0, 1, 1, 2): the operator string would be a^\dagger_0 a^\dagger_1 a_2 a_1
- */
-double DOCIRDMBuilder::calculateElement(const std::vector<size_t>& bra_indices, const std::vector<size_t>& ket_indices, const VectorX<double>& x) const {
-    throw std::runtime_error("DOCIRDMBuilder::calculateElement(std::vector<size_t>, std::vector<size_t>, VectorX<double>): is not implemented for DOCIRDMs");
+        for (size_t q = 0; q < p; q++) {
+            number_block(q,p) = number_block(p,q);
+            pair_block(q,p) = pair_block(p,q);
+        }
+    }
+
+    return SeniorityZeroTwoRDM<double>(number_block, pair_block);
 }
 
 
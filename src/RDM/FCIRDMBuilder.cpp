@@ -17,6 +17,8 @@
 // 
 #include "RDM/FCIRDMBuilder.hpp"
 
+#include "FockSpace/SingleExcitationList.hpp"
+
 
 namespace GQCP {
 
@@ -46,18 +48,20 @@ OneRDMs<double> FCIRDMBuilder::calculate1RDMs(const VectorX<double>& x) const {
     OneRDM<double> D_aa = OneRDM<double>::Zero(K, K);
     OneRDM<double> D_bb = OneRDM<double>::Zero(K, K);
 
-    FockSpace fock_space_alpha = fock_space.get_fock_space_alpha();
-    FockSpace fock_space_beta = fock_space.get_fock_space_beta();
+    const FockSpace& fock_space_alpha = fock_space.get_fock_space_alpha();
+    const FockSpace& fock_space_beta = fock_space.get_fock_space_beta();
 
     auto dim_alpha = fock_space_alpha.get_dimension();
     auto dim_beta = fock_space_beta.get_dimension();
     
     // ALPHA
-    ONV spin_string_alpha = fock_space_alpha.makeONV(0);  // alpha spin string with address 0
+    const auto alpha_excitations = fock_space_alpha.get_single_excitations();
     for (size_t I_alpha = 0; I_alpha < dim_alpha; I_alpha++) {  // I_alpha loops over all the addresses of the alpha spin strings
-        for (size_t p = 0; p < K; p++) {  // p loops over SOs
-            int sign_p = 1;
-            if (spin_string_alpha.annihilate(p, sign_p)) {  // if p is in I_alpha
+        for (const SingleExcitation* excitation = alpha_excitations->begin(I_alpha); excitation != alpha_excitations->end(I_alpha); excitation++) {
+            size_t p = excitation->get_p();  // the created orbital
+            size_t q = excitation->get_q();  // the annihilated orbital
+
+            if (p == q) {
                 double diagonal_contribution =  0;
 
                 // Diagonal contributions for the 1-DM, i.e. D_pp
@@ -68,42 +72,30 @@ OneRDMs<double> FCIRDMBuilder::calculate1RDMs(const VectorX<double>& x) const {
                 }
                 D_aa(p,p) += diagonal_contribution;
 
-                // Off-diagonal contributions for the 1-DM, i.e. D_pq (p!=q)
-                for (size_t q = 0; q < p; q++) {  // q < p loops over SOs
-                    int sign_pq = sign_p;
-                    if (spin_string_alpha.create(q, sign_pq)) {  // if q is not occupied in I_alpha
-                        size_t J_alpha = fock_space_alpha.getAddress(spin_string_alpha);  // find all strings J_alpha that couple to I_alpha
-
-                        double off_diagonal_contribution = 0;
-                        for(size_t I_beta = 0; I_beta < dim_beta; I_beta++) {
-                            double c_I_alpha_I_beta = x(I_alpha*dim_beta + I_beta);  // alpha addresses are 'major'
-                            double c_J_alpha_I_beta = x(J_alpha*dim_beta + I_beta);
-                            off_diagonal_contribution += c_I_alpha_I_beta * c_J_alpha_I_beta;
-                        }
-                        D_aa(p,q) += sign_pq * off_diagonal_contribution;
-                        D_aa(q,p) += sign_pq * off_diagonal_contribution;  // add the symmetric contribution because we are looping over q < p
-
-                        spin_string_alpha.annihilate(q);  // undo the previous creation
-                    }  // create on q
-                }  // q loop
-
-                spin_string_alpha.create(p);  // undo the previous annihilation
-            }  // annihilate on p
-        }  // p loop
+            } else if (p < q) {  // off-diagonal contributions for the 1-DM, i.e. D_pq (p!=q), for the strings J_alpha that couple to I_alpha
+                size_t J_alpha = excitation->get_J();
 
-        if (I_alpha < dim_alpha - 1) {  // prevent the last permutation to occur
-            fock_space_alpha.setNextONV(spin_string_alpha);
-        }
-        
+                double off_diagonal_contribution = 0;
+                for(size_t I_beta = 0; I_beta < dim_beta; I_beta++) {
+                    double c_I_alpha_I_beta = x(I_alpha*dim_beta + I_beta);  // alpha addresses are 'major'
+                    double c_J_alpha_I_beta = x(J_alpha*dim_beta + I_beta);
+                    off_diagonal_contribution += c_I_alpha_I_beta * c_J_alpha_I_beta;
+                }
+                D_aa(p,q) += excitation->get_sign() * off_diagonal_contribution;
+                D_aa(q,p) += excitation->get_sign() * off_diagonal_contribution;  // add the symmetric contribution because we are looping over p < q
+            }
+        }  // single excitations
     }  // I_alpha loop
 
 
     // BETA
-    ONV spin_string_beta = fock_space_beta.makeONV(0);  // spin string with address 0
+    const auto beta_excitations = fock_space_beta.get_single_excitations();
     for (size_t I_beta = 0; I_beta < dim_beta; I_beta++) {  // I_beta loops over all the addresses of the spin strings
-        for (size_t p = 0; p < K; p++) {  // p loops over SOs
-            int sign_p = 1;
-            if (spin_string_beta.annihilate(p, sign_p)) {  // if p is in I_beta
+        for (const SingleExcitation* excitation = beta_excitations->begin(I_beta); excitation != beta_excitations->end(I_beta); excitation++) {
+            size_t p = excitation->get_p();  // the created orbital
+            size_t q = excitation->get_q();  // the annihilated orbital
+
+            if (p == q) {
                 double diagonal_contribution = 0;
 
                 // Diagonal contributions for the 1-DM, i.e. D_pp
@@ -112,36 +104,21 @@ OneRDMs<double> FCIRDMBuilder::calculate1RDMs(const VectorX<double>& x) const {
                     double c_I_alpha_I_beta = x(I_alpha*dim_beta + I_beta);
                     diagonal_contribution += std::pow(c_I_alpha_I_beta, 2);
                 }
-
                 D_bb(p,p) += diagonal_contribution;
 
-                // Off-diagonal contributions for the 1-DM
-                for (size_t q = 0; q < p; q++) {  // q < p loops over SOs
-                    int sign_pq = sign_p;
-                    if (spin_string_beta.create(q, sign_pq)) {  // if q is not in I_beta
-                        size_t J_beta = fock_space_beta.getAddress(spin_string_beta);  // find all strings J_beta that couple to I_beta
-
-                        double off_diagonal_contribution = 0;
-                        for (size_t I_alpha = 0; I_alpha<dim_alpha; I_alpha++) {
-                            double c_I_alpha_I_beta = x(I_alpha*dim_beta + I_beta);  // alpha addresses are 'major'
-                            double c_I_alpha_J_beta = x(I_alpha*dim_beta + J_beta);
-                            off_diagonal_contribution += c_I_alpha_I_beta * c_I_alpha_J_beta;
-                        }
-                        D_bb(p,q) += sign_pq * off_diagonal_contribution;
-                        D_bb(q,p) += sign_pq * off_diagonal_contribution;  // add the symmetric contribution because we are looping over q < p
-
-                        spin_string_beta.annihilate(q);  // undo the previous creation
-                    }  // create on q
-                }  // loop over q
-
-                spin_string_beta.create(p);  // undo the previous annihilation
-            }  // annihilate on p
-        }  // loop over p
-
-        if (I_beta < dim_beta - 1) {  // prevent the last permutation to occur
-            fock_space_beta.setNextONV(spin_string_beta);
-        }
+            } else if (p < q) {  // off-diagonal contributions for the 1-DM, for the strings J_beta that couple to I_beta
+                size_t J_beta = excitation->get_J();
 
+                double off_diagonal_contribution = 0;
+                for (size_t I_alpha = 0; I_alpha<dim_alpha; I_alpha++) {
+                    double c_I_alpha_I_beta = x(I_alpha*dim_beta + I_beta);  // alpha addresses are 'major'
+                    double c_I_alpha_J_beta = x(I_alpha*dim_beta + J_beta);
+                    off_diagonal_contribution += c_I_alpha_I_beta * c_I_alpha_J_beta;
+                }
+                D_bb(p,q) += excitation->get_sign() * off_diagonal_contribution;
+                D_bb(q,p) += excitation->get_sign() * off_diagonal_contribution;  // add the symmetric contribution because we are looping over p < q
+            }
+        }  // single excitations
     }  // I_beta loop
     return OneRDMs<double>(D_aa, D_bb);
 }
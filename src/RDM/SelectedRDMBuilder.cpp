@@ -50,9 +50,9 @@ OneRDMs<double> SelectedRDMBuilder::calculate1RDMs(const VectorX<double>& x) con
 
 
     for (size_t I = 0; I < dim; I++) {  // loop over all addresses (1)
-        Configuration configuration_I = this->fock_space.get_configuration(I);
-        ONV alpha_I = configuration_I.onv_alpha;
-        ONV beta_I = configuration_I.onv_beta;
+        const Configuration& configuration_I = this->fock_space.get_configuration(I);
+        const ONV& alpha_I = configuration_I.onv_alpha;
+        const ONV& beta_I = configuration_I.onv_beta;
         
         double c_I = x(I);
 
@@ -73,36 +73,42 @@ OneRDMs<double> SelectedRDMBuilder::calculate1RDMs(const VectorX<double>& x) con
         // Calculate the off-diagonal elements, by going over all other ONVs
         for (size_t J = I+1; J < dim; J++) {
 
-            Configuration configuration_J = this->fock_space.get_configuration(J);
-            ONV alpha_J = configuration_J.onv_alpha;
-            ONV beta_J = configuration_J.onv_beta;
+            const Configuration& configuration_J = this->fock_space.get_configuration(J);
+            const ONV& alpha_J = configuration_J.onv_alpha;
+            const ONV& beta_J = configuration_J.onv_beta;
 
             double c_J = x(J);
 
+            auto alpha_excitation = alpha_I.analyzeExcitation(alpha_J);
+            auto beta_excitation = beta_I.analyzeExcitation(beta_J);
+            if (alpha_excitation.degree + beta_excitation.degree > 2) {  // the ONVs don't contribute to the RDMs
+                continue;
+            }
+
 
             // 1 electron excitation in alpha (i.e. 2 differences), 0 in beta
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 2) && (beta_I.countNumberOfDifferences(beta_J) == 0)) {
+            if ((alpha_excitation.degree == 1) && (beta_excitation.degree == 0)) {
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                size_t p = alpha_I.findDifferentOccupations(alpha_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
-                size_t q = alpha_J.findDifferentOccupations(alpha_I)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = alpha_excitation.holes[0];
+                size_t q = alpha_excitation.particles[0];
 
                 // Calculate the total sign, and include it in the RDM contribution
-                int sign = alpha_I.operatorPhaseFactor(p) * alpha_J.operatorPhaseFactor(q);
+                int sign = alpha_excitation.sign;
                 D_aa(p,q) += sign * c_I * c_J;
                 D_aa(q,p) += sign * c_I * c_J;
             }
 
 
             // 1 electron excitation in beta, 0 in alpha
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 0) && (beta_I.countNumberOfDifferences(beta_J) == 2)) {
+            if ((alpha_excitation.degree == 0) && (beta_excitation.degree == 1)) {
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                size_t p = beta_I.findDifferentOccupations(beta_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
-                size_t q = beta_J.findDifferentOccupations(beta_I)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = beta_excitation.holes[0];
+                size_t q = beta_excitation.particles[0];
 
                 // Calculate the total sign, and include it in the RDM contribution
-                int sign = beta_I.operatorPhaseFactor(p) * beta_J.operatorPhaseFactor(q);
+                int sign = beta_excitation.sign;
                 D_bb(p,q) += sign * c_I * c_J;
                 D_bb(q,p) += sign * c_I * c_J;
             }
@@ -141,9 +147,9 @@ TwoRDMs<double> SelectedRDMBuilder::calculate2RDMs(const VectorX<double>& x) con
 
     for (size_t I = 0; I < dim; I++) {  // loop over all addresses I
 
-        Configuration configuration_I = this->fock_space.get_configuration(I);
-        ONV alpha_I = configuration_I.onv_alpha;
-        ONV beta_I = configuration_I.onv_beta;
+        const Configuration& configuration_I = this->fock_space.get_configuration(I);
+        const ONV& alpha_I = configuration_I.onv_alpha;
+        const ONV& beta_I = configuration_I.onv_beta;
 
         double c_I = x(I);
         
@@ -186,21 +192,27 @@ TwoRDMs<double> SelectedRDMBuilder::calculate2RDMs(const VectorX<double>& x) con
 
         for (size_t J = I+1; J < dim; J++) {
 
-            Configuration configuration_J = this->fock_space.get_configuration(J);
-            ONV alpha_J = configuration_J.onv_alpha;
-            ONV beta_J = configuration_J.onv_beta;
+            const Configuration& configuration_J = this->fock_space.get_configuration(J);
+            const ONV& alpha_J = configuration_J.onv_alpha;
+            const ONV& beta_J = configuration_J.onv_beta;
 
             double c_J = x(J);
 
+            auto alpha_excitation = alpha_I.analyzeExcitation(alpha_J);
+            auto beta_excitation = beta_I.analyzeExcitation(beta_J);
+            if (alpha_excitation.degree + beta_excitation.degree > 2) {  // the ONVs don't contribute to the RDMs
+                continue;
+            }
+
             // 1 electron excitation in alpha, 0 in beta
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 2) && (beta_I.countNumberOfDifferences(beta_J) == 0)) {
+            if ((alpha_excitation.degree == 1) && (beta_excitation.degree == 0)) {
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                size_t p = alpha_I.findDifferentOccupations(alpha_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
-                size_t q = alpha_J.findDifferentOccupations(alpha_I)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = alpha_excitation.holes[0];
+                size_t q = alpha_excitation.particles[0];
 
                 // Calculate the total sign
-                int sign = alpha_I.operatorPhaseFactor(p) * alpha_J.operatorPhaseFactor(q);
+                int sign = alpha_excitation.sign;
 
 
                 for (size_t r = 0; r < K; r++) {  // r loops over spatial orbitals
@@ -234,14 +246,14 @@ TwoRDMs<double> SelectedRDMBuilder::calculate2RDMs(const VectorX<double>& x) con
 
 
             // 0 electron excitations in alpha, 1 in beta
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 0) && (beta_I.countNumberOfDifferences(beta_J) == 2)) {
+            if ((alpha_excitation.degree == 0) && (beta_excitation.degree == 1)) {
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                size_t p = beta_I.findDifferentOccupations(beta_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
-                size_t q = beta_J.findDifferentOccupations(beta_I)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = beta_excitation.holes[0];
+                size_t q = beta_excitation.particles[0];
 
                 // Calculate the total sign
-                int sign = beta_I.operatorPhaseFactor(p) * beta_J.operatorPhaseFactor(q);
+                int sign = beta_excitation.sign;
 
 
                 for (size_t r = 0; r < K; r++) {  // r loops over spatial orbitals
@@ -275,17 +287,17 @@ TwoRDMs<double> SelectedRDMBuilder::calculate2RDMs(const VectorX<double>& x) con
 
 
             // 1 electron excitation in alpha, 1 in beta
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 2) && (beta_I.countNumberOfDifferences(beta_J) == 2)) {
+            if ((alpha_excitation.degree == 1) && (beta_excitation.degree == 1)) {
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                size_t p = alpha_I.findDifferentOccupations(alpha_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
-                size_t q = alpha_J.findDifferentOccupations(alpha_I)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = alpha_excitation.holes[0];
+                size_t q = alpha_excitation.particles[0];
 
-                size_t r = beta_I.findDifferentOccupations(beta_J)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
-                size_t s = beta_J.findDifferentOccupations(beta_I)[0];  // we're sure that there is only 1 element in the std::vector<size_t>
+                size_t r = beta_excitation.holes[0];
+                size_t s = beta_excitation.particles[0];
 
                 // Calculate the total sign, and include it in the 2-RDM contribution
-                int sign = alpha_I.operatorPhaseFactor(p) * alpha_J.operatorPhaseFactor(q) * beta_I.operatorPhaseFactor(r) * beta_J.operatorPhaseFactor(s);
+                int sign = alpha_excitation.sign * beta_excitation.sign;
                 d_aabb(p,q,r,s) += sign * c_I * c_J;
                 d_aabb(q,p,s,r) += sign * c_I * c_J;
 
@@ -295,20 +307,18 @@ TwoRDMs<double> SelectedRDMBuilder::calculate2RDMs(const VectorX<double>& x) con
 
 
             // 2 electron excitations in alpha, 0 in beta
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 4) && (beta_I.countNumberOfDifferences(beta_J) == 0)) {
+            if ((alpha_excitation.degree == 2) && (beta_excitation.degree == 0)) {
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                std::vector<size_t> occupied_indices_I = alpha_I.findDifferentOccupations(alpha_J);  // we're sure this has two elements
-                size_t p = occupied_indices_I[0];
-                size_t r = occupied_indices_I[1];
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = alpha_excitation.holes[0];
+                size_t r = alpha_excitation.holes[1];
 
-                std::vector<size_t> occupied_indices_J = alpha_J.findDifferentOccupations(alpha_I);  // we're sure this has two elements
-                size_t q = occupied_indices_J[0];
-                size_t s = occupied_indices_J[1];
+                size_t q = alpha_excitation.particles[0];
+                size_t s = alpha_excitation.particles[1];
 
 
                 // Calculate the total sign, and include it in the 2-RDM contribution
-                int sign = alpha_I.operatorPhaseFactor(p) * alpha_I.operatorPhaseFactor(r) * alpha_J.operatorPhaseFactor(q) * alpha_J.operatorPhaseFactor(s);
+                int sign = alpha_excitation.sign;
                 d_aaaa(p,q,r,s) += sign * c_I * c_J;
                 d_aaaa(p,s,r,q) -= sign * c_I * c_J;
                 d_aaaa(r,q,p,s) -= sign * c_I * c_J;
@@ -322,20 +332,18 @@ TwoRDMs<double> SelectedRDMBuilder::calculate2RDMs(const VectorX<double>& x) con
 
 
             // 0 electron excitations in alpha, 2 in beta
-            if ((alpha_I.countNumberOfDifferences(alpha_J) == 0) && (beta_I.countNumberOfDifferences(beta_J) == 4)) {
+            if ((alpha_excitation.degree == 0) && (beta_excitation.degree == 2)) {
 
-                // Find the orbitals that are occupied in one string, and aren't in the other
-                std::vector<size_t> occupied_indices_I = beta_I.findDifferentOccupations(beta_J);  // we're sure this has two elements
-                size_t p = occupied_indices_I[0];
-                size_t r = occupied_indices_I[1];
+                // The orbitals that are occupied in one string, and aren't in the other
+                size_t p = beta_excitation.holes[0];
+                size_t r = beta_excitation.holes[1];
 
-                std::vector<size_t> occupied_indices_J = beta_J.findDifferentOccupations(beta_I);  // we're sure this has two elements
-                size_t q = occupied_indices_J[0];
-                size_t s = occupied_indices_J[1];
+                size_t q = beta_excitation.particles[0];
+                size_t s = beta_excitation.particles[1];
 
 
                 // Calculate the total sign, and include it in the 2-RDM contribution
-                int sign = beta_I.operatorPhaseFactor(p) * beta_I.operatorPhaseFactor(r) * beta_J.operatorPhaseFactor(q) * beta_J.operatorPhaseFactor(s);
+                int sign = beta_excitation.sign;
                 d_bbbb(p,q,r,s) += sign * c_I * c_J;
                 d_bbbb(p,s,r,q) -= sign * c_I * c_J;
                 d_bbbb(r,q,p,s) -= sign * c_I * c_J;
@@ -17,6 +17,8 @@
 // 
 #include "RDM/SpinUnresolvedFCIRDMBuilder.hpp"
 
+#include "FockSpace/SingleExcitationList.hpp"
+
 
 namespace GQCP {
 
@@ -39,7 +41,21 @@ SpinUnresolvedFCIRDMBuilder::SpinUnresolvedFCIRDMBuilder(const FockSpace& fock_s
  *  @return the 1-RDM given a coefficient vector
  */
 OneRDM<double> SpinUnresolvedFCIRDMBuilder::calculate1RDM(const VectorX<double>& x) const {
-    throw std::runtime_error("SpinUnresolvedFCIRDMBuilder::calculate1RDMs(VectorX<double>): not implemented yet");
+
+    size_t K = this->fock_space.get_K();
+    size_t dim = this->fock_space.get_dimension();
+
+    OneRDM<double> D = OneRDM<double>::Zero(K, K);
+
+    // D(p,q) = <a^\dagger_p a_q>, in which a^\dagger_p a_q |I> = sign |J>
+    const auto single_excitations = this->fock_space.get_single_excitations();
+    for (size_t I = 0; I < dim; I++) {
+        for (const SingleExcitation* excitation = single_excitations->begin(I); excitation != single_excitations->end(I); excitation++) {
+            D(excitation->get_p(), excitation->get_q()) += excitation->get_sign() * x(excitation->get_J()) * x(I);
+        }
+    }
+
+    return D;
 }
 
 
@@ -49,7 +65,36 @@ OneRDM<double> SpinUnresolvedFCIRDMBuilder::calculate1RDM(const VectorX<double>&
      *  @return the 2-RDM given a coefficient vector
      */
 TwoRDM<double> SpinUnresolvedFCIRDMBuilder::calculate2RDM(const VectorX<double>& x) const {
-    throw std::runtime_error("SpinUnresolvedFCIRDMBuilder::calculate2RDMs(VectorX<double>): not implemented yet");
+
+    size_t K = this->fock_space.get_K();
+    size_t dim = this->fock_space.get_dimension();
+
+    TwoRDM<double> d (K);
+    d.setZero();
+
+    // d(p,q,r,s) = <a^\dagger_p a^\dagger_r a_s a_q> = <E_pq E_rs> - delta_qr <E_ps>, so we apply two single excitations after each other
+    const auto single_excitations = this->fock_space.get_single_excitations();
+    for (size_t I = 0; I < dim; I++) {
+        for (const SingleExcitation* excitation_rs = single_excitations->begin(I); excitation_rs != single_excitations->end(I); excitation_rs++) {
+            size_t L = excitation_rs->get_J();  // E_rs |I> = sign_rs |L>
+
+            for (const SingleExcitation* excitation_pq = single_excitations->begin(L); excitation_pq != single_excitations->end(L); excitation_pq++) {
+                double value = excitation_rs->get_sign() * excitation_pq->get_sign() * x(excitation_pq->get_J()) * x(I);
+                d(excitation_pq->get_p(), excitation_pq->get_q(), excitation_rs->get_p(), excitation_rs->get_q()) += value;
+            }
+        }
+    }
+
+    OneRDM<double> D = this->calculate1RDM(x);
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t s = 0; s < K; s++) {
+                d(p,q,q,s) -= D(p,s);
+            }
+        }
+    }
+
+    return d;
 }
 
 
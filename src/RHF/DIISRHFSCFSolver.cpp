@@ -34,7 +34,7 @@ namespace GQCP {
  */
 OneElectronOperator<double> DIISRHFSCFSolver::calculateNewFockMatrix(const OneRDM<double>& D_AO) {
 
-    auto S = this->ham_par.get_S();
+    const auto& S = this->S;
 
     // Calculate the Fock matrix based off the density matrix
     auto f_AO = calculateRHFAOFockMatrix(D_AO, this->ham_par);
@@ -105,6 +105,7 @@ OneElectronOperator<double> DIISRHFSCFSolver::calculateNewFockMatrix(const OneRD
  */
 DIISRHFSCFSolver::DIISRHFSCFSolver(HamiltonianParameters<double> ham_par, Molecule molecule, size_t minimum_subspace_dimension, size_t maximum_subspace_dimension, double threshold, size_t maximum_number_of_iterations) :
     RHFSCFSolver(ham_par, molecule, threshold, maximum_number_of_iterations),
+    ham_par (ham_par),
     minimum_subspace_dimension (minimum_subspace_dimension),
     maximum_subspace_dimension (maximum_subspace_dimension)
 {}
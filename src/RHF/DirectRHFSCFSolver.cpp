@@ -0,0 +1,94 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "RHF/DirectRHFSCFSolver.hpp"
+
+#include "LibintCommunicator.hpp"
+
+
+namespace GQCP {
+
+/*
+ *  PRIVATE METHODS
+ */
+/**
+ *  Update the Fock matrix, i.e. calculate the Fock matrix to be used in the next iteration of the SCF procedure: the 'new' Fock matrix is just F = H_core + G, in which G is updated with the contribution of the change in the density matrix
+ *
+ *  @param D_AO     the RHF density matrix in AO basis
+ *
+ *  @return the new Fock matrix (expressed in AO basis)
+ */
+OneElectronOperator<double> DirectRHFSCFSolver::calculateNewFockMatrix(const OneRDM<double>& D_AO) {
+
+    const auto& libint_communicator = LibintCommunicator::get();
+
+    // G is linear in the density matrix, so G(D) = G(D_previous) + G(D - D_previous)
+    if ((this->number_of_fock_builds % this->full_rebuild_interval) == 0) {
+        this->G = libint_communicator.calculateRHFTwoElectronFockMatrix(*this->ao_basis, D_AO, this->schwarz_bounds, this->screening_threshold);
+    } else {
+        OneRDM<double> delta_D_AO = D_AO - this->D_AO_previous;
+        this->G += libint_communicator.calculateRHFTwoElectronFockMatrix(*this->ao_basis, delta_D_AO, this->schwarz_bounds, this->screening_threshold);
+    }
+
+    this->number_of_fock_builds++;
+    this->D_AO_previous = D_AO;
+
+    return this->H_core + this->G;
+}
+
+
+
+/*
+ * CONSTRUCTORS
+ */
+/**
+ *  @param ao_basis                         the AO basis in which the SCF equations are solved
+ *  @param molecule                         the molecule used for the SCF calculation
+ *  @param screening_threshold              the shell quartets whose density-weighted Cauchy-Schwarz bound is smaller than this threshold are skipped
+ *  @param full_rebuild_interval            the number of Fock builds after which the two-electron part is rebuilt from the full density matrix
+ *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+ *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+ */
+DirectRHFSCFSolver::DirectRHFSCFSolver(std::shared_ptr<AOBasis> ao_basis, const Molecule& molecule, double screening_threshold, size_t full_rebuild_interval, double threshold, size_t maximum_number_of_iterations) :
+    RHFSCFSolver(LibintCommunicator::get().calculateOverlapIntegrals(*ao_basis),
+                 OneElectronOperator<double>(LibintCommunicator::get().calculateKineticIntegrals(*ao_basis) + LibintCommunicator::get().calculateNuclearIntegrals(*ao_basis)),
+                 molecule, threshold, maximum_number_of_iterations),
+    ao_basis (std::move(ao_basis)),
+    schwarz_bounds (LibintCommunicator::get().calculateCoulombRepulsionSchwarzBounds(*this->ao_basis)),
+    screening_threshold (screening_threshold),
+    full_rebuild_interval (full_rebuild_interval)
+{
+    if (full_rebuild_interval == 0) {
+        throw std::invalid_argument("DirectRHFSCFSolver::DirectRHFSCFSolver(std::shared_ptr<AOBasis>, Molecule, double, size_t, double, size_t): The interval for full rebuilds of the Fock matrix should be at least 1.");
+    }
+}
+
+
+/**
+ *  @param molecule                         the molecule used for the SCF calculation
+ *  @param basisset                         the name of the basisset corresponding to the AO basis
+ *  @param screening_threshold              the shell quartets whose density-weighted Cauchy-Schwarz bound is smaller than this threshold are skipped
+ *  @param full_rebuild_interval            the number of Fock builds after which the two-electron part is rebuilt from the full density matrix
+ *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+ *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+ */
+DirectRHFSCFSolver::DirectRHFSCFSolver(const Molecule& molecule, const std::string& basisset, double screening_threshold, size_t full_rebuild_interval, double threshold, size_t maximum_number_of_iterations) :
+    DirectRHFSCFSolver(std::make_shared<AOBasis>(molecule, basisset), molecule, screening_threshold, full_rebuild_interval, threshold, maximum_number_of_iterations)
+{}
+
+
+}  // namespace GQCP
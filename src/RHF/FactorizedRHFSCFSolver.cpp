@@ -0,0 +1,111 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "RHF/FactorizedRHFSCFSolver.hpp"
+
+#include "LibintCommunicator.hpp"
+
+
+namespace GQCP {
+
+/*
+ *  PRIVATE METHODS
+ */
+/**
+ *  Update the Fock matrix, i.e. calculate the Fock matrix to be used in the next iteration of the SCF procedure: the 'new' Fock matrix is just F = H_core + G, in which G is built from the factorized two-electron integrals
+ *
+ *  @param D_AO     the RHF density matrix in AO basis
+ *
+ *  @return the new Fock matrix (expressed in AO basis)
+ */
+OneElectronOperator<double> FactorizedRHFSCFSolver::calculateNewFockMatrix(const OneRDM<double>& D_AO) {
+    return this->H_core + calculateRHFAOTwoElectronFockMatrix(D_AO, this->g_AO);
+}
+
+
+
+/*
+ * CONSTRUCTORS
+ */
+/**
+ *  @param S                                the overlap matrix in AO basis
+ *  @param H_core                           the core Hamiltonian in AO basis
+ *  @param g_AO                             the factorized two-electron integrals in AO basis
+ *  @param molecule                         the molecule used for the SCF calculation
+ *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+ *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+ */
+FactorizedRHFSCFSolver::FactorizedRHFSCFSolver(const OneElectronOperator<double>& S, const OneElectronOperator<double>& H_core, const FactorizedTwoElectronOperator<double>& g_AO, const Molecule& molecule, double threshold, size_t maximum_number_of_iterations) :
+    RHFSCFSolver(S, H_core, molecule, threshold, maximum_number_of_iterations),
+    g_AO (g_AO)
+{
+    if (g_AO.get_dim() != S.get_dim()) {
+        throw std::invalid_argument("FactorizedRHFSCFSolver::FactorizedRHFSCFSolver(OneElectronOperator<double>, OneElectronOperator<double>, FactorizedTwoElectronOperator<double>, Molecule, double, size_t): The dimensions of the one- and two-electron integrals are incompatible.");
+    }
+}
+
+
+
+/*
+ *  NAMED CONSTRUCTORS
+ */
+/**
+ *  @param molecule                         the molecule used for the SCF calculation
+ *  @param basisset                         the name of the basisset corresponding to the AO basis
+ *  @param auxiliary_basisset               the name of the basisset corresponding to the auxiliary basis used for density fitting
+ *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+ *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+ *
+ *  @return an RHF SCF solver that uses the density-fitted two-electron integrals
+ */
+FactorizedRHFSCFSolver FactorizedRHFSCFSolver::DensityFitted(const Molecule& molecule, const std::string& basisset, const std::string& auxiliary_basisset, double threshold, size_t maximum_number_of_iterations) {
+
+    const auto& libint_communicator = LibintCommunicator::get();
+    AOBasis ao_basis (molecule, basisset);
+    AOBasis auxiliary_basis (molecule, auxiliary_basisset);
+
+    auto S = libint_communicator.calculateOverlapIntegrals(ao_basis);
+    OneElectronOperator<double> H_core = libint_communicator.calculateKineticIntegrals(ao_basis) + libint_communicator.calculateNuclearIntegrals(ao_basis);
+    auto g_AO = libint_communicator.calculateDensityFittedCoulombRepulsionIntegrals(ao_basis, auxiliary_basis);
+
+    return FactorizedRHFSCFSolver(S, H_core, g_AO, molecule, threshold, maximum_number_of_iterations);
+}
+
+
+/**
+ *  @param molecule                         the molecule used for the SCF calculation
+ *  @param basisset                         the name of the basisset corresponding to the AO basis
+ *  @param cholesky_threshold               the threshold for the pivoted incomplete Cholesky decomposition of the two-electron integrals
+ *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+ *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+ *
+ *  @return an RHF SCF solver that uses the Cholesky-decomposed two-electron integrals
+ */
+FactorizedRHFSCFSolver FactorizedRHFSCFSolver::Cholesky(const Molecule& molecule, const std::string& basisset, double cholesky_threshold, double threshold, size_t maximum_number_of_iterations) {
+
+    const auto& libint_communicator = LibintCommunicator::get();
+    AOBasis ao_basis (molecule, basisset);
+
+    auto S = libint_communicator.calculateOverlapIntegrals(ao_basis);
+    OneElectronOperator<double> H_core = libint_communicator.calculateKineticIntegrals(ao_basis) + libint_communicator.calculateNuclearIntegrals(ao_basis);
+    auto g_AO = libint_communicator.calculateCholeskyDecomposedCoulombRepulsionIntegrals(ao_basis, cholesky_threshold);
+
+    return FactorizedRHFSCFSolver(S, H_core, g_AO, molecule, threshold, maximum_number_of_iterations);
+}
+
+
+}  // namespace GQCP
@@ -46,7 +46,8 @@ OneElectronOperator<double> PlainRHFSCFSolver::calculateNewFockMatrix(const OneR
  *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
  */
 PlainRHFSCFSolver::PlainRHFSCFSolver(const HamiltonianParameters<double>& ham_par, const Molecule& molecule, double threshold, size_t maximum_number_of_iterations) :
-    RHFSCFSolver(ham_par, molecule, threshold, maximum_number_of_iterations)
+    RHFSCFSolver(ham_par, molecule, threshold, maximum_number_of_iterations),
+    ham_par (ham_par)
 {}
 
 
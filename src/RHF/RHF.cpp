@@ -17,6 +17,8 @@
 // 
 #include "RHF/RHF.hpp"
 
+#include "utilities/parallel.hpp"
+
 
 namespace GQCP {
 
@@ -94,36 +96,124 @@ OneRDM<double> calculateRHFAO1RDM(const SquareMatrix<double>& C, size_t N) {
 
 
 /**
- *  Calculate the RHF Fock matrix F = H_core + G, in which G is a contraction of the density matrix and the two-electron integrals
+ *  Calculate the two-electron part G = J - 1/2 K of the RHF Fock matrix, in which
+ *      J(mu nu) = (mu nu|rho lambda) D(lambda rho)
+ *      K(mu lambda) = (mu nu|rho lambda) D(nu rho)
  *
- *  @param D_AO     the RHF density matrix in AO basis
- *  @param ham_par  The Hamiltonian parameters in AO basis
+ *  @param D_AO                 the RHF density matrix in AO basis
+ *  @param g_AO                 the two-electron integrals in AO basis
+ *  @param number_of_threads    the number of threads that should be used
  *
- *  @return the RHF Fock matrix expressed in the AO basis
+ *  @return the two-electron part of the RHF Fock matrix expressed in the AO basis
+ *
+ *  The integrals are read in-place and only once: every contiguous (K x K)-block (mu nu|rho lambda) for fixed rho and lambda contributes to both J and K through matrix(-vector) products, while every thread handles a range of lambda
  */
-OneElectronOperator<double> calculateRHFAOFockMatrix(const OneRDM<double>& D_AO, const HamiltonianParameters<double>& ham_par) {
+SquareMatrix<double> calculateRHFAOTwoElectronFockMatrix(const OneRDM<double>& D_AO, const TwoElectronOperator<double>& g_AO, size_t number_of_threads) {
 
-    // To perform the contraction, we will first have to convert the MatrixX<double> D_AO to an Eigen::Tensor<const double, 2> D_AO_tensor, as contractions are only implemented for Eigen::Tensors
-    Eigen::TensorMap<Eigen::Tensor<const double, 2>> D_AO_tensor (D_AO.data(), D_AO.rows(), D_AO.cols());
+    const size_t K = g_AO.get_dim();
+    if (D_AO.get_dim() != K) {
+        throw std::invalid_argument("calculateRHFAOTwoElectronFockMatrix(OneRDM<double>, TwoElectronOperator<double>, size_t): The dimensions of the density matrix and the two-electron integrals are incompatible.");
+    }
+
+    number_of_threads = std::max<size_t>(std::min(number_of_threads, K), 1);
+    const double* g_data = g_AO.data();  // (mu nu|rho lambda) is stored at mu + K (nu + K (rho + K lambda))
+
+    // Every thread accumulates J into its own matrix, while the columns of K that a thread calculates are its own
+    std::vector<SquareMatrix<double>> J_partial (number_of_threads, SquareMatrix<double>::Zero(K, K));
+    SquareMatrix<double> K_AO = SquareMatrix<double>::Zero(K, K);
+
+    parallelFor(0, number_of_threads, [K, number_of_threads, g_data, &D_AO, &J_partial, &K_AO] (size_t t_begin, size_t t_end) {
+        for (size_t t = t_begin; t < t_end; t++) {
+            SquareMatrix<double>& J = J_partial[t];
 
-    // Specify the contraction pairs
-    // To calculate G, we must perform two double contractions
-    //      1. (mu nu|rho lambda) P(lambda rho)
-    Eigen::array<Eigen::IndexPair<int>, 2> direct_contraction_pair = {Eigen::IndexPair<int>(3, 0), Eigen::IndexPair<int>(2, 1)};
-    //      2. -0.5 (mu lambda|rho nu) P(lambda rho)
-    Eigen::array<Eigen::IndexPair<int>, 2> exchange_contraction_pair = {Eigen::IndexPair<int>(1, 0), Eigen::IndexPair<int>(2, 1)};
+            for (size_t lambda = t * K / number_of_threads; lambda < (t + 1) * K / number_of_threads; lambda++) {
+                for (size_t rho = 0; rho < K; rho++) {
+                    Eigen::Map<const Eigen::MatrixXd> g_block (g_data + K * K * (rho + K * lambda), K, K);  // (mu nu|rho lambda) for fixed rho and lambda
 
-    // Calculate both contractions (and incorporate prefactors)
-    auto g = ham_par.get_g();
-    Tensor<double, 2> direct_contraction = g.contract(D_AO_tensor, direct_contraction_pair);
-    Tensor<double, 2> exchange_contraction = -0.5 * g.contract(D_AO_tensor, exchange_contraction_pair);
+                    J += D_AO(lambda, rho) * g_block;
+                    K_AO.col(lambda).noalias() += g_block * D_AO.col(rho);
+                }
+            }
+        }
+    }, number_of_threads);
 
-    // The previous contractions are Eigen::Tensor<double 2> instances. In order to calculate the total G matrix, we will convert them back into MatrixX<double>
-    Eigen::Map<Eigen::MatrixXd> G1 (direct_contraction.data(), direct_contraction.dimension(0), direct_contraction.dimension(1));
-    Eigen::Map<Eigen::MatrixXd> G2 (exchange_contraction.data(), exchange_contraction.dimension(0), exchange_contraction.dimension(1));
 
+    SquareMatrix<double> G = -0.5 * K_AO;
+    for (const auto& J : J_partial) {
+        G += J;
+    }
+
+    return G;
+}
+
+
+/**
+ *  Calculate the two-electron part G = J - 1/2 K of the RHF Fock matrix from a factorization of the two-electron integrals (mu nu|rho lambda) = sum_m L_m(mu nu) L_m(rho lambda), i.e.
+ *      J = sum_m L_m tr(L_m D)
+ *      K = sum_m L_m D L_m
+ *
+ *  @param D_AO                 the RHF density matrix in AO basis
+ *  @param g_AO                 the factorized (e.g. density-fitted) two-electron integrals in AO basis
+ *  @param number_of_threads    the number of threads that should be used
+ *
+ *  @return the two-electron part of the RHF Fock matrix expressed in the AO basis
+ */
+SquareMatrix<double> calculateRHFAOTwoElectronFockMatrix(const OneRDM<double>& D_AO, const FactorizedTwoElectronOperator<double>& g_AO, size_t number_of_threads) {
+
+    const size_t K = g_AO.get_dim();
+    if (D_AO.get_dim() != K) {
+        throw std::invalid_argument("calculateRHFAOTwoElectronFockMatrix(OneRDM<double>, FactorizedTwoElectronOperator<double>, size_t): The dimensions of the density matrix and the two-electron integrals are incompatible.");
+    }
+
+    const size_t M = g_AO.get_rank();
+    const auto& L = g_AO.get_vectors();  // the columns are the vectorized L_m
+
+
+    // The Coulomb matrix is found through two matrix-vector products: gamma_m = tr(L_m D) = vec(D^T)^T vec(L_m) and vec(J) = L gamma
+    const SquareMatrix<double> D_transpose = D_AO.transpose();
+    const VectorX<double> gamma = L.transpose() * Eigen::Map<const Eigen::VectorXd>(D_transpose.data(), K * K);
+    SquareMatrix<double> G (K);
+    Eigen::Map<Eigen::VectorXd>(G.data(), K * K).noalias() = L * gamma;
+
+
+    // Every thread accumulates the exchange contributions of its own vectors L_m into its own matrix
+    number_of_threads = std::max<size_t>(std::min(number_of_threads, M), 1);
+    std::vector<SquareMatrix<double>> K_partial (number_of_threads, SquareMatrix<double>::Zero(K, K));
+
+    parallelFor(0, number_of_threads, [K, M, number_of_threads, &L, &D_AO, &K_partial] (size_t t_begin, size_t t_end) {
+        SquareMatrix<double> DL_m (K);
+        for (size_t t = t_begin; t < t_end; t++) {
+            SquareMatrix<double>& K_AO = K_partial[t];
+
+            for (size_t m = t * M / number_of_threads; m < (t + 1) * M / number_of_threads; m++) {
+                Eigen::Map<const Eigen::MatrixXd> L_m (L.col(m).data(), K, K);
+
+                DL_m.noalias() = D_AO * L_m;
+                K_AO.noalias() += L_m * DL_m;
+            }
+        }
+    }, number_of_threads);
+
+
+    for (const auto& K_AO : K_partial) {
+        G -= 0.5 * K_AO;
+    }
+
+    return G;
+}
+
+
+/**
+ *  Calculate the RHF Fock matrix F = H_core + G, in which G is a contraction of the density matrix and the two-electron integrals
+ *
+ *  @param D_AO     the RHF density matrix in AO basis
+ *  @param ham_par  The Hamiltonian parameters in AO basis
+ *
+ *  @return the RHF Fock matrix expressed in the AO basis
+ */
+OneElectronOperator<double> calculateRHFAOFockMatrix(const OneRDM<double>& D_AO, const HamiltonianParameters<double>& ham_par) {
 
-    return ham_par.get_h() + G1 + G2;
+    return ham_par.get_h() + calculateRHFAOTwoElectronFockMatrix(D_AO, ham_par.get_g());
 }
 
 
@@ -31,10 +31,23 @@ namespace GQCP {
  *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
  */
 RHFSCFSolver::RHFSCFSolver(const HamiltonianParameters<double>& ham_par, const Molecule& molecule, double threshold, size_t maximum_number_of_iterations) :
-    ham_par (ham_par),
-    molecule (molecule),
+    RHFSCFSolver(ham_par.get_S(), ham_par.get_h(), molecule, threshold, maximum_number_of_iterations)
+{}
+
+
+/**
+ *  @param S                                the overlap matrix in AO basis
+ *  @param H_core                           the core Hamiltonian in AO basis
+ *  @param molecule                         the molecule used for the SCF calculation
+ *  @param threshold                        the convergence treshold on the Frobenius norm on the AO density matrix
+ *  @param maximum_number_of_iterations     the maximum number of iterations for the SCF procedure
+ */
+RHFSCFSolver::RHFSCFSolver(const OneElectronOperator<double>& S, const OneElectronOperator<double>& H_core, const Molecule& molecule, double threshold, size_t maximum_number_of_iterations) :
     maximum_number_of_iterations (maximum_number_of_iterations),
-    threshold (threshold)
+    threshold (threshold),
+    S (S),
+    H_core (H_core),
+    molecule (molecule)
 {
     // Check if the given molecule has an even number of electrons
     if ((molecule.get_N() % 2) != 0) {
@@ -52,8 +65,8 @@ RHFSCFSolver::RHFSCFSolver(const HamiltonianParameters<double>& ham_par, const M
  */
 void RHFSCFSolver::solve() {
 
-    auto H_core = this->ham_par.get_h();
-    auto S = this->ham_par.get_S();
+    const auto& H_core = this->H_core;
+    const auto& S = this->S;
 
 
     // Obtain an initial guess for the AO density matrix by solving the generalized eigenvalue problem for H_core
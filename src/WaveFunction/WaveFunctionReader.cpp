@@ -132,7 +132,9 @@ WaveFunctionReader::WaveFunctionReader(const std::string& GAMESS_filename)
 
         // Create a double for the third field
         this->coefficients(index_count) = std::stod(splitted_line[2]);
-        this->fock_space.addConfiguration(reversed_alpha, reversed_beta);
+        if (this->fock_space.addConfiguration(reversed_alpha, reversed_beta) != index_count) {  // a configuration that is already present isn't added again
+            throw std::invalid_argument("WaveFunctionReader(std::string): The provided file contains the same configuration more than once.");
+        }
 
     }  // while getline
 
@@ -29,8 +29,11 @@ namespace GQCP {
  */
 double calculateAP1roGEnergy(const AP1roGGeminalCoefficients& G, const HamiltonianParameters<double>& ham_par) {
 
-    auto h = ham_par.get_h();
-    auto g = ham_par.get_g();
+    const auto& h = ham_par.get_h();
+    auto pair_integrals = ham_par.get_pair_integrals();
+    const auto& coulomb = pair_integrals->get_coulomb();
+    const auto& exchange = pair_integrals->get_exchange();
+    const auto& pair_hopping = pair_integrals->get_pair_hopping();
 
 
     // KISS implementation of the AP1roG energy
@@ -39,11 +42,11 @@ double calculateAP1roGEnergy(const AP1roGGeminalCoefficients& G, const Hamiltoni
         E += 2 * h(j,j);
 
         for (size_t k = 0; k < G.get_N_P(); k++) {
-            E += 2 * g(k,k,j,j) - g(k,j,j,k);
+            E += 2 * coulomb(k,j) - exchange(k,j);
         }
 
         for (size_t b = G.get_N_P(); b < G.get_K(); b++) {
-            E += g(j,b,j,b) * G(j,b);
+            E += pair_hopping(j,b) * G(j,b);
         }
     }
 
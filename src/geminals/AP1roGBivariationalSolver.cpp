@@ -83,7 +83,8 @@ AP1roGBivariationalSolver::AP1roGBivariationalSolver(const Molecule& molecule, c
  */
 void AP1roGBivariationalSolver::solve() {
 
-    auto g = this->ham_par.get_g();
+    auto pair_integrals = this->ham_par.get_pair_integrals();
+    const auto& pair_hopping = pair_integrals->get_pair_hopping();
 
 
     // Solve the PSEs and set part of the solutions
@@ -136,14 +137,14 @@ void AP1roGBivariationalSolver::solve() {
             size_t row_vector_index = this->geminal_coefficients.vectorIndex(i, a);
 
             // First column
-            A(1 + row_vector_index, 0) = g(i,a,i,a);
+            A(1 + row_vector_index, 0) = pair_hopping(i,a);
 
             // Large lower right block
             for (size_t j = 0; j < this->N_P; j++) {
                 for (size_t b = this->N_P; b < this->K; b++) {
                     size_t column_vector_index = this->geminal_coefficients.vectorIndex(j, b);
 
-                    A(1 + row_vector_index, 1 + column_vector_index) = J(column_vector_index, row_vector_index) + g(i,a,i,a) * this->geminal_coefficients(j, b);  // transpose of the Jacobian
+                    A(1 + row_vector_index, 1 + column_vector_index) = J(column_vector_index, row_vector_index) + pair_hopping(i,a) * this->geminal_coefficients(j, b);  // transpose of the Jacobian
                 }
             }  // j and b
 
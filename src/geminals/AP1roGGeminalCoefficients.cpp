@@ -73,8 +73,9 @@ AP1roGGeminalCoefficients AP1roGGeminalCoefficients::WeakInteractionLimit(const
 
     auto K = ham_par.get_K();
     auto number_of_geminal_coefficients = AP1roGGeminalCoefficients::numberOfGeminalCoefficients(N_P, K);
-    auto h = ham_par.get_h();  // core Hamiltonian integrals
-    auto g = ham_par.get_g();  // two-electron integrals
+    const auto& h = ham_par.get_h();  // core Hamiltonian integrals
+    auto pair_integrals = ham_par.get_pair_integrals();
+    const auto& pair_hopping = pair_integrals->get_pair_hopping();
 
     // Provide the weak interaction limit values for the geminal coefficients
     VectorX<double> g_vector = VectorX<double>::Zero(number_of_geminal_coefficients);
@@ -82,7 +83,7 @@ AP1roGGeminalCoefficients AP1roGGeminalCoefficients::WeakInteractionLimit(const
         size_t i = GQCP::matrixIndexMajor(mu, K, N_P);
         size_t a = GQCP::matrixIndexMinor(mu, K, N_P);
 
-        g_vector(mu) = - g(a,i,a,i) / (2 * (h(a,a) - h(i,i)));
+        g_vector(mu) = - pair_hopping(a,i) / (2 * (h(a,a) - h(i,i)));
     }
 
 
@@ -153,27 +154,26 @@ double AP1roGGeminalCoefficients::overlap(const ONV& onv) const {
     FockSpace fock_space (this->K, this->N_P);  // the DOCI Fock space
     ONV reference = fock_space.makeONV(0);
 
-    if (onv.countNumberOfDifferences(reference) == 0) {  // no excitations
+    auto excitation = reference.analyzeExcitation(onv);
+
+    if (excitation.degree == 0) {  // no excitations
         return 1.0;
     }
 
-    else if (onv.countNumberOfDifferences(reference) == 2) {  // one pair excitation
+    else if (excitation.degree == 1) {  // one pair excitation
 
-        size_t i = reference.findDifferentOccupations(onv)[0];
-        size_t a = onv.findDifferentOccupations(reference)[0];
+        size_t i = excitation.holes[0];
+        size_t a = excitation.particles[0];
 
         return this->operator()(i, a);
     }
 
-    else if (onv.countNumberOfDifferences(reference) == 4) {  // two pair excitations
-
-        auto different_occupied = reference.findDifferentOccupations(onv);
-        auto different_virtual = onv.findDifferentOccupations(reference);
+    else if (excitation.degree == 2) {  // two pair excitations
 
-        size_t i = different_occupied[0];
-        size_t j = different_occupied[1];
-        size_t a = different_virtual[0];
-        size_t b = different_virtual[1];
+        size_t i = excitation.holes[0];
+        size_t j = excitation.holes[1];
+        size_t a = excitation.particles[0];
+        size_t b = excitation.particles[1];
 
         return this->operator()(i, a) * this->operator()(j, b) + this->operator()(j, a) * this->operator()(i, b);
     }
@@ -80,8 +80,11 @@ AP1roGJacobiOrbitalOptimizer::AP1roGJacobiOrbitalOptimizer(const Molecule& molec
  */
 void AP1roGJacobiOrbitalOptimizer::calculateJacobiCoefficients(size_t p, size_t q, const AP1roGGeminalCoefficients& G) {
 
-    auto h = this->ham_par.get_h();
-    auto g = this->ham_par.get_g();
+    const auto& h = this->ham_par.get_h();
+    const auto& g = this->ham_par.get_g();  // for the integrals that are not of pair type
+    auto pair_integrals = this->ham_par.get_pair_integrals();
+    const auto& coulomb = pair_integrals->get_coulomb();
+    const auto& pair_hopping = pair_integrals->get_pair_hopping();
 
 
     // Implementation of the Jacobi rotation coefficients with disjoint cases for p and q
@@ -95,8 +98,8 @@ void AP1roGJacobiOrbitalOptimizer::calculateJacobiCoefficients(size_t p, size_t
 
 
         for (size_t b = this->N_P; b < this->K; b++) {
-            this->A1 -= 0.5 * (g(b,p,b,p) - g(b,q,b,q)) * (G(p,b) - G(q,b));
-            this->B1 += 0.5 * (g(b,p,b,p) - g(b,q,b,q)) * (G(p,b) - G(q,b));
+            this->A1 -= 0.5 * (pair_hopping(b,p) - pair_hopping(b,q)) * (G(p,b) - G(q,b));
+            this->B1 += 0.5 * (pair_hopping(b,p) - pair_hopping(b,q)) * (G(p,b) - G(q,b));
             this->C1 += g(b,p,b,q) * (G(q,b) - G(p,b));
         }
     }
@@ -112,21 +115,21 @@ void AP1roGJacobiOrbitalOptimizer::calculateJacobiCoefficients(size_t p, size_t
         this->E2 = 0.0;
 
 
-        this->A2 += h(p,p) - h(q,q) + 0.375 * (g(p,p,p,p) + g(q,q,q,q)) * (1 - G(q,p)) - 0.25 * g(p,p,q,q) * (7 + G(q,p)) + 0.5 * g(p,q,p,q) * (3 + G(q,p));
-        this->B2 += h(q,q) - h(p,p) + 2 * g(p,p,q,q) + 0.5 * (g(p,p,p,p) + g(q,q,q,q)) * (G(q,p) - 1) - g(p,q,p,q) * (1 + G(q,p));
+        this->A2 += h(p,p) - h(q,q) + 0.375 * (coulomb(p,p) + coulomb(q,q)) * (1 - G(q,p)) - 0.25 * coulomb(p,q) * (7 + G(q,p)) + 0.5 * pair_hopping(p,q) * (3 + G(q,p));
+        this->B2 += h(q,q) - h(p,p) + 2 * coulomb(p,q) + 0.5 * (coulomb(p,p) + coulomb(q,q)) * (G(q,p) - 1) - pair_hopping(p,q) * (1 + G(q,p));
         this->C2 += 2 * h(p,q) + (g(p,p,p,q) - g(p,q,q,q)) * (1 - G(q,p));
-        this->D2 += 0.125 * (g(p,p,p,p) + g(q,q,q,q) - 2 * (g(p,p,q,q) + 2 * g(p,q,p,q))) * (1 - G(q,p));
+        this->D2 += 0.125 * (coulomb(p,p) + coulomb(q,q) - 2 * (coulomb(p,q) + 2 * pair_hopping(p,q))) * (1 - G(q,p));
         this->E2 += 0.5 * (g(p,p,p,q) - g(p,q,q,q)) * (G(q,p) - 1);
 
         for (size_t j = 0; j < this->N_P; j++) {
-            this->A2 += 2 * (g(j,j,p,p) - g(j,j,q,q)) - 0.5 * (g(j,p,j,p) - g(j,q,j,q)) * (2 + G(j,p));
-            this->B2 += 2 * (g(j,j,q,q) - g(j,j,p,p)) + 0.5 * (g(j,p,j,p) - g(j,q,j,q)) * (2 + G(j,p));
+            this->A2 += 2 * (coulomb(j,p) - coulomb(j,q)) - 0.5 * (pair_hopping(j,p) - pair_hopping(j,q)) * (2 + G(j,p));
+            this->B2 += 2 * (coulomb(j,q) - coulomb(j,p)) + 0.5 * (pair_hopping(j,p) - pair_hopping(j,q)) * (2 + G(j,p));
             this->C2 += 4 * g(j,j,p,q) - g(j,p,j,q) * (2 + G(j,p));
         }
 
         for (size_t b = this->N_P; b < this->K; b++) {
-            this->A2 += 0.5 * (g(b,p,b,p) - g(b,q,b,q)) * G(q,b);
-            this->B2 += 0.5 * (g(b,q,b,q) - g(b,p,b,p)) * G(q,b);
+            this->A2 += 0.5 * (pair_hopping(b,p) - pair_hopping(b,q)) * G(q,b);
+            this->B2 += 0.5 * (pair_hopping(b,q) - pair_hopping(b,p)) * G(q,b);
             this->C2 += g(b,p,b,q) * G(q,b);
         }
     }
@@ -141,8 +144,8 @@ void AP1roGJacobiOrbitalOptimizer::calculateJacobiCoefficients(size_t p, size_t
 
 
         for (size_t j = 0; j < this->N_P; j++) {
-            this->A3 -= 0.5 * (g(j,p,j,p) - g(j,q,j,q)) * (G(j,p) - G(j,q));
-            this->B3 += 0.5 * (g(j,p,j,p) - g(j,q,j,q)) * (G(j,p) - G(j,q));
+            this->A3 -= 0.5 * (pair_hopping(j,p) - pair_hopping(j,q)) * (G(j,p) - G(j,q));
+            this->B3 += 0.5 * (pair_hopping(j,p) - pair_hopping(j,q)) * (G(j,p) - G(j,q));
             this->C3 += g(j,p,j,q) * (G(j,q) - G(j,p));
         }
     }
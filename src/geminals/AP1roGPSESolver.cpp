@@ -87,8 +87,11 @@ AP1roGPSESolver::AP1roGPSESolver(const Molecule& molecule, const HamiltonianPara
  */
 double AP1roGPSESolver::calculateJacobianElement(const AP1roGGeminalCoefficients& G, size_t i, size_t a, size_t k, size_t c) const {
 
-    auto h = this->ham_par.get_h();
-    auto g = this->ham_par.get_g();
+    const auto& h = this->ham_par.get_h();
+    auto pair_integrals = this->ham_par.get_pair_integrals();
+    const auto& coulomb = pair_integrals->get_coulomb();
+    const auto& exchange = pair_integrals->get_exchange();
+    const auto& pair_hopping = pair_integrals->get_pair_hopping();
 
     double j_el = 0.0;
 
@@ -101,10 +104,10 @@ double AP1roGPSESolver::calculateJacobianElement(const AP1roGGeminalCoefficients
         }
 
         else {  // i!=k and a == c
-            j_el += g(k,i,k,i) - 2 * g(k,a,k,a) * G(i,a);
+            j_el += pair_hopping(k,i) - 2 * pair_hopping(k,a) * G(i,a);
 
             for (size_t b = this->N_P; b < this->K; b++) {
-                j_el += g(k,b,k,b) * G(i,b);
+                j_el += pair_hopping(k,b) * G(i,b);
             }
 
         }
@@ -113,10 +116,10 @@ double AP1roGPSESolver::calculateJacobianElement(const AP1roGGeminalCoefficients
     else {  // i==k
 
         if (a != c) {  // i==k and a!=c
-            j_el += g(a,c,a,c) - 2 * g(i,c,i,c) * G(i,a);
+            j_el += pair_hopping(a,c) - 2 * pair_hopping(i,c) * G(i,a);
 
             for (size_t j = 0; j < this->N_P; j++) {
-                j_el += g(j,c,j,c) * G(j,a);
+                j_el += pair_hopping(j,c) * G(j,a);
             }
         }
 
@@ -124,21 +127,21 @@ double AP1roGPSESolver::calculateJacobianElement(const AP1roGGeminalCoefficients
 
             j_el += 2 * (h(a,a) - h(i,i));
 
-            j_el += g(a,a,a,a) + g(i,i,i,i);
+            j_el += coulomb(a,a) + coulomb(i,i);
 
-            j_el -= 2 * (2 * g(a,a,i,i) - g(a,i,i,a));
+            j_el -= 2 * (2 * coulomb(a,i) - exchange(a,i));
 
 
             for (size_t j = 0; j < this->N_P; j++) {
-                j_el += 2 * (2 * g(a,a,j,j) - g(a,j,j,a)) - (2 * g(i,i,j,j) - g(i,j,j,i));
+                j_el += 2 * (2 * coulomb(a,j) - exchange(a,j)) - (2 * coulomb(i,j) - exchange(i,j));
             }
 
             for (size_t j = 0; j < this->N_P; j++) {
-                j_el -= g(j,a,j,a) * G(j,a);
+                j_el -= pair_hopping(j,a) * G(j,a);
             }
 
             for (size_t b = this->N_P; b < this->K; b++) {
-                j_el -= g(i,b,i,b) * G(i,b);
+                j_el -= pair_hopping(i,b) * G(i,b);
             }
         }
 
@@ -189,33 +192,36 @@ SquareMatrix<double> AP1roGPSESolver::calculateJacobian(const VectorX<double>& g
  */
 double AP1roGPSESolver::calculateCoordinateFunction(const AP1roGGeminalCoefficients& G, size_t i, size_t a) const {
 
-    auto h = this->ham_par.get_h();
-    auto g = this->ham_par.get_g();
+    const auto& h = this->ham_par.get_h();
+    auto pair_integrals = this->ham_par.get_pair_integrals();
+    const auto& coulomb = pair_integrals->get_coulomb();
+    const auto& exchange = pair_integrals->get_exchange();
+    const auto& pair_hopping = pair_integrals->get_pair_hopping();
 
     double f = 0.0;
 
     // A KISS implementation of the AP1roG pSE equations
-    f += g(a,i,a,i) * (1 - std::pow(G(i,a), 2));
+    f += pair_hopping(a,i) * (1 - std::pow(G(i,a), 2));
 
     for (size_t j = 0; j < this->N_P; j++) {
         if (j != i) {
-            f += 2 * ((2 * g(a,a,j,j) - g(a,j,j,a)) - (2 * g(i,i,j,j) - g(i,j,j,i))) * G(i,a);
+            f += 2 * ((2 * coulomb(a,j) - exchange(a,j)) - (2 * coulomb(i,j) - exchange(i,j))) * G(i,a);
         }
     }
 
     f += 2 * (h(a,a) - h(i,i)) * G(i,a);
 
-    f += (g(a,a,a,a) - g(i,i,i,i)) * G(i,a);
+    f += (coulomb(a,a) - coulomb(i,i)) * G(i,a);
 
     for (size_t b = this->N_P; b < this->K; b++) {
         if (b != a) {
-            f += (g(a,b,a,b) - g(i,b,i,b) * G(i,a)) * G(i,b);
+            f += (pair_hopping(a,b) - pair_hopping(i,b) * G(i,a)) * G(i,b);
         }
     }
 
     for (size_t j = 0; j < this->N_P; j++) {
         if (j != i) {
-            f += (g(j,i,j,i) - g(j,a,j,a) * G(i,a)) * G(j,a);
+            f += (pair_hopping(j,i) - pair_hopping(j,a) * G(i,a)) * G(j,a);
         }
     }
 
@@ -224,7 +230,7 @@ double AP1roGPSESolver::calculateCoordinateFunction(const AP1roGGeminalCoefficie
 
             for (size_t j = 0; j < this->N_P; j++) {
                 if (j != i) {
-                    f += g(j,b,j,b) * G(j,a) * G(i,b);
+                    f += pair_hopping(j,b) * G(j,a) * G(i,b);
                 }
             }
 
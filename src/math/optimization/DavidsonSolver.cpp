@@ -20,6 +20,7 @@
 
 
 
+#include <algorithm>
 #include <chrono>
 
 
@@ -27,12 +28,161 @@
 namespace GQCP {
 
 
+/*
+ *  PRIVATE METHODS
+ */
+
+/**
+ *  Solve the eigenvalue problem using the block Davidson algorithm, in which the correction vectors of (at most this->block_size) roots are added to the subspace at once
+ */
+void DavidsonSolver::solveBlock() {
+
+    const size_t r = this->number_of_requested_eigenpairs;
+
+    // Allocate the subspace vectors V, their matrix-vector products VA and the subspace matrix S only once, since the subspace dimension is bounded
+    size_t subspace_dimension = this->V_0.cols();
+    const size_t capacity = std::max(this->maximum_subspace_dimension, subspace_dimension);
+
+    MatrixX<double> V (this->dim, capacity);
+    MatrixX<double> VA (this->dim, capacity);
+    MatrixX<double> S (capacity, capacity);
+
+    V.leftCols(subspace_dimension) = this->V_0;
+    VA.leftCols(subspace_dimension) = this->blockMatrixVectorProduct(this->V_0);
+    S.topLeftCorner(subspace_dimension, subspace_dimension) = V.leftCols(subspace_dimension).transpose() * VA.leftCols(subspace_dimension);
+
+
+    // this->number_of_iterations starts at 0
+    while (!(this->_is_solved)) {
+        // Diagonalize the subspace matrix and find the r lowest eigenpairs
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigensolver (S.topLeftCorner(subspace_dimension, subspace_dimension));
+        VectorX<double> Lambda = eigensolver.eigenvalues().head(r);
+        MatrixX<double> Z = eigensolver.eigenvectors().leftCols(r);
+
+        // Calculate the current guesses for the eigenvectors and their residual vectors
+        MatrixX<double> X = V.leftCols(subspace_dimension) * Z;
+        MatrixX<double> R = VA.leftCols(subspace_dimension) * Z - X * Lambda.asDiagonal();
+        VectorX<double> residual_norms = R.colwise().norm();
+
+
+        // Check for convergence on each of the residual vectors
+        if (!((residual_norms.array() > this->convergence_threshold).any())) {
+            this->_is_solved = true;
+
+            for (size_t i = 0; i < r; i++) {
+                this->eigenpairs.emplace_back(Lambda(i), X.col(i));  // already reserved in the base constructor
+            }
+
+            break;
+        }
+
+        this->number_of_iterations++;
+        if (this->number_of_iterations >= this->maximum_number_of_iterations) {
+            throw std::runtime_error("DavidsonSolver::solveBlock(): The Davidson algorithm did not converge.");
+        }
+
+
+        // Gather the roots that contribute a correction vector, in order of decreasing residual norm: the unconverged roots therefore always come first, also when there are more roots than the block size
+        // Converged eigenpairs are skipped if they are locked
+        std::vector<size_t> roots (r);
+        for (size_t i = 0; i < r; i++) {
+            roots[i] = i;
+        }
+        std::stable_sort(roots.begin(), roots.end(), [&residual_norms] (size_t i, size_t j) { return residual_norms(i) > residual_norms(j); });
+
+        std::vector<size_t> expanded_roots;
+        for (size_t i : roots) {
+            if (expanded_roots.size() == this->block_size) {
+                break;
+            }
+
+            if (!(this->lock_converged_eigenpairs) || (residual_norms(i) > this->convergence_threshold)) {
+                expanded_roots.push_back(i);
+            }
+        }
+
+        // Solve the residual equations for the gathered roots
+        // The implementation of these equations is adapted from Klaas Gunst's DOCI code (https://github.com/klgunst/doci)
+        MatrixX<double> Delta (this->dim, expanded_roots.size());
+        for (size_t k = 0; k < expanded_roots.size(); k++) {
+            size_t i = expanded_roots[k];
+
+            VectorX<double> denominator = this->diagonal - VectorX<double>::Constant(this->dim, Lambda(i));
+            Delta.col(k) = (denominator.array().abs() > this->correction_threshold).select(R.col(i).array() / denominator.array().abs(),
+                                                                                           R.col(i) / this->correction_threshold);
+            Delta.col(k).normalize();
+        }
+
+
+        // If the block of correction vectors doesn't fit in the subspace anymore, do a subspace collapse
+        if (subspace_dimension + Delta.cols() > this->maximum_subspace_dimension) {
+            const size_t c = this->collapsed_subspace_dimension;
+            MatrixX<double> lowest_eigenvectors = eigensolver.eigenvectors().leftCols(c);
+
+            // The new subspace vectors are linear combinations of current subspace vectors, with coefficients found in the lowest eigenvectors of the subspace matrix
+            V.leftCols(c) = V.leftCols(subspace_dimension) * lowest_eigenvectors;  // the product is evaluated into a temporary, so aliasing is not an issue
+            VA.leftCols(c) = VA.leftCols(subspace_dimension) * lowest_eigenvectors;
+            S.topLeftCorner(c, c) = V.leftCols(c).transpose() * VA.leftCols(c);
+
+            subspace_dimension = c;
+        }
+
+
+        // Project the correction vectors on the orthogonal complement of V using block Gram-Schmidt
+        // A second pass re-orthogonalizes the corrections against the numerical noise of the first one
+        auto V_current = V.leftCols(subspace_dimension);
+        for (size_t pass = 0; pass < 2; pass++) {
+            Delta -= V_current * (V_current.transpose() * Delta);
+        }
+
+        // Orthonormalize the corrections among each other, discarding the ones that are (numerically) linearly dependent
+        // The accepted correction vectors are compacted in the first columns of Delta
+        size_t number_of_new_vectors = 0;
+        for (size_t k = 0; k < static_cast<size_t>(Delta.cols()); k++) {
+            VectorX<double> v = Delta.col(k);
+
+            auto W = Delta.leftCols(number_of_new_vectors);
+            for (size_t pass = 0; pass < 2; pass++) {
+                v -= W * (W.transpose() * v);
+            }
+
+            double norm = v.norm();  // if the norm is large enough, we include it in the subspace
+            if (norm > 1.0e-03) {
+                Delta.col(number_of_new_vectors) = v / norm;
+                number_of_new_vectors++;
+            }
+        }
+
+        if (number_of_new_vectors == 0) {
+            throw std::runtime_error("DavidsonSolver::solveBlock(): The correction vectors are linearly dependent on the current subspace.");
+        }
+
+
+        // Calculate the expensive matrix-vector products for the new subspace vectors in one block
+        const size_t n = subspace_dimension;
+        const size_t b = number_of_new_vectors;
+        V.middleCols(n, b) = Delta.leftCols(b);
+        VA.middleCols(n, b) = this->blockMatrixVectorProduct(Delta.leftCols(b));
+        assert((V.leftCols(n+b).transpose() * V.leftCols(n+b)).isApprox(MatrixX<double>::Identity(n+b, n+b), 1.0e-08));  // make sure that the subspace vectors are orthonormal
+
+        // Only calculate the rows and columns of S that haven't been calculated yet
+        MatrixX<double> S_new = V.leftCols(n+b).transpose() * VA.middleCols(n, b);  // ((n+b) x b)
+        S.block(0, n, n, b) = S_new.topRows(n);
+        S.block(n, 0, b, n) = S_new.topRows(n).transpose();
+        S.block(n, n, b, b) = 0.5 * (S_new.bottomRows(b) + S_new.bottomRows(b).transpose());
+
+        subspace_dimension = n + b;
+    }
+}
+
+
+
 /*
  *  CONSTRUCTORS
  */
 
 /**
- *  @param matrixVectorProduct                  a vector function that returns the matrix-vector product (i.e. the matrix-vector product representation of the matrix)
+ *  @param blockMatrixVectorProduct             a function that returns the matrix-vector products of all the columns of a given matrix at once
  *  @param diagonal                             the diagonal of the matrix
  *  @param V_0                                  the (set of) initial guess(es) specified as a vector (matrix of column vectors)
  *  @param number_of_requested_eigenpairs       the number of eigenpairs the solver should find
@@ -41,45 +191,84 @@ namespace GQCP {
  *  @param maximum_subspace_dimension           the maximum dimension of the Davidson subspace before collapsing
  *  @param collapsed_subspace_dimension         the dimension of the subspace after collapse
  *  @param maximum_number_of_iterations         the maximum number of Davidson iterations
+ *  @param block_size                           the maximum number of correction vectors that are added per iteration
+ *  @param lock_converged_eigenpairs            if true, converged eigenpairs no longer contribute correction vectors
  */
-DavidsonSolver::DavidsonSolver(const VectorFunction& matrixVectorProduct, const VectorX<double>& diagonal, const MatrixX<double>& V_0, size_t number_of_requested_eigenpairs, double convergence_threshold, double correction_threshold, size_t maximum_subspace_dimension, size_t collapsed_subspace_dimension, size_t maximum_number_of_iterations) :
+DavidsonSolver::DavidsonSolver(const BlockVectorFunction& blockMatrixVectorProduct, const VectorX<double>& diagonal, const MatrixX<double>& V_0, size_t number_of_requested_eigenpairs, double convergence_threshold, double correction_threshold, size_t maximum_subspace_dimension, size_t collapsed_subspace_dimension, size_t maximum_number_of_iterations, size_t block_size, bool lock_converged_eigenpairs) :
     BaseEigenproblemSolver(static_cast<size_t>(V_0.rows()), number_of_requested_eigenpairs),
-    matrixVectorProduct (matrixVectorProduct),
+    blockMatrixVectorProduct (blockMatrixVectorProduct),
     diagonal (diagonal),
     V_0 (V_0),
     convergence_threshold (convergence_threshold),
     correction_threshold (correction_threshold),
     maximum_subspace_dimension (maximum_subspace_dimension),
     collapsed_subspace_dimension (collapsed_subspace_dimension),
-    maximum_number_of_iterations (maximum_number_of_iterations)
+    maximum_number_of_iterations (maximum_number_of_iterations),
+    block_size (block_size),
+    lock_converged_eigenpairs (lock_converged_eigenpairs)
 {
-    if (V_0.cols() < this->number_of_requested_eigenpairs) {
-        throw std::invalid_argument("DavidsonSolver::DavidsonSolver(VectorFunction, VectorX<double>, MatrixX<double>, size_t, double, double, size_t, size_t, size_t): You have to specify at least as many initial guesses as number of requested eigenpairs.");
+    if (static_cast<size_t>(V_0.cols()) < this->number_of_requested_eigenpairs) {
+        throw std::invalid_argument("DavidsonSolver::DavidsonSolver(BlockVectorFunction, VectorX<double>, MatrixX<double>, size_t, double, double, size_t, size_t, size_t, size_t, bool): You have to specify at least as many initial guesses as number of requested eigenpairs.");
     }
 
     if (this->collapsed_subspace_dimension < this->number_of_requested_eigenpairs) {
-        throw std::invalid_argument("DavidsonSolver::DavidsonSolver(VectorFunction, VectorX<double>, MatrixX<double>, size_t, double, double, size_t, size_t, size_t): The collapsed subspace dimension must be at least the number of requested eigenpairs.");
+        throw std::invalid_argument("DavidsonSolver::DavidsonSolver(BlockVectorFunction, VectorX<double>, MatrixX<double>, size_t, double, double, size_t, size_t, size_t, size_t, bool): The collapsed subspace dimension must be at least the number of requested eigenpairs.");
     }
 
     if (this->collapsed_subspace_dimension >= this->maximum_subspace_dimension) {
-        throw std::invalid_argument("DavidsonSolver::DavidsonSolver(VectorFunction, VectorX<double>, MatrixX<double>, size_t, double, double, size_t, size_t, size_t): The collapsed subspace dimension must be smaller than the maximum subspace dimension.");
+        throw std::invalid_argument("DavidsonSolver::DavidsonSolver(BlockVectorFunction, VectorX<double>, MatrixX<double>, size_t, double, double, size_t, size_t, size_t, size_t, bool): The collapsed subspace dimension must be smaller than the maximum subspace dimension.");
+    }
+
+    if (this->block_size == 0) {
+        throw std::invalid_argument("DavidsonSolver::DavidsonSolver(BlockVectorFunction, VectorX<double>, MatrixX<double>, size_t, double, double, size_t, size_t, size_t, size_t, bool): The block size must be at least 1.");
+    }
+
+    if ((this->block_size > 1) && (this->collapsed_subspace_dimension + this->block_size > this->maximum_subspace_dimension)) {
+        throw std::invalid_argument("DavidsonSolver::DavidsonSolver(BlockVectorFunction, VectorX<double>, MatrixX<double>, size_t, double, double, size_t, size_t, size_t, size_t, bool): A block of correction vectors must fit in the collapsed subspace.");
     }
 }
 
 
+/**
+ *  @param matrixVectorProduct                  a vector function that returns the matrix-vector product (i.e. the matrix-vector product representation of the matrix)
+ *  @param diagonal                             the diagonal of the matrix
+ *  @param V_0                                  the (set of) initial guess(es) specified as a vector (matrix of column vectors)
+ *  @param number_of_requested_eigenpairs       the number of eigenpairs the solver should find
+ *  @param convergence_threshold                the tolerance on the norm of the residual vector
+ *  @param correction_threshold                 the threshold used in solving the (approximated) residue correction equation
+ *  @param maximum_subspace_dimension           the maximum dimension of the Davidson subspace before collapsing
+ *  @param collapsed_subspace_dimension         the dimension of the subspace after collapse
+ *  @param maximum_number_of_iterations         the maximum number of Davidson iterations
+ *  @param block_size                           the maximum number of correction vectors that are added per iteration
+ *  @param lock_converged_eigenpairs            if true, converged eigenpairs no longer contribute correction vectors
+ */
+DavidsonSolver::DavidsonSolver(const VectorFunction& matrixVectorProduct, const VectorX<double>& diagonal, const MatrixX<double>& V_0, size_t number_of_requested_eigenpairs, double convergence_threshold, double correction_threshold, size_t maximum_subspace_dimension, size_t collapsed_subspace_dimension, size_t maximum_number_of_iterations, size_t block_size, bool lock_converged_eigenpairs) :
+    DavidsonSolver(BlockVectorFunction([matrixVectorProduct](const MatrixX<double>& X) {  // apply the given matrix-vector product to every column
+                       MatrixX<double> AX (X.rows(), X.cols());
+                       for (size_t j = 0; j < static_cast<size_t>(X.cols()); j++) {
+                           AX.col(j) = matrixVectorProduct(X.col(j));
+                       }
+                       return AX;
+                   }),
+                   diagonal, V_0, number_of_requested_eigenpairs, convergence_threshold, correction_threshold, maximum_subspace_dimension, collapsed_subspace_dimension, maximum_number_of_iterations, block_size, lock_converged_eigenpairs)
+{}
+
+
 /**
  *  @param A                                    the matrix to be diagonalized
  *  @param V_0                                  the (set of) initial guess(es) specified as a vector (matrix of column vectors)
  *  @param number_of_requested_eigenpairs       the number of eigenpairs the solver should find
- *  @param convergence_threshold                    the tolerance on the norm of the residual vector
+ *  @param convergence_threshold                the tolerance on the norm of the residual vector
  *  @param correction_threshold                 the threshold used in solving the (approximated) residue correction equation
  *  @param maximum_subspace_dimension           the maximum dimension of the Davidson subspace before collapsing
  *  @param collapsed_subspace_dimension         the dimension of the subspace after collapse
  *  @param maximum_number_of_iterations         the maximum number of Davidson iterations
+ *  @param block_size                           the maximum number of correction vectors that are added per iteration
+ *  @param lock_converged_eigenpairs            if true, converged eigenpairs no longer contribute correction vectors
  */
-DavidsonSolver::DavidsonSolver(const SquareMatrix<double>& A, const MatrixX<double>& V_0, size_t number_of_requested_eigenpairs, double convergence_threshold, double correction_threshold, size_t maximum_subspace_dimension, size_t collapsed_subspace_dimension, size_t maximum_number_of_iterations) :
-    DavidsonSolver([A](const VectorX<double>& x) { return A * x; },  // lambda matrix-vector product function created from the given matrix A
-                   A.diagonal(), V_0, number_of_requested_eigenpairs, convergence_threshold, correction_threshold, maximum_subspace_dimension, collapsed_subspace_dimension, maximum_number_of_iterations)
+DavidsonSolver::DavidsonSolver(const SquareMatrix<double>& A, const MatrixX<double>& V_0, size_t number_of_requested_eigenpairs, double convergence_threshold, double correction_threshold, size_t maximum_subspace_dimension, size_t collapsed_subspace_dimension, size_t maximum_number_of_iterations, size_t block_size, bool lock_converged_eigenpairs) :
+    DavidsonSolver(BlockVectorFunction([A](const MatrixX<double>& X) { return MatrixX<double>(A * X); }),  // lambda block matrix-vector product function created from the given matrix A
+                   A.diagonal(), V_0, number_of_requested_eigenpairs, convergence_threshold, correction_threshold, maximum_subspace_dimension, collapsed_subspace_dimension, maximum_number_of_iterations, block_size, lock_converged_eigenpairs)
 {}
 
 
@@ -90,7 +279,18 @@ DavidsonSolver::DavidsonSolver(const SquareMatrix<double>& A, const MatrixX<doub
  */
 DavidsonSolver::DavidsonSolver(const VectorFunction& matrixVectorProduct, const VectorX<double>& diagonal,
                                const DavidsonSolverOptions& davidson_solver_options) :
-   DavidsonSolver(matrixVectorProduct, diagonal, davidson_solver_options.X_0, davidson_solver_options.number_of_requested_eigenpairs, davidson_solver_options.convergence_threshold, davidson_solver_options.correction_threshold, davidson_solver_options.maximum_subspace_dimension, davidson_solver_options.collapsed_subspace_dimension, davidson_solver_options.maximum_number_of_iterations)
+   DavidsonSolver(matrixVectorProduct, diagonal, davidson_solver_options.X_0, davidson_solver_options.number_of_requested_eigenpairs, davidson_solver_options.convergence_threshold, davidson_solver_options.correction_threshold, davidson_solver_options.maximum_subspace_dimension, davidson_solver_options.collapsed_subspace_dimension, davidson_solver_options.maximum_number_of_iterations, davidson_solver_options.block_size, davidson_solver_options.lock_converged_eigenpairs)
+{}
+
+
+/**
+ *  @param blockMatrixVectorProduct     a function that returns the matrix-vector products of all the columns of a given matrix at once
+ *  @param diagonal                     the diagonal of the matrix
+ *  @param davidson_solver_options      the options specified for solving the Davidson eigenvalue problem
+ */
+DavidsonSolver::DavidsonSolver(const BlockVectorFunction& blockMatrixVectorProduct, const VectorX<double>& diagonal,
+                               const DavidsonSolverOptions& davidson_solver_options) :
+   DavidsonSolver(blockMatrixVectorProduct, diagonal, davidson_solver_options.X_0, davidson_solver_options.number_of_requested_eigenpairs, davidson_solver_options.convergence_threshold, davidson_solver_options.correction_threshold, davidson_solver_options.maximum_subspace_dimension, davidson_solver_options.collapsed_subspace_dimension, davidson_solver_options.maximum_number_of_iterations, davidson_solver_options.block_size, davidson_solver_options.lock_converged_eigenpairs)
 {}
 
 
@@ -99,8 +299,7 @@ DavidsonSolver::DavidsonSolver(const VectorFunction& matrixVectorProduct, const
  *  @param davidson_solver_options      the options specified for solving the Davidson eigenvalue problem
  */
 DavidsonSolver::DavidsonSolver(const SquareMatrix<double>& A, const DavidsonSolverOptions& davidson_solver_options) :
-    DavidsonSolver([A](const VectorX<double>& x) { return A * x; },  // lambda matrix-vector product function created from the given matrix A
-                   A.diagonal(), davidson_solver_options)
+    DavidsonSolver(A, davidson_solver_options.X_0, davidson_solver_options.number_of_requested_eigenpairs, davidson_solver_options.convergence_threshold, davidson_solver_options.correction_threshold, davidson_solver_options.maximum_subspace_dimension, davidson_solver_options.collapsed_subspace_dimension, davidson_solver_options.maximum_number_of_iterations, davidson_solver_options.block_size, davidson_solver_options.lock_converged_eigenpairs)
 {}
 
 
@@ -133,13 +332,14 @@ size_t DavidsonSolver::get_number_of_iterations() const {
  */
 void DavidsonSolver::solve() {
 
-    // Calculate the expensive matrix-vector products for all given initial guesses, and store them in VA
-    MatrixX<double> VA = MatrixX<double>::Zero(this->dim, this->V_0.cols());
-
-    for (size_t j = 0; j < this->V_0.cols(); j++) {
-        VA.col(j) = this->matrixVectorProduct(this->V_0.col(j));
+    if (this->block_size > 1) {
+        this->solveBlock();
+        return;
     }
 
+    // Calculate the expensive matrix-vector products for all given initial guesses, and store them in VA
+    MatrixX<double> VA = this->blockMatrixVectorProduct(this->V_0);
+
     // Calculate the initial subspace matrix S
     MatrixX<double> V = this->V_0;
     MatrixX<double> S = V.transpose() * VA;
@@ -165,7 +365,7 @@ void DavidsonSolver::solve() {
         //  Calculate the correction vectors in the matrix Delta (dim x number_of_requested_eigenpairs)
         MatrixX<double> R = MatrixX<double>::Zero(this->dim, this->number_of_requested_eigenpairs);
         MatrixX<double> Delta = MatrixX<double>::Zero(this->dim, this->number_of_requested_eigenpairs);
-        for (size_t column_index = 0; column_index < R.cols(); column_index++) {
+        for (size_t column_index = 0; column_index < this->number_of_requested_eigenpairs; column_index++) {
 
             // Calculate the residual vectors
             R.col(column_index) = VA * Z.col(column_index) - Lambda(column_index) * X.col(column_index);
@@ -207,7 +407,12 @@ void DavidsonSolver::solve() {
 
 
         // Calculate new subspace vectors by projecting the correction vectors (in Delta) onto the orthogonal complement of V
-        for (size_t column_index = 0; column_index < Delta.cols(); column_index++) {
+        for (size_t column_index = 0; column_index < this->number_of_requested_eigenpairs; column_index++) {
+
+            // Converged eigenpairs may be locked: they don't contribute a correction vector
+            if (this->lock_converged_eigenpairs && (R.col(column_index).norm() <= this->convergence_threshold)) {
+                continue;
+            }
 
             // Project the correction vectors on the orthogonal complement of V
             VectorX<double> v = Delta.col(column_index) - V * (V.transpose() * Delta.col(column_index));
@@ -218,7 +423,7 @@ void DavidsonSolver::solve() {
             if (norm > 1.0e-03) {  // include in the new subspace
 
                 // If needed, do a subspace collapse
-                if (V.cols() == this->maximum_subspace_dimension) {
+                if (static_cast<size_t>(V.cols()) == this->maximum_subspace_dimension) {
                     MatrixX<double> lowest_eigenvectors = eigensolver.eigenvectors().topLeftCorner(S.cols(), this->collapsed_subspace_dimension);
 
                     // The new subspace vectors are linear combinations of current subspace vectors, with coefficients found in the lowest eigenvectors of the subspace matrix
@@ -231,7 +436,7 @@ void DavidsonSolver::solve() {
                 V.conservativeResize(Eigen::NoChange, V.cols()+1);
                 V.col(V.cols()-1) = v;
 
-                VectorX<double> vA = this->matrixVectorProduct(v);  // calculate the expensive matrix-vector product if a new vector is added to the subspace
+                VectorX<double> vA = this->blockMatrixVectorProduct(v).col(0);  // calculate the expensive matrix-vector product if a new vector is added to the subspace
                 VA.conservativeResize(Eigen::NoChange, VA.cols()+1);
                 VA.col(VA.cols()-1) = vA;
             }
@@ -20,11 +20,99 @@
 #include "Spectra/SymEigsSolver.h"
 #include "Spectra/MatOp/SparseSymMatProd.h"
 
+#include <algorithm>
+
 
 
 namespace GQCP {
 
 
+/*
+ *  PRIVATE METHODS
+ */
+
+/**
+ *  Add the pending triplets to the sparse matrix, summing duplicate entries
+ */
+void SparseSolver::assemble() const {
+
+    if (this->triplets.empty()) {
+        return;
+    }
+
+    Eigen::SparseMatrix<double> addition (this->dim, this->dim);
+    addition.setFromTriplets(this->triplets.begin(), this->triplets.end());  // duplicate entries are summed
+
+    if (this->matrix.nonZeros() == 0) {
+        this->matrix.swap(addition);
+    } else {
+        this->matrix += addition;
+    }
+
+    this->triplets.clear();
+    this->triplets.shrink_to_fit();
+}
+
+
+/**
+ *  Run Spectra's symmetric eigensolver with the given matrix operation and store the requested eigenpairs
+ *
+ *  @tparam MatrixOperation     the type of the Spectra matrix operation
+ *
+ *  @param matrix_operation     the matrix operation that Spectra should use
+ */
+template <typename MatrixOperation>
+void SparseSolver::solveWith(MatrixOperation& matrix_operation) {
+
+    if (this->number_of_requested_eigenpairs > this->dim) {
+        throw std::invalid_argument("SparseSolver::solve(): The number of requested eigenpairs exceeds the dimension of the matrix.");
+    }
+
+    // Spectra needs at least 2 more Lanczos vectors than requested eigenvalues, which doesn't fit in a tiny matrix: its eigenpairs are then found from the explicitly constructed dense matrix
+    if (this->dim < this->number_of_requested_eigenpairs + 2) {
+        Eigen::MatrixXd dense_matrix (this->dim, this->dim);
+        Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(this->dim, this->dim);
+        for (size_t j = 0; j < this->dim; j++) {
+            matrix_operation.perform_op(identity.col(j).data(), dense_matrix.col(j).data());
+        }
+
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> dense_eigensolver (dense_matrix);  // the eigenvalues are sorted in ascending order
+        this->_is_solved = true;
+        for (size_t i = 0; i < this->number_of_requested_eigenpairs; i++) {
+            double eigenvalue = dense_eigensolver.eigenvalues()(i);
+            VectorX<double> eigenvector = dense_eigensolver.eigenvectors().col(i);
+
+            this->eigenpairs.emplace_back(eigenvalue, eigenvector);
+        }
+        return;
+    }
+
+    // Request the number of eigenpairs, and use enough Lanczos vectors (at least 2 more than requested eigenvalues, but not more than the dimension)
+    auto number_of_requested_eigenpairs = static_cast<int>(this->number_of_requested_eigenpairs);
+    int number_of_lanczos_vectors = std::min(static_cast<int>(this->dim), std::max(2*number_of_requested_eigenpairs + 1, 20));
+
+    Spectra::SymEigsSolver<double, Spectra::SMALLEST_ALGE, MatrixOperation> spectra_sparse_eigensolver (&matrix_operation, number_of_requested_eigenpairs, number_of_lanczos_vectors);
+    spectra_sparse_eigensolver.init();
+    spectra_sparse_eigensolver.compute();
+
+    // Set the eigenvalue and eigenvector as the lowest-energy eigenpair. We can use increasing indices because
+    // we have specified Spectra::SMALLEST_ALGE, which selects eigenvalues with smallest algebraic value
+    if (spectra_sparse_eigensolver.info() == Spectra::SUCCESSFUL) {
+        this->_is_solved = true;
+
+        for (size_t i = 0; i < this->number_of_requested_eigenpairs; i++) {
+            double eigenvalue = spectra_sparse_eigensolver.eigenvalues()(i);
+            VectorX<double> eigenvector = spectra_sparse_eigensolver.eigenvectors().col(i);
+
+            this->eigenpairs.emplace_back(eigenvalue, eigenvector);  // already reserved in the base constructor
+        }
+    } else {  // if Spectra was not successful
+        throw std::runtime_error("SparseSolver::solve(): Spectra could not solve the sparse eigenvalue problem.");
+    }
+}
+
+
+
 /*
  *  CONSTRUCTORS
  */
@@ -48,6 +136,50 @@ SparseSolver::SparseSolver(size_t dim, const SparseSolverOptions& sparse_solver_
 {}
 
 
+/**
+ *  @param matrix                   the preassembled compressed sparse representation of the matrix
+ *  @param sparse_solver_options    the options to be used for the sparse eigenproblem algorithm
+ */
+SparseSolver::SparseSolver(const Eigen::SparseMatrix<double>& matrix, const SparseSolverOptions& sparse_solver_options) :
+    BaseMatrixSolver(static_cast<size_t>(matrix.rows()), sparse_solver_options.number_of_requested_eigenpairs),
+    matrix (matrix)
+{
+    if (matrix.rows() != matrix.cols()) {
+        throw std::invalid_argument("SparseSolver::SparseSolver(Eigen::SparseMatrix<double>, SparseSolverOptions): The given matrix is not square.");
+    }
+}
+
+
+/**
+ *  @param matrixVectorProduct      a vector function that returns the matrix-vector product
+ *  @param dim                      the dimension of the matrix
+ *  @param sparse_solver_options    the options to be used for the sparse eigenproblem algorithm
+ */
+SparseSolver::SparseSolver(const VectorFunction& matrixVectorProduct, size_t dim, const SparseSolverOptions& sparse_solver_options) :
+    BaseMatrixSolver(dim, sparse_solver_options.number_of_requested_eigenpairs),
+    matrixVectorProduct (matrixVectorProduct)
+{}
+
+
+
+/*
+ *  GETTERS
+ */
+
+/**
+ *  @return the sparse matrix, in which all values that have been added are assembled
+ */
+const Eigen::SparseMatrix<double>& SparseSolver::get_matrix() const {
+
+    if (this->matrixVectorProduct) {
+        throw std::logic_error("SparseSolver::get_matrix(): A matrix-free solver doesn't store a matrix.");
+    }
+
+    this->assemble();
+    return this->matrix;
+}
+
+
 
 /*
  *  PUBLIC OVERRIDDEN METHODS
@@ -62,29 +194,13 @@ SparseSolver::SparseSolver(size_t dim, const SparseSolverOptions& sparse_solver_
  */
 void SparseSolver::solve() {
 
-    // Solve the sparse eigenvalue problem of the Hamiltonian matrix
-    Spectra::SparseSymMatProd<double> matrixVectorProduct (this->matrix);
-
-    // Request the number of eigenpairs, and use at least 2 more Ritz pairs than requested eigenvalues)
-    Spectra::SymEigsSolver<double, Spectra::SMALLEST_ALGE, Spectra::SparseSymMatProd<double>> spectra_sparse_eigensolver (&matrixVectorProduct, static_cast<int>(this->number_of_requested_eigenpairs), static_cast<int>(this->number_of_requested_eigenpairs) + 2);
-    spectra_sparse_eigensolver.init();
-    spectra_sparse_eigensolver.compute();
-
-    // Set number of requested eigenpairs
-
-    // Set the eigenvalue and eigenvector as the lowest-energy eigenpair. We can use increasing indices because
-    // we have specified Spectra::SMALLEST_ALGE, which selects eigenvalues with smallest algebraic value
-    if (spectra_sparse_eigensolver.info() == Spectra::SUCCESSFUL) {
-        this->_is_solved = true;
-
-        for (size_t i = 0; i < this->number_of_requested_eigenpairs; i++) {
-            double eigenvalue = spectra_sparse_eigensolver.eigenvalues()(i);
-            VectorX<double> eigenvector = spectra_sparse_eigensolver.eigenvectors().col(i);
-
-            this->eigenpairs.emplace_back(eigenvalue, eigenvector);  // already reserved in the base constructor
-        }
-    } else {  // if Spectra was not successful
-        throw std::runtime_error("SparseSolver::solve(): Spectra could not solve the sparse eigenvalue problem.");
+    if (this->matrixVectorProduct) {  // matrix-free: Spectra calls the matrix-vector product function directly
+        VectorFunctionOperator matrix_operation (this->matrixVectorProduct, this->dim);
+        this->solveWith(matrix_operation);
+    } else {
+        this->assemble();
+        Spectra::SparseSymMatProd<double> matrix_operation (this->matrix);
+        this->solveWith(matrix_operation);
     }
 }
 
@@ -95,9 +211,16 @@ void SparseSolver::solve() {
  *  @param index2       the second index of the matrix
  *
  *  Add the value to the matrix at (index1, index2)
+ *
+ *  The values are collected as triplets and are only assembled into the sparse matrix when it is needed
  */
 void SparseSolver::addToMatrix(double value, size_t index1, size_t index2) {
-    this->matrix.coeffRef(index1,index2) += value;
+
+    if (this->matrixVectorProduct) {
+        throw std::logic_error("SparseSolver::addToMatrix(double, size_t, size_t): Can't add values to a matrix-free solver.");
+    }
+
+    this->triplets.emplace_back(static_cast<int>(index1), static_cast<int>(index2), value);
 }
 
 
@@ -69,6 +69,35 @@ double calculateExpectationValue(const TwoElectronOperator<double>& two_op, cons
 }
 
 
+/**
+ *  @param two_op       the two-electron operator whose expectation value should be calculated
+ *  @param two_rdm      the 2-RDM of a seniority-zero wave function, in its compact representation
+ *
+ *  @return the expectation value of the two-electron operator, with the given 2-RDM: this includes the prefactor 1/2
+ */
+double calculateExpectationValue(const TwoElectronOperator<double>& two_op, const SeniorityZeroTwoRDM<double>& two_rdm) {
+
+    auto K = two_rdm.get_K();
+    if (two_op.get_dim() != K) {
+        throw std::invalid_argument("calculateExpectationValue(TwoElectronOperator<double>, SeniorityZeroTwoRDM<double>): The given two-electron integrals are not compatible with the 2-RDM.");
+    }
+
+    // Only the elements d(p,p,q,q), d(p,q,q,p) and d(p,q,p,q) are non-zero
+    double expectation_value = 0.0;
+    for (size_t p = 0; p < K; p++) {
+        expectation_value += two_op(p,p,p,p) * two_rdm(p,p,p,p);
+
+        for (size_t q = 0; q < K; q++) {
+            if (p != q) {
+                expectation_value += two_op(p,p,q,q) * two_rdm(p,p,q,q) + two_op(p,q,q,p) * two_rdm(p,q,q,p) + two_op(p,q,p,q) * two_rdm(p,q,p,q);
+            }
+        }
+    }
+
+    return 0.5 * expectation_value;
+}
+
+
 
 /*
  *  MIXED OPERATORS
@@ -87,4 +116,17 @@ double calculateExpectationValue(const HamiltonianParameters<double>& ham_par, c
 }
 
 
+/**
+ *  @param ham_par      the Hamiltonian parameters containing the scalar interaction term and the one- and two-electron integrals
+ *  @param one_rdm      the 1-RDM
+ *  @param two_rdm      the 2-RDM of a seniority-zero wave function, in its compact representation
+ *
+ *  @return the expectation value of the 'Hamiltonian' represented by the Hamiltonian parameters
+ */
+double calculateExpectationValue(const HamiltonianParameters<double>& ham_par, const OneRDM<double>& one_rdm, const SeniorityZeroTwoRDM<double>& two_rdm) {
+
+    return ham_par.get_scalar() + calculateExpectationValue(ham_par.get_h(), one_rdm) + calculateExpectationValue(ham_par.get_g(), two_rdm);
+}
+
+
 }  // namespace GQCP
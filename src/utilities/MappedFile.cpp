@@ -0,0 +1,79 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "utilities/MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+
+namespace GQCP {
+
+
+/*
+ *  CONSTRUCTORS
+ */
+
+/**
+ *  @param filename     the name of the file that should be mapped into memory
+ */
+MappedFile::MappedFile(const std::string& filename) {
+
+    int file_descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (file_descriptor == -1) {
+        throw std::runtime_error("MappedFile::MappedFile(std::string): The file " + filename + " could not be opened. Maybe you specified a wrong path?");
+    }
+
+    struct stat file_status;
+    if (::fstat(file_descriptor, &file_status) == -1) {
+        ::close(file_descriptor);
+        throw std::runtime_error("MappedFile::MappedFile(std::string): The size of the file " + filename + " could not be determined.");
+    }
+
+    this->size = static_cast<size_t>(file_status.st_size);
+    if (this->size > 0) {  // an empty file can't be mapped
+        void* mapping = ::mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(file_descriptor);
+            throw std::runtime_error("MappedFile::MappedFile(std::string): The file " + filename + " could not be mapped into memory.");
+        }
+
+        ::madvise(mapping, this->size, MADV_SEQUENTIAL);  // the files are usually read from front to back
+        this->data = static_cast<const char*>(mapping);
+    }
+
+    ::close(file_descriptor);  // the mapping stays valid after closing the file
+}
+
+
+
+/*
+ *  DESTRUCTOR
+ */
+
+MappedFile::~MappedFile() {
+    if (this->data) {
+        ::munmap(const_cast<char*>(this->data), this->size);
+    }
+}
+
+
+}  // namespace GQCP
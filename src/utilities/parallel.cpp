@@ -0,0 +1,66 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#include "utilities/parallel.hpp"
+
+#include <atomic>
+#include <cstdlib>
+
+
+namespace GQCP {
+
+
+/*
+ *  The number of threads that was set explicitly, 0 if the default should be used
+ */
+static std::atomic<size_t> explicit_number_of_threads (0);
+
+
+/**
+ *  @return the number of threads that the multithreaded algorithms in this library use
+ *
+ *  If no number of threads has been set explicitly, the environment variable GQCP_NUM_THREADS is used. If that isn't set either, the number of concurrent threads supported by the hardware is used
+ */
+size_t getNumberOfThreads() {
+
+    size_t number_of_threads = explicit_number_of_threads;
+    if (number_of_threads > 0) {
+        return number_of_threads;
+    }
+
+    const char* environment_value = std::getenv("GQCP_NUM_THREADS");
+    if (environment_value) {
+        long value = std::strtol(environment_value, nullptr, 10);
+        if (value > 0) {
+            return static_cast<size_t>(value);
+        }
+    }
+
+    // std::thread::hardware_concurrency() returns 0 if the value can't be determined
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+
+/**
+ *  @param number_of_threads        the number of threads that the multithreaded algorithms in this library should use: 0 restores the default (see getNumberOfThreads())
+ */
+void setNumberOfThreads(size_t number_of_threads) {
+    explicit_number_of_threads = number_of_threads;
+}
+
+
+}  // namespace GQCP
@@ -93,3 +93,121 @@ BOOST_AUTO_TEST_CASE ( test_Hubbard_vs_FCI_davidson_large ) {
 
     BOOST_CHECK(std::abs(fci_energy - (hubbard_energy)) < 1.0e-06);
 }
+
+
+BOOST_AUTO_TEST_CASE ( test_Hubbard_vs_FCI_block_davidson ) {
+
+    // Check if the block Davidson algorithm finds the same lowest eigenvalues for Hubbard and FCI as the dense solver
+
+    // Create the Hamiltonian parameters for a random Hubbard hopping matrix
+    size_t K = 6;
+    auto H = GQCP::HoppingMatrix::Random(K);
+    auto mol_ham_par = GQCP::HamiltonianParameters<double>::Hubbard(H);
+
+
+    // Create the Hubbard and FCI modules
+    size_t N = 3;
+    GQCP::ProductFockSpace fock_space (K, N, N);  // dim = 400
+    GQCP::Hubbard hubbard (fock_space);
+    GQCP::FCI fci (fock_space);
+
+    GQCP::CISolver hubbard_solver (hubbard, mol_ham_par);
+    GQCP::CISolver fci_solver (fci, mol_ham_par);
+
+
+    // Solve with dense for reference
+    size_t number_of_requested_eigenpairs = 3;
+    GQCP::CISolver dense_solver (fci, mol_ham_par);
+    GQCP::DenseSolverOptions dense_solver_options;
+    dense_solver_options.number_of_requested_eigenpairs = number_of_requested_eigenpairs;
+    dense_solver.solve(dense_solver_options);
+
+
+    // Solve with block Davidson
+    GQCP::MatrixX<double> initial_guesses (fock_space.get_dimension(), number_of_requested_eigenpairs);
+    for (size_t i = 0; i < number_of_requested_eigenpairs; i++) {
+        initial_guesses.col(i) = fock_space.randomExpansion();
+    }
+    Eigen::HouseholderQR<Eigen::MatrixXd> qr (initial_guesses);  // the initial guesses should be orthonormal
+    initial_guesses = qr.householderQ() * Eigen::MatrixXd::Identity(fock_space.get_dimension(), number_of_requested_eigenpairs);
+
+    GQCP::DavidsonSolverOptions solver_options (initial_guesses);
+    solver_options.number_of_requested_eigenpairs = number_of_requested_eigenpairs;
+    solver_options.collapsed_subspace_dimension = number_of_requested_eigenpairs;
+    solver_options.block_size = number_of_requested_eigenpairs;
+    solver_options.lock_converged_eigenpairs = true;
+    hubbard_solver.solve(solver_options);
+    fci_solver.solve(solver_options);
+
+    for (size_t i = 0; i < number_of_requested_eigenpairs; i++) {
+        double ref_energy = dense_solver.get_eigenpair(i).get_eigenvalue();
+
+        BOOST_CHECK(std::abs(fci_solver.get_eigenpair(i).get_eigenvalue() - ref_energy) < 1.0e-06);
+        BOOST_CHECK(std::abs(hubbard_solver.get_eigenpair(i).get_eigenvalue() - ref_energy) < 1.0e-06);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE ( test_Hubbard_vs_FCI_preassembled_davidson ) {
+
+    // Check if the Davidson algorithm on the preassembled Hamiltonian finds the same lowest eigenvalues as the dense solver
+
+    // Create the Hamiltonian parameters for a random Hubbard hopping matrix
+    size_t K = 6;
+    auto H = GQCP::HoppingMatrix::Random(K);
+    auto mol_ham_par = GQCP::HamiltonianParameters<double>::Hubbard(H);
+
+
+    // Create the Hubbard and FCI modules
+    size_t N = 3;
+    GQCP::ProductFockSpace fock_space (K, N, N);  // dim = 400
+    GQCP::Hubbard hubbard (fock_space);
+    GQCP::FCI fci (fock_space);
+
+    GQCP::CISolver hubbard_solver (hubbard, mol_ham_par);
+    GQCP::CISolver fci_solver (fci, mol_ham_par);
+
+
+    // Solve with dense for reference
+    size_t number_of_requested_eigenpairs = 3;
+    GQCP::CISolver dense_solver (fci, mol_ham_par);
+    GQCP::DenseSolverOptions dense_solver_options;
+    dense_solver_options.number_of_requested_eigenpairs = number_of_requested_eigenpairs;
+    dense_solver.solve(dense_solver_options);
+
+
+    // Solve with block Davidson on the preassembled Hamiltonian
+    GQCP::MatrixX<double> initial_guesses (fock_space.get_dimension(), number_of_requested_eigenpairs);
+    for (size_t i = 0; i < number_of_requested_eigenpairs; i++) {
+        initial_guesses.col(i) = fock_space.randomExpansion();
+    }
+    Eigen::HouseholderQR<Eigen::MatrixXd> qr (initial_guesses);  // the initial guesses should be orthonormal
+    initial_guesses = qr.householderQ() * Eigen::MatrixXd::Identity(fock_space.get_dimension(), number_of_requested_eigenpairs);
+
+    GQCP::DavidsonSolverOptions solver_options (initial_guesses);
+    solver_options.number_of_requested_eigenpairs = number_of_requested_eigenpairs;
+    solver_options.collapsed_subspace_dimension = number_of_requested_eigenpairs;
+    solver_options.block_size = number_of_requested_eigenpairs;
+    solver_options.lock_converged_eigenpairs = true;
+    solver_options.preassemble = true;
+    hubbard_solver.solve(solver_options);
+    fci_solver.solve(solver_options);
+
+    for (size_t i = 0; i < number_of_requested_eigenpairs; i++) {
+        double ref_energy = dense_solver.get_eigenpair(i).get_eigenvalue();
+
+        BOOST_CHECK(std::abs(fci_solver.get_eigenpair(i).get_eigenvalue() - ref_energy) < 1.0e-06);
+        BOOST_CHECK(std::abs(hubbard_solver.get_eigenpair(i).get_eigenvalue() - ref_energy) < 1.0e-06);
+    }
+
+
+    // Solve for the ground state with the single-vector Davidson algorithm, which reuses the assembled Hamiltonian
+    GQCP::DavidsonSolverOptions single_solver_options (fock_space.randomExpansion());
+    single_solver_options.preassemble = true;
+    hubbard_solver.solve(single_solver_options);
+    fci_solver.solve(single_solver_options);
+
+    double ref_energy = dense_solver.get_eigenpair().get_eigenvalue();
+    BOOST_CHECK(std::abs(fci_solver.get_eigenpair().get_eigenvalue() - ref_energy) < 1.0e-06);
+    BOOST_CHECK(std::abs(hubbard_solver.get_eigenpair().get_eigenvalue() - ref_energy) < 1.0e-06);
+}
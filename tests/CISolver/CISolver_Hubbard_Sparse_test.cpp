@@ -0,0 +1,114 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "SparseHubbardSolver"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
+
+
+#include "CISolver/CISolver.hpp"
+#include "FockSpace/ProductFockSpace.hpp"
+#include "HamiltonianBuilder/Hubbard.hpp"
+#include "HamiltonianBuilder/FCI.hpp"
+#include "HamiltonianParameters/HamiltonianParameters.hpp"
+
+
+BOOST_AUTO_TEST_CASE ( test_Hubbard_vs_FCI_sparse ) {
+
+    // Check if FCI and Hubbard produce the same results for Hubbard Hamiltonian parameters
+
+    // Create the Hamiltonian parameters for a random Hubbard hopping matrix
+    size_t K = 6;
+    auto H = GQCP::HoppingMatrix::Random(K);
+    auto mol_ham_par = GQCP::HamiltonianParameters<double>::Hubbard(H);
+
+
+    // Create the Hubbard and FCI modules
+    size_t N = 3;
+    GQCP::ProductFockSpace fock_space (K, N, N);  // dim = 400
+    GQCP::Hubbard hubbard (fock_space);
+    GQCP::FCI fci (fock_space);
+
+
+    // Solve via dense for FCI and via the preassembled sparse matrix for Hubbard
+    GQCP::CISolver hubbard_solver (hubbard, mol_ham_par);
+    GQCP::CISolver fci_solver (fci, mol_ham_par);
+
+    GQCP::DenseSolverOptions dense_solver_options;
+    GQCP::SparseSolverOptions sparse_solver_options;
+    hubbard_solver.solve(sparse_solver_options);
+    fci_solver.solve(dense_solver_options);
+
+    auto fci_energy = fci_solver.get_eigenpair().get_eigenvalue();
+    auto hubbard_energy = hubbard_solver.get_eigenpair().get_eigenvalue();
+
+    BOOST_CHECK(std::abs(fci_energy - (hubbard_energy)) < 1.0e-06);
+}
+
+
+BOOST_AUTO_TEST_CASE ( test_Hubbard_vs_FCI_sparse_matrix_free ) {
+
+    // Check if FCI and Hubbard produce the same results for Hubbard Hamiltonian parameters, using only matrix-vector products
+
+    // Create the Hamiltonian parameters for a random Hubbard hopping matrix
+    size_t K = 6;
+    auto H = GQCP::HoppingMatrix::Random(K);
+    auto mol_ham_par = GQCP::HamiltonianParameters<double>::Hubbard(H);
+
+
+    // Create the Hubbard and FCI modules
+    size_t N = 3;
+    GQCP::ProductFockSpace fock_space (K, N, N);  // dim = 400
+    GQCP::Hubbard hubbard (fock_space);
+    GQCP::FCI fci (fock_space);
+
+
+    // Solve via matrix-free Lanczos
+    GQCP::CISolver hubbard_solver (hubbard, mol_ham_par);
+    GQCP::CISolver fci_solver (fci, mol_ham_par);
+
+    GQCP::SparseSolverOptions sparse_solver_options;
+    sparse_solver_options.matrix_free = true;
+    sparse_solver_options.number_of_requested_eigenpairs = 2;
+    hubbard_solver.solve(sparse_solver_options);
+    fci_solver.solve(sparse_solver_options);
+
+    for (size_t i = 0; i < 2; i++) {
+        auto fci_energy = fci_solver.get_eigenpair(i).get_eigenvalue();
+        auto hubbard_energy = hubbard_solver.get_eigenpair(i).get_eigenvalue();
+
+        BOOST_CHECK(std::abs(fci_energy - (hubbard_energy)) < 1.0e-06);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE ( sparse_Hamiltonian ) {
+
+    // Check if the sparse Hubbard Hamiltonian is equal to the dense one
+    size_t K = 4;
+    auto H = GQCP::HoppingMatrix::Random(K);
+    auto ham_par = GQCP::HamiltonianParameters<double>::Hubbard(H);
+
+    GQCP::ProductFockSpace fock_space (K, 2, 2);
+    GQCP::Hubbard hubbard (fock_space);
+
+    GQCP::SquareMatrix<double> dense_hamiltonian = hubbard.constructHamiltonian(ham_par);
+    GQCP::SquareMatrix<double> sparse_hamiltonian = GQCP::MatrixX<double>(hubbard.constructSparseHamiltonian(ham_par));
+
+    BOOST_CHECK(sparse_hamiltonian.isApprox(dense_hamiltonian, 1.0e-12));
+}
@@ -0,0 +1,185 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "BitString"
+#include <boost/test/unit_test.hpp>
+#include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
+
+
+#include "FockSpace/BitString.hpp"
+
+
+
+BOOST_AUTO_TEST_CASE ( BitString_constructor ) {
+
+    GQCP::BitString<2> zero;
+    BOOST_CHECK(zero.none());
+
+    GQCP::BitString<2> bitstring (19);  // "010011"
+    BOOST_CHECK_EQUAL(bitstring.get_words()[0], 19);
+    BOOST_CHECK_EQUAL(bitstring.get_words()[1], 0);
+    BOOST_CHECK_EQUAL(bitstring.count(), 3);
+}
+
+
+BOOST_AUTO_TEST_CASE ( set_reset_isSet ) {
+
+    GQCP::BitString<2> bitstring;
+    bitstring.set(3);
+    bitstring.set(64);
+    bitstring.set(127);
+
+    BOOST_CHECK(bitstring.isSet(3));
+    BOOST_CHECK(bitstring.isSet(64));
+    BOOST_CHECK(bitstring.isSet(127));
+    BOOST_CHECK(!bitstring.isSet(63));
+    BOOST_CHECK_EQUAL(bitstring.count(), 3);
+    BOOST_CHECK_EQUAL(bitstring.get_words()[1], 1UL + (1UL << 63));
+
+    bitstring.reset(64);
+    BOOST_CHECK(!bitstring.isSet(64));
+    BOOST_CHECK_EQUAL(bitstring.count(), 2);
+}
+
+
+BOOST_AUTO_TEST_CASE ( countBefore_countTrailingZeros ) {
+
+    GQCP::BitString<3> bitstring;
+    bitstring.set(5);
+    bitstring.set(70);
+    bitstring.set(130);
+
+    BOOST_CHECK_EQUAL(bitstring.countBefore(0), 0);
+    BOOST_CHECK_EQUAL(bitstring.countBefore(6), 1);
+    BOOST_CHECK_EQUAL(bitstring.countBefore(64), 1);
+    BOOST_CHECK_EQUAL(bitstring.countBefore(70), 1);
+    BOOST_CHECK_EQUAL(bitstring.countBefore(71), 2);
+    BOOST_CHECK_EQUAL(bitstring.countBefore(128), 2);
+    BOOST_CHECK_EQUAL(bitstring.countBefore(191), 3);
+
+    BOOST_CHECK_EQUAL(bitstring.countTrailingZeros(), 5);
+    bitstring.resetLeastSignificantBit();
+    BOOST_CHECK_EQUAL(bitstring.countTrailingZeros(), 70);
+    bitstring.resetLeastSignificantBit();
+    BOOST_CHECK_EQUAL(bitstring.countTrailingZeros(), 130);
+    bitstring.resetLeastSignificantBit();
+    BOOST_CHECK(bitstring.none());
+    BOOST_CHECK_THROW(bitstring.countTrailingZeros(), std::logic_error);
+}
+
+
+BOOST_AUTO_TEST_CASE ( bitwise_operators ) {
+
+    GQCP::BitString<2> a;
+    a.set(1);
+    a.set(65);
+
+    GQCP::BitString<2> b;
+    b.set(1);
+    b.set(100);
+
+    BOOST_CHECK_EQUAL((a ^ b).count(), 2);
+    BOOST_CHECK((a ^ b).isSet(65) && (a ^ b).isSet(100));
+    BOOST_CHECK_EQUAL((a & b).count(), 1);
+    BOOST_CHECK((a & b).isSet(1));
+    BOOST_CHECK_EQUAL((a | b).count(), 3);
+
+    BOOST_CHECK(a == a);
+    BOOST_CHECK(a != b);
+}
+
+
+BOOST_AUTO_TEST_CASE ( shifts ) {
+
+    GQCP::BitString<2> bitstring;
+    bitstring.set(0);
+    bitstring.set(63);
+
+    auto left = bitstring << 1;  // crosses the word boundary
+    BOOST_CHECK(left.isSet(1));
+    BOOST_CHECK(left.isSet(64));
+    BOOST_CHECK_EQUAL(left.count(), 2);
+
+    auto far_left = bitstring << 65;  // the most significant bit is shifted out
+    BOOST_CHECK(far_left.isSet(65));
+    BOOST_CHECK_EQUAL(far_left.count(), 1);
+
+    BOOST_CHECK(((bitstring << 70) >> 70) == GQCP::BitString<2>(1UL));
+    BOOST_CHECK((left >> 1) == bitstring);
+}
+
+
+BOOST_AUTO_TEST_CASE ( LowestBits_asUnsigned ) {
+
+    BOOST_CHECK(GQCP::BitString<2>::LowestBits(0).none());
+    BOOST_CHECK(GQCP::BitString<2>::LowestBits(3) == GQCP::BitString<2>(7UL));
+    BOOST_CHECK_EQUAL(GQCP::BitString<2>::LowestBits(64).get_words()[0], ~0UL);
+    BOOST_CHECK_EQUAL(GQCP::BitString<2>::LowestBits(64).get_words()[1], 0);
+    BOOST_CHECK_EQUAL(GQCP::BitString<2>::LowestBits(70).count(), 70);
+    BOOST_CHECK_EQUAL(GQCP::BitString<2>::LowestBits(128).count(), 128);
+
+    BOOST_CHECK_EQUAL(GQCP::BitString<2>(19UL).asUnsigned(), 19);
+    BOOST_CHECK_THROW(GQCP::BitString<2>::LowestBits(65).asUnsigned(), std::overflow_error);
+}
+
+
+BOOST_AUTO_TEST_CASE ( comparison_hash ) {
+
+    GQCP::BitString<2> small (1UL << 63);
+    GQCP::BitString<2> large;
+    large.set(64);
+
+    BOOST_CHECK(small < large);
+    BOOST_CHECK(!(large < small));
+    BOOST_CHECK(!(small < small));
+
+    BOOST_CHECK_EQUAL(small.hash(), GQCP::BitString<2>(1UL << 63).hash());
+    BOOST_CHECK(small.hash() != large.hash());
+}
+
+
+BOOST_AUTO_TEST_CASE ( nextPermutation ) {
+
+    // Within a single word, the permutations are the usual ones
+    BOOST_CHECK(GQCP::BitString<1>(3UL).nextPermutation() == GQCP::BitString<1>(5UL));  // 011 -> 101
+    BOOST_CHECK(GQCP::BitString<1>(5UL).nextPermutation() == GQCP::BitString<1>(6UL));  // 101 -> 110
+    BOOST_CHECK(GQCP::BitString<1>(6UL).nextPermutation() == GQCP::BitString<1>(9UL));  // 0110 -> 1001
+
+    // A run of set bits crosses the word boundary
+    GQCP::BitString<2> bitstring;
+    bitstring.set(61);
+    bitstring.set(62);
+    bitstring.set(63);
+
+    GQCP::BitString<2> next = bitstring.nextPermutation();  // the highest bit of the run {61, 62, 63} moves up to 64 and the others drop down
+    BOOST_CHECK_EQUAL(next.count(), 3);
+    BOOST_CHECK(next.isSet(0) && next.isSet(1) && next.isSet(64));
+
+    // Going through all permutations of 2 set bits in 100 bits gives every combination exactly once
+    GQCP::BitString<2> permutation (3UL);
+    size_t number_of_permutations = 1;
+    while (!(permutation.isSet(98) && permutation.isSet(99))) {
+        GQCP::BitString<2> previous = permutation;
+        permutation = permutation.nextPermutation();
+        BOOST_CHECK(previous < permutation);
+        number_of_permutations++;
+    }
+    BOOST_CHECK_EQUAL(number_of_permutations, 4950);
+
+    // The next permutation of the largest bitstring doesn't fit
+    BOOST_CHECK_THROW(GQCP::BitString<1>(1UL << 63).nextPermutation(), std::overflow_error);
+}
@@ -299,3 +299,60 @@ BOOST_AUTO_TEST_CASE ( FockSpace_setNext ) {
     x3 << 1, 2, 3;
     BOOST_CHECK(x3.isApprox(onv.get_occupation_indices()));
 }
+
+
+
+BOOST_AUTO_TEST_CASE ( FockSpace_large_K ) {
+
+    // For K > 64, the ONVs need a multi-word representation, whose width is set through the ONV_WIDTH CMake option
+    if (GQCP::ONVRepresentation::number_of_bits < 100) {
+        BOOST_CHECK_THROW(GQCP::FockSpace (100, 2), std::invalid_argument);
+        return;
+    }
+
+    GQCP::FockSpace fock_space (100, 2);
+    const size_t dimension_fock_space = 4950;
+
+    // Iterate through the Fock space in reverse lexicographical order and check the addresses and the representations
+    GQCP::ONV onv = fock_space.makeONV(0);
+    BOOST_CHECK_EQUAL(onv.get_unsigned_representation(), 3);  // "0...011"
+
+    bool is_correct = true;  // variable that is updated to false if an unexpected result occurs
+    for (size_t I = 0; I < dimension_fock_space; I++) {
+
+        if ((fock_space.getAddress(onv) != I) || (fock_space.calculateRepresentation(I) != onv.get_representation())) {
+            is_correct = false;
+        }
+
+        if (I < dimension_fock_space - 1) {
+            fock_space.setNextONV(onv);
+        }
+    }
+    BOOST_CHECK(is_correct);
+
+    // The last ONV should have the two highest orbitals occupied
+    BOOST_CHECK_EQUAL(onv.get_occupation_index(0), 98);
+    BOOST_CHECK_EQUAL(onv.get_occupation_index(1), 99);
+}
+
+
+BOOST_AUTO_TEST_CASE ( FockSpace_getAddresses ) {
+
+    GQCP::FockSpace fock_space (15, 5);
+    const size_t dim = fock_space.get_dimension();
+
+    // Collect all representations, in reverse order to make sure the addresses don't just follow the input
+    std::vector<GQCP::ONVRepresentation> representations (dim);
+    for (size_t I = 0; I < dim; I++) {
+        representations[dim - 1 - I] = fock_space.calculateRepresentation(I);
+    }
+
+    GQCP::Vectoru addresses = fock_space.getAddresses(representations);
+    BOOST_REQUIRE_EQUAL(addresses.size(), dim);
+    for (size_t i = 0; i < dim; i++) {
+        BOOST_CHECK_EQUAL(addresses[i], dim - 1 - i);
+        BOOST_CHECK_EQUAL(addresses[i], fock_space.getAddress(representations[i]));
+    }
+
+    BOOST_CHECK(fock_space.getAddresses(std::vector<GQCP::ONVRepresentation>()).empty());
+}
@@ -70,7 +70,7 @@ BOOST_AUTO_TEST_CASE ( coupling_count ) {
 }
 
 
-BOOST_AUTO_TEST_CASE ( ulongNextPermutation_getAddress_calculateRepresentation ) {
+BOOST_AUTO_TEST_CASE ( nextPermutation_getAddress_calculateRepresentation ) {
 
     size_t K = 5;
     size_t N = 3;
@@ -81,10 +81,10 @@ BOOST_AUTO_TEST_CASE ( ulongNextPermutation_getAddress_calculateRepresentation )
     // "00111", "01011", "01101", "10011", "10101", "11001"
     size_t bit_frozen_fock_space[6] = {7, 11, 13, 19, 21, 25};
 
-    size_t bit_onv = bit_frozen_fock_space[0];
+    GQCP::ONVRepresentation bit_onv = bit_frozen_fock_space[0];
     BOOST_CHECK(frozen_fock_space.getAddress(bit_onv) == 0);
     for (size_t i = 1; i < frozen_fock_space.get_dimension(); i++) {
-        bit_onv = frozen_fock_space.ulongNextPermutation(bit_onv);
+        bit_onv = frozen_fock_space.nextPermutation(bit_onv);
         BOOST_CHECK(bit_onv == bit_frozen_fock_space[i]);
         BOOST_CHECK(frozen_fock_space.getAddress(bit_onv) == i);
         BOOST_CHECK(frozen_fock_space.calculateRepresentation(i) == bit_onv);
@@ -489,3 +489,107 @@ BOOST_AUTO_TEST_CASE ( findMatchingOccupations ) {
     BOOST_TEST(onv2.findMatchingOccupations(onv3) == (std::vector<size_t> {1,4}), boost::test_tools::per_element());
     BOOST_TEST(onv3.findMatchingOccupations(onv2) == (std::vector<size_t> {1,4}), boost::test_tools::per_element());
 }
+
+
+BOOST_AUTO_TEST_CASE ( analyzeExcitation ) {
+
+    GQCP::ONV onv1 (5, 3, 21);  // "10101" (21)
+    GQCP::ONV onv2 (5, 3, 22);  // "10110" (22)
+    GQCP::ONV onv3 (5, 3, 26);  // "11010" (26)
+    GQCP::ONV onv4 (6, 3, 56);  // "111000" (56)
+    GQCP::ONV onv5 (6, 3, 7);  // "000111" (7)
+
+    // No excitation
+    auto excitation11 = onv1.analyzeExcitation(onv1);
+    BOOST_CHECK_EQUAL(excitation11.degree, 0);
+    BOOST_CHECK_EQUAL(excitation11.sign, 1);
+
+    // Single and double excitations: compare with the vector-based methods and the operator phase factors
+    std::vector<std::pair<GQCP::ONV, GQCP::ONV>> pairs {{onv1, onv2}, {onv2, onv1}, {onv1, onv3}, {onv3, onv1}, {onv2, onv3}, {onv3, onv2}};
+    for (const auto& pair : pairs) {
+        const auto& bra = pair.first;
+        const auto& ket = pair.second;
+        auto excitation = bra.analyzeExcitation(ket);
+
+        auto holes = bra.findDifferentOccupations(ket);
+        auto particles = ket.findDifferentOccupations(bra);
+        BOOST_REQUIRE_EQUAL(excitation.degree, holes.size());
+
+        int sign = 1;
+        for (size_t i = 0; i < excitation.degree; i++) {
+            BOOST_CHECK_EQUAL(excitation.holes[i], holes[i]);
+            BOOST_CHECK_EQUAL(excitation.particles[i], particles[i]);
+            sign *= bra.operatorPhaseFactor(holes[i]) * ket.operatorPhaseFactor(particles[i]);
+        }
+        BOOST_CHECK_EQUAL(excitation.sign, sign);
+    }
+
+    // A triple excitation only yields the excitation degree
+    BOOST_CHECK_EQUAL(onv4.analyzeExcitation(onv5).degree, 3);
+}
+
+
+BOOST_AUTO_TEST_CASE ( ONV_large_K ) {
+
+    // Bits beyond the 32nd should be handled correctly
+    GQCP::ONV onv (64, 2, (1UL << 40) + (1UL << 63));
+    BOOST_CHECK(onv.isOccupied(40));
+    BOOST_CHECK(onv.isOccupied(63));
+    BOOST_CHECK(!onv.isOccupied(33));
+
+    BOOST_CHECK(onv.annihilate(40));
+    BOOST_CHECK(onv.create(50));
+    BOOST_CHECK_EQUAL(onv.get_unsigned_representation(), (1UL << 50) + (1UL << 63));
+    BOOST_CHECK_EQUAL(onv.slice(0, 64), onv.get_unsigned_representation());
+    BOOST_CHECK_EQUAL(onv.slice(50, 64), 1UL + (1UL << 13));
+
+    // The representation cannot hold more orbitals than its width
+    BOOST_CHECK_THROW(GQCP::ONV (GQCP::ONVRepresentation::number_of_bits + 1, 2), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE ( ONV_multiword ) {
+
+    // For K > 64, the representation of an ONV spans multiple words, whose number is set through the ONV_WIDTH CMake option
+    if (GQCP::ONVRepresentation::number_of_bits < 100) {
+        BOOST_CHECK_THROW(GQCP::ONV (100, 3), std::invalid_argument);
+        return;
+    }
+
+    GQCP::ONVRepresentation representation;
+    representation.set(1);
+    representation.set(64);
+    representation.set(99);
+    GQCP::ONV onv (100, 3, representation);
+
+    BOOST_CHECK_EQUAL(onv.get_occupation_index(0), 1);
+    BOOST_CHECK_EQUAL(onv.get_occupation_index(1), 64);
+    BOOST_CHECK_EQUAL(onv.get_occupation_index(2), 99);
+    BOOST_CHECK_THROW(onv.get_unsigned_representation(), std::overflow_error);
+    BOOST_CHECK_EQUAL(onv.asString(), "1" + std::string(34, '0') + "1" + std::string(62, '0') + "10");
+
+    BOOST_CHECK_EQUAL(onv.operatorPhaseFactor(64), -1);  // one electron in front
+    BOOST_CHECK_EQUAL(onv.operatorPhaseFactor(99), 1);  // two electrons in front
+    BOOST_CHECK_EQUAL(onv.slice(64, 100), 1UL + (1UL << 35));
+
+    // Excite across the word boundary: 64 -> 70 and 1 -> 80
+    GQCP::ONV other = onv;
+    int sign = 1;
+    BOOST_CHECK(other.annihilate(64, sign));
+    BOOST_CHECK(other.create(70, sign));
+    BOOST_CHECK(other.annihilate(1, sign));
+    BOOST_CHECK(other.create(80, sign));
+    other.updateOccupationIndices();
+
+    BOOST_CHECK_EQUAL(onv.countNumberOfDifferences(other), 4);
+    BOOST_CHECK(onv.findDifferentOccupations(other) == std::vector<size_t>({1, 64}));
+    BOOST_CHECK(other.findDifferentOccupations(onv) == std::vector<size_t>({70, 80}));
+    BOOST_CHECK(onv.findMatchingOccupations(other) == std::vector<size_t>({99}));
+
+    auto excitation = onv.analyzeExcitation(other);
+    BOOST_CHECK_EQUAL(excitation.degree, 2);
+    BOOST_CHECK_EQUAL(excitation.holes[0], 1);
+    BOOST_CHECK_EQUAL(excitation.holes[1], 64);
+    BOOST_CHECK_EQUAL(excitation.particles[0], 70);
+    BOOST_CHECK_EQUAL(excitation.particles[1], 80);
+}
@@ -123,3 +123,133 @@ BOOST_AUTO_TEST_CASE ( reader_test ) {
     BOOST_CHECK(beta2_test == beta2_ref);
 
 }
+
+
+BOOST_AUTO_TEST_CASE ( addConfiguration_duplicates ) {
+
+    GQCP::SelectedFockSpace fock_space (3, 1, 1);
+
+    BOOST_CHECK_EQUAL(fock_space.addConfiguration("001", "010"), 0);
+    BOOST_CHECK_EQUAL(fock_space.addConfiguration("010", "001"), 1);
+
+    // Adding a configuration that is already present shouldn't change the Fock space
+    BOOST_CHECK_EQUAL(fock_space.addConfiguration("001", "010"), 0);
+    BOOST_CHECK_EQUAL(fock_space.get_dimension(), 2);
+
+    std::vector<std::string> alpha_set = {"001", "100", "100"};
+    std::vector<std::string> beta_set = {"010", "100", "100"};
+    fock_space.addConfiguration(alpha_set, beta_set);
+    BOOST_CHECK_EQUAL(fock_space.get_dimension(), 3);
+}
+
+
+BOOST_AUTO_TEST_CASE ( findAddress ) {
+
+    // Check if the addresses of a selected Fock space generated from a product Fock space are those of the product Fock space
+    GQCP::ProductFockSpace product_fock_space (6, 3, 2);
+    GQCP::SelectedFockSpace fock_space (product_fock_space);
+
+    for (size_t I = 0; I < fock_space.get_dimension(); I++) {
+        const auto& configuration = fock_space.get_configuration(I);
+        BOOST_CHECK_EQUAL(fock_space.findAddress(configuration), I);
+        BOOST_CHECK(fock_space.contains(configuration));
+    }
+
+    // A configuration that isn't present can't be found
+    GQCP::SelectedFockSpace small_fock_space (3, 1, 1);
+    small_fock_space.addConfiguration("001", "010");
+    BOOST_CHECK_EQUAL(small_fock_space.findAddress(4, 1), GQCP::SelectedFockSpace::not_found);
+    BOOST_CHECK_EQUAL(small_fock_space.findAddress(1, 2), 0);
+}
+
+
+BOOST_AUTO_TEST_CASE ( sort ) {
+
+    GQCP::SelectedFockSpace fock_space (3, 1, 1);
+    std::vector<std::string> alpha_set = {"100", "001", "100", "010"};
+    std::vector<std::string> beta_set = {"001", "100", "010", "010"};
+    fock_space.addConfiguration(alpha_set, beta_set);
+
+    fock_space.sort();
+
+    // The configurations should be sorted by alpha, then beta representation, and the addresses should be updated
+    std::vector<std::pair<size_t, size_t>> ref_representations = {{1, 4}, {2, 2}, {4, 1}, {4, 2}};
+    for (size_t I = 0; I < fock_space.get_dimension(); I++) {
+        const auto& configuration = fock_space.get_configuration(I);
+        BOOST_CHECK_EQUAL(configuration.onv_alpha.get_unsigned_representation(), ref_representations[I].first);
+        BOOST_CHECK_EQUAL(configuration.onv_beta.get_unsigned_representation(), ref_representations[I].second);
+        BOOST_CHECK_EQUAL(fock_space.findAddress(configuration), I);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE ( calculateConnections ) {
+
+    // Check the connections against a pairwise comparison of all configurations, for a selected Fock space that doesn't contain every configuration
+    GQCP::ProductFockSpace product_fock_space (6, 3, 2);
+    GQCP::SelectedFockSpace full_fock_space (product_fock_space);
+    GQCP::SelectedFockSpace fock_space (6, 3, 2);
+    for (size_t I = 0; I < full_fock_space.get_dimension(); I += 3) {
+        fock_space.addConfiguration(full_fock_space.get_configuration(I));
+    }
+
+    auto connections = fock_space.calculateConnections();
+    BOOST_REQUIRE_EQUAL(connections.size(), fock_space.get_dimension());
+
+    for (size_t I = 0; I < fock_space.get_dimension(); I++) {
+        const auto& configuration_I = fock_space.get_configuration(I);
+
+        std::vector<size_t> ref_connections_I;
+        for (size_t J = I+1; J < fock_space.get_dimension(); J++) {
+            const auto& configuration_J = fock_space.get_configuration(J);
+
+            size_t number_of_differences = configuration_I.onv_alpha.countNumberOfDifferences(configuration_J.onv_alpha) + configuration_I.onv_beta.countNumberOfDifferences(configuration_J.onv_beta);
+            if (number_of_differences <= 4) {
+                ref_connections_I.push_back(J);
+            }
+        }
+
+        BOOST_CHECK(connections[I] == ref_connections_I);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE ( SelectedFockSpace_large_K ) {
+
+    // For K > 64, the ONVs need a multi-word representation, whose width is set through the ONV_WIDTH CMake option
+    if (GQCP::ONVRepresentation::number_of_bits < 100) {
+        BOOST_CHECK_THROW(GQCP::SelectedFockSpace (100, 2, 1), std::invalid_argument);
+        return;
+    }
+
+    // Make the string of an ONV in 100 spatial orbitals, in which the most significant bit comes first
+    const auto make_string = [] (const std::vector<size_t>& occupied_orbitals) {
+        std::string onv_string (100, '0');
+        for (size_t p : occupied_orbitals) {
+            onv_string[99 - p] = '1';
+        }
+        return onv_string;
+    };
+
+    GQCP::SelectedFockSpace fock_space (100, 2, 1);
+    fock_space.addConfiguration(make_string({0, 70}), make_string({99}));
+    fock_space.addConfiguration(make_string({0, 71}), make_string({99}));  // single excitation from the first
+    fock_space.addConfiguration(make_string({1, 71}), make_string({98}));  // single excitation from the second, triple from the first
+    fock_space.addConfiguration(make_string({65, 66}), make_string({0}));  // not connected to any other configuration
+    BOOST_REQUIRE_EQUAL(fock_space.get_dimension(), 4);
+
+    const auto& configuration = fock_space.get_configuration(0);
+    BOOST_CHECK(configuration.onv_alpha.isOccupied(70));
+    BOOST_CHECK(configuration.onv_beta.isOccupied(99));
+
+    for (size_t I = 0; I < fock_space.get_dimension(); I++) {
+        BOOST_CHECK_EQUAL(fock_space.findAddress(fock_space.get_configuration(I)), I);
+    }
+
+    auto connections = fock_space.calculateConnections();
+    BOOST_REQUIRE_EQUAL(connections.size(), 4);
+    BOOST_CHECK(connections[0] == std::vector<size_t>({1}));
+    BOOST_CHECK(connections[1] == std::vector<size_t>({2}));
+    BOOST_CHECK(connections[2].empty());
+    BOOST_CHECK(connections[3].empty());
+}
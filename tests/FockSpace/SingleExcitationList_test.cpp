@@ -0,0 +1,178 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "SingleExcitationList"
+#include <boost/test/unit_test.hpp>
+#include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
+
+
+#include "FockSpace/SingleExcitationList.hpp"
+
+#include "FockSpace/FockSpace.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+
+
+BOOST_AUTO_TEST_CASE ( SingleExcitationList_constructor ) {
+
+    GQCP::FockSpace fock_space (6, 3);
+    GQCP::SingleExcitationList single_excitations (fock_space);
+
+    // Every ONV has N * (K - N + 1) single excitations, including the N excitations E_pp
+    BOOST_CHECK_EQUAL(single_excitations.get_dimension(), 20);
+    BOOST_CHECK_EQUAL(single_excitations.get_excitations().size(), 20 * 3 * 4);
+    BOOST_CHECK_EQUAL(single_excitations.get_offsets()[20], 20 * 3 * 4);
+    BOOST_CHECK_EQUAL(single_excitations.get_K(), 6);
+    BOOST_CHECK_EQUAL(single_excitations.get_N(), 3);
+
+    BOOST_CHECK_EQUAL(GQCP::SingleExcitationList::calculateMemoryRequirement(6, 3), 20 * 3 * 4 * sizeof(GQCP::SingleExcitation) + 21 * sizeof(size_t));
+}
+
+
+BOOST_AUTO_TEST_CASE ( SingleExcitationList_ONV ) {
+
+    // Check every single excitation with the annihilation and creation operators on the ONVs
+    GQCP::FockSpace fock_space (8, 3);
+    GQCP::SingleExcitationList single_excitations (fock_space);
+
+    bool is_correct = true;  // variable that is updated to false if an unexpected result occurs
+    for (size_t I = 0; I < fock_space.get_dimension(); I++) {
+        GQCP::ONV onv = fock_space.makeONV(I);
+
+        size_t count = 0;
+        for (const GQCP::SingleExcitation* excitation = single_excitations.begin(I); excitation != single_excitations.end(I); excitation++) {
+            GQCP::ONV excited_onv = onv;
+            int sign = 1;
+            if (!excited_onv.annihilate(excitation->get_q(), sign) || !excited_onv.create(excitation->get_p(), sign)) {
+                is_correct = false;
+                continue;
+            }
+
+            if ((fock_space.getAddress(excited_onv) != excitation->get_J()) || (sign != excitation->get_sign())) {
+                is_correct = false;
+            }
+            count++;
+        }
+
+        if (count != 3 * 6) {
+            is_correct = false;
+        }
+    }
+    BOOST_CHECK(is_correct);
+}
+
+
+BOOST_AUTO_TEST_CASE ( FockSpace_get_single_excitations ) {
+
+    GQCP::FockSpace fock_space (5, 2);
+
+    // The list is only generated once, and is shared with copies that are made afterwards
+    auto single_excitations = fock_space.get_single_excitations();
+    BOOST_CHECK(single_excitations == fock_space.get_single_excitations());
+
+    GQCP::FockSpace fock_space_copy = fock_space;
+    BOOST_CHECK(single_excitations == fock_space_copy.get_single_excitations());
+
+    BOOST_CHECK_EQUAL(single_excitations->get_excitations().size(), 10 * 2 * 4);
+}
+
+
+BOOST_AUTO_TEST_CASE ( SingleExcitation_packing ) {
+
+    BOOST_CHECK_EQUAL(sizeof(GQCP::SingleExcitation), 8);
+
+    GQCP::SingleExcitation excitation (255, 3, GQCP::SingleExcitation::max_address, -1);
+    BOOST_CHECK_EQUAL(excitation.get_p(), 255);
+    BOOST_CHECK_EQUAL(excitation.get_q(), 3);
+    BOOST_CHECK_EQUAL(excitation.get_J(), GQCP::SingleExcitation::max_address);
+    BOOST_CHECK_EQUAL(excitation.get_sign(), -1);
+
+    GQCP::SingleExcitation diagonal_excitation (0, 0, 0, 1);
+    BOOST_CHECK_EQUAL(diagonal_excitation.get_p(), 0);
+    BOOST_CHECK_EQUAL(diagonal_excitation.get_q(), 0);
+    BOOST_CHECK_EQUAL(diagonal_excitation.get_J(), 0);
+    BOOST_CHECK_EQUAL(diagonal_excitation.get_sign(), 1);
+}
+
+
+BOOST_AUTO_TEST_CASE ( FockSpace_get_single_excitations_threads ) {
+
+    GQCP::FockSpace fock_space (8, 4);
+
+    // When the list is asked for from several threads at once, all of them should get the same list
+    std::vector<std::shared_ptr<const GQCP::SingleExcitationList>> single_excitations (4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; t++) {
+        threads.emplace_back([&fock_space, &single_excitations, t] () { single_excitations[t] = fock_space.get_single_excitations(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t t = 0; t < 4; t++) {
+        BOOST_CHECK(single_excitations[t] == fock_space.get_single_excitations());
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE ( writeBinary_ReadBinary ) {
+
+    GQCP::FockSpace fock_space (7, 3);
+    GQCP::SingleExcitationList single_excitations (fock_space);
+
+    // Check if the single excitations survive a round trip through a binary file
+    single_excitations.writeBinary("single_excitations_7_3.bin");
+    auto single_excitations_read = GQCP::SingleExcitationList::ReadBinary("single_excitations_7_3.bin");
+
+    BOOST_CHECK_EQUAL(single_excitations_read.get_K(), 7);
+    BOOST_CHECK_EQUAL(single_excitations_read.get_N(), 3);
+    BOOST_CHECK(single_excitations_read.get_offsets() == single_excitations.get_offsets());
+    BOOST_REQUIRE_EQUAL(single_excitations_read.get_excitations().size(), single_excitations.get_excitations().size());
+    BOOST_CHECK(std::memcmp(single_excitations_read.get_excitations().data(), single_excitations.get_excitations().data(), single_excitations.get_excitations().size() * sizeof(GQCP::SingleExcitation)) == 0);
+
+
+    // Check if a header that doesn't match the size of the file throws, before anything is allocated for it
+    std::string contents;
+    {
+        std::ifstream input_file_stream ("single_excitations_7_3.bin", std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(input_file_stream), std::istreambuf_iterator<char>());
+    }
+
+    const size_t N_offset = 24;  // after the magic number, the version and K
+    for (std::uint64_t N : {std::uint64_t(2), std::uint64_t(8), std::uint64_t(1) << 40}) {
+        std::string faulty_contents = contents;
+        std::memcpy(&faulty_contents[N_offset], &N, sizeof(N));
+        std::ofstream("single_excitations_faulty.bin", std::ios::binary) << faulty_contents;
+
+        BOOST_CHECK_THROW(GQCP::SingleExcitationList::ReadBinary("single_excitations_faulty.bin"), std::invalid_argument);
+    }
+
+    // Check if a truncated file and a file with another magic number throw
+    std::ofstream("single_excitations_faulty.bin", std::ios::binary) << contents.substr(0, contents.size() - 8);
+    BOOST_CHECK_THROW(GQCP::SingleExcitationList::ReadBinary("single_excitations_faulty.bin"), std::invalid_argument);
+
+    std::ofstream("single_excitations_faulty.bin", std::ios::binary) << "GQCPFCID" << contents.substr(8);
+    BOOST_CHECK_THROW(GQCP::SingleExcitationList::ReadBinary("single_excitations_faulty.bin"), std::invalid_argument);
+
+    std::remove("single_excitations_7_3.bin");
+    std::remove("single_excitations_faulty.bin");
+}
@@ -25,6 +25,7 @@
 #include "HamiltonianBuilder/DOCI.hpp"
 #include "HamiltonianParameters/HamiltonianParameters.hpp"
 #include "RHF/PlainRHFSCFSolver.hpp"
+#include "utilities/parallel.hpp"
 
 
 BOOST_AUTO_TEST_CASE ( DOCI_constructor ) {
@@ -57,3 +58,72 @@ BOOST_AUTO_TEST_CASE ( DOCI_public_methods ) {
     BOOST_CHECK_THROW(random_doci_invalid.constructHamiltonian(random_hamiltonian_parameters), std::invalid_argument);
     BOOST_CHECK_THROW(random_doci_invalid.matrixVectorProduct(random_hamiltonian_parameters, x, x), std::invalid_argument);
 }
+
+
+BOOST_AUTO_TEST_CASE ( DOCI_blockMatrixVectorProduct ) {
+
+    size_t K = 6;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::FockSpace fock_space (K, 3);
+    GQCP::DOCI builder (fock_space);
+
+    // Check if the block matrix-vector product gives the same result as the action of the full Hamiltonian on every vector
+    auto H = builder.constructHamiltonian(ham_par);
+    auto diagonal = builder.calculateDiagonal(ham_par);
+    GQCP::MatrixX<double> X = GQCP::MatrixX<double>::Random(fock_space.get_dimension(), 3);
+
+    GQCP::MatrixX<double> matvecs = builder.blockMatrixVectorProduct(ham_par, X, diagonal);
+    BOOST_CHECK(matvecs.isApprox(H * X, 1.0e-12));
+
+    for (size_t k = 0; k < 3; k++) {
+        GQCP::VectorX<double> x = X.col(k);
+        BOOST_CHECK(matvecs.col(k).isApprox(builder.matrixVectorProduct(ham_par, x, diagonal), 1.0e-12));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE ( DOCI_threads ) {
+
+    size_t K = 8;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::FockSpace fock_space (K, 4);  // dim = 70
+    GQCP::DOCI builder (fock_space);
+
+    // Check if the diagonal and the (block) matrix-vector products don't depend on the number of threads
+    GQCP::setNumberOfThreads(1);
+    auto H = builder.constructHamiltonian(ham_par);
+    GQCP::MatrixX<double> X = GQCP::MatrixX<double>::Random(fock_space.get_dimension(), 2);
+    GQCP::VectorX<double> x = X.col(0);
+
+    for (size_t number_of_threads : {1, 2, 3, 8}) {
+        GQCP::setNumberOfThreads(number_of_threads);
+
+        auto diagonal = builder.calculateDiagonal(ham_par);
+        BOOST_CHECK(diagonal.isApprox(H.diagonal(), 1.0e-12));
+        BOOST_CHECK(builder.matrixVectorProduct(ham_par, x, diagonal).isApprox(H * x, 1.0e-12));
+        BOOST_CHECK(builder.blockMatrixVectorProduct(ham_par, X, diagonal).isApprox(H * X, 1.0e-12));
+    }
+
+    GQCP::setNumberOfThreads(0);  // restore the default
+}
+
+
+BOOST_AUTO_TEST_CASE ( DOCI_constructSparseHamiltonian ) {
+
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::FockSpace fock_space (K, 2);
+    GQCP::DOCI builder (fock_space);
+
+    // Check if the sparse representations, which are assembled from the evaluated elements, reproduce the dense Hamiltonian
+    auto H = builder.constructHamiltonian(ham_par);
+    GQCP::SquareMatrix<double> H_sparse = GQCP::MatrixX<double>(builder.constructSparseHamiltonian(ham_par));
+    BOOST_CHECK(H_sparse.isApprox(H, 1.0e-12));
+
+    auto H_symmetric = builder.constructSymmetricSparseHamiltonian(ham_par);
+    for (size_t I = 0; I < fock_space.get_dimension(); I++) {
+        for (size_t J = 0; J < fock_space.get_dimension(); J++) {
+            BOOST_CHECK(std::abs(H_symmetric(I,J) - H(I,J)) < 1.0e-12);
+        }
+    }
+}
@@ -24,6 +24,7 @@
 #include "HamiltonianBuilder/FCI.hpp"
 
 #include "HamiltonianParameters/HamiltonianParameters.hpp"
+#include "utilities/parallel.hpp"
 
 
 
@@ -57,3 +58,80 @@ BOOST_AUTO_TEST_CASE ( FCI_public_methods ) {
     BOOST_CHECK_THROW(random_fci_invalid.constructHamiltonian(random_hamiltonian_parameters), std::invalid_argument);
     BOOST_CHECK_THROW(random_fci_invalid.matrixVectorProduct(random_hamiltonian_parameters, x, x), std::invalid_argument);
 }
+
+
+BOOST_AUTO_TEST_CASE ( FCI_prepare ) {
+
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::ProductFockSpace fock_space (K, 3, 2);
+    GQCP::FCI fci (fock_space);
+
+    auto H = fci.constructHamiltonian(ham_par);
+    auto diagonal = fci.calculateDiagonal(ham_par);
+    GQCP::VectorX<double> x = GQCP::VectorX<double>::Random(fock_space.get_dimension());
+    GQCP::MatrixX<double> X = GQCP::MatrixX<double>::Random(fock_space.get_dimension(), 3);
+
+    // Check if the prepared operator gives the same (block) matrix-vector products as the full Hamiltonian
+    auto prepared_fci = fci.prepare(ham_par);
+    BOOST_CHECK(prepared_fci->matrixVectorProduct(x, diagonal).isApprox(H * x, 1.0e-12));
+    BOOST_CHECK(prepared_fci->blockMatrixVectorProduct(X, diagonal).isApprox(H * X, 1.0e-12));
+    BOOST_CHECK(fci.matrixVectorProduct(ham_par, x, diagonal).isApprox(H * x, 1.0e-12));
+    BOOST_CHECK(fci.blockMatrixVectorProduct(ham_par, X, diagonal).isApprox(H * X, 1.0e-12));
+
+    // Check if unmodified Hamiltonian parameters re-use the prepared intermediates, also after copying
+    auto ham_par_copy = ham_par;
+    BOOST_CHECK(fci.prepare(ham_par) == prepared_fci);
+    BOOST_CHECK(fci.prepare(ham_par_copy) == prepared_fci);
+
+    // Check if modifying the Hamiltonian parameters leads to new intermediates
+    ham_par.rotate(GQCP::JacobiRotationParameters(3, 1, 0.56));
+    auto rotated_fci = fci.prepare(ham_par);
+    BOOST_CHECK(rotated_fci != prepared_fci);
+    BOOST_CHECK(fci.matrixVectorProduct(ham_par, x, fci.calculateDiagonal(ham_par)).isApprox(fci.constructHamiltonian(ham_par) * x, 1.0e-12));
+}
+
+
+BOOST_AUTO_TEST_CASE ( FCI_matrixVectorProduct_threads ) {
+
+    size_t K = 6;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::ProductFockSpace fock_space (K, 3, 2);
+    GQCP::FCI fci (fock_space);
+
+    auto diagonal = fci.calculateDiagonal(ham_par);
+    GQCP::VectorX<double> x = GQCP::VectorX<double>::Random(fock_space.get_dimension());
+
+    // Check if the multithreaded matrix-vector product doesn't depend on the number of threads
+    GQCP::setNumberOfThreads(1);
+    auto matvec_serial = fci.matrixVectorProduct(ham_par, x, diagonal);
+
+    GQCP::setNumberOfThreads(4);
+    auto matvec_parallel = fci.matrixVectorProduct(ham_par, x, diagonal);
+    GQCP::setNumberOfThreads(0);
+
+    BOOST_CHECK(matvec_parallel.isApprox(matvec_serial, 1.0e-12));
+    BOOST_CHECK(matvec_serial.isApprox(fci.constructHamiltonian(ham_par) * x, 1.0e-12));
+}
+
+
+
+BOOST_AUTO_TEST_CASE ( FCI_constructSparseHamiltonian ) {
+
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::ProductFockSpace fock_space (K, 3, 2);
+    GQCP::FCI builder (fock_space);
+
+    // Check if the sparse representations, which are assembled from the evaluated elements, reproduce the dense Hamiltonian
+    auto H = builder.constructHamiltonian(ham_par);
+    GQCP::SquareMatrix<double> H_sparse = GQCP::MatrixX<double>(builder.constructSparseHamiltonian(ham_par));
+    BOOST_CHECK(H_sparse.isApprox(H, 1.0e-12));
+
+    auto H_symmetric = builder.constructSymmetricSparseHamiltonian(ham_par);
+    for (size_t I = 0; I < fock_space.get_dimension(); I++) {
+        for (size_t J = 0; J < fock_space.get_dimension(); J++) {
+            BOOST_CHECK(std::abs(H_symmetric(I,J) - H(I,J)) < 1.0e-12);
+        }
+    }
+}
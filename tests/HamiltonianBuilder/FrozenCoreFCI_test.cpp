@@ -23,6 +23,7 @@
 
 #include "HamiltonianBuilder/FrozenCoreFCI.hpp"
 
+#include "CISolver/CISolver.hpp"
 #include "HamiltonianParameters/HamiltonianParameters.hpp"
 #include "HamiltonianBuilder/SelectedCI.hpp"
 
@@ -90,3 +91,69 @@ BOOST_AUTO_TEST_CASE ( SelectedCI_vs_FrozenCoreFCI ) {
     BOOST_CHECK(sci_matvec.isApprox(fci_matvec));
     BOOST_CHECK(sci_ham.isApprox(fci_ham));
 }
+
+
+BOOST_AUTO_TEST_CASE ( FrozenCoreFCI_blockMatrixVectorProduct ) {
+
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::FrozenProductFockSpace fock_space (K, 3, 3, 1);
+    GQCP::FrozenCoreFCI builder (fock_space);
+
+    // Check if the active builder's block matrix-vector product with the frozen Hamiltonian parameters gives the action of the full frozen core Hamiltonian
+    GQCP::MatrixX<double> X = GQCP::MatrixX<double>::Random(fock_space.get_dimension(), 3);
+    auto H = builder.constructHamiltonian(ham_par);
+    BOOST_CHECK(builder.blockMatrixVectorProduct(ham_par, X, builder.calculateDiagonal(ham_par)).isApprox(H * X, 1.0e-12));
+}
+
+
+BOOST_AUTO_TEST_CASE ( FrozenCoreFCI_sparse ) {
+
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::FrozenProductFockSpace fock_space (K, 3, 3, 1);
+    GQCP::FrozenCoreFCI builder (fock_space);
+
+    // Check if the sparse Hamiltonian matrix includes the frozen core correction on its diagonal
+    GQCP::SquareMatrix<double> dense_hamiltonian = builder.constructHamiltonian(ham_par);
+    GQCP::SquareMatrix<double> sparse_hamiltonian = GQCP::MatrixX<double>(builder.constructSparseHamiltonian(ham_par));
+    BOOST_CHECK(sparse_hamiltonian.isApprox(dense_hamiltonian, 1.0e-12));
+
+
+    // Check if the sparse solver, which preassembles the sparse Hamiltonian by default, finds the lowest eigenvalue
+    GQCP::CISolver dense_ci_solver (builder, ham_par);
+    GQCP::DenseSolverOptions dense_solver_options;
+    dense_ci_solver.solve(dense_solver_options);
+
+    GQCP::CISolver sparse_ci_solver (builder, ham_par);
+    GQCP::SparseSolverOptions sparse_solver_options;
+    sparse_ci_solver.solve(sparse_solver_options);
+
+    BOOST_CHECK(std::abs(sparse_ci_solver.get_eigenpair().get_eigenvalue() - dense_ci_solver.get_eigenpair().get_eigenvalue()) < 1.0e-06);
+}
+
+
+BOOST_AUTO_TEST_CASE ( FrozenCoreFCI_prepareFrozenHamiltonianParameters ) {
+
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::FrozenProductFockSpace fock_space (K, 3, 3, 1);
+    GQCP::FrozenCoreFCI builder (fock_space);
+
+    // The frozen Hamiltonian parameters should be re-used for the same (or copied) Hamiltonian parameters
+    auto frozen_ham_par = builder.prepareFrozenHamiltonianParameters(ham_par);
+    auto ham_par_copy = ham_par;
+    BOOST_CHECK(builder.prepareFrozenHamiltonianParameters(ham_par) == frozen_ham_par);
+    BOOST_CHECK(builder.prepareFrozenHamiltonianParameters(ham_par_copy) == frozen_ham_par);
+    BOOST_CHECK(frozen_ham_par->get_h().isApprox(builder.freezeHamiltonianParameters(ham_par, 1).get_h(), 1.0e-12));
+
+    // After a rotation, the frozen Hamiltonian parameters should be recalculated
+    ham_par.rotate(GQCP::JacobiRotationParameters(4, 2, 56.81));
+    auto rotated_frozen_ham_par = builder.prepareFrozenHamiltonianParameters(ham_par);
+    BOOST_CHECK(rotated_frozen_ham_par != frozen_ham_par);
+    BOOST_CHECK(rotated_frozen_ham_par->get_h().isApprox(builder.freezeHamiltonianParameters(ham_par, 1).get_h(), 1.0e-12));
+
+    // The frozen core energy is the contribution of the frozen orbitals to every diagonal element
+    double frozen_core_energy = builder.calculateFrozenCoreEnergy(ham_par, 1);
+    BOOST_CHECK(builder.calculateFrozenCoreDiagonal(ham_par, 1).isApprox(frozen_core_energy * GQCP::VectorX<double>::Ones(fock_space.get_dimension()), 1.0e-12));
+}
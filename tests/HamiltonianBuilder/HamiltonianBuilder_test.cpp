@@ -0,0 +1,93 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "HamiltonianBuilder"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
+
+
+#include "HamiltonianBuilder/HamiltonianBuilder.hpp"
+
+#include "FockSpace/FockSpace.hpp"
+
+
+/**
+ *  A HamiltonianBuilder that only implements the pure virtual methods, using a given Hamiltonian matrix, so that the default implementations of the base class can be tested
+ */
+class DenseHamiltonianBuilder : public GQCP::HamiltonianBuilder {
+private:
+    GQCP::FockSpace fock_space;
+    GQCP::SquareMatrix<double> H;
+
+public:
+    DenseHamiltonianBuilder(const GQCP::FockSpace& fock_space, const GQCP::SquareMatrix<double>& H) :
+        fock_space (fock_space),
+        H (H)
+    {}
+
+    const GQCP::BaseFockSpace* get_fock_space() const override { return &this->fock_space; }
+
+    GQCP::SquareMatrix<double> constructHamiltonian(const GQCP::HamiltonianParameters<double>&) const override { return this->H; }
+    GQCP::VectorX<double> matrixVectorProduct(const GQCP::HamiltonianParameters<double>&, const GQCP::VectorX<double>& x, const GQCP::VectorX<double>&) const override { return this->H * x; }
+    GQCP::VectorX<double> calculateDiagonal(const GQCP::HamiltonianParameters<double>&) const override { return this->H.diagonal(); }
+};
+
+
+BOOST_AUTO_TEST_CASE ( default_blockMatrixVectorProduct ) {
+
+    GQCP::FockSpace fock_space (5, 2);  // dim = 10
+    GQCP::SquareMatrix<double> H = GQCP::SquareMatrix<double>::Random(10, 10);
+    H = (H + H.transpose()).eval();
+
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(5);
+    DenseHamiltonianBuilder builder (fock_space, H);
+    auto diagonal = builder.calculateDiagonal(ham_par);
+
+
+    // Check if the block matrix-vector product gives the action of the Hamiltonian on every vector, i.e. the matrix-vector product of every column
+    GQCP::MatrixX<double> X = GQCP::MatrixX<double>::Random(10, 3);
+    GQCP::MatrixX<double> matvecs = builder.blockMatrixVectorProduct(ham_par, X, diagonal);
+    BOOST_REQUIRE_EQUAL(matvecs.rows(), 10);
+    BOOST_REQUIRE_EQUAL(matvecs.cols(), 3);
+    BOOST_CHECK(matvecs.isApprox(H * X, 1.0e-12));
+
+    for (size_t k = 0; k < 3; k++) {
+        GQCP::VectorX<double> x = X.col(k);
+        BOOST_CHECK(matvecs.col(k).isApprox(builder.matrixVectorProduct(ham_par, x, diagonal), 1.0e-12));
+    }
+
+
+    // Check the edge cases of a single vector and no vectors at all
+    GQCP::MatrixX<double> x = GQCP::MatrixX<double>::Random(10, 1);
+    BOOST_CHECK(builder.blockMatrixVectorProduct(ham_par, x, diagonal).isApprox(H * x, 1.0e-12));
+
+    GQCP::MatrixX<double> no_vectors (10, 0);
+    BOOST_CHECK_EQUAL(builder.blockMatrixVectorProduct(ham_par, no_vectors, diagonal).cols(), 0);
+}
+
+
+BOOST_AUTO_TEST_CASE ( default_constructSparseHamiltonian ) {
+
+    GQCP::FockSpace fock_space (5, 2);
+    DenseHamiltonianBuilder builder (fock_space, GQCP::SquareMatrix<double>::Identity(10, 10));
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(5);
+
+    // The default implementations don't convert the dense Hamiltonian matrix
+    BOOST_CHECK_THROW(builder.constructSparseHamiltonian(ham_par), std::runtime_error);
+    BOOST_CHECK_THROW(builder.constructSymmetricSparseHamiltonian(ham_par), std::runtime_error);
+}
@@ -149,3 +149,39 @@ BOOST_AUTO_TEST_CASE ( test_Hubbard_vs_FCI_large_matvec ) {
     GQCP::VectorX<double> fci_matvec = fci.matrixVectorProduct(mol_ham_par, fci_diagonal, fci_diagonal);
     BOOST_CHECK(hubbard_matvec.isApprox(fci_matvec));
 }
+
+
+BOOST_AUTO_TEST_CASE ( Hubbard_blockMatrixVectorProduct ) {
+
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Hubbard(GQCP::HoppingMatrix::Random(K));
+    GQCP::ProductFockSpace fock_space (K, 3, 2);
+    GQCP::Hubbard builder (fock_space);
+
+    // Check if passing every coupling to all vectors at once gives the action of the full Hamiltonian
+    GQCP::MatrixX<double> X = GQCP::MatrixX<double>::Random(fock_space.get_dimension(), 3);
+    auto H = builder.constructHamiltonian(ham_par);
+    BOOST_CHECK(builder.blockMatrixVectorProduct(ham_par, X, builder.calculateDiagonal(ham_par)).isApprox(H * X, 1.0e-12));
+}
+
+
+BOOST_AUTO_TEST_CASE ( Hubbard_constructSymmetricSparseHamiltonian ) {
+
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Hubbard(GQCP::HoppingMatrix::Random(K));
+    GQCP::ProductFockSpace fock_space (K, 3, 2);
+    GQCP::Hubbard builder (fock_space);
+
+    // Check if the sparse Hamiltonian, of which only the upper half is stored, reproduces the dense Hamiltonian and its matrix-vector products
+    auto H = builder.constructHamiltonian(ham_par);
+    auto H_symmetric = builder.constructSymmetricSparseHamiltonian(ham_par);
+
+    for (size_t I = 0; I < fock_space.get_dimension(); I++) {
+        for (size_t J = 0; J < fock_space.get_dimension(); J++) {
+            BOOST_CHECK(std::abs(H_symmetric(I,J) - H(I,J)) < 1.0e-12);
+        }
+    }
+
+    GQCP::VectorX<double> x = fock_space.randomExpansion();
+    BOOST_CHECK(H_symmetric.matrixVectorProduct(x).isApprox(H * x, 1.0e-12));
+}
@@ -121,3 +121,57 @@ BOOST_AUTO_TEST_CASE ( SelectedCI_vs_DOCI ) {
     BOOST_CHECK(selected_ci_matvec.isApprox(doci_matvec));
     BOOST_CHECK(selected_ci_hamiltonian.isApprox(doci_hamiltonian));
 }
+
+
+BOOST_AUTO_TEST_CASE ( SelectedCI_blockMatrixVectorProduct ) {
+
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::ProductFockSpace product_fock_space (K, 3, 2);
+    GQCP::SelectedFockSpace fock_space (product_fock_space);
+    GQCP::SelectedCI builder (fock_space);
+
+    // Check if passing every Hamiltonian element to all vectors at once gives the action of the full Hamiltonian
+    GQCP::MatrixX<double> X = GQCP::MatrixX<double>::Random(fock_space.get_dimension(), 3);
+    auto H = builder.constructHamiltonian(ham_par);
+    BOOST_CHECK(builder.blockMatrixVectorProduct(ham_par, X, builder.calculateDiagonal(ham_par)).isApprox(H * X, 1.0e-12));
+}
+
+
+BOOST_AUTO_TEST_CASE ( SelectedCI_constructSparseHamiltonian ) {
+
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::ProductFockSpace product_fock_space (K, 3, 2);
+    GQCP::SelectedFockSpace fock_space (product_fock_space);
+    GQCP::SelectedCI builder (fock_space);
+
+    // Check if the sparse Hamiltonian is equal to the dense one
+    GQCP::SquareMatrix<double> H_dense = builder.constructHamiltonian(ham_par);
+    GQCP::SquareMatrix<double> H_sparse = GQCP::MatrixX<double>(builder.constructSparseHamiltonian(ham_par));
+
+    BOOST_CHECK(H_sparse.isApprox(H_dense, 1.0e-12));
+}
+
+
+BOOST_AUTO_TEST_CASE ( SelectedCI_constructSymmetricSparseHamiltonian ) {
+
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    GQCP::ProductFockSpace product_fock_space (K, 3, 2);
+    GQCP::SelectedFockSpace fock_space (product_fock_space);
+    GQCP::SelectedCI builder (fock_space);
+
+    // Check if the sparse Hamiltonian, of which only the upper half is stored, reproduces the dense Hamiltonian and its matrix-vector products
+    GQCP::SquareMatrix<double> H_dense = builder.constructHamiltonian(ham_par);
+    auto H_symmetric = builder.constructSymmetricSparseHamiltonian(ham_par);
+
+    for (size_t I = 0; I < fock_space.get_dimension(); I++) {
+        for (size_t J = 0; J < fock_space.get_dimension(); J++) {
+            BOOST_CHECK(std::abs(H_symmetric(I,J) - H_dense(I,J)) < 1.0e-12);
+        }
+    }
+
+    GQCP::MatrixX<double> X = GQCP::MatrixX<double>::Random(fock_space.get_dimension(), 3);
+    BOOST_CHECK(H_symmetric.blockMatrixVectorProduct(X).isApprox(H_dense * X, 1.0e-12));
+}
@@ -0,0 +1,158 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "FCIDUMP"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
+
+#include "HamiltonianParameters/FCIDUMP.hpp"
+#include "HamiltonianParameters/HamiltonianParameters.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+
+BOOST_AUTO_TEST_CASE ( ReadText_header ) {
+
+    // The header of this FCIDUMP file ends with '&END'
+    auto fcidump = GQCP::FCIDUMP::ReadText("data/beh_cation_631g_caitlin.FCIDUMP");
+    BOOST_CHECK_EQUAL(fcidump.get_K(), 16);
+    BOOST_CHECK_EQUAL(fcidump.get_N(), 4);
+    BOOST_CHECK_EQUAL(fcidump.get_MS2(), 0);
+    BOOST_CHECK(std::abs(fcidump.get_core_energy() - 1.5900757460937498e+00) < 1.0e-12);
+
+    // The header of this FCIDUMP file ends with '/', and has multiple orbital symmetries
+    auto fcidump_h2o = GQCP::FCIDUMP::ReadText("data/h2o_sto3g_klaas.FCIDUMP");
+    std::vector<size_t> ref_orbital_symmetries {1, 1, 1, 1, 2, 3, 3};
+    BOOST_CHECK_EQUAL(fcidump_h2o.get_K(), 7);
+    BOOST_CHECK_EQUAL(fcidump_h2o.get_N(), 10);
+    BOOST_CHECK(fcidump_h2o.get_orbital_symmetries() == ref_orbital_symmetries);
+}
+
+
+BOOST_AUTO_TEST_CASE ( ReadText_integrals ) {
+
+    auto fcidump = GQCP::FCIDUMP::ReadText("data/beh_cation_631g_caitlin.FCIDUMP");
+
+    // Check if the integrals are read in correctly from a previous implementation
+    auto h = fcidump.get_h();
+    BOOST_CHECK(std::abs(h(0,0) - (-8.34082)) < 1.0e-5);
+    BOOST_CHECK(std::abs(h(5,1) - 0.381418) < 1.0e-6);
+    BOOST_CHECK(std::abs(h(1,5) - 0.381418) < 1.0e-6);
+
+    auto g = fcidump.calculateTwoElectronIntegrals();
+    BOOST_CHECK(std::abs(g(2,5,4,4) - 0.0139645) < 1.0e-6);
+    BOOST_CHECK(std::abs(g(3,1,3,0) - (-0.0141251)) <  1.0e-6);
+    BOOST_CHECK(std::abs(g(7,7,2,1) - (-0.031278)) < 1.0e-6);
+    BOOST_CHECK(std::abs(g(13,15,15,13) - 0.00766898) < 1.0e-7);
+
+
+    // Check if the unfolded integrals have the permutational symmetries of real integrals
+    size_t K = fcidump.get_K();
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    BOOST_REQUIRE(g(p,q,r,s) == g(q,p,s,r));
+                    BOOST_REQUIRE(g(p,q,r,s) == g(r,s,p,q));
+                }
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE ( ReadText_throws ) {
+
+    BOOST_CHECK_THROW(GQCP::FCIDUMP::ReadText("data/this_file_does_not_exist.FCIDUMP"), std::runtime_error);
+    BOOST_CHECK_THROW(GQCP::FCIDUMP::ReadText("data/h2o.xyz"), std::invalid_argument);  // no FCIDUMP header
+}
+
+
+BOOST_AUTO_TEST_CASE ( binary_round_trip ) {
+
+    auto fcidump = GQCP::FCIDUMP::ReadText("data/h2o_631g_klaas.FCIDUMP");
+    fcidump.writeBinary("h2o_631g_klaas.bin");
+
+    auto fcidump_binary = GQCP::FCIDUMP::ReadBinary("h2o_631g_klaas.bin");
+    std::remove("h2o_631g_klaas.bin");
+
+    BOOST_CHECK_EQUAL(fcidump_binary.get_K(), fcidump.get_K());
+    BOOST_CHECK_EQUAL(fcidump_binary.get_N(), fcidump.get_N());
+    BOOST_CHECK_EQUAL(fcidump_binary.get_MS2(), fcidump.get_MS2());
+    BOOST_CHECK(fcidump_binary.get_orbital_symmetries() == fcidump.get_orbital_symmetries());
+    BOOST_CHECK(fcidump_binary.get_core_energy() == fcidump.get_core_energy());
+    BOOST_CHECK(fcidump_binary.get_h().isApprox(fcidump.get_h(), 1.0e-16));
+    BOOST_CHECK(fcidump_binary.get_unique_two_electron_integrals() == fcidump.get_unique_two_electron_integrals());
+
+
+    // Check if the Hamiltonian parameters from the binary file are the same as those from the text file
+    auto ham_par = GQCP::HamiltonianParameters<double>::ReadFCIDUMP("data/h2o_631g_klaas.FCIDUMP");
+    auto ham_par_binary = GQCP::HamiltonianParameters<double>::FromFCIDUMP(fcidump_binary);
+
+    BOOST_CHECK(ham_par_binary.get_h().isApprox(ham_par.get_h(), 1.0e-16));
+    BOOST_CHECK(ham_par_binary.get_g().isApprox(ham_par.get_g(), 1.0e-16));
+    BOOST_CHECK(ham_par_binary.get_scalar() == ham_par.get_scalar());
+}
+
+
+BOOST_AUTO_TEST_CASE ( ReadBinary_throws ) {
+
+    BOOST_CHECK_THROW(GQCP::FCIDUMP::ReadBinary("data/this_file_does_not_exist.bin"), std::runtime_error);
+    BOOST_CHECK_THROW(GQCP::FCIDUMP::ReadBinary("data/h2o_sto3g_klaas.FCIDUMP"), std::invalid_argument);  // a text file
+
+
+    // Check if a number of orbitals in the header that doesn't match the size of the file throws, before anything is allocated for it
+    GQCP::FCIDUMP::ReadText("data/h2o_sto3g_klaas.FCIDUMP").writeBinary("h2o_sto3g_klaas.bin");
+    std::string contents;
+    {
+        std::ifstream input_file_stream ("h2o_sto3g_klaas.bin", std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(input_file_stream), std::istreambuf_iterator<char>());
+    }
+
+    const size_t K_offset = 16;  // after the magic number and the version
+    for (std::uint64_t K : {std::uint64_t(6), std::uint64_t(8), std::uint64_t(1) << 40, ~std::uint64_t(0)}) {
+        std::string faulty_contents = contents;
+        std::memcpy(&faulty_contents[K_offset], &K, sizeof(K));
+        std::ofstream("h2o_sto3g_klaas_faulty.bin", std::ios::binary) << faulty_contents;
+
+        BOOST_CHECK_THROW(GQCP::FCIDUMP::ReadBinary("h2o_sto3g_klaas_faulty.bin"), std::invalid_argument);
+    }
+
+    // Check if a truncated file throws
+    std::ofstream("h2o_sto3g_klaas_faulty.bin", std::ios::binary) << contents.substr(0, contents.size() - 8);
+    BOOST_CHECK_THROW(GQCP::FCIDUMP::ReadBinary("h2o_sto3g_klaas_faulty.bin"), std::invalid_argument);
+
+    std::remove("h2o_sto3g_klaas.bin");
+    std::remove("h2o_sto3g_klaas_faulty.bin");
+}
+
+
+BOOST_AUTO_TEST_CASE ( constructor_from_g ) {
+
+    // Packing the integrals of Hamiltonian parameters and unfolding them again should give the same integrals
+    auto ham_par = GQCP::HamiltonianParameters<double>::ReadFCIDUMP("data/h2o_sto3g_klaas.FCIDUMP");
+    size_t K = ham_par.get_K();
+
+    GQCP::FCIDUMP fcidump (10, 0, std::vector<size_t>(K, 1), ham_par.get_scalar(), ham_par.get_h(), ham_par.get_g());
+    BOOST_CHECK(fcidump.calculateTwoElectronIntegrals().isApprox(ham_par.get_g(), 1.0e-16));
+
+    BOOST_CHECK_THROW(GQCP::FCIDUMP (10, 0, std::vector<size_t>(K + 1, 1), 0.0, ham_par.get_h(), ham_par.get_g()), std::invalid_argument);  // wrong number of orbital symmetries
+}
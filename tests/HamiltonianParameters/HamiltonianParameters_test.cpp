@@ -192,6 +192,63 @@ BOOST_AUTO_TEST_CASE ( rotate_overlap_matrix ) {
 }
 
 
+BOOST_AUTO_TEST_CASE ( revision ) {
+
+    size_t K = 4;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    auto revision = ham_par.get_revision();
+
+    // Other Hamiltonian parameters should have another revision, while a copy should keep it
+    auto ham_par_other = GQCP::HamiltonianParameters<double>::Random(K);
+    auto ham_par_copy = ham_par;
+    BOOST_CHECK(ham_par_other.get_revision() != revision);
+    BOOST_CHECK(ham_par_copy.get_revision() == revision);
+
+    // Every modification should lead to a new revision
+    ham_par.rotate(GQCP::JacobiRotationParameters(2, 1, 0.56));
+    BOOST_CHECK(ham_par.get_revision() != revision);
+    revision = ham_par.get_revision();
+
+    ham_par.transform(GQCP::SquareMatrix<double>(GQCP::SquareMatrix<double>::Identity(K, K)));
+    BOOST_CHECK(ham_par.get_revision() != revision);
+    BOOST_CHECK(ham_par_copy.get_revision() != ham_par.get_revision());
+}
+
+
+BOOST_AUTO_TEST_CASE ( pair_integrals ) {
+
+    size_t K = 4;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    const auto& g = ham_par.get_g();
+
+    // Check the values of the pair integrals
+    auto pair_integrals = ham_par.get_pair_integrals();
+    BOOST_CHECK(pair_integrals->get_K() == K);
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            BOOST_CHECK(std::abs(pair_integrals->get_coulomb()(p,q) - g(p,p,q,q)) < 1.0e-12);
+            BOOST_CHECK(std::abs(pair_integrals->get_exchange()(p,q) - g(p,q,q,p)) < 1.0e-12);
+            BOOST_CHECK(std::abs(pair_integrals->get_pair_hopping()(p,q) - g(p,q,p,q)) < 1.0e-12);
+        }
+    }
+
+    // The pair integrals should be calculated only once, and copies should share them
+    auto ham_par_copy = ham_par;
+    BOOST_CHECK(ham_par.get_pair_integrals() == pair_integrals);
+    BOOST_CHECK(ham_par_copy.get_pair_integrals() == pair_integrals);
+
+    // After a modification, the pair integrals should be recalculated
+    ham_par.rotate(GQCP::JacobiRotationParameters(2, 1, 0.56));
+    auto rotated_pair_integrals = ham_par.get_pair_integrals();
+    BOOST_CHECK(rotated_pair_integrals != pair_integrals);
+    BOOST_CHECK(std::abs(rotated_pair_integrals->get_pair_hopping()(1,2) - ham_par.get_g()(1,2,1,2)) < 1.0e-12);
+    BOOST_CHECK(ham_par_copy.get_pair_integrals() == pair_integrals);  // the copy has not been modified
+
+    ham_par.transform(GQCP::SquareMatrix<double>(GQCP::SquareMatrix<double>::Identity(K, K)));
+    BOOST_CHECK(ham_par.get_pair_integrals() != rotated_pair_integrals);
+}
+
+
 BOOST_AUTO_TEST_CASE ( constructor_C ) {
 
     // Create dummy Hamiltonian parameters
@@ -412,6 +469,27 @@ BOOST_AUTO_TEST_CASE ( calculate_generalized_Fock_matrix_and_super ) {
 }
 
 
+BOOST_AUTO_TEST_CASE ( calculate_generalized_Fock_matrix_and_super_seniority_zero ) {
+
+    // Check if the (super-)generalized Fock matrix for a compact seniority-zero 2-RDM matches the one for its expansion
+    size_t K = 4;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+
+    auto d = GQCP::SeniorityZeroTwoRDM<double>::Random(K);
+    GQCP::OneRDM<double> D = d.reduce();
+
+    auto F_ref = ham_par.calculateGeneralizedFockMatrix(D, d.expand());
+    BOOST_CHECK(ham_par.calculateGeneralizedFockMatrix(D, d).isApprox(F_ref, 1.0e-12));
+
+    auto W_ref = ham_par.calculateSuperGeneralizedFockMatrix(D, d.expand());
+    BOOST_CHECK(ham_par.calculateSuperGeneralizedFockMatrix(D, d).isApprox(W_ref, 1.0e-12));
+
+    // Check the dimension checks
+    GQCP::SeniorityZeroTwoRDM<double> d_faulty (GQCP::SquareMatrix<double>::Zero(K+1, K+1), GQCP::SquareMatrix<double>::Zero(K+1, K+1));
+    BOOST_CHECK_THROW(ham_par.calculateGeneralizedFockMatrix(D, d_faulty), std::invalid_argument);
+}
+
+
 BOOST_AUTO_TEST_CASE ( calculateEdmistonRuedenbergLocalizationIndex ) {
 
     // Create toy Hamiltonian parameters: only the two-electron integrals are important
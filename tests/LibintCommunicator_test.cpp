@@ -21,8 +21,10 @@
 #include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
 
 #include "LibintCommunicator.hpp"
+#include "RHF/RHF.hpp"
 
 #include "utilities/linalg.hpp"
+#include "utilities/parallel.hpp"
 
 
 BOOST_AUTO_TEST_CASE ( atoms_interface ) {
@@ -146,3 +148,152 @@ BOOST_AUTO_TEST_CASE( HORTON_integrals_h2o_sto3g ) {
     BOOST_CHECK(V.isApprox(ref_V, 1.0e-08));
     BOOST_CHECK(g.isApprox(ref_g, 1.0e-06));
 }
+
+
+BOOST_AUTO_TEST_CASE ( Schwarz_screening_h2o_sto3g ) {
+
+    // Set up a basis
+    auto water = GQCP::Molecule::Readxyz("data/h2o.xyz");
+    GQCP::AOBasis basis (water, "STO-3G");
+    auto nbf = basis.get_number_of_basis_functions();
+
+
+    // Calculate the two-electron integrals without and with Cauchy-Schwarz screening
+    auto g_unscreened = GQCP::LibintCommunicator::get().calculateCoulombRepulsionIntegrals(basis, 0.0);
+    auto g_screened = GQCP::LibintCommunicator::get().calculateCoulombRepulsionIntegrals(basis, 1.0e-08);
+
+    GQCP::TwoElectronOperator<double> ref_g = GQCP::TwoElectronOperator<double>::FromFile("data/h2o_sto-3g_coulomb_horton.data", nbf);
+    BOOST_CHECK(g_unscreened.isApprox(ref_g, 1.0e-06));
+    BOOST_CHECK(g_screened.isApprox(g_unscreened, 1.0e-08));
+
+
+    // Check if the unfolded integrals have the 8-fold permutational symmetry
+    for (size_t p = 0; p < nbf; p++) {
+        for (size_t q = 0; q < nbf; q++) {
+            for (size_t r = 0; r < nbf; r++) {
+                for (size_t s = 0; s < nbf; s++) {
+                    BOOST_CHECK(std::abs(g_unscreened(p,q,r,s) - g_unscreened(q,p,s,r)) < 1.0e-12);
+                    BOOST_CHECK(std::abs(g_unscreened(p,q,r,s) - g_unscreened(r,s,p,q)) < 1.0e-12);
+                }
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE ( integrals_threads_h2o_sto3g ) {
+
+    // Set up a basis
+    auto water = GQCP::Molecule::Readxyz("data/h2o.xyz");
+    GQCP::AOBasis basis (water, "STO-3G");
+
+
+    // Check if the integrals don't depend on the number of threads
+    GQCP::setNumberOfThreads(1);
+    auto S_serial = GQCP::LibintCommunicator::get().calculateOverlapIntegrals(basis);
+    auto dipole_serial = GQCP::LibintCommunicator::get().calculateDipoleIntegrals(basis);
+    auto g_serial = GQCP::LibintCommunicator::get().calculateCoulombRepulsionIntegrals(basis);
+
+    GQCP::setNumberOfThreads(4);
+    auto S_parallel = GQCP::LibintCommunicator::get().calculateOverlapIntegrals(basis);
+    auto dipole_parallel = GQCP::LibintCommunicator::get().calculateDipoleIntegrals(basis);
+    auto g_parallel = GQCP::LibintCommunicator::get().calculateCoulombRepulsionIntegrals(basis);
+    GQCP::setNumberOfThreads(0);
+
+    BOOST_CHECK(S_parallel.isApprox(S_serial, 1.0e-12));
+    for (size_t i = 0; i < 3; i++) {
+        BOOST_CHECK(dipole_parallel[i].isApprox(dipole_serial[i], 1.0e-12));
+    }
+    BOOST_CHECK(g_parallel.isApprox(g_serial, 1.0e-12));
+}
+
+
+BOOST_AUTO_TEST_CASE ( direct_RHF_Fock_matrix_h2o_sto3g ) {
+
+    // Set up a basis and a symmetric density matrix
+    auto water = GQCP::Molecule::Readxyz("data/h2o.xyz");
+    GQCP::AOBasis basis (water, "STO-3G");
+    auto nbf = basis.get_number_of_basis_functions();
+
+    GQCP::OneRDM<double> D = GQCP::OneRDM<double>::Random(nbf, nbf);
+    D = GQCP::OneRDM<double>(D + D.transpose());
+
+
+    // Check if the direct contraction of the shell quartets gives the same result as the contraction with the stored integrals
+    auto g = GQCP::LibintCommunicator::get().calculateCoulombRepulsionIntegrals(basis, 0.0);
+    auto G_ref = GQCP::calculateRHFAOTwoElectronFockMatrix(D, g);
+
+    auto schwarz_bounds = GQCP::LibintCommunicator::get().calculateCoulombRepulsionSchwarzBounds(basis);
+    auto G_direct = GQCP::LibintCommunicator::get().calculateRHFTwoElectronFockMatrix(basis, D, schwarz_bounds, 0.0);
+    BOOST_CHECK(G_direct.isApprox(G_ref, 1.0e-10));
+
+    auto G_screened = GQCP::LibintCommunicator::get().calculateRHFTwoElectronFockMatrix(basis, D, schwarz_bounds, 1.0e-10);
+    BOOST_CHECK(G_screened.isApprox(G_ref, 1.0e-08));
+
+
+    // Check if wrong dimensions throw
+    GQCP::OneRDM<double> D_wrong = GQCP::OneRDM<double>::Zero(nbf + 1, nbf + 1);
+    BOOST_CHECK_THROW(GQCP::LibintCommunicator::get().calculateRHFTwoElectronFockMatrix(basis, D_wrong, schwarz_bounds), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE ( density_fitted_integrals_h2o_ccpvdz ) {
+
+    auto water = GQCP::Molecule::Readxyz("data/h2o.xyz");
+    GQCP::AOBasis basis (water, "cc-pVDZ");
+    GQCP::AOBasis auxiliary_basis (water, "cc-pVDZ-RI");
+    auto nbf = basis.get_number_of_basis_functions();
+    auto naux = auxiliary_basis.get_number_of_basis_functions();
+
+
+    // Check the dimensions and the symmetry of the two- and three-center integrals
+    auto metric = GQCP::LibintCommunicator::get().calculateCoulombMetric(auxiliary_basis);
+    BOOST_CHECK_EQUAL(metric.get_dim(), naux);
+    BOOST_CHECK(metric.isApprox(metric.transpose(), 1.0e-12));
+
+    auto B = GQCP::LibintCommunicator::get().calculateThreeCenterCoulombRepulsionIntegrals(basis, auxiliary_basis);
+    BOOST_CHECK_EQUAL(B.rows(), nbf * nbf);
+    BOOST_CHECK_EQUAL(B.cols(), naux);
+    BOOST_CHECK(std::abs(B(1 + nbf * 4, 3) - B(4 + nbf * 1, 3)) < 1.0e-12);
+
+
+    // Check if the density-fitted integrals approximate the exact integrals, and so do the RI-J/K Fock matrices
+    auto g = GQCP::LibintCommunicator::get().calculateCoulombRepulsionIntegrals(basis, 0.0);
+    auto g_DF = GQCP::LibintCommunicator::get().calculateDensityFittedCoulombRepulsionIntegrals(basis, auxiliary_basis);
+    BOOST_CHECK(g_DF.toTwoElectronOperator().isApprox(g, 1.0e-02));
+
+    GQCP::OneRDM<double> D = GQCP::OneRDM<double>::Random(nbf, nbf);
+    D = GQCP::OneRDM<double>(D + D.transpose());
+    BOOST_CHECK(GQCP::calculateRHFAOTwoElectronFockMatrix(D, g_DF).isApprox(GQCP::calculateRHFAOTwoElectronFockMatrix(D, g), 1.0e-02));
+}
+
+
+BOOST_AUTO_TEST_CASE ( Cholesky_decomposed_integrals_h2o_631gdp ) {
+
+    auto water = GQCP::Molecule::Readxyz("data/h2o.xyz");
+    GQCP::AOBasis basis (water, "6-31G**");
+    auto nbf = basis.get_number_of_basis_functions();
+
+
+    // Check the diagonal and the columns against the exact integrals
+    auto g = GQCP::LibintCommunicator::get().calculateCoulombRepulsionIntegrals(basis, 0.0);
+
+    auto diagonal = GQCP::LibintCommunicator::get().calculateCoulombRepulsionIntegralsDiagonal(basis);
+    BOOST_CHECK(std::abs(diagonal(2 + nbf * 5) - g(2,5,2,5)) < 1.0e-12);
+    BOOST_CHECK(std::abs(diagonal(5 + nbf * 2) - g(5,2,5,2)) < 1.0e-12);
+
+    auto columns = GQCP::LibintCommunicator::get().calculateCoulombRepulsionIntegralsColumns(basis, 0, 0);  // the first shell contains only the first basis function
+    BOOST_CHECK_EQUAL(columns.cols(), 1);
+    BOOST_CHECK(std::abs(columns(3 + nbf * 1, 0) - g(3,1,0,0)) < 1.0e-12);
+
+
+    // Check that every element of the decomposition is accurate to within the threshold, with a rank that is much smaller than K^2
+    double threshold = 1.0e-06;
+    auto g_chol = GQCP::LibintCommunicator::get().calculateCholeskyDecomposedCoulombRepulsionIntegrals(basis, threshold);
+    BOOST_CHECK(g_chol.get_rank() < nbf * nbf / 2);
+
+    auto g_approx = g_chol.toTwoElectronOperator();
+    Eigen::Map<const Eigen::MatrixXd> V (g.data(), nbf * nbf, nbf * nbf);
+    Eigen::Map<const Eigen::MatrixXd> V_approx (g_approx.data(), nbf * nbf, nbf * nbf);
+    BOOST_CHECK((V - V_approx).lpNorm<Eigen::Infinity>() < threshold);
+}
@@ -0,0 +1,164 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "FactorizedTwoElectronOperator"
+
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
+
+#include "Operator/FactorizedTwoElectronOperator.hpp"
+
+
+BOOST_AUTO_TEST_CASE ( FactorizedTwoElectronOperator_constructor ) {
+
+    // Check a correct constructor
+    GQCP::FactorizedTwoElectronOperator<double> g (3, GQCP::MatrixX<double>::Random(9, 4));
+    BOOST_CHECK_EQUAL(g.get_dim(), 3);
+    BOOST_CHECK_EQUAL(g.get_rank(), 4);
+
+    GQCP::FactorizedTwoElectronOperator<double> g_empty (3);
+    BOOST_CHECK_EQUAL(g_empty.get_rank(), 0);
+
+
+    // Check a faulty constructor
+    BOOST_CHECK_THROW(GQCP::FactorizedTwoElectronOperator<double> g2 (3, GQCP::MatrixX<double>::Random(8, 4)), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE ( FactorizedTwoElectronOperator_elements ) {
+
+    // Check that the elements and the dense representation correspond to g(p q r s) = sum_m L_m(p q) L_m(r s)
+    size_t K = 3;
+    size_t M = 5;
+    GQCP::FactorizedTwoElectronOperator<double> g (K, GQCP::MatrixX<double>::Random(K*K, M));
+    auto g_dense = g.toTwoElectronOperator();
+
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    double ref_value = 0.0;
+                    for (size_t m = 0; m < M; m++) {
+                        ref_value += g.vector(m)(p,q) * g.vector(m)(r,s);
+                    }
+
+                    BOOST_CHECK(std::abs(g(p,q,r,s) - ref_value) < 1.0e-12);
+                    BOOST_CHECK(std::abs(g_dense(p,q,r,s) - ref_value) < 1.0e-12);
+                }
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE ( FactorizedTwoElectronOperator_transform ) {
+
+    // Check that transforming the factorization is equal to transforming the dense two-electron operator, independently of the number of threads
+    size_t K = 4;
+    GQCP::FactorizedTwoElectronOperator<double> g (K, GQCP::MatrixX<double>::Random(K*K, 6));
+    GQCP::SquareMatrix<double> T = GQCP::SquareMatrix<double>::Random(K, K);
+
+    auto g_dense = g.toTwoElectronOperator();
+    g_dense.transform(T);
+
+    for (size_t number_of_threads : {1, 2, 8}) {
+        auto g_transformed = g;
+        g_transformed.transform(T, number_of_threads);
+        BOOST_CHECK(g_transformed.toTwoElectronOperator().isApprox(g_dense, 1.0e-12));
+    }
+
+
+    // Check that an incompatible transformation matrix throws
+    BOOST_CHECK_THROW(g.transform(GQCP::SquareMatrix<double>::Random(K+1, K+1)), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE ( FactorizedTwoElectronOperator_rotate_JacobiRotationParameters ) {
+
+    // Check that a rotation with Jacobi rotation parameters is equal to the rotation of the dense two-electron operator
+    size_t dim = 5;
+    GQCP::FactorizedTwoElectronOperator<double> g (dim, GQCP::MatrixX<double>::Random(dim*dim, 3));
+    auto g_dense = g.toTwoElectronOperator();
+
+    GQCP::JacobiRotationParameters jacobi_rotation_parameters (4, 2, 56.81);
+    g.rotate(jacobi_rotation_parameters);
+    g_dense.rotate(jacobi_rotation_parameters);
+
+    BOOST_CHECK(g.toTwoElectronOperator().isApprox(g_dense, 1.0e-12));
+}
+
+
+BOOST_AUTO_TEST_CASE ( FactorizedTwoElectronOperator_DensityFitted ) {
+
+    // Check that the density-fitted two-electron operator is equal to (mu nu|P) (P|Q)^(-1) (Q|rho lambda)
+    size_t K = 3;
+    size_t N_aux = 6;
+    GQCP::MatrixX<double> B = GQCP::MatrixX<double>::Random(K*K, N_aux);
+    GQCP::MatrixX<double> A = GQCP::MatrixX<double>::Random(N_aux, N_aux);
+    GQCP::SquareMatrix<double> metric = A * A.transpose() + GQCP::MatrixX<double>::Identity(N_aux, N_aux);  // a positive definite metric
+
+    auto g = GQCP::FactorizedTwoElectronOperator<double>::DensityFitted(B, metric);
+    BOOST_CHECK_EQUAL(g.get_dim(), K);
+    BOOST_CHECK_EQUAL(g.get_rank(), N_aux);
+
+    GQCP::MatrixX<double> g_ref = B * metric.inverse() * B.transpose();  // the (pq, rs)-representation
+    GQCP::MatrixX<double> g_matrix = g.get_vectors() * g.get_vectors().transpose();
+    BOOST_CHECK(g_matrix.isApprox(g_ref, 1.0e-10));
+
+
+    // Check the throws for incompatible dimensions and a metric that isn't positive definite
+    BOOST_CHECK_THROW(GQCP::FactorizedTwoElectronOperator<double>::DensityFitted(GQCP::MatrixX<double>::Random(K*K, N_aux+1), metric), std::invalid_argument);
+    BOOST_CHECK_THROW(GQCP::FactorizedTwoElectronOperator<double>::DensityFitted(GQCP::MatrixX<double>::Random(K*K+1, N_aux), metric), std::invalid_argument);
+    BOOST_CHECK_THROW(GQCP::FactorizedTwoElectronOperator<double>::DensityFitted(B, GQCP::SquareMatrix<double>(-metric)), std::runtime_error);
+}
+
+
+BOOST_AUTO_TEST_CASE ( FactorizedTwoElectronOperator_Cholesky ) {
+
+    // Check that the Cholesky decomposition of a low-rank two-electron operator recovers it exactly, with the correct rank
+    size_t K = 4;
+    size_t M = 3;
+    auto g = GQCP::FactorizedTwoElectronOperator<double>(K, GQCP::MatrixX<double>::Random(K*K, M)).toTwoElectronOperator();
+
+    auto g_chol = GQCP::FactorizedTwoElectronOperator<double>::Cholesky(g, 1.0e-12);
+    BOOST_CHECK_EQUAL(g_chol.get_dim(), K);
+    BOOST_CHECK_EQUAL(g_chol.get_rank(), M);
+    BOOST_CHECK(g_chol.toTwoElectronOperator().isApprox(g, 1.0e-10));
+
+
+    // Check that the elements of an incomplete decomposition are accurate to within the threshold
+    auto g_full = GQCP::FactorizedTwoElectronOperator<double>(K, GQCP::MatrixX<double>::Random(K*K, K*K)).toTwoElectronOperator();
+    double threshold = 1.0e-01;
+    auto g_incomplete = GQCP::FactorizedTwoElectronOperator<double>::Cholesky(g_full, threshold);
+    BOOST_CHECK(g_incomplete.get_rank() < K*K);
+
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    BOOST_CHECK(std::abs(g_incomplete(p,q,r,s) - g_full(p,q,r,s)) < threshold);
+                }
+            }
+        }
+    }
+
+
+    // Check the throw for a diagonal whose dimension isn't a square
+    auto column = [] (size_t pq) { return GQCP::VectorX<double>::Zero(5); };
+    BOOST_CHECK_THROW(GQCP::FactorizedTwoElectronOperator<double>::Cholesky(GQCP::VectorX<double>::Ones(5), column), std::invalid_argument);
+}
@@ -82,6 +82,33 @@ BOOST_AUTO_TEST_CASE ( TwoElectronOperator_transform_olsens ) {
 }
 
 
+BOOST_AUTO_TEST_CASE ( TwoElectronOperator_transform_blocked ) {
+
+    // Check the in-place blocked transformation against the tensor contractions, independently of the number of threads
+    // For dim = 33, the rows are split in several blocks of which the last one is partial
+    for (size_t dim : {1, 4, 7, 33}) {
+        GQCP::SquareRankFourTensor<double> g (dim);
+        g.setRandom();
+        GQCP::SquareMatrix<double> T = GQCP::SquareMatrix<double>::Random(dim, dim);
+
+        GQCP::TwoElectronOperator<double> G_ref (g);
+        G_ref.transform<double>(T);  // the explicit template argument selects the tensor contractions
+
+        // The transformed elements grow as dim^2, so the tolerance is relative to that size
+        for (size_t number_of_threads : {1, 2, 3}) {
+            GQCP::TwoElectronOperator<double> G (g);
+            G.transform(T, number_of_threads);
+            BOOST_CHECK(G.isApprox(G_ref, 1.0e-12 * dim * dim));
+        }
+    }
+
+
+    // Check that an incompatible transformation matrix throws
+    GQCP::TwoElectronOperator<double> G (3);
+    BOOST_CHECK_THROW(G.transform(GQCP::SquareMatrix<double>::Identity(4, 4)), std::invalid_argument);
+}
+
+
 BOOST_AUTO_TEST_CASE ( TwoElectronOperator_rotate_throws ) {
 
     // Create a random TwoElectronOperator
@@ -20,11 +20,13 @@
 #include <boost/test/included/unit_test.hpp>
 #include "RDM/RDMCalculator.hpp"
 #include "RDM/DOCIRDMBuilder.hpp"
+#include "RDM/FCIRDMBuilder.hpp"
 
 #include "CISolver/CISolver.hpp"
 #include "HamiltonianBuilder/DOCI.hpp"
 #include "HamiltonianParameters/HamiltonianParameters.hpp"
 #include "properties/expectation_values.hpp"
+#include "utilities/parallel.hpp"
 
 
 
@@ -153,6 +155,69 @@ BOOST_AUTO_TEST_CASE ( lih_energy_RDM_contraction_DOCI ) {
     BOOST_CHECK(std::abs(energy_by_eigenvalue - energy_by_contraction) < 1.0e-12);
 }
 
+BOOST_AUTO_TEST_CASE ( lih_energy_seniority_zero_2RDM ) {
+
+    // Test if the compact seniority-zero 2-RDM gives the DOCI energy, and if its expansion matches the FCI 2-RDM of the same wave function
+    size_t N = 4;  // 4 electrons
+    auto ham_par = GQCP::HamiltonianParameters<double>::ReadFCIDUMP("data/lih_631g_caitlin.FCIDUMP");
+    size_t K = ham_par.get_K();  // 16 SO
+
+    GQCP::FockSpace fock_space (K, N/2);  // dim = 120
+    GQCP::DOCI doci (fock_space);
+
+    GQCP::CISolver ci_solver (doci, ham_par);
+    GQCP::DenseSolverOptions solver_options;
+    ci_solver.solve(solver_options);
+
+    GQCP::VectorX<double> coef = ci_solver.get_eigenpair().get_eigenvector();
+    double energy_by_eigenvalue = ci_solver.get_eigenpair().get_eigenvalue();
+
+    GQCP::DOCIRDMBuilder doci_rdm (fock_space);
+    auto d = doci_rdm.calculateSeniorityZero2RDM(coef);
+    GQCP::OneRDMs<double> one_rdms = doci_rdm.calculate1RDMs(coef);
+
+    double energy_by_contraction = GQCP::calculateExpectationValue(ham_par, one_rdms.one_rdm, d) - ham_par.get_scalar();
+    BOOST_CHECK(std::abs(energy_by_eigenvalue - energy_by_contraction) < 1.0e-12);
+
+    BOOST_CHECK(std::abs(d.trace() - N*(N-1)) < 1.0e-12);
+
+    // In the FCI Fock space, the DOCI wave function only has coefficients for the ONVs whose alpha and beta strings are equal
+    GQCP::ProductFockSpace fci_fock_space (K, N/2, N/2);  // dim = 14400
+    auto dim = fock_space.get_dimension();
+    GQCP::VectorX<double> fci_coef = GQCP::VectorX<double>::Zero(fci_fock_space.get_dimension());
+    for (size_t I = 0; I < dim; I++) {
+        fci_coef(I * dim + I) = coef(I);
+    }
+
+    GQCP::FCIRDMBuilder fci_rdm (fci_fock_space);
+    BOOST_CHECK(d.expand().isApprox(fci_rdm.calculate2RDMs(fci_coef).two_rdm, 1.0e-12));
+}
+
+
+BOOST_AUTO_TEST_CASE ( seniority_zero_2RDM_threads ) {
+
+    // Check if the compact 2-RDM doesn't depend on the number of threads
+    size_t K = 8;
+    size_t N_P = 3;
+    GQCP::FockSpace fock_space (K, N_P);  // dim = 56
+    GQCP::DOCIRDMBuilder doci_rdm (fock_space);
+
+    GQCP::VectorX<double> coef = GQCP::VectorX<double>::Random(fock_space.get_dimension());
+    coef.normalize();
+
+    GQCP::setNumberOfThreads(1);
+    auto d_serial = doci_rdm.calculateSeniorityZero2RDM(coef);
+
+    GQCP::setNumberOfThreads(3);
+    auto d_parallel = doci_rdm.calculateSeniorityZero2RDM(coef);
+    GQCP::setNumberOfThreads(0);
+
+    BOOST_CHECK(d_serial.get_number_block().isApprox(d_parallel.get_number_block(), 1.0e-12));
+    BOOST_CHECK(d_serial.get_pair_block().isApprox(d_parallel.get_pair_block(), 1.0e-12));
+    BOOST_CHECK(std::abs(d_serial.trace() - 2*N_P*(2*N_P-1)) < 1.0e-12);
+}
+
+
 BOOST_AUTO_TEST_CASE ( lih_1RDM_2RDM_trace_DOCI_wavefunction ) {
 
     // Repeat test with wavefunction input
@@ -0,0 +1,68 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "SeniorityZeroTwoRDM"
+
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
+
+#include "RDM/SeniorityZeroTwoRDM.hpp"
+
+
+BOOST_AUTO_TEST_CASE ( SeniorityZeroTwoRDM_constructor ) {
+
+    GQCP::SquareMatrix<double> A = GQCP::SquareMatrix<double>::Zero(3, 3);
+    GQCP::SquareMatrix<double> B = GQCP::SquareMatrix<double>::Zero(4, 4);
+
+    BOOST_CHECK_NO_THROW(GQCP::SeniorityZeroTwoRDM<double> (A, A));
+    BOOST_CHECK_THROW(GQCP::SeniorityZeroTwoRDM<double> (A, B), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE ( expand ) {
+
+    size_t K = 4;
+    auto d = GQCP::SeniorityZeroTwoRDM<double>::Random(K);
+
+    // Check if the element access matches the expansion, and if the spin-summed 2-RDM is the sum of the spin-resolved ones
+    auto d_full = d.expand();
+    auto d_aaaa = d.expandSameSpin();
+    auto d_aabb = d.expandOppositeSpin();
+
+    for (size_t p = 0; p < K; p++) {
+        for (size_t q = 0; q < K; q++) {
+            for (size_t r = 0; r < K; r++) {
+                for (size_t s = 0; s < K; s++) {
+                    BOOST_CHECK(std::abs(d(p,q,r,s) - d_full(p,q,r,s)) < 1.0e-12);
+                    BOOST_CHECK(std::abs(d_full(p,q,r,s) - 2 * (d_aaaa(p,q,r,s) + d_aabb(p,q,r,s))) < 1.0e-12);
+                }
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE ( trace_and_reduce ) {
+
+    size_t K = 5;
+    auto d = GQCP::SeniorityZeroTwoRDM<double>::Random(K);
+    auto d_full = d.expand();
+
+    BOOST_CHECK(std::abs(d.trace() - d_full.trace()) < 1.0e-12);
+    BOOST_CHECK(d.reduce().isApprox(d_full.reduce(), 1.0e-12));
+}
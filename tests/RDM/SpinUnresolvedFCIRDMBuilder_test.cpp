@@ -23,6 +23,8 @@
 
 #include "RDM/SpinUnresolvedFCIRDMBuilder.hpp"
 
+#include "RDM/FCIRDMBuilder.hpp"
+
 
 
 BOOST_AUTO_TEST_CASE ( calculateElement_throws ) {
@@ -101,19 +103,48 @@ BOOST_AUTO_TEST_CASE ( calculateElement_3RDM ) {
 }
 
 
-BOOST_AUTO_TEST_CASE ( throw_1and2_RDMs ) {
+BOOST_AUTO_TEST_CASE ( calculate1RDM_elements ) {
 
     // Create a test wave function
-    size_t M = 5;
-    size_t N = 4;
+    size_t M = 3;
+    size_t N = 1;
     GQCP::FockSpace fock_space (M, N);
 
     GQCP::VectorX<double> coeff (fock_space.get_dimension());
-    coeff << 1, 1, -2, 4, -5;
+    coeff << 1, 2, -3;
+
+
+    // Check the same 1-RDM values as in calculateElement_1RDM
+    GQCP::SpinUnresolvedFCIRDMBuilder d (fock_space);
+    GQCP::OneRDM<double> one_rdm = d.calculate1RDM(coeff);
+    BOOST_CHECK(std::abs(one_rdm(0,0) - 1.0) < 1.0e-12);
+    BOOST_CHECK(std::abs(one_rdm(0,1) - 2.0) < 1.0e-12);
+    BOOST_CHECK(std::abs(one_rdm(2,1) - (-6.0)) < 1.0e-12);
+}
+
+
+BOOST_AUTO_TEST_CASE ( calculate1RDM_and_2RDM ) {
 
+    // Create a test wave function
+    size_t M = 5;
+    size_t N = 3;
+    GQCP::FockSpace fock_space (M, N);
+    GQCP::VectorX<double> coeff = fock_space.randomExpansion();
 
-    // not implemented yet and should throw
     GQCP::SpinUnresolvedFCIRDMBuilder d (fock_space);
-    BOOST_CHECK_THROW(d.calculate1RDM(coeff), std::runtime_error);
-    BOOST_CHECK_THROW(d.calculate2RDM(coeff), std::runtime_error);
+    GQCP::OneRDM<double> one_rdm = d.calculate1RDM(coeff);
+    GQCP::TwoRDM<double> two_rdm = d.calculate2RDM(coeff);
+
+
+    // Without beta electrons, the RDMs should match the alpha RDMs of the FCI RDM builder
+    GQCP::ProductFockSpace product_fock_space (M, N, 0);
+    GQCP::FCIRDMBuilder fci_rdm_builder (product_fock_space);
+    GQCP::OneRDMs<double> one_rdms = fci_rdm_builder.calculate1RDMs(coeff);
+    GQCP::TwoRDMs<double> two_rdms = fci_rdm_builder.calculate2RDMs(coeff);
+
+    BOOST_CHECK(one_rdm.isApprox(one_rdms.one_rdm_aa, 1.0e-12));
+    BOOST_CHECK(two_rdm.isApprox(two_rdms.two_rdm_aaaa, 1.0e-12));
+
+    BOOST_CHECK(std::abs(one_rdm.trace() - N) < 1.0e-12);
+    BOOST_CHECK(std::abs(two_rdm.trace() - N*(N-1)) < 1.0e-12);
 }
@@ -0,0 +1,84 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "DirectRHFSCFSolver"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
+
+#include "RHF/DirectRHFSCFSolver.hpp"
+#include "RHF/PlainRHFSCFSolver.hpp"
+#include "HamiltonianParameters/HamiltonianParameters.hpp"
+
+#include "utilities/linalg.hpp"
+
+
+
+BOOST_AUTO_TEST_CASE ( constructor ) {
+
+    // Check a correct constructor with an even number of electrons
+    auto h2 = GQCP::Molecule::Readxyz("data/h2_szabo.xyz");
+    GQCP::DirectRHFSCFSolver direct_solver (h2, "STO-3G");
+
+    // Check if a faulty constructor with an odd number of electron throws
+    auto h2_ion = GQCP::Molecule::Readxyz("data/h2_szabo.xyz", +1);
+    BOOST_CHECK_THROW(GQCP::DirectRHFSCFSolver (h2_ion, "STO-3G"), std::invalid_argument);
+
+    // Check if a zero interval for the full rebuilds throws
+    BOOST_CHECK_THROW(GQCP::DirectRHFSCFSolver (h2, "STO-3G", 1.0e-12, 0), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE ( h2o_sto3g_horton_direct ) {
+
+    // We have some reference data from horton
+    double ref_total_energy = -74.942080055631;
+
+    GQCP::VectorX<double> ref_orbital_energies (7);  // the STO-3G basisset has 7 basis functions for water
+    ref_orbital_energies << -20.26289322, -1.20969863, -0.54796582, -0.43652631, -0.38758791, 0.47762043, 0.5881361;
+
+
+    // Do our own integral-direct RHF calculation
+    auto water = GQCP::Molecule::Readxyz("data/h2o.xyz");
+    GQCP::DirectRHFSCFSolver direct_scf_solver (water, "STO-3G");
+    direct_scf_solver.solve();
+    auto rhf = direct_scf_solver.get_solution();
+
+    // Check the calculated results with the reference
+    double total_energy = rhf.get_electronic_energy() + water.calculateInternuclearRepulsionEnergy();
+    BOOST_CHECK(std::abs(total_energy - ref_total_energy) < 1.0e-06);
+    BOOST_CHECK(GQCP::areEqualEigenvalues(ref_orbital_energies, rhf.get_orbital_energies(), 1.0e-06));
+}
+
+
+BOOST_AUTO_TEST_CASE ( h2o_sto3g_direct_vs_plain ) {
+
+    // Check if the incremental Fock builds, with and without periodic full rebuilds, reproduce the conventional RHF solution
+    auto water = GQCP::Molecule::Readxyz("data/h2o_crawdad.xyz");
+    auto mol_ham_par = GQCP::HamiltonianParameters<double>::Molecular(water, "STO-3G");
+
+    GQCP::PlainRHFSCFSolver plain_scf_solver (mol_ham_par, water);
+    plain_scf_solver.solve();
+    double ref_energy = plain_scf_solver.get_solution().get_electronic_energy();
+
+    for (size_t full_rebuild_interval : {1, 4, 1000}) {
+        GQCP::DirectRHFSCFSolver direct_scf_solver (water, "STO-3G", 1.0e-12, full_rebuild_interval);
+        direct_scf_solver.solve();
+
+        BOOST_CHECK(std::abs(direct_scf_solver.get_solution().get_electronic_energy() - ref_energy) < 1.0e-08);
+    }
+}
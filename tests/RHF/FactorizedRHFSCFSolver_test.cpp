@@ -0,0 +1,107 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "FactorizedRHFSCFSolver"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
+
+#include "RHF/FactorizedRHFSCFSolver.hpp"
+#include "RHF/PlainRHFSCFSolver.hpp"
+#include "HamiltonianParameters/HamiltonianParameters.hpp"
+
+#include "utilities/linalg.hpp"
+
+
+
+BOOST_AUTO_TEST_CASE ( constructor ) {
+
+    auto h2 = GQCP::Molecule::Readxyz("data/h2_szabo.xyz");
+    GQCP::OneElectronOperator<double> S = GQCP::OneElectronOperator<double>::Identity(2, 2);
+    GQCP::OneElectronOperator<double> H_core = GQCP::OneElectronOperator<double>::Random(2, 2);
+
+    // Check a correct constructor with an even number of electrons
+    GQCP::FactorizedRHFSCFSolver factorized_solver (S, H_core, GQCP::FactorizedTwoElectronOperator<double>(2), h2);
+
+    // Check if a faulty constructor with an odd number of electron throws
+    auto h2_ion = GQCP::Molecule::Readxyz("data/h2_szabo.xyz", +1);
+    BOOST_CHECK_THROW(GQCP::FactorizedRHFSCFSolver (S, H_core, GQCP::FactorizedTwoElectronOperator<double>(2), h2_ion), std::invalid_argument);
+
+    // Check if two-electron integrals of an incompatible dimension throw
+    BOOST_CHECK_THROW(GQCP::FactorizedRHFSCFSolver (S, H_core, GQCP::FactorizedTwoElectronOperator<double>(3), h2), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE ( h2o_sto3g_horton_cholesky ) {
+
+    // We have some reference data from horton
+    double ref_total_energy = -74.942080055631;
+
+    GQCP::VectorX<double> ref_orbital_energies (7);  // the STO-3G basisset has 7 basis functions for water
+    ref_orbital_energies << -20.26289322, -1.20969863, -0.54796582, -0.43652631, -0.38758791, 0.47762043, 0.5881361;
+
+
+    // Do our own RHF calculation with the Cholesky-decomposed reference integrals
+    auto water = GQCP::Molecule::Readxyz("data/h2o.xyz");
+    size_t nbf = 7;
+    GQCP::OneElectronOperator<double> S = GQCP::OneElectronOperator<double>::FromFile("data/h2o_sto-3g_overlap_horton.data", nbf, nbf);
+    GQCP::OneElectronOperator<double> T = GQCP::OneElectronOperator<double>::FromFile("data/h2o_sto-3g_kinetic_horton.data", nbf, nbf);
+    GQCP::OneElectronOperator<double> V = GQCP::OneElectronOperator<double>::FromFile("data/h2o_sto-3g_nuclear_horton.data", nbf, nbf);
+    GQCP::TwoElectronOperator<double> g = GQCP::TwoElectronOperator<double>::FromFile("data/h2o_sto-3g_coulomb_horton.data", nbf);
+
+    auto g_chol = GQCP::FactorizedTwoElectronOperator<double>::Cholesky(g, 1.0e-10);
+    GQCP::FactorizedRHFSCFSolver factorized_scf_solver (S, GQCP::OneElectronOperator<double>(T + V), g_chol, water);
+    factorized_scf_solver.solve();
+    auto rhf = factorized_scf_solver.get_solution();
+
+    // Check the calculated results with the reference
+    double total_energy = rhf.get_electronic_energy() + water.calculateInternuclearRepulsionEnergy();
+    BOOST_CHECK(std::abs(total_energy - ref_total_energy) < 1.0e-06);
+    BOOST_CHECK(GQCP::areEqualEigenvalues(ref_orbital_energies, rhf.get_orbital_energies(), 1.0e-06));
+}
+
+
+BOOST_AUTO_TEST_CASE ( h2o_631gdp_cholesky_vs_plain ) {
+
+    // Check if the Cholesky-decomposed integrals reproduce the conventional RHF solution
+    auto water = GQCP::Molecule::Readxyz("data/h2o_crawdad.xyz");
+    auto mol_ham_par = GQCP::HamiltonianParameters<double>::Molecular(water, "6-31G**");
+
+    GQCP::PlainRHFSCFSolver plain_scf_solver (mol_ham_par, water);
+    plain_scf_solver.solve();
+    double ref_energy = plain_scf_solver.get_solution().get_electronic_energy();
+
+    auto cholesky_scf_solver = GQCP::FactorizedRHFSCFSolver::Cholesky(water, "6-31G**", 1.0e-08);
+    cholesky_scf_solver.solve();
+    BOOST_CHECK(std::abs(cholesky_scf_solver.get_solution().get_electronic_energy() - ref_energy) < 1.0e-06);
+}
+
+
+BOOST_AUTO_TEST_CASE ( h2o_ccpvdz_density_fitted_vs_plain ) {
+
+    // Check if the density-fitted integrals approximate the conventional RHF solution
+    auto water = GQCP::Molecule::Readxyz("data/h2o.xyz");
+    auto mol_ham_par = GQCP::HamiltonianParameters<double>::Molecular(water, "cc-pVDZ");
+
+    GQCP::PlainRHFSCFSolver plain_scf_solver (mol_ham_par, water);
+    plain_scf_solver.solve();
+    double ref_energy = plain_scf_solver.get_solution().get_electronic_energy();
+
+    auto density_fitted_scf_solver = GQCP::FactorizedRHFSCFSolver::DensityFitted(water, "cc-pVDZ", "cc-pVDZ-RI");
+    density_fitted_scf_solver.solve();
+    BOOST_CHECK(std::abs(density_fitted_scf_solver.get_solution().get_electronic_energy() - ref_energy) < 1.0e-02);
+}
@@ -52,6 +52,63 @@ BOOST_AUTO_TEST_CASE ( RHF_1RDM_matrix ) {
 }
 
 
+BOOST_AUTO_TEST_CASE ( RHF_AO_Fock_matrix ) {
+
+    // Check the two-electron part of the Fock matrix against explicit tensor contractions, for a random (non-symmetric) density matrix
+    size_t K = 5;
+    auto ham_par = GQCP::HamiltonianParameters<double>::Random(K);
+    const auto& g = ham_par.get_g();
+    GQCP::OneRDM<double> D = GQCP::OneRDM<double>::Random(K, K);
+
+    GQCP::SquareMatrix<double> J = GQCP::SquareMatrix<double>::Zero(K, K);
+    GQCP::SquareMatrix<double> K_ref = GQCP::SquareMatrix<double>::Zero(K, K);
+    for (size_t mu = 0; mu < K; mu++) {
+        for (size_t nu = 0; nu < K; nu++) {
+            for (size_t rho = 0; rho < K; rho++) {
+                for (size_t lambda = 0; lambda < K; lambda++) {
+                    J(mu,nu) += g(mu,nu,rho,lambda) * D(lambda,rho);
+                    K_ref(mu,lambda) += g(mu,nu,rho,lambda) * D(nu,rho);
+                }
+            }
+        }
+    }
+    GQCP::SquareMatrix<double> G_ref = J - 0.5 * K_ref;
+
+    // The result shouldn't depend on the number of threads, even if there are more threads than basis functions
+    for (size_t number_of_threads : {1, 2, 3, 8}) {
+        BOOST_CHECK(GQCP::calculateRHFAOTwoElectronFockMatrix(D, g, number_of_threads).isApprox(G_ref, 1.0e-12));
+    }
+    BOOST_CHECK(GQCP::calculateRHFAOFockMatrix(D, ham_par).isApprox(ham_par.get_h() + G_ref, 1.0e-12));
+
+
+    // Check that incompatible dimensions throw
+    GQCP::OneRDM<double> D_wrong = GQCP::OneRDM<double>::Random(K+1, K+1);
+    BOOST_CHECK_THROW(GQCP::calculateRHFAOTwoElectronFockMatrix(D_wrong, g), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE ( RHF_AO_Fock_matrix_factorized ) {
+
+    // Check the RI-J/K two-electron part of the Fock matrix against the one that is calculated from the dense two-electron integrals
+    size_t K = 5;
+    size_t M = 7;
+    GQCP::FactorizedTwoElectronOperator<double> g (K, GQCP::MatrixX<double>::Random(K*K, M));
+    GQCP::OneRDM<double> D = GQCP::OneRDM<double>::Random(K, K);
+
+    GQCP::SquareMatrix<double> G_ref = GQCP::calculateRHFAOTwoElectronFockMatrix(D, g.toTwoElectronOperator());
+
+    // The result shouldn't depend on the number of threads, even if there are more threads than vectors
+    for (size_t number_of_threads : {1, 2, 3, 8}) {
+        BOOST_CHECK(GQCP::calculateRHFAOTwoElectronFockMatrix(D, g, number_of_threads).isApprox(G_ref, 1.0e-12));
+    }
+
+
+    // Check that incompatible dimensions throw
+    GQCP::OneRDM<double> D_wrong = GQCP::OneRDM<double>::Random(K+1, K+1);
+    BOOST_CHECK_THROW(GQCP::calculateRHFAOTwoElectronFockMatrix(D_wrong, g), std::invalid_argument);
+}
+
+
 BOOST_AUTO_TEST_CASE ( HOMO_LUMO_index ) {
 
     // For K=7 and N=10, the index of the HOMO should be 4
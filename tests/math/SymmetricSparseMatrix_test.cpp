@@ -0,0 +1,132 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "SymmetricSparseMatrix"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
+
+#include "math/SymmetricSparseMatrix.hpp"
+
+
+/**
+ *  @return a symmetric test matrix with some zero off-diagonal elements
+ */
+GQCP::MatrixX<double> testMatrix() {
+
+    GQCP::MatrixX<double> A (5, 5);
+    A << 1.0,  2.0,  0.0,  0.0,  3.0,
+         2.0,  4.0, -1.0,  0.0,  0.0,
+         0.0, -1.0,  5.0,  6.0,  0.0,
+         0.0,  0.0,  6.0, -2.0,  7.0,
+         3.0,  0.0,  0.0,  7.0,  8.0;
+
+    return A;
+}
+
+
+BOOST_AUTO_TEST_CASE ( constructor_triplets ) {
+
+    GQCP::MatrixX<double> A = testMatrix();
+
+    // Provide the full matrix, with one upper element split into two duplicates: the lower triangle should be ignored
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = 0; j < 5; j++) {
+            if ((i == 0) && (j == 4)) {
+                triplets.emplace_back(i, j, 1.0);
+                triplets.emplace_back(i, j, 2.0);
+            } else if (std::abs(A(i,j)) > 1.0e-12) {
+                triplets.emplace_back(i, j, A(i,j));
+            }
+        }
+    }
+
+    GQCP::SymmetricSparseMatrix<double> S (5, triplets);
+    BOOST_CHECK_EQUAL(S.get_dimension(), 5);
+    BOOST_CHECK_EQUAL(S.countStoredElements(), 10);  // 5 diagonal elements and 5 strictly upper elements
+
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = 0; j < 5; j++) {
+            BOOST_CHECK(std::abs(S(i,j) - A(i,j)) < 1.0e-12);
+        }
+    }
+    BOOST_CHECK(S.diagonal().isApprox(A.diagonal()));
+
+
+    // Check that out-of-bounds elements throw
+    std::vector<Eigen::Triplet<double>> wrong_triplets {Eigen::Triplet<double>(0, 5, 1.0)};
+    BOOST_CHECK_THROW(GQCP::SymmetricSparseMatrix<double> (5, wrong_triplets), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE ( constructor_sparse ) {
+
+    GQCP::MatrixX<double> A = testMatrix();
+    Eigen::SparseMatrix<double> A_sparse = A.sparseView();
+
+    GQCP::SymmetricSparseMatrix<double> S (A_sparse);
+    BOOST_CHECK_EQUAL(S.countStoredElements(), 10);
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = 0; j < 5; j++) {
+            BOOST_CHECK(std::abs(S(i,j) - A(i,j)) < 1.0e-12);
+        }
+    }
+
+
+    // Check that non-square matrices throw
+    Eigen::SparseMatrix<double> B (5, 4);
+    BOOST_CHECK_THROW(GQCP::SymmetricSparseMatrix<double> S_B (B), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE ( matrixVectorProduct ) {
+
+    GQCP::MatrixX<double> A = testMatrix();
+    Eigen::SparseMatrix<double> A_sparse = A.sparseView();
+    GQCP::SymmetricSparseMatrix<double> S (A_sparse);
+
+    GQCP::VectorX<double> x (5);
+    x << 1.0, -2.0, 0.5, 3.0, -1.5;
+    GQCP::VectorX<double> ref = A * x;
+
+    // The result shouldn't depend on the number of threads, even if there are more threads than rows
+    for (size_t number_of_threads : {1, 2, 3, 8}) {
+        BOOST_CHECK(S.matrixVectorProduct(x, number_of_threads).isApprox(ref, 1.0e-12));
+    }
+
+    GQCP::VectorX<double> y (4);
+    BOOST_CHECK_THROW(S.matrixVectorProduct(y), std::invalid_argument);
+}
+
+
+BOOST_AUTO_TEST_CASE ( blockMatrixVectorProduct ) {
+
+    GQCP::MatrixX<double> A = testMatrix();
+    Eigen::SparseMatrix<double> A_sparse = A.sparseView();
+    GQCP::SymmetricSparseMatrix<double> S (A_sparse);
+
+    GQCP::MatrixX<double> X = GQCP::MatrixX<double>::Random(5, 3);
+    GQCP::MatrixX<double> ref = A * X;
+
+    for (size_t number_of_threads : {1, 2, 3, 8}) {
+        BOOST_CHECK(S.blockMatrixVectorProduct(X, number_of_threads).isApprox(ref, 1.0e-12));
+    }
+
+    GQCP::MatrixX<double> Y (4, 3);
+    BOOST_CHECK_THROW(S.blockMatrixVectorProduct(Y), std::invalid_argument);
+}
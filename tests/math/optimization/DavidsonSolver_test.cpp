@@ -387,3 +387,124 @@ BOOST_AUTO_TEST_CASE ( liu_1000_number_of_requested_eigenpairs ) {
         BOOST_CHECK(std::abs(eigenpairs[i].get_eigenvector().norm() - 1) < 1.0e-12);  // check if the found eigenpairs are normalized
     }
 }
+
+
+BOOST_AUTO_TEST_CASE ( constructor_block ) {
+
+    GQCP::SquareMatrix<double> A = GQCP::SquareMatrix<double>::Random(10, 10);
+    GQCP::MatrixX<double> X_0 = GQCP::MatrixX<double>::Identity(10, 10).topLeftCorner(10, 2);
+
+    GQCP::DavidsonSolverOptions solver_options (X_0);
+    solver_options.block_size = 0;
+    BOOST_CHECK_THROW(GQCP::DavidsonSolver (A, solver_options), std::invalid_argument);  // the block size must be at least 1
+
+    solver_options.block_size = 14;
+    BOOST_CHECK_THROW(GQCP::DavidsonSolver (A, solver_options), std::invalid_argument);  // collapsed subspace dimension (2) + block size (14) is larger than the maximum subspace dimension (15)
+
+    solver_options.block_size = 2;
+    BOOST_CHECK_NO_THROW(GQCP::DavidsonSolver (A, solver_options));
+}
+
+
+// Test the block Davidson algorithm, in which the converged eigenpairs are locked
+BOOST_AUTO_TEST_CASE ( liu_1000_block ) {
+
+    size_t number_of_requested_eigenpairs = 3;
+
+    // Let's prepare the Liu reference test (liu1978)
+    size_t N = 1000;
+    GQCP::SquareMatrix<double> A = GQCP::SquareMatrix<double>::Ones(N, N);
+    for (size_t i = 0; i < N; i++) {
+        if (i < 5) {
+            A(i, i) = 1 + 0.1 * i;
+        } else {
+            A(i, i) = 2 * (i + 1) - 1;
+        }
+    }
+
+
+    // Solve the eigenvalue problem with Eigen
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigensolver (A);
+    GQCP::VectorX<double> ref_lowest_eigenvalues = eigensolver.eigenvalues().head(number_of_requested_eigenpairs);
+    GQCP::MatrixX<double> ref_lowest_eigenvectors = eigensolver.eigenvectors().topLeftCorner(N, number_of_requested_eigenpairs);
+
+    std::vector<GQCP::Eigenpair> ref_eigenpairs (number_of_requested_eigenpairs);
+    for (size_t i = 0; i < number_of_requested_eigenpairs; i++) {
+        ref_eigenpairs[i] = GQCP::Eigenpair(ref_lowest_eigenvalues(i), ref_lowest_eigenvectors.col(i));
+    }
+
+
+    // Solve using the block Davidson diagonalization, forcing some subspace collapses
+    // The matrix-vector products are counted to check that they are calculated in blocks
+    size_t number_of_block_products = 0;
+    GQCP::BlockVectorFunction blockMatrixVectorProduct = [&A, &number_of_block_products](const GQCP::MatrixX<double>& X) {
+        number_of_block_products++;
+        return GQCP::MatrixX<double>(A * X);
+    };
+
+    GQCP::MatrixX<double> X_0 = GQCP::MatrixX<double>::Identity(N, N).topLeftCorner(N, number_of_requested_eigenpairs);
+    GQCP::DavidsonSolverOptions solver_options (X_0);
+    solver_options.number_of_requested_eigenpairs = number_of_requested_eigenpairs;
+    solver_options.collapsed_subspace_dimension = number_of_requested_eigenpairs;
+    solver_options.maximum_subspace_dimension = 9;
+    solver_options.block_size = number_of_requested_eigenpairs;
+    solver_options.lock_converged_eigenpairs = true;
+
+    GQCP::DavidsonSolver davidson_solver (blockMatrixVectorProduct, A.diagonal(), solver_options);
+    davidson_solver.solve();
+
+    std::vector<GQCP::Eigenpair> eigenpairs = davidson_solver.get_eigenpairs();
+    for (size_t i = 0; i < number_of_requested_eigenpairs; i++) {
+        BOOST_CHECK(eigenpairs[i].isEqual(ref_eigenpairs[i]));  // check if the found eigenpairs are equal to the reference eigenpairs
+        BOOST_CHECK(std::abs(eigenpairs[i].get_eigenvector().norm() - 1) < 1.0e-12);  // check if the found eigenpairs are normalized
+    }
+
+    BOOST_CHECK(number_of_block_products == davidson_solver.get_number_of_iterations() + 1);  // one block product for the initial guesses and one per iteration
+}
+
+
+// Test the block Davidson algorithm with more requested eigenpairs than the block size, without locking the converged eigenpairs
+BOOST_AUTO_TEST_CASE ( liu_1000_block_smaller_than_number_of_requested_eigenpairs ) {
+
+    size_t number_of_requested_eigenpairs = 6;
+
+    // Let's prepare the Liu reference test (liu1978)
+    size_t N = 1000;
+    GQCP::SquareMatrix<double> A = GQCP::SquareMatrix<double>::Ones(N, N);
+    for (size_t i = 0; i < N; i++) {
+        if (i < 5) {
+            A(i, i) = 1 + 0.1 * i;
+        } else {
+            A(i, i) = 2 * (i + 1) - 1;
+        }
+    }
+
+
+    // Solve the eigenvalue problem with Eigen
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigensolver (A);
+    GQCP::VectorX<double> ref_lowest_eigenvalues = eigensolver.eigenvalues().head(number_of_requested_eigenpairs);
+    GQCP::MatrixX<double> ref_lowest_eigenvectors = eigensolver.eigenvectors().topLeftCorner(N, number_of_requested_eigenpairs);
+
+    std::vector<GQCP::Eigenpair> ref_eigenpairs (number_of_requested_eigenpairs);
+    for (size_t i = 0; i < number_of_requested_eigenpairs; i++) {
+        ref_eigenpairs[i] = GQCP::Eigenpair(ref_lowest_eigenvalues(i), ref_lowest_eigenvectors.col(i));
+    }
+
+
+    // Solve using the block Davidson diagonalization: every root should get correction vectors, not only the first block_size ones
+    GQCP::MatrixX<double> X_0 = GQCP::MatrixX<double>::Identity(N, N).topLeftCorner(N, number_of_requested_eigenpairs);
+    GQCP::DavidsonSolverOptions solver_options (X_0);
+    solver_options.number_of_requested_eigenpairs = number_of_requested_eigenpairs;
+    solver_options.collapsed_subspace_dimension = number_of_requested_eigenpairs;
+    solver_options.maximum_subspace_dimension = 10;
+    solver_options.block_size = 2;
+    solver_options.lock_converged_eigenpairs = false;
+
+    GQCP::DavidsonSolver davidson_solver (A, solver_options);
+    davidson_solver.solve();
+
+    std::vector<GQCP::Eigenpair> eigenpairs = davidson_solver.get_eigenpairs();
+    for (size_t i = 0; i < number_of_requested_eigenpairs; i++) {
+        BOOST_CHECK(eigenpairs[i].isEqual(ref_eigenpairs[i]));  // check if the found eigenpairs are equal to the reference eigenpairs
+    }
+}
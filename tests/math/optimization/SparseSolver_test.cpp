@@ -175,3 +175,103 @@ BOOST_AUTO_TEST_CASE ( simple_sparse_number_of_requested_eigenpairs ) {
         std::cerr << "I caught a runtime error, which probably means that Spectra didn't find a solution. For the purpose of testing, this isn't numopt's fault.";
     }
 }
+
+
+BOOST_AUTO_TEST_CASE ( addToMatrix_duplicates ) {
+
+    // Values that are added to the same element should be summed
+    GQCP::SparseSolver sparse_solver (3);
+    sparse_solver.addToMatrix(1.0, 0, 1);
+    sparse_solver.addToMatrix(2.0, 0, 1);
+    sparse_solver.addToMatrix(4.0, 2, 2);
+
+    BOOST_CHECK(std::abs(sparse_solver.get_matrix().coeff(0, 1) - 3.0) < 1.0e-12);
+    BOOST_CHECK(std::abs(sparse_solver.get_matrix().coeff(2, 2) - 4.0) < 1.0e-12);
+
+    // Adding values after the matrix has been assembled should still work
+    sparse_solver.addToMatrix(1.0, 0, 1);
+    BOOST_CHECK(std::abs(sparse_solver.get_matrix().coeff(0, 1) - 4.0) < 1.0e-12);
+    BOOST_CHECK_EQUAL(sparse_solver.get_matrix().nonZeros(), 2);
+}
+
+
+BOOST_AUTO_TEST_CASE ( preassembled_and_matrix_free ) {
+
+    // Create a random sparse symmetric matrix
+    std::default_random_engine gen;
+    std::uniform_real_distribution<double> dist (0.0,1.0);
+
+    size_t dim = 100;
+    std::vector<Eigen::Triplet<double>> triplet_list;
+    for (size_t i = 0; i < dim; i++) {
+        triplet_list.emplace_back(static_cast<int>(i), static_cast<int>(i), static_cast<double>(i));
+
+        for (size_t j = 0; j < i; j++) {
+            auto random_number = dist(gen);
+
+            if (random_number > 0.8) {  // if larger than a threshold, insert it (symmetrically)
+                triplet_list.emplace_back(static_cast<int>(i), static_cast<int>(j), random_number);
+                triplet_list.emplace_back(static_cast<int>(j), static_cast<int>(i), random_number);
+            }
+        }
+    }
+
+    Eigen::SparseMatrix<double> A (dim, dim);
+    A.setFromTriplets(triplet_list.begin(), triplet_list.end());
+
+
+    // Find the lowest eigenpairs using the dense representation
+    Eigen::MatrixXd A_dense = A;
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> dense_eigensolver (A_dense);
+    GQCP::VectorX<double> ref_eigenvalues = dense_eigensolver.eigenvalues().head(3);
+
+
+    GQCP::SparseSolverOptions solver_options;
+    solver_options.number_of_requested_eigenpairs = 3;
+
+    // Solve using the preassembled sparse matrix
+    GQCP::SparseSolver preassembled_solver (A, solver_options);
+    preassembled_solver.solve();
+
+    // Solve without storing the matrix
+    GQCP::VectorFunction matrixVectorProduct = [&A] (const GQCP::VectorX<double>& x) { return GQCP::VectorX<double>(A * x); };
+    GQCP::SparseSolver matrix_free_solver (matrixVectorProduct, dim, solver_options);
+    matrix_free_solver.solve();
+
+    for (size_t i = 0; i < 3; i++) {
+        BOOST_CHECK(std::abs(preassembled_solver.get_eigenpairs()[i].get_eigenvalue() - ref_eigenvalues(i)) < 1.0e-08);
+        BOOST_CHECK(std::abs(matrix_free_solver.get_eigenpairs()[i].get_eigenvalue() - ref_eigenvalues(i)) < 1.0e-08);
+        BOOST_CHECK(std::abs(matrix_free_solver.get_eigenpairs()[i].get_eigenvector().norm() - 1) < 1.0e-12);
+    }
+
+    // A matrix-free solver doesn't accept matrix elements
+    BOOST_CHECK_THROW(matrix_free_solver.addToMatrix(1.0, 0, 0), std::logic_error);
+}
+
+
+BOOST_AUTO_TEST_CASE ( tiny_dimension ) {
+
+    // A matrix that can't accommodate 2 more Lanczos vectors than requested eigenvalues
+    size_t dim = 3;
+    GQCP::SquareMatrix<double> A = GQCP::SquareMatrix<double>::Random(dim, dim);
+    A = A + A.transpose().eval();
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> dense_eigensolver (A);
+    GQCP::VectorX<double> ref_eigenvalues = dense_eigensolver.eigenvalues();
+
+    GQCP::SparseSolverOptions solver_options;
+    solver_options.number_of_requested_eigenpairs = 2;
+    GQCP::VectorFunction matrixVectorProduct = [&A] (const GQCP::VectorX<double>& x) { return GQCP::VectorX<double>(A * x); };
+    GQCP::SparseSolver matrix_free_solver (matrixVectorProduct, dim, solver_options);
+    matrix_free_solver.solve();
+
+    for (size_t i = 0; i < 2; i++) {
+        BOOST_CHECK(std::abs(matrix_free_solver.get_eigenpairs()[i].get_eigenvalue() - ref_eigenvalues(i)) < 1.0e-12);
+        BOOST_CHECK(std::abs(matrix_free_solver.get_eigenpairs()[i].get_eigenvector().norm() - 1) < 1.0e-12);
+    }
+
+    // Requesting more eigenpairs than the dimension is an error
+    solver_options.number_of_requested_eigenpairs = 4;
+    GQCP::SparseSolver too_many_solver (matrixVectorProduct, dim, solver_options);
+    BOOST_CHECK_THROW(too_many_solver.solve(), std::invalid_argument);
+}
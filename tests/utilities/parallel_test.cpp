@@ -0,0 +1,100 @@
+// This file is part of GQCG-gqcp.
+// 
+// Copyright (C) 2017-2019  the GQCG developers
+// 
+// GQCG-gqcp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GQCG-gqcp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with GQCG-gqcp.  If not, see <http://www.gnu.org/licenses/>.
+// 
+#define BOOST_TEST_MODULE "parallel"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/included/unit_test.hpp>  // include this to get main(), otherwise the compiler will complain
+
+#include "utilities/parallel.hpp"
+
+#include <stdexcept>
+
+
+BOOST_AUTO_TEST_CASE ( number_of_threads ) {
+
+    BOOST_CHECK(GQCP::getNumberOfThreads() >= 1);
+
+    GQCP::setNumberOfThreads(3);
+    BOOST_CHECK(GQCP::getNumberOfThreads() == 3);
+
+    // Setting zero threads should restore the default
+    GQCP::setNumberOfThreads(0);
+    BOOST_CHECK(GQCP::getNumberOfThreads() >= 1);
+}
+
+
+BOOST_AUTO_TEST_CASE ( parallelFor ) {
+
+    // Check if every index is visited exactly once, for a number of threads that does and doesn't divide the range
+    for (size_t number_of_threads : {1, 2, 3, 4, 11, 20}) {
+        std::vector<size_t> visits (11, 0);
+        GQCP::parallelFor(0, 11, [&visits] (size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                visits[i]++;
+            }
+        }, number_of_threads);
+
+        for (size_t i = 0; i < 11; i++) {
+            BOOST_CHECK(visits[i] == 1);
+        }
+    }
+
+
+    // Check if an empty range doesn't call the function
+    bool is_called = false;
+    GQCP::parallelFor(4, 4, [&is_called] (size_t begin, size_t end) { is_called = true; }, 2);
+    BOOST_CHECK(!is_called);
+}
+
+
+BOOST_AUTO_TEST_CASE ( parallelFor_throws ) {
+
+    // Check if an exception in one of the threads is passed to the calling thread
+    BOOST_CHECK_THROW(GQCP::parallelFor(0, 10, [] (size_t begin, size_t end) {
+        if (begin == 0) {
+            throw std::runtime_error("first chunk");
+        }
+    }, 4), std::runtime_error);
+}
+
+
+BOOST_AUTO_TEST_CASE ( parallelForDynamic ) {
+
+    // Check if every index is visited exactly once, and if the thread indices are in range
+    for (size_t number_of_threads : {1, 2, 3, 4, 20}) {
+        std::vector<size_t> visits (11, 0);
+        std::vector<size_t> thread_indices (11, 0);
+        GQCP::parallelForDynamic(2, 13, [&visits, &thread_indices] (size_t index, size_t thread_index) {
+            visits[index - 2]++;
+            thread_indices[index - 2] = thread_index;
+        }, number_of_threads);
+
+        for (size_t i = 0; i < 11; i++) {
+            BOOST_CHECK(visits[i] == 1);
+            BOOST_CHECK(thread_indices[i] < std::min<size_t>(number_of_threads, 11));
+        }
+    }
+
+
+    // Check if an exception in one of the threads is passed to the calling thread
+    BOOST_CHECK_THROW(GQCP::parallelForDynamic(0, 100, [] (size_t index, size_t thread_index) {
+        if (index == 5) {
+            throw std::runtime_error("index 5");
+        }
+    }, 4), std::runtime_error);
+}